@@ -31,10 +31,23 @@
 
 #include "AppCore.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
 #include <utility>
 #include "AppOptions.h"
+#include "BatchReport.h"
+#include "QuoteArchive.h"
 #include "IAttestationLibraryAdapter.h"
 #include "StatusPrinter.h"
+#include "VerificationServer.h"
+
+#ifdef __linux__
+#include <csignal>
+#endif
 
 namespace intel { namespace sgx { namespace dcap {
 
@@ -66,6 +79,48 @@ void outputResult(const std::string& step, Status status, std::ostream& logger)
         logger << step << " verification OK!" << std::endl;
     }
 }
+
+#ifdef __linux__
+VerificationServer* runningServer = nullptr;
+
+void stopRunningServer(int)
+{
+    if (runningServer != nullptr)
+    {
+        runningServer->stop();
+    }
+}
+
+void reloadRunningServer(int)
+{
+    if (runningServer != nullptr)
+    {
+        runningServer->reload();
+    }
+}
+
+std::vector<std::string> collateralDirectories(const AppOptions& options)
+{
+    std::vector<std::string> directories;
+    for (const auto& file : {options.pckCertificateFile, options.intermediateCaCrlFile, options.tcbInfoFile, options.qeIdentityFile,
+                             options.rootCaCrlFile, options.pckSigningChainFile, options.tcbSigningChainFile,
+                             options.trustedRootCACertificateFile, options.qveIdentityFile})
+    {
+        if (file.empty())
+        {
+            continue;
+        }
+        const auto separator = file.find_last_of('/');
+        const auto directory = separator == std::string::npos ? std::string(".") :
+                               separator == 0 ? std::string("/") : file.substr(0, separator);
+        if (std::find(directories.begin(), directories.end(), directory) == directories.end())
+        {
+            directories.push_back(directory);
+        }
+    }
+    return directories;
+}
+#endif
 }
 
 AppCore::AppCore(std::shared_ptr<IAttestationLibraryAdapter> libAdapter, std::shared_ptr<IFileReader> reader)
@@ -82,62 +137,336 @@ bool AppCore::runVerification(const AppOptions& options, std::ostream& logger) c
 {
     try
     {
-        static constexpr char PEM_HEADER_STRING_X509_CRL[] = "-----BEGIN X509 CRL-----";
-        const auto expirationDate = options.expirationDate;
-        const auto pckCert = fileReader->readContent(options.pckCertificateFile);
-        const auto pckSigningChain = fileReader->readContent(options.pckSigningChainFile);
-        const auto pckCertChain = pckSigningChain + pckCert;
-        auto rootCaCrl = fileReader->readContent(options.rootCaCrlFile);
-        if (rootCaCrl.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
+        const auto collateral = readCollateral(options);
+        const auto collateralValid = verifyCollateral(collateral, options.expirationDate, logger);
+
+        const auto quote = fileReader->readBinaryContent(options.quoteFile);
+        const auto quoteVerifyStatus = attestationLib->verifyQuote(quote, collateral.pckCert, collateral.intermediateCaCrl,
+                                                                   collateral.tcbInfo, collateral.qeIdentity);
+        outputResult("Quote", quoteVerifyStatus, logger);
+
+        return collateralValid && (quoteVerifyStatus == STATUS_OK);
+    }
+    catch (const IFileReader::ReadFileException& e)
+    {
+        logger << "ERROR while trying to read input files: " << e.what();
+        return false;
+    }
+}
+
+bool AppCore::runServer(const AppOptions& options, std::ostream& logger) const
+{
+#ifdef __linux__
+    QuoteCollateral quoteCollateral;
+    if (!loadServedCollateral(options, options.expirationDate, quoteCollateral, logger))
+    {
+        logger << "Collateral verification failed, not starting" << std::endl;
+        return false;
+    }
+
+    VerificationServer server(attestationLib, std::move(quoteCollateral));
+    if (!server.listen(options.serveSocketPath, logger))
+    {
+        return false;
+    }
+
+    const auto reloader = [this, &options, &logger](QuoteCollateral& collateral) {
+        // a daemon outlives the expiration date taken at startup
+        const auto expirationDate = std::max(options.expirationDate, std::time(nullptr));
+        const auto reloaded = loadServedCollateral(options, expirationDate, collateral, logger);
+        logger << (reloaded ? "Collateral reloaded" : "Collateral reload failed, keeping previous one") << std::endl;
+        return reloaded;
+    };
+    if (!server.enableReload(reloader, options.watchCollateral ? collateralDirectories(options) : std::vector<std::string>{},
+                             logger))
+    {
+        return false;
+    }
+
+    runningServer = &server;
+    struct sigaction action{};
+    action.sa_handler = stopRunningServer;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    action.sa_handler = reloadRunningServer;
+    sigaction(SIGHUP, &action, nullptr);
+
+    const bool listening = server.run();
+
+    action.sa_handler = SIG_DFL;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGHUP, &action, nullptr);
+    runningServer = nullptr;
+    logger << (listening ? "Verification server stopped" : "Verification server stopped, listening socket failed") << std::endl;
+    return listening;
+#else
+    (void) options;
+    logger << "Verification server is supported on Linux only" << std::endl;
+    return false;
+#endif
+}
+
+bool AppCore::runBatch(const AppOptions& options, std::ostream& logger) const
+{
+    QuoteCollateral collateral;
+    if (!loadServedCollateral(options, options.expirationDate, collateral, logger))
+    {
+        logger << "Collateral verification failed, quotes not verified" << std::endl;
+        return false;
+    }
+
+    std::vector<QuoteArchive::Entry> quotes;
+    try
+    {
+        quotes = readQuotes(options);
+    }
+    catch (const IFileReader::ReadFileException& e)
+    {
+        logger << "ERROR while trying to read input files: " << e.what() << std::endl;
+        return false;
+    }
+
+    std::ofstream resultFile;
+    if (!options.resultFile.empty())
+    {
+        resultFile.open(options.resultFile, std::ios::trunc);
+        if (!resultFile.is_open())
         {
-            rootCaCrl = bytesToHexString(fileReader->readBinaryContent(options.rootCaCrlFile));
+            logger << "ERROR can't open result file \"" << options.resultFile << "\"" << std::endl;
+            return false;
         }
-        auto intermediateCaCrl = fileReader->readContent(options.intermediateCaCrlFile);
-        if (intermediateCaCrl.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
+    }
+
+    const size_t requestedThreads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    const auto threadCount = std::max<size_t>(1, std::min(requestedThreads, quotes.size()));
+    std::vector<BatchResult> results(quotes.size());
+    std::atomic<size_t> nextQuote{0};
+    const auto verifyQuotes = [&]() {
+        for (auto index = nextQuote++; index < quotes.size(); index = nextQuote++)
         {
-            intermediateCaCrl = bytesToHexString(fileReader->readBinaryContent(options.intermediateCaCrlFile));
+            auto& result = results[index];
+            result.quotePath = quotes[index].name;
+            try
+            {
+                // archive entries are mapped already, the view is released right after verification
+                const auto quote = quotes[index].quote.owner ? std::move(quotes[index].quote)
+                                                             : fileReader->mapContent(result.quotePath);
+                const auto start = std::chrono::steady_clock::now();
+                result.status = attestationLib->verifyQuoteWithCollateral(quote.data, quote.size, "", collateral);
+                result.latencyUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+                result.quoteRead = true;
+            }
+            catch (const IFileReader::ReadFileException&)
+            {
+                result.quoteRead = false;
+            }
         }
-        const auto trustedRootCACert = fileReader->readContent(options.trustedRootCACertificateFile);
-        const auto pckVerifyStatus = attestationLib->verifyPCKCertificate(pckCertChain, rootCaCrl, intermediateCaCrl, trustedRootCACert, expirationDate);
-        outputResult("PCK certificate chain", pckVerifyStatus, logger);
-
-        const auto tcbInfo = fileReader->readContent(options.tcbInfoFile);
-        const auto tcbSigningCert = fileReader->readContent(options.tcbSigningChainFile);
-        const auto tcbVerifyStatus = attestationLib->verifyTCBInfo(tcbInfo, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
-        outputResult("TCB info", tcbVerifyStatus, logger);
-
-        const auto qeIdentityPresent = !options.qeIdentityFile.empty();
-        std::string qeIdentity = std::string{};
-        Status qeIdentityVerifyStatus = STATUS_OK;
-        if (qeIdentityPresent)
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(verifyQuotes);
+    }
+    verifyQuotes();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto& resultOutput = resultFile.is_open() ? static_cast<std::ostream&>(resultFile) : logger;
+    writeResultHeader(options.resultFormat, resultOutput);
+    for (const auto& result : results)
+    {
+        writeResult(result, options.resultFormat, resultOutput);
+    }
+    resultOutput.flush();
+    writeSummary(summarize(results, elapsed), logger);
+
+    return std::all_of(results.begin(), results.end(), [](const BatchResult& result) {
+        return result.quoteRead && result.status == STATUS_OK;
+    });
+}
+
+bool AppCore::packQuotes(const AppOptions& options, std::ostream& logger) const
+{
+    std::vector<QuoteArchive::Entry> quotes;
+    try
+    {
+        quotes = readQuotes(options);
+    }
+    catch (const IFileReader::ReadFileException& e)
+    {
+        logger << "ERROR while trying to read input files: " << e.what() << std::endl;
+        return false;
+    }
+
+    std::ofstream archive(options.packQuotes, std::ios::binary | std::ios::trunc);
+    if (!archive.is_open())
+    {
+        logger << "ERROR can't open quote archive \"" << options.packQuotes << "\"" << std::endl;
+        return false;
+    }
+    try
+    {
+        QuoteArchive::write(quotes.size(), [this, &quotes](size_t index) {
+            const auto& quote = quotes[index];
+            return QuoteArchive::Entry{quote.name, quote.quote.owner ? quote.quote : fileReader->mapContent(quote.name)};
+        }, archive);
+        archive.close();
+    }
+    catch (const std::exception& e)
+    {
+        logger << "ERROR while packing quotes: " << e.what() << std::endl;
+        return false;
+    }
+    if (archive.fail())
+    {
+        logger << "ERROR while writing quote archive \"" << options.packQuotes << "\"" << std::endl;
+        return false;
+    }
+
+    logger << "Packed " << quotes.size() << " quotes into " << options.packQuotes << std::endl;
+    return true;
+}
+
+bool AppCore::loadServedCollateral(const AppOptions& options, const time_t& expirationDate, QuoteCollateral& quoteCollateral,
+                                   std::ostream& logger) const
+{
+    try
+    {
+        const auto collateral = readCollateral(options);
+        if (!verifyCollateral(collateral, expirationDate, logger))
+        {
+            return false;
+        }
+        quoteCollateral = QuoteCollateral{collateral.pckCert, collateral.intermediateCaCrl, collateral.tcbInfo,
+                                          collateral.qeIdentity, nullptr};
+    }
+    catch (const IFileReader::ReadFileException& e)
+    {
+        logger << "ERROR while trying to read input files: " << e.what() << std::endl;
+        return false;
+    }
+
+    const auto parseStatus = attestationLib->parseCollateral(quoteCollateral);
+    outputResult("Collateral parsing", parseStatus, logger);
+    return parseStatus == STATUS_OK;
+}
+
+std::vector<QuoteArchive::Entry> AppCore::readQuotes(const AppOptions& options) const
+{
+    std::vector<QuoteArchive::Entry> quotes;
+    for (auto& path : readQuotePaths(options))
+    {
+        // mapped when verified, so only quotes in progress are mapped at a time
+        quotes.push_back(QuoteArchive::Entry{std::move(path), FileView{nullptr, 0, nullptr}});
+    }
+    if (!options.quoteArchive.empty())
+    {
+        QuoteArchive archive;
+        if (!archive.parse(fileReader->mapContent(options.quoteArchive)))
+        {
+            throw IFileReader::ReadFileException("\"" + options.quoteArchive + "\" is not a valid quote archive");
+        }
+        for (size_t index = 0; index < archive.size(); ++index)
         {
-            qeIdentity = fileReader->readContent(options.qeIdentityFile);
-            qeIdentityVerifyStatus = attestationLib->verifyQeIdentity(qeIdentity, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
-            outputResult("QeIdentity", qeIdentityVerifyStatus, logger);
+            quotes.push_back(QuoteArchive::Entry{options.quoteArchive + ":" + archive.name(index), archive.quote(index)});
         }
+    }
+    return quotes;
+}
 
-        const auto qveIdentityPresent = !options.qveIdentityFile.empty();
-        std::string qveIdentity = std::string{};
-        Status qveIdentityVerifyStatus = STATUS_OK;
-        if (qveIdentityPresent)
+std::vector<std::string> AppCore::readQuotePaths(const AppOptions& options) const
+{
+    std::vector<std::string> quotePaths;
+    if (!options.quoteDir.empty())
+    {
+        quotePaths = fileReader->listFiles(options.quoteDir);
+    }
+    if (!options.quoteList.empty())
+    {
+        std::istringstream list(fileReader->readContent(options.quoteList));
+        std::string path;
+        while (std::getline(list, path))
         {
-            qveIdentity = fileReader->readContent(options.qveIdentityFile);
-            qveIdentityVerifyStatus = attestationLib->verifyQeIdentity(qveIdentity, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
-            outputResult("QveIdentity", qveIdentityVerifyStatus, logger);
+            if (!path.empty() && path.back() == '\r')
+            {
+                path.pop_back();
+            }
+            if (!path.empty())
+            {
+                quotePaths.push_back(path);
+            }
         }
+    }
+    return quotePaths;
+}
 
-        const auto quote = fileReader->readBinaryContent(options.quoteFile);
-        const auto quoteVerifyStatus = attestationLib->verifyQuote(quote, pckCert, intermediateCaCrl, tcbInfo, qeIdentity);
-        outputResult("Quote", quoteVerifyStatus, logger);
+AppCore::Collateral AppCore::readCollateral(const AppOptions& options) const
+{
+    static constexpr char PEM_HEADER_STRING_X509_CRL[] = "-----BEGIN X509 CRL-----";
+    Collateral collateral;
+    collateral.pckCert = fileReader->readContent(options.pckCertificateFile);
+    collateral.pckCertChain = fileReader->readContent(options.pckSigningChainFile) + collateral.pckCert;
+    collateral.rootCaCrl = fileReader->readContent(options.rootCaCrlFile);
+    if (collateral.rootCaCrl.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
+    {
+        collateral.rootCaCrl = bytesToHexString(fileReader->readBinaryContent(options.rootCaCrlFile));
+    }
+    collateral.intermediateCaCrl = fileReader->readContent(options.intermediateCaCrlFile);
+    if (collateral.intermediateCaCrl.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
+    {
+        collateral.intermediateCaCrl = bytesToHexString(fileReader->readBinaryContent(options.intermediateCaCrlFile));
+    }
+    collateral.trustedRootCACert = fileReader->readContent(options.trustedRootCACertificateFile);
+    collateral.tcbInfo = fileReader->readContent(options.tcbInfoFile);
+    collateral.tcbSigningCert = fileReader->readContent(options.tcbSigningChainFile);
+    if (!options.qeIdentityFile.empty())
+    {
+        collateral.qeIdentity = fileReader->readContent(options.qeIdentityFile);
+    }
+    if (!options.qveIdentityFile.empty())
+    {
+        collateral.qveIdentity = fileReader->readContent(options.qveIdentityFile);
+    }
+    return collateral;
+}
 
-        return (pckVerifyStatus == STATUS_OK) && (tcbVerifyStatus == STATUS_OK) && (quoteVerifyStatus == STATUS_OK) &&
-                    (qeIdentityVerifyStatus == STATUS_OK) && (qveIdentityVerifyStatus == STATUS_OK);
+bool AppCore::verifyCollateral(const Collateral& collateral, const time_t& expirationDate, std::ostream& logger) const
+{
+    const auto pckVerifyStatus = attestationLib->verifyPCKCertificate(collateral.pckCertChain, collateral.rootCaCrl,
+                                                                      collateral.intermediateCaCrl, collateral.trustedRootCACert,
+                                                                      expirationDate);
+    outputResult("PCK certificate chain", pckVerifyStatus, logger);
+
+    const auto tcbVerifyStatus = attestationLib->verifyTCBInfo(collateral.tcbInfo, collateral.tcbSigningCert, collateral.rootCaCrl,
+                                                               collateral.trustedRootCACert, expirationDate);
+    outputResult("TCB info", tcbVerifyStatus, logger);
+
+    Status qeIdentityVerifyStatus = STATUS_OK;
+    if (!collateral.qeIdentity.empty())
+    {
+        qeIdentityVerifyStatus = attestationLib->verifyQeIdentity(collateral.qeIdentity, collateral.tcbSigningCert,
+                                                                  collateral.rootCaCrl, collateral.trustedRootCACert, expirationDate);
+        outputResult("QeIdentity", qeIdentityVerifyStatus, logger);
     }
-    catch (const IFileReader::ReadFileException& e)
+
+    Status qveIdentityVerifyStatus = STATUS_OK;
+    if (!collateral.qveIdentity.empty())
     {
-        logger << "ERROR while trying to read input files: " << e.what();
-        return false;
+        qveIdentityVerifyStatus = attestationLib->verifyQeIdentity(collateral.qveIdentity, collateral.tcbSigningCert,
+                                                                   collateral.rootCaCrl, collateral.trustedRootCACert, expirationDate);
+        outputResult("QveIdentity", qveIdentityVerifyStatus, logger);
     }
+
+    return (pckVerifyStatus == STATUS_OK) && (tcbVerifyStatus == STATUS_OK) &&
+           (qeIdentityVerifyStatus == STATUS_OK) && (qveIdentityVerifyStatus == STATUS_OK);
 }
 
 }}}
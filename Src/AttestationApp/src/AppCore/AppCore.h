@@ -35,8 +35,10 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <ctime>
 #include "IFileReader.h"
 #include "IAttestationLibraryAdapter.h"
+#include "QuoteArchive.h"
 
 namespace intel { namespace sgx { namespace dcap {
 
@@ -50,7 +52,47 @@ public:
 
     bool runVerification(const AppOptions& options, std::ostream& log) const;
 
+    /**
+     * Verifies collateral once and serves quote verification requests on options.serveSocketPath
+     * until SIGINT or SIGTERM. SIGHUP, or a change of collateral files when options.watchCollateral is set,
+     * reloads collateral without interrupting requests. Linux only.
+     */
+    bool runServer(const AppOptions& options, std::ostream& log) const;
+
+    /**
+     * Verifies collateral once, then every quote of options.quoteDir, options.quoteList and options.quoteArchive
+     * against it on options.threads threads. Writes per quote results and a throughput and latency summary.
+     * @return true when collateral and all quotes verified successfully
+     */
+    bool runBatch(const AppOptions& options, std::ostream& log) const;
+
+    /**
+     * Packs quotes of options.quoteDir, options.quoteList and options.quoteArchive into a quote archive at
+     * options.packQuotes, so later batches read them from a single mapped file
+     */
+    bool packQuotes(const AppOptions& options, std::ostream& log) const;
+
 private:
+    struct Collateral
+    {
+        std::string pckCert;
+        std::string pckCertChain;
+        std::string rootCaCrl;
+        std::string intermediateCaCrl;
+        std::string trustedRootCACert;
+        std::string tcbInfo;
+        std::string tcbSigningCert;
+        std::string qeIdentity;
+        std::string qveIdentity;
+    };
+
+    Collateral readCollateral(const AppOptions& options) const;
+    std::vector<QuoteArchive::Entry> readQuotes(const AppOptions& options) const;
+    std::vector<std::string> readQuotePaths(const AppOptions& options) const;
+    bool verifyCollateral(const Collateral& collateral, const time_t& expirationDate, std::ostream& log) const;
+    bool loadServedCollateral(const AppOptions& options, const time_t& expirationDate, QuoteCollateral& quoteCollateral,
+                              std::ostream& log) const;
+
     std::shared_ptr<IAttestationLibraryAdapter> attestationLib;
     std::shared_ptr<IFileReader> fileReader;
 };
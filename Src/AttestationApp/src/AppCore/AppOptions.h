@@ -34,6 +34,7 @@
 
 #include <string>
 #include <ctime>
+#include <cstdint>
 
 namespace intel { namespace sgx { namespace dcap {
 struct AppOptions
@@ -49,6 +50,15 @@ struct AppOptions
     std::string qeIdentityFile;
     std::string qveIdentityFile;
     time_t expirationDate;
+    std::string serveSocketPath; // empty runs single verification
+    bool watchCollateral;
+    std::string quoteDir; // batch mode when this or quoteList is given
+    std::string quoteList;
+    std::string quoteArchive;
+    std::string packQuotes; // packs quoteDir and quoteList into this archive instead of verifying them
+    uint32_t threads; // 0 uses all CPUs
+    std::string resultFormat;
+    std::string resultFile; // empty logs results
 };
 
 }}}
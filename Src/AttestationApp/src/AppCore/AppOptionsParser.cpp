@@ -31,6 +31,8 @@
 
 #include "AppOptionsParser.h"
 #include <chrono>
+#include <cstdint>
+#include <stdexcept>
 
 namespace intel { namespace sgx { namespace dcap {
 
@@ -45,6 +47,14 @@ namespace {
     static const std::string intermediateCaCrlDefaultPath = "intermediateCaCrl.der";
     static const std::string qeIdentityDefaultPath = "";
     static const std::string qveIdentityDefaultPath = "";
+    static const std::string serveSocketDefaultPath = "";
+    static const std::string quoteDirDefaultPath = "";
+    static const std::string quoteListDefaultPath = "";
+    static const std::string quoteArchiveDefaultPath = "";
+    static const std::string packQuotesDefaultPath = "";
+    static const std::string threadsDefault = "0";
+    static const std::string resultFormatDefault = "csv";
+    static const std::string resultFileDefaultPath = "";
     static const std::string expirationDateDefault = std::to_string(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
 }
 
@@ -61,12 +71,22 @@ std::unique_ptr<AppOptions> AppOptionsParser::parse(int argc, char **argv, std::
     auto intermediateCaCrlFile = arg_str0(NULL, "intermediateCaCrl", NULL, "Intermediate Ca CRL file path, PEM or DER format [=intermediateCaCrl.der]");
     auto quoteFile = arg_str0(NULL, "quote", NULL, "Quote file path, binary format [=quote.dat]");
     auto expirationDate = arg_str0(NULL, "expirationDate", NULL, "Expiration date in timestamp seconds [=seconds]");
+    auto serveSocket = arg_str0(NULL, "serve", NULL, "Run as verification daemon on Unix domain socket at given path. Collateral is loaded and verified once at startup, requests carry quotes [=]");
+    struct arg_lit* watchCollateral = arg_lit0(NULL, "watchCollateral", "Reload collateral of verification daemon when files in its directories change. SIGHUP always reloads it");
+    auto quoteDir = arg_str0(NULL, "quoteDir", NULL, "Verify every quote file in given directory against the collateral, results are reported per quote [=]");
+    auto quoteList = arg_str0(NULL, "quoteList", NULL, "File with quote file paths, one per line, verified like quoteDir [=]");
+    auto quoteArchive = arg_str0(NULL, "quoteArchive", NULL, "Quote archive file path, its quotes are verified like quoteDir [=]");
+    auto packQuotes = arg_str0(NULL, "packQuotes", NULL, "Pack quotes of quoteDir and quoteList into quote archive at given path instead of verifying them [=]");
+    auto threads = arg_str0(NULL, "threads", NULL, "Number of threads verifying quotes of quoteDir or quoteList, 0 uses all CPUs [=0]");
+    auto resultFormat = arg_str0(NULL, "resultFormat", NULL, "Format of per quote results, csv or json (one object per line) [=csv]");
+    auto resultFile = arg_str0(NULL, "resultFile", NULL, "Per quote results file path, results are logged when not given [=]");
     struct arg_lit* help = arg_lit0("h", "help", "Print this message");
     auto end = arg_end(20);
 
     void *argtable[] = {trustedRootCACertificateFile, pckSigningChainFile, pckCertificateFile,
                         tcbSigningChainFile, tcbInfoFile, qeIdentityFile, qveIdentityFile,
-                        rootCaCrlFile, intermediateCaCrlFile, quoteFile, expirationDate, help, end};
+                        rootCaCrlFile, intermediateCaCrlFile, quoteFile, expirationDate, serveSocket, watchCollateral,
+                        quoteDir, quoteList, quoteArchive, packQuotes, threads, resultFormat, resultFile, help, end};
 
     if (arg_nullcheck(argtable) != 0)
     {
@@ -85,6 +105,14 @@ std::unique_ptr<AppOptions> AppOptionsParser::parse(int argc, char **argv, std::
     intermediateCaCrlFile->sval[0] = intermediateCaCrlDefaultPath.c_str();
     quoteFile->sval[0] = quoteDefaultPath.c_str();
     expirationDate->sval[0] = expirationDateDefault.c_str();
+    serveSocket->sval[0] = serveSocketDefaultPath.c_str();
+    quoteDir->sval[0] = quoteDirDefaultPath.c_str();
+    quoteList->sval[0] = quoteListDefaultPath.c_str();
+    quoteArchive->sval[0] = quoteArchiveDefaultPath.c_str();
+    packQuotes->sval[0] = packQuotesDefaultPath.c_str();
+    threads->sval[0] = threadsDefault.c_str();
+    resultFormat->sval[0] = resultFormatDefault.c_str();
+    resultFile->sval[0] = resultFileDefaultPath.c_str();
 
 
     auto nerrors = arg_parse(argc, argv, argtable);
@@ -113,6 +141,14 @@ std::unique_ptr<AppOptions> AppOptionsParser::parse(int argc, char **argv, std::
     options->rootCaCrlFile = std::string(rootCaCrlFile->sval[0]);
     options->intermediateCaCrlFile = std::string(intermediateCaCrlFile->sval[0]);
     options->quoteFile = std::string(quoteFile->sval[0]);
+    options->serveSocketPath = std::string(serveSocket->sval[0]);
+    options->watchCollateral = watchCollateral->count > 0;
+    options->quoteDir = std::string(quoteDir->sval[0]);
+    options->quoteList = std::string(quoteList->sval[0]);
+    options->quoteArchive = std::string(quoteArchive->sval[0]);
+    options->packQuotes = std::string(packQuotes->sval[0]);
+    options->resultFormat = std::string(resultFormat->sval[0]);
+    options->resultFile = std::string(resultFile->sval[0]);
 
     try
     {
@@ -125,6 +161,29 @@ std::unique_ptr<AppOptions> AppOptionsParser::parse(int argc, char **argv, std::
         arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
         return nullptr;
     }
+    try
+    {
+        const auto threadCount = std::stoul(threads->sval[0]);
+        if (threadCount > UINT32_MAX || threads->sval[0][0] == '-')
+        {
+            throw std::out_of_range("out of range");
+        }
+        options->threads = static_cast<uint32_t>(threadCount);
+    }
+    catch(std::exception& ex)
+    {
+        printf("Can't parse threads: %s\n\n", ex.what());
+        printHelp(argtable);
+        arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
+        return nullptr;
+    }
+    if (options->resultFormat != "csv" && options->resultFormat != "json")
+    {
+        printf("Unsupported resultFormat: %s\n\n", options->resultFormat.c_str());
+        printHelp(argtable);
+        arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
+        return nullptr;
+    }
     arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
 
     return options;
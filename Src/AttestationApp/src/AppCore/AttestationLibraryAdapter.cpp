@@ -57,6 +57,57 @@ Status AttestationLibraryAdapter::verifyQuote(const std::vector<uint8_t>& quote,
 #endif
 }
 
+Status AttestationLibraryAdapter::parseCollateral(QuoteCollateral& collateral) const
+{
+#ifdef SGX_TRUSTED
+    (void) collateral;
+    return STATUS_OK;
+#else
+    VerificationCollateral* parsed = nullptr;
+    const auto qeIdentityRawPtr = collateral.qeIdentity.empty() ? nullptr : collateral.qeIdentity.c_str();
+    const auto status = ::sgxAttestationCollateralCreate(collateral.pckCertificate.c_str(), collateral.pckCrl.c_str(),
+                                                         collateral.tcbInfo.c_str(), qeIdentityRawPtr, &parsed);
+    if (status == STATUS_OK)
+    {
+        collateral.parsed = std::shared_ptr<const VerificationCollateral>(parsed, [](const VerificationCollateral* handle) {
+            ::sgxAttestationCollateralDestroy(const_cast<VerificationCollateral*>(handle));
+        });
+    }
+    return status;
+#endif
+}
+
+Status AttestationLibraryAdapter::verifyQuoteWithCollateral(const std::vector<uint8_t>& quote,
+                                                            const std::string& pckCertificate,
+                                                            const QuoteCollateral& collateral) const
+{
+    return verifyQuoteWithCollateral(quote.data(), quote.size(), pckCertificate, collateral);
+}
+
+Status AttestationLibraryAdapter::verifyQuoteWithCollateral(const uint8_t* quote,
+                                                            size_t quoteSize,
+                                                            const std::string& pckCertificate,
+                                                            const QuoteCollateral& collateral) const
+{
+    if (quoteSize > UINT32_MAX)
+    {
+        return STATUS_UNSUPPORTED_QUOTE_FORMAT;
+    }
+#ifdef SGX_TRUSTED
+    return verifyQuote(std::vector<uint8_t>(quote, quote + quoteSize),
+                       pckCertificate.empty() ? collateral.pckCertificate : pckCertificate,
+                       collateral.pckCrl, collateral.tcbInfo, collateral.qeIdentity);
+#else
+    if (!collateral.parsed)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    return ::sgxAttestationVerifyQuoteWithCollateral(quote, (uint32_t) quoteSize,
+                                                     pckCertificate.empty() ? nullptr : pckCertificate.c_str(),
+                                                     collateral.parsed.get());
+#endif
+}
+
 Status AttestationLibraryAdapter::verifyPCKCertificate(const std::string& pemCertChain,
                                                        const std::string& pemRootCaCRL,
                                                        const std::string& intermediateCaCRL,
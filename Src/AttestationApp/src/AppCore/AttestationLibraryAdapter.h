@@ -54,6 +54,17 @@ public:
                        const std::string& tcbInfo,
                        const std::string& qeIdentity = std::string{}) const override;
 
+    Status parseCollateral(QuoteCollateral& collateral) const override;
+
+    Status verifyQuoteWithCollateral(const std::vector<uint8_t>& quote,
+                                     const std::string& pckCertificate,
+                                     const QuoteCollateral& collateral) const override;
+
+    Status verifyQuoteWithCollateral(const uint8_t* quote,
+                                     size_t quoteSize,
+                                     const std::string& pckCertificate,
+                                     const QuoteCollateral& collateral) const override;
+
     Status verifyPCKCertificate(const std::string& pemCertChain,
                                 const std::string& pemRootCaCRL,
                                 const std::string& intermediateCaCRL,
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "BatchReport.h"
+#include "StatusPrinter.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+constexpr char READ_ERROR[] = "READ_ERROR";
+
+std::string outcome(const BatchResult& result)
+{
+    return result.quoteRead ? printStatus(result.status) : READ_ERROR;
+}
+
+std::string csvField(const std::string& value)
+{
+    if (value.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (const auto c : value)
+    {
+        if (c == '"')
+        {
+            quoted.push_back('"');
+        }
+        quoted.push_back(c);
+    }
+    return quoted + "\"";
+}
+
+std::string jsonString(const std::string& value)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+    std::string escaped = "\"";
+    for (const auto c : value)
+    {
+        const auto byte = static_cast<uint8_t>(c);
+        if (c == '"' || c == '\\')
+        {
+            escaped.push_back('\\');
+            escaped.push_back(c);
+        }
+        else if (byte < 0x20)
+        {
+            escaped += "\\u00";
+            escaped.push_back(hex[byte >> 4]);
+            escaped.push_back(hex[byte & 0x0F]);
+        }
+        else
+        {
+            escaped.push_back(c);
+        }
+    }
+    return escaped + "\"";
+}
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, size_t percent)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    // nearest rank
+    const auto rank = (sorted.size() * percent + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+}
+
+void writeResultHeader(const std::string& format, std::ostream& out)
+{
+    if (format == "csv")
+    {
+        out << "quote,status,latency_us\n";
+    }
+}
+
+void writeResult(const BatchResult& result, const std::string& format, std::ostream& out)
+{
+    if (format == "csv")
+    {
+        out << csvField(result.quotePath) << ',' << outcome(result) << ',' << result.latencyUs << '\n';
+    }
+    else
+    {
+        out << "{\"quote\":" << jsonString(result.quotePath) << ",\"status\":" << jsonString(outcome(result))
+            << ",\"latencyUs\":" << result.latencyUs << "}\n";
+    }
+}
+
+BatchSummary summarize(const std::vector<BatchResult>& results, std::chrono::steady_clock::duration elapsed)
+{
+    BatchSummary summary{};
+    summary.quotes = results.size();
+    summary.seconds = std::chrono::duration<double>(elapsed).count();
+    summary.quotesPerSecond = summary.seconds > 0 ? static_cast<double>(results.size()) / summary.seconds : 0;
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(results.size());
+    for (const auto& result : results)
+    {
+        ++summary.outcomes[outcome(result)];
+        if (result.quoteRead)
+        {
+            latencies.push_back(result.latencyUs);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    summary.p50LatencyUs = percentile(latencies, 50);
+    summary.p99LatencyUs = percentile(latencies, 99);
+    return summary;
+}
+
+void writeSummary(const BatchSummary& summary, std::ostream& out)
+{
+    out << "Verified " << summary.quotes << " quotes in " << std::fixed << std::setprecision(3) << summary.seconds << " s, "
+        << std::setprecision(1) << summary.quotesPerSecond << " quotes/s" << std::defaultfloat << std::endl;
+    out << "Latency p50: " << summary.p50LatencyUs << " us, p99: " << summary.p99LatencyUs << " us" << std::endl;
+    for (const auto& outcomeCount : summary.outcomes)
+    {
+        out << "  " << outcomeCount.first << ": " << outcomeCount.second << std::endl;
+    }
+}
+
+}}}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_BATCHREPORT_H
+#define SGXECDSAATTESTATION_BATCHREPORT_H
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+struct BatchResult
+{
+    std::string quotePath;
+    bool quoteRead; // false when quote file couldn't be read, status is not set then
+    Status status;
+    uint64_t latencyUs;
+};
+
+struct BatchSummary
+{
+    size_t quotes;
+    double seconds;
+    double quotesPerSecond;
+    uint64_t p50LatencyUs;
+    uint64_t p99LatencyUs;
+    std::map<std::string, size_t> outcomes; // printed status, or READ_ERROR, to number of quotes
+};
+
+/**
+ * Per quote results as CSV with header row or as JSON lines, format is "csv" or "json"
+ */
+void writeResultHeader(const std::string& format, std::ostream& out);
+void writeResult(const BatchResult& result, const std::string& format, std::ostream& out);
+
+BatchSummary summarize(const std::vector<BatchResult>& results, std::chrono::steady_clock::duration elapsed);
+void writeSummary(const BatchSummary& summary, std::ostream& out);
+
+}}}
+
+#endif //SGXECDSAATTESTATION_BATCHREPORT_H
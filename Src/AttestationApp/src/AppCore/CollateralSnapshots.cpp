@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CollateralSnapshots.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace intel { namespace sgx { namespace dcap {
+
+CollateralSnapshots::Reader::Reader(const CollateralSnapshots& snapshots, size_t slot)
+    : slotEpoch(snapshots.slots.at(slot).epoch)
+{
+    // announcement must be visible before the pointer is loaded, both are sequentially consistent
+    slotEpoch.store(snapshots.epoch.load());
+    collateral = snapshots.current.load();
+}
+
+CollateralSnapshots::Reader::~Reader()
+{
+    slotEpoch.store(0, std::memory_order_release);
+}
+
+CollateralSnapshots::CollateralSnapshots(QuoteCollateral initial, size_t readerSlots)
+    : current(new QuoteCollateral(std::move(initial))), slots(readerSlots)
+{
+}
+
+CollateralSnapshots::~CollateralSnapshots()
+{
+    for (const auto& snapshot : retired)
+    {
+        delete snapshot.collateral;
+    }
+    delete current.load();
+}
+
+void CollateralSnapshots::publish(QuoteCollateral collateral)
+{
+    const auto replaced = current.exchange(new QuoteCollateral(std::move(collateral)));
+    retired.push_back(Retired{replaced, ++epoch});
+    reclaim();
+}
+
+size_t CollateralSnapshots::reclaim()
+{
+    auto oldestReader = epoch.load();
+    for (const auto& slot : slots)
+    {
+        const auto readerEpoch = slot.epoch.load();
+        if (readerEpoch != 0)
+        {
+            oldestReader = std::min(oldestReader, readerEpoch);
+        }
+    }
+
+    const auto reclaimable = std::partition(retired.begin(), retired.end(), [oldestReader](const Retired& snapshot) {
+        return snapshot.epoch > oldestReader;
+    });
+    std::for_each(reclaimable, retired.end(), [](const Retired& snapshot) { delete snapshot.collateral; });
+    retired.erase(reclaimable, retired.end());
+    return retired.size();
+}
+
+}}}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_COLLATERALSNAPSHOTS_H
+#define SGXECDSAATTESTATION_COLLATERALSNAPSHOTS_H
+
+#include "IAttestationLibraryAdapter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Current collateral of the verification daemon, replaced while requests are being verified.
+ *
+ * Readers announce the epoch they entered in their own slot and load the current snapshot, neither step takes
+ * a lock or waits for the writer. The writer swaps the snapshot pointer, advances the epoch and frees a
+ * replaced snapshot once no slot holds an epoch older than its replacement. One writer thread at a time.
+ */
+class CollateralSnapshots
+{
+public:
+    class Reader
+    {
+    public:
+        Reader(const CollateralSnapshots& snapshots, size_t slot);
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        const QuoteCollateral& get() const { return *collateral; }
+
+    private:
+        std::atomic<uint64_t>& slotEpoch;
+        const QuoteCollateral* collateral;
+    };
+
+    CollateralSnapshots(QuoteCollateral initial, size_t readerSlots);
+    ~CollateralSnapshots();
+
+    CollateralSnapshots(const CollateralSnapshots&) = delete;
+    CollateralSnapshots& operator=(const CollateralSnapshots&) = delete;
+
+    /**
+     * Makes collateral current for readers entering from now on, the replaced snapshot is retired
+     */
+    void publish(QuoteCollateral collateral);
+
+    /**
+     * Frees retired snapshots no reader can see anymore
+     * @return number of snapshots still retired
+     */
+    size_t reclaim();
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> epoch{0}; // 0 when reader is outside of verification
+    };
+
+    struct Retired
+    {
+        const QuoteCollateral* collateral;
+        uint64_t epoch; // first epoch in which readers can't load it
+    };
+
+    std::atomic<const QuoteCollateral*> current;
+    std::atomic<uint64_t> epoch{1};
+    mutable std::vector<Slot> slots;
+    std::vector<Retired> retired;
+};
+
+}}}
+
+#endif //SGXECDSAATTESTATION_COLLATERALSNAPSHOTS_H
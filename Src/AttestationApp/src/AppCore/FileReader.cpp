@@ -31,6 +31,9 @@
 
 #include <sstream>
 #include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <iterator>
 #include "FileReader.h"
 
 
@@ -58,12 +61,34 @@ std::vector<uint8_t> FileReader::readBinaryContent(const std::string& filePath)
         throw ReadFileException(std::string("FileReader: failed to open \"") + filePath + "\" binary file!");
     }
 
-    file.seekg(0, std::ios_base::end);
-    std::streampos fileSize = file.tellg();
+    // read until end of stream instead of seeking, so pipes and /dev/stdin work as well
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+FileView FileReader::mapContent(const std::string& filePath) const
+{
+    const auto content = std::make_shared<const std::vector<uint8_t>>(readBinaryContent(filePath));
+    return FileView{content->data(), content->size(), content};
+}
+
+std::vector<std::string> FileReader::listFiles(const std::string& directoryPath) const
+{
+    std::error_code error;
+    std::vector<std::string> files;
+    for (std::filesystem::directory_iterator it(directoryPath, error), end; !error && it != end; it.increment(error))
+    {
+        std::error_code statusError;
+        if (it->is_regular_file(statusError))
+        {
+            files.push_back(it->path().string());
+        }
+    }
+    if (error)
+    {
+        throw ReadFileException(std::string("FileReader: failed to list \"") + directoryPath + "\" directory: " + error.message());
+    }
 
-    file.seekg(0, std::ios_base::beg);
-    std::vector<uint8_t> retVal((uint32_t) fileSize);
-    file.read(reinterpret_cast<char*>(retVal.data()), fileSize);
-    return retVal;
+    std::sort(files.begin(), files.end());
+    return files;
 }
 }}}
@@ -41,6 +41,8 @@ public:
 
     std::string readContent(const std::string& filePath) const override;
     std::vector<uint8_t> readBinaryContent(const std::string& filePath) const override;
+    std::vector<std::string> listFiles(const std::string& directoryPath) const override;
+    FileView mapContent(const std::string& filePath) const override;
 };
 
 }}}
@@ -36,9 +36,23 @@
 #include <SgxEcdsaAttestation/QuoteVerification.h>
 #include <vector>
 #include <ctime>
+#include <memory>
 
 namespace intel { namespace sgx { namespace dcap {
 
+/**
+ * Collateral kept by a long running verifier. The library parses it once into a handle, enclave builds
+ * pass the raw strings with every verification instead.
+ */
+struct QuoteCollateral
+{
+    std::string pckCertificate;
+    std::string pckCrl;
+    std::string tcbInfo;
+    std::string qeIdentity;
+    std::shared_ptr<const VerificationCollateral> parsed;
+};
+
 struct IAttestationLibraryAdapter
 {
     virtual  ~IAttestationLibraryAdapter() = default;
@@ -51,6 +65,23 @@ struct IAttestationLibraryAdapter
                                const std::string& tcbInfo,
                                const std::string& qeIdentity) const = 0;
 
+    virtual Status parseCollateral(QuoteCollateral& collateral) const = 0;
+
+    /**
+     * @param pckCertificate - certificate of the quoting platform, empty selects the collateral one
+     */
+    virtual Status verifyQuoteWithCollateral(const std::vector<uint8_t>& quote,
+                                             const std::string& pckCertificate,
+                                             const QuoteCollateral& collateral) const = 0;
+
+    /**
+     * Verifies quote in place, e.g. straight from a mapped file
+     */
+    virtual Status verifyQuoteWithCollateral(const uint8_t* quote,
+                                             size_t quoteSize,
+                                             const std::string& pckCertificate,
+                                             const QuoteCollateral& collateral) const = 0;
+
     virtual Status verifyPCKCertificate(const std::string& pemCertChain,
                                         const std::string& pemRootCaCRL,
                                         const std::string& intermediateCaCRL,
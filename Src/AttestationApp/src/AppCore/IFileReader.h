@@ -37,9 +37,20 @@
 #include <vector>
 #include <stdexcept>
 #include <cstdint>
+#include <memory>
 
 namespace intel { namespace sgx { namespace dcap {
 
+/**
+ * Read-only view of file content, valid while owner is kept
+ */
+struct FileView
+{
+    const uint8_t* data;
+    size_t size;
+    std::shared_ptr<const void> owner;
+};
+
 struct IFileReader
 {
     struct ReadFileException : public std::runtime_error
@@ -51,6 +62,16 @@ struct IFileReader
 
     virtual std::string readContent(const std::string& filePath) const = 0;
     virtual std::vector<uint8_t> readBinaryContent(const std::string& filePath) const = 0;
+
+    /**
+     * @return paths of regular files in the directory, sorted
+     */
+    virtual std::vector<std::string> listFiles(const std::string& directoryPath) const = 0;
+
+    /**
+     * @return whole file content without copying it when the reader can map files
+     */
+    virtual FileView mapContent(const std::string& filePath) const = 0;
 };
 
 }}}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifdef __linux__
+
+#include "MappedFileReader.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+struct Mapping
+{
+    void* address = nullptr;
+    size_t size = 0;
+
+    ~Mapping()
+    {
+        if (address != nullptr)
+        {
+            munmap(address, size);
+        }
+    }
+};
+
+FileView mapFile(const std::string& filePath)
+{
+    const int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw IFileReader::ReadFileException(std::string("MappedFileReader: failed to open \"") + filePath + "\" file!");
+    }
+
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || S_ISDIR(status.st_mode))
+    {
+        close(fd);
+        throw IFileReader::ReadFileException(std::string("MappedFileReader: \"") + filePath + "\" is not a file!");
+    }
+    if (!S_ISREG(status.st_mode))
+    {
+        // pipes and devices can't be mapped, consume them from the descriptor already open
+        // so that a writer on the other end never sees its reader go away
+        auto content = std::make_shared<std::vector<uint8_t>>();
+        uint8_t buffer[64 * 1024];
+        for (;;)
+        {
+            const auto count = read(fd, buffer, sizeof(buffer));
+            if (count > 0)
+            {
+                content->insert(content->end(), buffer, buffer + count);
+                continue;
+            }
+            if (count == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            const auto error = errno;
+            close(fd);
+            if (count == -1)
+            {
+                throw IFileReader::ReadFileException(std::string("MappedFileReader: failed to read \"") + filePath + "\" file: " +
+                                                     std::strerror(error));
+            }
+            break;
+        }
+        return FileView{content->data(), content->size(), content};
+    }
+
+    auto mapping = std::make_shared<Mapping>();
+    mapping->size = static_cast<size_t>(status.st_size);
+    if (mapping->size > 0)
+    {
+        const auto address = mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            const auto error = errno;
+            close(fd);
+            throw IFileReader::ReadFileException(std::string("MappedFileReader: failed to map \"") + filePath + "\" file: " +
+                                                 std::strerror(error));
+        }
+        mapping->address = address;
+        // content is consumed front to back once, read ahead aggressively and drop pages behind
+        madvise(mapping->address, mapping->size, MADV_SEQUENTIAL);
+        madvise(mapping->address, mapping->size, MADV_WILLNEED);
+    }
+    close(fd);
+    return FileView{static_cast<const uint8_t*>(mapping->address), mapping->size, mapping};
+}
+
+}
+
+FileView MappedFileReader::mapContent(const std::string& filePath) const
+{
+    return mapFile(filePath);
+}
+
+}}}
+
+#endif // __linux__
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteArchive.h"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC = {{'Q', 'V', 'L', 'Q', 'A', 'R', 'C', '1'}};
+
+template<typename T>
+void writeLittleEndian(T value, std::ostream& out)
+{
+    std::array<char, sizeof(T)> bytes{};
+    for (auto& byte : bytes)
+    {
+        byte = static_cast<char>(value & 0xFF);
+        value = static_cast<T>(value >> 8);
+    }
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+template<typename T>
+T readLittleEndian(const uint8_t* data)
+{
+    T value = 0;
+    for (size_t i = sizeof(T); i > 0; --i)
+    {
+        value = static_cast<T>(value << 8 | data[i - 1]);
+    }
+    return value;
+}
+
+bool fits(uint64_t offset, uint64_t size, size_t total)
+{
+    return offset <= total && size <= total - offset;
+}
+
+}
+
+void QuoteArchive::write(const std::vector<Entry>& entries, std::ostream& out)
+{
+    write(entries.size(), [&entries](size_t index) { return entries[index]; }, out);
+}
+
+void QuoteArchive::write(size_t count, const std::function<Entry(size_t index)>& readEntry, std::ostream& out)
+{
+    if (count > UINT32_MAX)
+    {
+        throw std::length_error("QuoteArchive: too many entries");
+    }
+
+    out.write(MAGIC.data(), static_cast<std::streamsize>(MAGIC.size()));
+    writeLittleEndian(static_cast<uint32_t>(count), out);
+    writeLittleEndian(uint32_t{0}, out);
+
+    std::vector<uint64_t> entrySizes(count);
+    uint64_t offset = HEADER_SIZE + ENTRY_SIZE * count;
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto entry = readEntry(index);
+        if (entry.name.size() > UINT32_MAX || entry.quote.size > UINT32_MAX)
+        {
+            throw std::length_error("QuoteArchive: entry \"" + entry.name + "\" is too big");
+        }
+        const auto nameOffset = offset;
+        const auto quoteOffset = nameOffset + entry.name.size();
+        offset = quoteOffset + entry.quote.size;
+        entrySizes[index] = entry.name.size() + entry.quote.size;
+
+        writeLittleEndian(quoteOffset, out);
+        writeLittleEndian(static_cast<uint32_t>(entry.quote.size), out);
+        writeLittleEndian(static_cast<uint32_t>(entry.name.size()), out);
+        writeLittleEndian(nameOffset, out);
+    }
+    for (size_t index = 0; index < count; ++index)
+    {
+        const auto entry = readEntry(index);
+        if (entry.name.size() + entry.quote.size != entrySizes[index])
+        {
+            throw std::runtime_error("QuoteArchive: entry \"" + entry.name + "\" changed while packing");
+        }
+        out.write(entry.name.data(), static_cast<std::streamsize>(entry.name.size()));
+        out.write(reinterpret_cast<const char*>(entry.quote.data), static_cast<std::streamsize>(entry.quote.size));
+    }
+}
+
+bool QuoteArchive::parse(FileView archive)
+{
+    if (archive.size < HEADER_SIZE || std::memcmp(archive.data, MAGIC.data(), MAGIC.size()) != 0)
+    {
+        return false;
+    }
+
+    const auto count = readLittleEndian<uint32_t>(archive.data + MAGIC.size());
+    if (!fits(HEADER_SIZE, uint64_t{count} * ENTRY_SIZE, archive.size))
+    {
+        return false;
+    }
+
+    std::vector<Index> parsed(count);
+    const auto* entry = archive.data + HEADER_SIZE;
+    for (auto& item : parsed)
+    {
+        item.quoteOffset = readLittleEndian<uint64_t>(entry);
+        item.quoteSize = readLittleEndian<uint32_t>(entry + 8);
+        item.nameSize = readLittleEndian<uint32_t>(entry + 12);
+        item.nameOffset = readLittleEndian<uint64_t>(entry + 16);
+        if (!fits(item.quoteOffset, item.quoteSize, archive.size) || !fits(item.nameOffset, item.nameSize, archive.size))
+        {
+            return false;
+        }
+        entry += ENTRY_SIZE;
+    }
+
+    content = std::move(archive);
+    index = std::move(parsed);
+    return true;
+}
+
+size_t QuoteArchive::size() const
+{
+    return index.size();
+}
+
+std::string QuoteArchive::name(size_t position) const
+{
+    const auto& item = index.at(position);
+    return std::string(reinterpret_cast<const char*>(content.data + item.nameOffset), item.nameSize);
+}
+
+FileView QuoteArchive::quote(size_t position) const
+{
+    const auto& item = index.at(position);
+    return FileView{content.data + item.quoteOffset, item.quoteSize, content.owner};
+}
+
+}}}
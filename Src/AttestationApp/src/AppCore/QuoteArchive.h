@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_QUOTEARCHIVE_H
+#define SGXECDSAATTESTATION_QUOTEARCHIVE_H
+
+#include "IFileReader.h"
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Many quotes packed into one file, so a batch opens and maps a single file and reads quotes in place.
+ *
+ * Layout, all integers little endian:
+ * | magic "QVLQARC1" (8) | entry count (4) | reserved (4) | entries | names and quotes |
+ * entry: | quote offset (8) | quote size (4) | name size (4) | name offset (8) |
+ * Offsets are counted from the beginning of the archive.
+ */
+class QuoteArchive
+{
+public:
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t ENTRY_SIZE = 24;
+
+    struct Entry
+    {
+        std::string name;
+        FileView quote;
+    };
+
+    static void write(const std::vector<Entry>& entries, std::ostream& out);
+
+    /**
+     * Packs entries without holding all of them at once, every entry is read twice: for the index and for the data
+     */
+    static void write(size_t count, const std::function<Entry(size_t index)>& readEntry, std::ostream& out);
+
+    /**
+     * @return false when content is not an archive or an entry points outside of it
+     */
+    bool parse(FileView content);
+
+    size_t size() const;
+    std::string name(size_t index) const;
+
+    /**
+     * @return view into the archive content, keeps it alive
+     */
+    FileView quote(size_t index) const;
+
+private:
+    struct Index
+    {
+        uint64_t quoteOffset;
+        uint32_t quoteSize;
+        uint32_t nameSize;
+        uint64_t nameOffset;
+    };
+
+    FileView content{nullptr, 0, nullptr};
+    std::vector<Index> index;
+};
+
+}}}
+
+#endif //SGXECDSAATTESTATION_QUOTEARCHIVE_H
@@ -37,7 +37,7 @@ namespace intel::sgx::dcap {
 
 std::string printStatus(const Status s)
 {
-    static constexpr Status MAX_STATUS = STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED;
+    static constexpr Status MAX_STATUS = STATUS_BUSY;
     static std::array<std::string, MAX_STATUS + 1> statusStrs = {{
         "STATUS_OK",
         "STATUS_UNSUPPORTED_CERT_FORMAT",
@@ -141,7 +141,8 @@ std::string printStatus(const Status s)
         "STATUS_TDX_MODULE_MISMATCH",
         "STATUS_SGX_ENCLAVE_REPORT_ISVSVN_NOT_SUPPORTED",
         "STATUS_TCB_TD_RELAUNCH_ADVISED",
-        "STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED"
+        "STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED",
+        "STATUS_BUSY"
     }};
 
     const auto statusNumberStr = "(" + std::to_string(s) + ")";
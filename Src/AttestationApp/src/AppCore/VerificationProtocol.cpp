@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "VerificationProtocol.h"
+
+#include <algorithm>
+
+namespace intel { namespace sgx { namespace dcap { namespace protocol {
+
+namespace {
+
+void writeUint32(uint32_t value, uint8_t* out)
+{
+    out[0] = static_cast<uint8_t>(value >> 24);
+    out[1] = static_cast<uint8_t>(value >> 16);
+    out[2] = static_cast<uint8_t>(value >> 8);
+    out[3] = static_cast<uint8_t>(value);
+}
+
+uint32_t readUint32(const uint8_t* in)
+{
+    return static_cast<uint32_t>(in[0]) << 24 | static_cast<uint32_t>(in[1]) << 16 |
+           static_cast<uint32_t>(in[2]) << 8 | static_cast<uint32_t>(in[3]);
+}
+
+}
+
+bool decodeRequestHeader(const std::array<uint8_t, REQUEST_HEADER_SIZE>& bytes, RequestHeader& header)
+{
+    header.quoteSize = readUint32(bytes.data());
+    header.pckCertificateSize = readUint32(bytes.data() + 4);
+    return header.quoteSize > 0 && header.quoteSize <= MAX_QUOTE_SIZE && header.pckCertificateSize <= MAX_PCK_CERTIFICATE_SIZE;
+}
+
+std::vector<uint8_t> encodeRequest(const std::vector<uint8_t>& quote, const std::string& pckCertificate)
+{
+    std::vector<uint8_t> request(REQUEST_HEADER_SIZE + quote.size() + pckCertificate.size());
+    writeUint32(static_cast<uint32_t>(quote.size()), request.data());
+    writeUint32(static_cast<uint32_t>(pckCertificate.size()), request.data() + 4);
+    const auto quoteEnd = std::copy(quote.begin(), quote.end(), request.begin() + REQUEST_HEADER_SIZE);
+    std::copy(pckCertificate.begin(), pckCertificate.end(), quoteEnd);
+    return request;
+}
+
+std::array<uint8_t, RESPONSE_SIZE> encodeResponse(Status status)
+{
+    std::array<uint8_t, RESPONSE_SIZE> response{};
+    writeUint32(static_cast<uint32_t>(status), response.data());
+    return response;
+}
+
+Status decodeResponse(const std::array<uint8_t, RESPONSE_SIZE>& bytes)
+{
+    return static_cast<Status>(readUint32(bytes.data()));
+}
+
+}}}}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_VERIFICATIONPROTOCOL_H
+#define SGXECDSAATTESTATION_VERIFICATIONPROTOCOL_H
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace protocol {
+
+/**
+ * Framing of verification daemon requests and responses, all integers are big endian.
+ *
+ * Request:  | quote size (4) | PCK certificate size (4) | quote | PCK certificate PEM |
+ * Response: | Status (4) |
+ *
+ * Empty PCK certificate selects the certificate loaded with the collateral. A connection carries any number
+ * of requests, responses come back in request order.
+ */
+constexpr size_t REQUEST_HEADER_SIZE = 8;
+constexpr size_t RESPONSE_SIZE = 4;
+constexpr uint32_t MAX_QUOTE_SIZE = 1024 * 1024;
+constexpr uint32_t MAX_PCK_CERTIFICATE_SIZE = 64 * 1024;
+
+struct RequestHeader
+{
+    uint32_t quoteSize;
+    uint32_t pckCertificateSize;
+};
+
+/**
+ * @return false when quote is empty or sizes exceed the protocol limits, the connection should be dropped then
+ */
+bool decodeRequestHeader(const std::array<uint8_t, REQUEST_HEADER_SIZE>& bytes, RequestHeader& header);
+
+std::vector<uint8_t> encodeRequest(const std::vector<uint8_t>& quote, const std::string& pckCertificate);
+
+std::array<uint8_t, RESPONSE_SIZE> encodeResponse(Status status);
+
+Status decodeResponse(const std::array<uint8_t, RESPONSE_SIZE>& bytes);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace protocol {
+
+#endif //SGXECDSAATTESTATION_VERIFICATIONPROTOCOL_H
@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifdef __linux__
+
+#include "VerificationServer.h"
+#include "VerificationProtocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+bool readFully(int fd, uint8_t* data, size_t size)
+{
+    while (size > 0)
+    {
+        const auto received = recv(fd, data, size, 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0)
+        {
+            return false;
+        }
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool writeFully(int fd, const uint8_t* data, size_t size)
+{
+    while (size > 0)
+    {
+        const auto sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+void drain(int fd)
+{
+    char buffer[4096];
+    while (read(fd, buffer, sizeof(buffer)) > 0)
+    {}
+}
+
+void closeAll(const int* fds, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (fds[i] != -1)
+        {
+            close(fds[i]);
+        }
+    }
+}
+
+// connection is left pending on these, polling again would return right away
+bool isResourceError(int error)
+{
+    return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM;
+}
+
+// errors of the listening socket itself, accept will keep failing
+bool isListenerError(int error)
+{
+    return error == EBADF || error == EINVAL || error == ENOTSOCK || error == EOPNOTSUPP || error == EFAULT;
+}
+
+/**
+ * @return 0 when a server accepts connections at the address, errno of connect otherwise
+ */
+int probeSocket(const sockaddr_un& address)
+{
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+    {
+        return errno;
+    }
+    const int error = connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 ? 0 : errno;
+    close(fd);
+    return error;
+}
+
+// files are usually replaced one after another, reload once they stop changing
+constexpr int WATCH_SETTLE_TIME_MS = 200;
+constexpr int RECLAIM_RETRY_TIME_MS = 10;
+constexpr int ACCEPT_BACKOFF_TIME_MS = 100;
+
+}
+
+VerificationServer::VerificationServer(std::shared_ptr<IAttestationLibraryAdapter> libAdapter, QuoteCollateral quoteCollateral)
+    : attestationLib(std::move(libAdapter)), collateral(std::move(quoteCollateral), MAX_CONNECTIONS)
+{
+    for (size_t slot = MAX_CONNECTIONS; slot > 0; --slot)
+    {
+        freeSlots.push_back(slot - 1);
+    }
+    if (pipe2(wakeFds, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        wakeFds[0] = wakeFds[1] = -1;
+    }
+    reserveFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+}
+
+VerificationServer::~VerificationServer()
+{
+    reapConnections(true);
+    if (listenFd != -1)
+    {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    closeAll(wakeFds, 2);
+    closeAll(reloadFds, 2);
+    closeAll(&watchFd, 1);
+    closeAll(&reserveFd, 1);
+}
+
+bool VerificationServer::listen(const std::string& path, std::ostream& logger)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        logger << "Socket path \"" << path << "\" is empty or too long" << std::endl;
+        return false;
+    }
+    if (wakeFds[0] == -1)
+    {
+        logger << "Can't create wake up pipe: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    std::copy(path.begin(), path.end(), address.sun_path);
+
+    struct stat existing{};
+    if (lstat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode))
+    {
+        // only a socket nobody listens on is stale, a running server keeps its path
+        const int probeError = probeSocket(address);
+        if (probeError == 0)
+        {
+            logger << "Socket \"" << path << "\" is served by a running server" << std::endl;
+            return false;
+        }
+        if (probeError != ECONNREFUSED && probeError != ENOENT)
+        {
+            logger << "Can't check socket \"" << path << "\": " << std::strerror(probeError) << std::endl;
+            return false;
+        }
+        unlink(path.c_str());
+    }
+
+    // non-blocking, a connection aborted between poll and accept must not block the loop
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (listenFd == -1 ||
+        bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0)
+    {
+        logger << "Can't listen on \"" << path << "\": " << std::strerror(errno) << std::endl;
+        if (listenFd != -1)
+        {
+            close(listenFd);
+            listenFd = -1;
+        }
+        return false;
+    }
+
+    socketPath = path;
+    logger << "Listening on " << path << std::endl;
+    return true;
+}
+
+bool VerificationServer::enableReload(CollateralLoader collateralLoader, const std::vector<std::string>& watchedDirectories,
+                                      std::ostream& logger)
+{
+    if (reloadFds[0] == -1 && pipe2(reloadFds, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        logger << "Can't create reload pipe: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!watchedDirectories.empty() && watchFd == -1)
+    {
+        watchFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (watchFd == -1)
+        {
+            logger << "Can't watch collateral: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    for (const auto& directory : watchedDirectories)
+    {
+        if (inotify_add_watch(watchFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+        {
+            logger << "Can't watch \"" << directory << "\": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        logger << "Watching " << directory << " for collateral changes" << std::endl;
+    }
+    loader = std::move(collateralLoader);
+    return true;
+}
+
+bool VerificationServer::run()
+{
+    bool listening = true;
+    stopping = false;
+    std::thread reloadThread;
+    if (loader)
+    {
+        reloadThread = std::thread(&VerificationServer::reloadCollateral, this);
+    }
+
+    pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+    while (listenFd != -1)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+        if ((fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0)
+        {
+            listening = false;
+            break;
+        }
+        if ((fds[0].revents & POLLIN) == 0)
+        {
+            continue;
+        }
+
+        const int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd == -1)
+        {
+            const int error = errno;
+            if (isListenerError(error))
+            {
+                listening = false;
+                break;
+            }
+            if (isResourceError(error))
+            {
+                reapConnections(false);
+                shedPendingConnection(error);
+                // stop() still ends the back off right away
+                poll(&fds[1], 1, ACCEPT_BACKOFF_TIME_MS);
+            }
+            continue;
+        }
+        reapConnections(false);
+        if (freeSlots.empty())
+        {
+            close(fd);
+            continue;
+        }
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->slot = freeSlots.back();
+        freeSlots.pop_back();
+        connection->thread = std::thread(&VerificationServer::serveConnection, this, std::ref(*connection));
+        connections.push_back(std::move(connection));
+    }
+    reapConnections(true);
+
+    if (reloadThread.joinable())
+    {
+        stopping = true;
+        reload();
+        reloadThread.join();
+    }
+    return listening;
+}
+
+void VerificationServer::stop()
+{
+    const char wake = 1;
+    if (write(wakeFds[1], &wake, 1) < 0)
+    {
+        // pipe already holds a wake up byte
+    }
+}
+
+void VerificationServer::reload()
+{
+    const char request = 1;
+    if (reloadFds[1] != -1 && write(reloadFds[1], &request, 1) < 0)
+    {
+        // pipe already holds a reload request
+    }
+}
+
+uint64_t VerificationServer::getReloadCount() const
+{
+    return reloadCount.load();
+}
+
+void VerificationServer::serveConnection(Connection& connection) const
+{
+    std::array<uint8_t, protocol::REQUEST_HEADER_SIZE> headerBytes{};
+    while (readFully(connection.fd, headerBytes.data(), headerBytes.size()))
+    {
+        protocol::RequestHeader header{};
+        if (!protocol::decodeRequestHeader(headerBytes, header))
+        {
+            break;
+        }
+
+        std::vector<uint8_t> quote(header.quoteSize);
+        std::string pckCertificate(header.pckCertificateSize, '\0');
+        if (!readFully(connection.fd, quote.data(), quote.size()) ||
+            !readFully(connection.fd, reinterpret_cast<uint8_t*>(&pckCertificate[0]), pckCertificate.size()))
+        {
+            break;
+        }
+
+        Status status;
+        {
+            const CollateralSnapshots::Reader snapshot(collateral, connection.slot);
+            status = attestationLib->verifyQuoteWithCollateral(quote, pckCertificate, snapshot.get());
+        }
+        const auto response = protocol::encodeResponse(status);
+        if (!writeFully(connection.fd, response.data(), response.size()))
+        {
+            break;
+        }
+    }
+    // client sees end of stream right away, descriptor is closed when the connection is reaped
+    shutdown(connection.fd, SHUT_RDWR);
+    connection.done = true;
+}
+
+void VerificationServer::shedPendingConnection(int error)
+{
+    if ((error != EMFILE && error != ENFILE) || reserveFd == -1)
+    {
+        return;
+    }
+    // the reserved descriptor makes room to accept and close the connection, its client sees end of stream
+    close(reserveFd);
+    const int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd != -1)
+    {
+        close(fd);
+    }
+    reserveFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+}
+
+void VerificationServer::reapConnections(bool all)
+{
+    for (auto it = connections.begin(); it != connections.end();)
+    {
+        auto& connection = **it;
+        if (!all && !connection.done)
+        {
+            ++it;
+            continue;
+        }
+        // wakes a thread blocked on reading next request, a verification in progress completes first
+        shutdown(connection.fd, SHUT_RDWR);
+        connection.thread.join();
+        close(connection.fd);
+        freeSlots.push_back(connection.slot);
+        it = connections.erase(it);
+    }
+}
+
+void VerificationServer::reloadCollateral()
+{
+    pollfd fds[2] = {{reloadFds[0], POLLIN, 0}, {watchFd, POLLIN, 0}};
+    const nfds_t fdCount = watchFd == -1 ? 1 : 2;
+    size_t retired = 0;
+    while (!stopping)
+    {
+        const auto ready = poll(fds, fdCount, retired > 0 ? RECLAIM_RETRY_TIME_MS : -1);
+        if (ready < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        bool requested = ready > 0 && fds[0].revents != 0;
+        if (requested)
+        {
+            drain(reloadFds[0]);
+        }
+        if (ready > 0 && fdCount == 2 && fds[1].revents != 0)
+        {
+            pollfd watch = {watchFd, POLLIN, 0};
+            do
+            {
+                drain(watchFd);
+            } while (poll(&watch, 1, WATCH_SETTLE_TIME_MS) > 0);
+            requested = true;
+        }
+
+        if (requested && !stopping)
+        {
+            QuoteCollateral next;
+            if (loader(next))
+            {
+                collateral.publish(std::move(next));
+                ++reloadCount;
+            }
+        }
+        retired = collateral.reclaim();
+    }
+}
+
+}}}
+
+#endif // __linux__
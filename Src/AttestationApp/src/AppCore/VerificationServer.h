@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_VERIFICATIONSERVER_H
+#define SGXECDSAATTESTATION_VERIFICATIONSERVER_H
+
+#ifdef __linux__
+
+#include "CollateralSnapshots.h"
+#include "IAttestationLibraryAdapter.h"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Verification daemon serving VerificationProtocol requests on a Unix domain socket. Every connection is served
+ * by its own thread, so requests of different clients are verified concurrently against the same collateral.
+ *
+ * Collateral is reloaded on a background thread, requests in progress complete against the snapshot they started
+ * with and the following ones use the new one.
+ */
+class VerificationServer
+{
+public:
+    static constexpr size_t MAX_CONNECTIONS = 256;
+
+    /**
+     * Fills collateral with verified and parsed replacement, false keeps the current one
+     */
+    using CollateralLoader = std::function<bool(QuoteCollateral& collateral)>;
+
+    VerificationServer(std::shared_ptr<IAttestationLibraryAdapter> attestationLib, QuoteCollateral collateral);
+
+    /**
+     * Closes the listening socket and removes its file
+     */
+    ~VerificationServer();
+
+    VerificationServer(const VerificationServer&) = delete;
+    VerificationServer& operator=(const VerificationServer&) = delete;
+
+    /**
+     * Binds the socket, a stale socket file left at the path is replaced,
+     * a socket some running server accepts connections on is not
+     */
+    bool listen(const std::string& path, std::ostream& logger);
+
+    /**
+     * Enables reload(), must be called before run()
+     * @param watchedDirectories - changes of files in these directories trigger reload as well, may be empty
+     */
+    bool enableReload(CollateralLoader loader, const std::vector<std::string>& watchedDirectories, std::ostream& logger);
+
+    /**
+     * Accepts connections until stop() is called, then closes them and joins their threads
+     * @return false when it stopped because the listening socket failed
+     */
+    bool run();
+
+    /**
+     * Makes run() return, async-signal-safe
+     */
+    void stop();
+
+    /**
+     * Requests collateral reload by the running server, async-signal-safe
+     */
+    void reload();
+
+    /**
+     * @return number of reloads which replaced collateral
+     */
+    uint64_t getReloadCount() const;
+
+private:
+    struct Connection
+    {
+        int fd = -1;
+        size_t slot = 0;
+        std::atomic<bool> done{false};
+        std::thread thread;
+    };
+
+    void serveConnection(Connection& connection) const;
+    void shedPendingConnection(int error);
+    void reapConnections(bool all);
+    void reloadCollateral();
+
+    std::shared_ptr<IAttestationLibraryAdapter> attestationLib;
+    CollateralSnapshots collateral;
+    std::string socketPath;
+    int listenFd = -1;
+    int wakeFds[2] = {-1, -1};
+    int reserveFd = -1; // released to accept a connection when out of descriptors
+    std::list<std::unique_ptr<Connection>> connections;
+    std::vector<size_t> freeSlots;
+
+    CollateralLoader loader;
+    int reloadFds[2] = {-1, -1};
+    int watchFd = -1;
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> reloadCount{0};
+};
+
+}}}
+
+#endif // __linux__
+
+#endif //SGXECDSAATTESTATION_VERIFICATIONSERVER_H
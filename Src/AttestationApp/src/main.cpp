@@ -36,12 +36,17 @@
 #include "AppCore/AppOptionsParser.h"
 #include "AppCore/AttestationLibraryAdapter.h"
 #include "AppCore/FileReader.h"
+#include "AppCore/MappedFileReader.h"
 #include "SgxEcdsaAttestation/QuoteVerification.h"
 
 int main(int argc, char* argv[])
 {
     auto libAdapter = std::make_shared<intel::sgx::dcap::AttestationLibraryAdapter>();
+#ifdef __linux__
+    auto fileReader = std::make_shared<intel::sgx::dcap::MappedFileReader>();
+#else
     auto fileReader = std::make_shared<intel::sgx::dcap::FileReader>();
+#endif
     intel::sgx::dcap::AppCore app(libAdapter, fileReader);
 
     std::stringstream logger;
@@ -59,6 +64,19 @@ int main(int argc, char* argv[])
                               "");
 #endif
     std::cout << "Running QVL version: " << app.version() << std::endl;
+    if (!options->serveSocketPath.empty())
+    {
+        return app.runServer(*options, std::cout) ? 0 : 1;
+    }
+    if (!options->packQuotes.empty())
+    {
+        return app.packQuotes(*options, std::cout) ? 0 : 1;
+    }
+    if (!options->quoteDir.empty() || !options->quoteList.empty() || !options->quoteArchive.empty())
+    {
+        return app.runBatch(*options, std::cout) ? 0 : 1;
+    }
+
     bool result = app.runVerification(*options, logger);
     std::cout << "Verification results: " << std::boolalpha << result << std::noboolalpha << "\n\n";
     std::cout << "AppLogs:\n" << logger.str() << std::endl;
@@ -34,6 +34,7 @@
 #include <gmock/gmock.h>
 #include "AppCore/AppCore.h"
 #include "AppCore/AppOptions.h"
+#include "AppCore/QuoteArchive.h"
 #include "Mocks/AttestationLibraryAdapterMock.h"
 #include "Mocks/FileReaderMock.h"
 
@@ -60,7 +61,16 @@ struct AppCoreTests: public Test
         "Quote/file/path",
         "QeIdentity/file/path/",
         "QveIdentity/file/path/",
-        0};
+        0,
+        "",
+        false,
+        "",
+        "",
+        "",
+        "",
+        0,
+        "csv",
+        ""};
 
     std::vector<uint8_t> quoteContent = {1, 2, 255, 0, 0, 43, 58};
     std::string pckCertContent = "pckCert content";
@@ -213,7 +223,16 @@ TEST_F(AppCoreTests, shouldVerifyWhenQeIdentityAndQveIdentityFileWasNotGiven)
             "",
             "",
             "",
-            0
+            0,
+            "",
+            false,
+            "",
+            "",
+            "",
+            "",
+            0,
+            "csv",
+            ""
     };
 
     EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
@@ -242,7 +261,16 @@ TEST_F(AppCoreTests, shouldVerifyWhenQeIdentityFileWasNotGiven)
             "",
             "",
             "QveIdentity/file/path/",
-            0
+            0,
+            "",
+            false,
+            "",
+            "",
+            "",
+            "",
+            0,
+            "csv",
+            ""
     };
 
     EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
@@ -270,7 +298,16 @@ TEST_F(AppCoreTests, shouldVerifyWhenQveIdentityFileWasNotGiven)
             "",
             "QeIdentity/file/path/",
             "",
-            0
+            0,
+            "",
+            false,
+            "",
+            "",
+            "",
+            "",
+            0,
+            "csv",
+            ""
     };
 
     EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
@@ -283,3 +320,138 @@ TEST_F(AppCoreTests, shouldVerifyWhenQveIdentityFileWasNotGiven)
 
     EXPECT_TRUE(app.runVerification(noQveIdentityOptions, log));
 }
+
+TEST_F(AppCoreTests, shouldNotStartServerWhenCollateralValidationFailed)
+{
+    options.serveSocketPath = "/tmp/qvl_app_core_test.sock";
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
+    EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyTCBInfo(_, _, _, _, _)).WillOnce(Return(STATUS_TCB_INFO_INVALID_SIGNATURE));
+    EXPECT_CALL(*attestationLibraryMock, verifyQeIdentity(_, _, _, _, _)).Times(2).WillRepeatedly(Return(STATUS_OK));
+
+    EXPECT_FALSE(app.runServer(options, log));
+    EXPECT_THAT(log.str(), HasSubstr("STATUS_TCB_INFO_INVALID_SIGNATURE"));
+}
+
+TEST_F(AppCoreTests, shouldNotStartServerWhenCollateralParsingFailed)
+{
+    options.serveSocketPath = "/tmp/qvl_app_core_test.sock";
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
+    EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyTCBInfo(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQeIdentity(_, _, _, _, _)).Times(2).WillRepeatedly(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, parseCollateral(Field(&QuoteCollateral::pckCertificate, "content")))
+        .WillOnce(Return(STATUS_UNSUPPORTED_PCK_RL_FORMAT));
+
+    EXPECT_FALSE(app.runServer(options, log));
+    EXPECT_THAT(log.str(), HasSubstr("STATUS_UNSUPPORTED_PCK_RL_FORMAT"));
+}
+
+struct AppCoreBatchTests: public AppCoreTests
+{
+    AppCoreBatchTests()
+    {
+        options.qveIdentityFile = "";
+        options.quoteDir = "quotes";
+        options.quoteList = "quotes.txt";
+        options.threads = 2;
+
+        EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
+        EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
+        EXPECT_CALL(*attestationLibraryMock, verifyTCBInfo(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
+        EXPECT_CALL(*attestationLibraryMock, verifyQeIdentity(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
+        EXPECT_CALL(*attestationLibraryMock, parseCollateral(_)).WillOnce(Return(STATUS_OK));
+    }
+
+    static FileView view(const std::vector<uint8_t>& content)
+    {
+        const auto owner = std::make_shared<const std::vector<uint8_t>>(content);
+        return FileView{owner->data(), owner->size(), owner};
+    }
+};
+
+TEST_F(AppCoreBatchTests, shouldVerifyQuotesOfDirectoryAndListInOrder)
+{
+    const std::vector<uint8_t> otherQuote = {7, 7, 7};
+    EXPECT_CALL(*fileReaderMock, listFiles("quotes")).WillOnce(Return(std::vector<std::string>{"quotes/a.dat", "quotes/b.dat"}));
+    EXPECT_CALL(*fileReaderMock, readContent("quotes.txt")).WillOnce(Return("archive/c.dat\r\n\narchive/d,e.dat\n"));
+    EXPECT_CALL(*fileReaderMock, mapContent(_)).WillRepeatedly(Return(view(quoteContent)));
+    EXPECT_CALL(*fileReaderMock, mapContent("quotes/b.dat")).WillOnce(Return(view(otherQuote)));
+    EXPECT_CALL(*fileReaderMock, mapContent("archive/c.dat")).WillOnce(Throw(IFileReader::ReadFileException("missing")));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(_, _, "", Field(&QuoteCollateral::tcbInfo, "-----BEGIN X509 CRL-----content")))
+        .With(Args<0, 1>(ElementsAreArray(quoteContent))).Times(2).WillRepeatedly(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(_, _, "", _))
+        .With(Args<0, 1>(ElementsAreArray(otherQuote))).WillOnce(Return(STATUS_TCB_OUT_OF_DATE));
+
+    EXPECT_FALSE(app.runBatch(options, log));
+
+    const auto output = log.str();
+    const auto header = output.find("quote,status,latency_us\n");
+    const auto first = output.find("quotes/a.dat,STATUS_OK(0),");
+    const auto second = output.find("quotes/b.dat,STATUS_TCB_OUT_OF_DATE(");
+    const auto third = output.find("archive/c.dat,READ_ERROR,");
+    const auto fourth = output.find("\"archive/d,e.dat\",STATUS_OK(0),");
+    ASSERT_NE(std::string::npos, header);
+    EXPECT_LT(header, first);
+    EXPECT_LT(first, second);
+    EXPECT_LT(second, third);
+    EXPECT_LT(third, fourth);
+    EXPECT_NE(std::string::npos, fourth);
+    EXPECT_THAT(output, HasSubstr("Verified 4 quotes in "));
+    EXPECT_THAT(output, HasSubstr("  READ_ERROR: 1\n"));
+    EXPECT_THAT(output, HasSubstr("  STATUS_OK(0): 2\n"));
+}
+
+TEST_F(AppCoreBatchTests, shouldSucceedWhenAllQuotesAreVerified)
+{
+    options.quoteList = "";
+    options.resultFormat = "json";
+    EXPECT_CALL(*fileReaderMock, listFiles("quotes")).WillOnce(Return(std::vector<std::string>{"quotes/a.dat"}));
+    EXPECT_CALL(*fileReaderMock, mapContent("quotes/a.dat")).WillOnce(Return(view(quoteContent)));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(_, quoteContent.size(), "", _)).WillOnce(Return(STATUS_OK));
+
+    EXPECT_TRUE(app.runBatch(options, log));
+    EXPECT_THAT(log.str(), HasSubstr("{\"quote\":\"quotes/a.dat\",\"status\":\"STATUS_OK(0)\",\"latencyUs\":"));
+}
+
+TEST_F(AppCoreBatchTests, shouldVerifyQuotesOfArchiveInPlace)
+{
+    options.quoteDir = "";
+    options.quoteList = "";
+    options.quoteArchive = "quotes.qarc";
+    const std::vector<uint8_t> otherQuote = {7, 7, 7};
+    std::ostringstream packed;
+    QuoteArchive::write({{"first", view(quoteContent)}, {"second", view(otherQuote)}}, packed);
+    const auto packedContent = packed.str();
+    const auto archive = view(std::vector<uint8_t>(packedContent.begin(), packedContent.end()));
+    EXPECT_CALL(*fileReaderMock, mapContent("quotes.qarc")).WillOnce(Return(archive));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(archive.data + QuoteArchive::HEADER_SIZE + 2 * QuoteArchive::ENTRY_SIZE + 5,
+                                                                   quoteContent.size(), "", _)).WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(_, otherQuote.size(), "", _))
+        .With(Args<0, 1>(ElementsAreArray(otherQuote))).WillOnce(Return(STATUS_OK));
+
+    EXPECT_TRUE(app.runBatch(options, log));
+    EXPECT_THAT(log.str(), HasSubstr("quotes.qarc:first,STATUS_OK(0),"));
+    EXPECT_THAT(log.str(), HasSubstr("quotes.qarc:second,STATUS_OK(0),"));
+}
+
+TEST_F(AppCoreBatchTests, shouldFailWhenQuoteArchiveIsInvalid)
+{
+    options.quoteDir = "";
+    options.quoteList = "";
+    options.quoteArchive = "quotes.qarc";
+    EXPECT_CALL(*fileReaderMock, mapContent("quotes.qarc")).WillOnce(Return(view(quoteContent)));
+
+    EXPECT_FALSE(app.runBatch(options, log));
+    EXPECT_THAT(log.str(), HasSubstr("is not a valid quote archive"));
+}
+
+TEST_F(AppCoreBatchTests, shouldFailWhenQuoteDirectoryCantBeListed)
+{
+    EXPECT_CALL(*fileReaderMock, listFiles("quotes")).WillOnce(Throw(IFileReader::ReadFileException("no such directory")));
+
+    EXPECT_FALSE(app.runBatch(options, log));
+    EXPECT_THAT(log.str(), HasSubstr("no such directory"));
+}
@@ -53,7 +53,7 @@ struct AppOptionsParserTests: public Test
     const std::string intermediateCaCrlDefaultPath = "intermediateCaCrl.der";
     const std::string qeIdentityDefaultPath = "qeIdentity.json";
 
-    const std::string helpOutput = "Usage: [-h] [--trustedRootCaCert=<string>] [--pckSignChain=<string>] [--pckCert=<string>] [--tcbSignChain=<string>] [--tcbInfo=<string>] [--qeIdentity=<string>] [--qveIdentity=<string>] [--rootCaCrl=<string>] [--intermediateCaCrl=<string>] [--quote=<string>] [--expirationDate=<string>]\n\n"
+    const std::string helpOutput = "Usage: [-h] [--trustedRootCaCert=<string>] [--pckSignChain=<string>] [--pckCert=<string>] [--tcbSignChain=<string>] [--tcbInfo=<string>] [--qeIdentity=<string>] [--qveIdentity=<string>] [--rootCaCrl=<string>] [--intermediateCaCrl=<string>] [--quote=<string>] [--expirationDate=<string>] [--serve=<string>] [--watchCollateral] [--quoteDir=<string>] [--quoteList=<string>] [--quoteArchive=<string>] [--packQuotes=<string>] [--threads=<string>] [--resultFormat=<string>] [--resultFile=<string>]\n\n"
             "--trustedRootCaCert=<string>             Trusted root CA Certificate file path, PEM format [=trustedRootCaCert.pem]\n"
             "--pckSignChain=<string>                  PCK Signing Certificate chain file path, PEM format [=pckSignChain.pem]\n"
             "--pckCert=<string>                       PCK Certificate file path, PEM format [=pckCert.pem]\n"
@@ -65,6 +65,15 @@ struct AppOptionsParserTests: public Test
             "--intermediateCaCrl=<string>             Intermediate Ca CRL file path, PEM or DER format [=intermediateCaCrl.der]\n"
             "--quote=<string>                         Quote file path, binary format [=quote.dat]\n"
             "--expirationDate=<string>                Expiration date in timestamp seconds [=seconds]\n"
+            "--serve=<string>                         Run as verification daemon on Unix domain socket at given path. Collateral is loaded and verified once at startup, requests carry quotes [=]\n"
+            "--watchCollateral                        Reload collateral of verification daemon when files in its directories change. SIGHUP always reloads it\n"
+            "--quoteDir=<string>                      Verify every quote file in given directory against the collateral, results are reported per quote [=]\n"
+            "--quoteList=<string>                     File with quote file paths, one per line, verified like quoteDir [=]\n"
+            "--quoteArchive=<string>                  Quote archive file path, its quotes are verified like quoteDir [=]\n"
+            "--packQuotes=<string>                    Pack quotes of quoteDir and quoteList into quote archive at given path instead of verifying them [=]\n"
+            "--threads=<string>                       Number of threads verifying quotes of quoteDir or quoteList, 0 uses all CPUs [=0]\n"
+            "--resultFormat=<string>                  Format of per quote results, csv or json (one object per line) [=csv]\n"
+            "--resultFile=<string>                    Per quote results file path, results are logged when not given [=]\n"
             "-h, --help                               Print this message\n";
 
     // return true if difference between input time and current time is less than 3 seconds
@@ -176,6 +185,67 @@ TEST_F(AppOptionsParserTests, ReturnsGivenValuesWhenParametersPassedPrintsNothin
     EXPECT_EQ(options->tcbSigningChainFile, tcbSignChain);
     EXPECT_EQ(options->quoteFile, quote);
     EXPECT_EQ(options->expirationDate, std::stol(expirationDate));
+    EXPECT_TRUE(options->serveSocketPath.empty());
+    EXPECT_FALSE(options->watchCollateral);
+    EXPECT_TRUE(options->quoteDir.empty());
+    EXPECT_TRUE(options->quoteList.empty());
+    EXPECT_TRUE(options->quoteArchive.empty());
+    EXPECT_TRUE(options->packQuotes.empty());
+    EXPECT_EQ(0u, options->threads);
+    EXPECT_EQ("csv", options->resultFormat);
+}
+
+TEST_F(AppOptionsParserTests, ReturnsBatchOptionsWhenQuoteDirPassedPrintsNothing)
+{
+    std::vector<const char*> vec {"./AppCommand", "--quoteDir=quotes", "--quoteList=quotes.txt", "--quoteArchive=quotes.qarc",
+                                  "--packQuotes=packed.qarc", "--threads=8",
+                                  "--resultFormat=json", "--resultFile=results.jsonl"};
+    std::ostringstream logger;
+
+    auto options = parser.parse((int32_t) vec.size(), const_cast<char**>(vec.data()), logger);
+
+    EXPECT_TRUE(options != nullptr);
+    EXPECT_TRUE(logger.str().empty());
+    EXPECT_EQ("quotes", options->quoteDir);
+    EXPECT_EQ("quotes.txt", options->quoteList);
+    EXPECT_EQ("quotes.qarc", options->quoteArchive);
+    EXPECT_EQ("packed.qarc", options->packQuotes);
+    EXPECT_EQ(8u, options->threads);
+    EXPECT_EQ("json", options->resultFormat);
+    EXPECT_EQ("results.jsonl", options->resultFile);
+}
+
+TEST_F(AppOptionsParserTests, ReturnsNothingWhenBatchOptionsAreInvalidPrintsErrorAndHelp)
+{
+    for (const auto arg : {"--threads=many", "--threads=-1", "--resultFormat=xml"})
+    {
+        std::vector<const char*> vec {"./AppCommand", arg};
+        std::ostringstream logger;
+
+        testing::internal::CaptureStdout();
+        auto options = parser.parse((int32_t) vec.size(), const_cast<char**>(vec.data()), logger);
+        std::string output = testing::internal::GetCapturedStdout();
+
+        EXPECT_TRUE(options == nullptr) << arg;
+        EXPECT_TRUE(output.find(helpOutput) != std::string::npos) << arg;
+    }
+}
+
+TEST_F(AppOptionsParserTests, ReturnsServeOptionsWhenServePassedPrintsNothing)
+{
+    const std::string socketPath = "/run/qvl.sock";
+    const std::string serveArg = "--serve=" + socketPath;
+
+    std::vector<const char*> vec {"./AppCommand", serveArg.c_str(), "--watchCollateral"};
+    std::ostringstream logger;
+
+    auto options = parser.parse((int32_t) vec.size(), const_cast<char**>(vec.data()), logger);
+
+    EXPECT_TRUE(options != nullptr);
+    EXPECT_TRUE(logger.str().empty());
+    EXPECT_EQ(options->serveSocketPath, socketPath);
+    EXPECT_TRUE(options->watchCollateral);
+    EXPECT_EQ(options->quoteFile, quoteDefaultPath);
 }
 
 TEST_F(AppOptionsParserTests, ReturnsNothingWhenHelpTypedPrintsHelp)
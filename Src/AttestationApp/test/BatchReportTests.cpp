@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "AppCore/BatchReport.h"
+
+#include <sstream>
+
+using namespace ::testing;
+using namespace intel::sgx::dcap;
+
+TEST(BatchReportTests, shouldQuoteCsvFieldsWithSeparators)
+{
+    std::ostringstream out;
+
+    writeResultHeader("csv", out);
+    writeResult(BatchResult{"plain.dat", true, STATUS_OK, 12}, "csv", out);
+    writeResult(BatchResult{"with,comma \"and\" quotes.dat", false, STATUS_OK, 0}, "csv", out);
+
+    EXPECT_EQ("quote,status,latency_us\n"
+              "plain.dat,STATUS_OK(0),12\n"
+              "\"with,comma \"\"and\"\" quotes.dat\",READ_ERROR,0\n", out.str());
+}
+
+TEST(BatchReportTests, shouldEscapeJsonStrings)
+{
+    std::ostringstream out;
+
+    writeResultHeader("json", out);
+    writeResult(BatchResult{"dir\\\"q\"\n.dat", true, STATUS_TCB_REVOKED, 7}, "json", out);
+
+    EXPECT_EQ("{\"quote\":\"dir\\\\\\\"q\\\"\\u000a.dat\",\"status\":\"STATUS_TCB_REVOKED(" + std::to_string(STATUS_TCB_REVOKED) +
+              ")\",\"latencyUs\":7}\n", out.str());
+}
+
+TEST(BatchReportTests, shouldSummarizeThroughputLatencyAndOutcomes)
+{
+    std::vector<BatchResult> results;
+    for (uint64_t latency = 1; latency <= 100; ++latency)
+    {
+        results.push_back(BatchResult{"q", true, latency % 10 == 0 ? STATUS_TCB_OUT_OF_DATE : STATUS_OK, latency});
+    }
+    results.push_back(BatchResult{"missing", false, STATUS_OK, 0});
+
+    const auto summary = summarize(results, std::chrono::milliseconds(500));
+
+    EXPECT_EQ(101u, summary.quotes);
+    EXPECT_DOUBLE_EQ(0.5, summary.seconds);
+    EXPECT_DOUBLE_EQ(202.0, summary.quotesPerSecond);
+    EXPECT_EQ(50u, summary.p50LatencyUs);
+    EXPECT_EQ(99u, summary.p99LatencyUs);
+    EXPECT_THAT(summary.outcomes, ElementsAre(Pair("READ_ERROR", 1u), Pair("STATUS_OK(0)", 90u),
+                                              Pair("STATUS_TCB_OUT_OF_DATE(" + std::to_string(STATUS_TCB_OUT_OF_DATE) + ")", 10u)));
+}
+
+TEST(BatchReportTests, shouldSummarizeEmptyBatch)
+{
+    const auto summary = summarize({}, std::chrono::steady_clock::duration::zero());
+
+    EXPECT_EQ(0u, summary.quotes);
+    EXPECT_EQ(0u, summary.p50LatencyUs);
+    EXPECT_EQ(0u, summary.p99LatencyUs);
+    EXPECT_DOUBLE_EQ(0.0, summary.quotesPerSecond);
+}
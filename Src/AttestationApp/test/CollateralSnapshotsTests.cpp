@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "AppCore/CollateralSnapshots.h"
+
+#include <memory>
+
+using namespace ::testing;
+using namespace intel::sgx::dcap;
+
+struct CollateralSnapshotsTests: public Test
+{
+    static QuoteCollateral collateral(const std::string& tcbInfo)
+    {
+        return QuoteCollateral{"pckCert", "pckCrl", tcbInfo, "qeIdentity", nullptr};
+    }
+
+    CollateralSnapshots snapshots{collateral("initial"), 2};
+};
+
+TEST_F(CollateralSnapshotsTests, shouldReadPublishedCollateral)
+{
+    EXPECT_EQ("initial", CollateralSnapshots::Reader(snapshots, 0).get().tcbInfo);
+
+    snapshots.publish(collateral("reloaded"));
+
+    EXPECT_EQ("reloaded", CollateralSnapshots::Reader(snapshots, 0).get().tcbInfo);
+    EXPECT_EQ(0u, snapshots.reclaim());
+}
+
+TEST_F(CollateralSnapshotsTests, shouldKeepSnapshotUntilReaderWhichSawItLeaves)
+{
+    auto reader = std::make_unique<CollateralSnapshots::Reader>(snapshots, 0);
+    const auto& seen = reader->get();
+
+    snapshots.publish(collateral("reloaded"));
+    const CollateralSnapshots::Reader laterReader(snapshots, 1);
+
+    EXPECT_EQ("initial", seen.tcbInfo);
+    EXPECT_EQ("reloaded", laterReader.get().tcbInfo);
+    EXPECT_EQ(1u, snapshots.reclaim());
+
+    reader.reset();
+    EXPECT_EQ(0u, snapshots.reclaim());
+}
+
+TEST_F(CollateralSnapshotsTests, shouldReclaimOnlySnapshotsOlderThanOldestReader)
+{
+    snapshots.publish(collateral("first"));
+    const CollateralSnapshots::Reader reader(snapshots, 0);
+    snapshots.publish(collateral("second"));
+    snapshots.publish(collateral("third"));
+
+    EXPECT_EQ("first", reader.get().tcbInfo);
+    EXPECT_EQ(2u, snapshots.reclaim());
+}
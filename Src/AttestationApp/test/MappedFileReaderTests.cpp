@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "AppCore/MappedFileReader.h"
+
+#ifdef __linux__
+
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace ::testing;
+using namespace intel::sgx::dcap;
+
+struct MappedFileReaderTests: public Test
+{
+    MappedFileReader reader;
+    std::string directory;
+
+    void SetUp() override
+    {
+        char pattern[] = "/tmp/qvl_mapped_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(pattern));
+        directory = pattern;
+    }
+
+    void TearDown() override
+    {
+        for (const auto& file : reader.listFiles(directory))
+        {
+            unlink(file.c_str());
+        }
+        unlink((directory + "/pipe").c_str());
+        rmdir(directory.c_str());
+    }
+
+    std::string createFile(const std::string& name, const std::string& content) const
+    {
+        const auto path = directory + "/" + name;
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+        return path;
+    }
+};
+
+TEST_F(MappedFileReaderTests, shouldReturnSameContentAsFileReader)
+{
+    const std::string content("-----BEGIN X509 CRL-----\0\x01\xff", 27);
+    const auto path = createFile("collateral.pem", content);
+
+    const auto view = reader.mapContent(path);
+
+    EXPECT_EQ(FileReader().readContent(path), reader.readContent(path));
+    EXPECT_EQ(FileReader().readBinaryContent(path), reader.readBinaryContent(path));
+    ASSERT_EQ(content.size(), view.size);
+    EXPECT_EQ(content, std::string(reinterpret_cast<const char*>(view.data), view.size));
+    EXPECT_NE(nullptr, view.owner);
+}
+
+TEST_F(MappedFileReaderTests, shouldKeepMappingAliveWhileViewIsHeld)
+{
+    const auto path = createFile("quote.dat", "quote");
+
+    const auto view = reader.mapContent(path);
+    unlink(path.c_str());
+
+    EXPECT_EQ("quote", std::string(reinterpret_cast<const char*>(view.data), view.size));
+}
+
+TEST_F(MappedFileReaderTests, shouldReadEmptyFile)
+{
+    const auto path = createFile("empty.dat", "");
+
+    EXPECT_EQ("", reader.readContent(path));
+    EXPECT_TRUE(reader.readBinaryContent(path).empty());
+    EXPECT_EQ(0u, reader.mapContent(path).size);
+}
+
+TEST_F(MappedFileReaderTests, shouldReadContentFromPipe)
+{
+    const auto path = directory + "/pipe";
+    ASSERT_EQ(0, mkfifo(path.c_str(), 0600));
+    const std::string content("tcbInfo\0\x01", 9);
+    const auto writeOnce = [&path, &content] {
+        std::ofstream(path, std::ios::binary) << content;
+    };
+
+    std::thread writer(writeOnce);
+    EXPECT_EQ(content, reader.readContent(path));
+    writer.join();
+
+    writer = std::thread(writeOnce);
+    EXPECT_EQ(std::vector<uint8_t>(content.begin(), content.end()), reader.readBinaryContent(path));
+    writer.join();
+
+    writer = std::thread(writeOnce);
+    const auto view = reader.mapContent(path);
+    writer.join();
+    EXPECT_EQ(content, std::string(reinterpret_cast<const char*>(view.data), view.size));
+}
+
+TEST_F(MappedFileReaderTests, shouldThrowWhenFileCantBeMapped)
+{
+    EXPECT_THROW(reader.readContent(directory + "/missing"), IFileReader::ReadFileException);
+    EXPECT_THROW(reader.mapContent(directory), IFileReader::ReadFileException);
+}
+
+#endif // __linux__
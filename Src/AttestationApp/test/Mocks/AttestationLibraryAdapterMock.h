@@ -45,6 +45,9 @@ public:
     MOCK_CONST_METHOD5(verifyPCKCertificate, Status(const std::string&, const std::string&, const std::string&, const std::string&, const time_t&));
     MOCK_CONST_METHOD5(verifyTCBInfo, Status(const std::string&, const std::string&, const std::string&, const std::string&,const time_t&));
     MOCK_CONST_METHOD5(verifyQeIdentity, Status(const std::string&, const std::string&, const std::string&, const std::string&, const time_t&));
+    MOCK_CONST_METHOD1(parseCollateral, Status(QuoteCollateral&));
+    MOCK_CONST_METHOD3(verifyQuoteWithCollateral, Status(const std::vector<uint8_t>&, const std::string&, const QuoteCollateral&));
+    MOCK_CONST_METHOD4(verifyQuoteWithCollateral, Status(const uint8_t*, size_t, const std::string&, const QuoteCollateral&));
 };
 }}}}
 
@@ -42,6 +42,8 @@ class FileReaderMock : public IFileReader
 public:
     MOCK_CONST_METHOD1(readContent, std::string(const std::string&));
     MOCK_CONST_METHOD1(readBinaryContent, std::vector<uint8_t>(const std::string&));
+    MOCK_CONST_METHOD1(listFiles, std::vector<std::string>(const std::string&));
+    MOCK_CONST_METHOD1(mapContent, FileView(const std::string&));
 };
 }}}}
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "AppCore/QuoteArchive.h"
+
+#include <sstream>
+
+using namespace ::testing;
+using namespace intel::sgx::dcap;
+
+struct QuoteArchiveTests: public Test
+{
+    static FileView view(const std::string& content)
+    {
+        const auto owner = std::make_shared<const std::string>(content);
+        return FileView{reinterpret_cast<const uint8_t*>(owner->data()), owner->size(), owner};
+    }
+
+    static std::string pack(const std::vector<QuoteArchive::Entry>& entries)
+    {
+        std::ostringstream out;
+        QuoteArchive::write(entries, out);
+        return out.str();
+    }
+
+    static std::string content(const FileView& file)
+    {
+        return std::string(reinterpret_cast<const char*>(file.data), file.size);
+    }
+};
+
+TEST_F(QuoteArchiveTests, shouldReadPackedQuotesInPlace)
+{
+    const auto packed = view(pack({{"first.dat", view("quote one")}, {"", view("")}, {"third.dat", view(std::string("\0\x01", 2))}}));
+    QuoteArchive archive;
+
+    ASSERT_TRUE(archive.parse(packed));
+
+    ASSERT_EQ(3u, archive.size());
+    EXPECT_EQ("first.dat", archive.name(0));
+    EXPECT_EQ("quote one", content(archive.quote(0)));
+    EXPECT_EQ("", archive.name(1));
+    EXPECT_EQ(0u, archive.quote(1).size);
+    EXPECT_EQ("third.dat", archive.name(2));
+    EXPECT_EQ(std::string("\0\x01", 2), content(archive.quote(2)));
+    EXPECT_GE(archive.quote(0).data, packed.data);
+    EXPECT_LT(archive.quote(0).data, packed.data + packed.size);
+    EXPECT_EQ(packed.owner, archive.quote(0).owner);
+}
+
+TEST_F(QuoteArchiveTests, shouldReadEmptyArchive)
+{
+    QuoteArchive archive;
+
+    ASSERT_TRUE(archive.parse(view(pack({}))));
+    EXPECT_EQ(0u, archive.size());
+}
+
+TEST_F(QuoteArchiveTests, shouldRejectContentWhichIsNotArchive)
+{
+    QuoteArchive archive;
+
+    EXPECT_FALSE(archive.parse(view("")));
+    EXPECT_FALSE(archive.parse(view("QVLQARC2 and some more bytes")));
+}
+
+TEST_F(QuoteArchiveTests, shouldRejectEntriesOutsideOfArchive)
+{
+    const auto packed = pack({{"first.dat", view("quote one")}});
+    QuoteArchive archive;
+
+    EXPECT_FALSE(archive.parse(view(packed.substr(0, packed.size() - 1))));
+    EXPECT_FALSE(archive.parse(view(packed.substr(0, QuoteArchive::HEADER_SIZE))));
+
+    auto corrupted = packed;
+    corrupted[QuoteArchive::HEADER_SIZE + 7] = '\x01'; // quote offset beyond any realistic size
+    EXPECT_FALSE(archive.parse(view(corrupted)));
+}
+
+TEST_F(QuoteArchiveTests, shouldFailPackingWhenEntryChangesBetweenPasses)
+{
+    size_t reads = 0;
+    std::ostringstream out;
+
+    EXPECT_THROW(QuoteArchive::write(1, [&reads](size_t) {
+        return QuoteArchive::Entry{"quote.dat", view(++reads == 1 ? "short" : "longer")};
+    }, out), std::runtime_error);
+}
@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "AppCore/VerificationProtocol.h"
+#include "AppCore/VerificationServer.h"
+#include "Mocks/AttestationLibraryAdapterMock.h"
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace ::testing;
+using namespace intel::sgx::dcap;
+
+TEST(VerificationProtocolTests, shouldEncodeRequestWithBigEndianSizes)
+{
+    const std::vector<uint8_t> quote = {1, 2, 3};
+    const std::string pckCertificate = "pem";
+
+    const auto request = protocol::encodeRequest(quote, pckCertificate);
+
+    ASSERT_EQ(protocol::REQUEST_HEADER_SIZE + quote.size() + pckCertificate.size(), request.size());
+    std::array<uint8_t, protocol::REQUEST_HEADER_SIZE> headerBytes{};
+    std::copy(request.begin(), request.begin() + protocol::REQUEST_HEADER_SIZE, headerBytes.begin());
+    EXPECT_THAT(headerBytes, ElementsAre(0, 0, 0, 3, 0, 0, 0, 3));
+
+    protocol::RequestHeader header{};
+    ASSERT_TRUE(protocol::decodeRequestHeader(headerBytes, header));
+    EXPECT_EQ(3u, header.quoteSize);
+    EXPECT_EQ(3u, header.pckCertificateSize);
+    EXPECT_EQ(quote, std::vector<uint8_t>(request.begin() + 8, request.begin() + 11));
+    EXPECT_EQ(pckCertificate, std::string(request.begin() + 11, request.end()));
+}
+
+TEST(VerificationProtocolTests, shouldRejectHeaderExceedingLimits)
+{
+    protocol::RequestHeader header{};
+    EXPECT_FALSE(protocol::decodeRequestHeader({{0x00, 0x10, 0x00, 0x01, 0, 0, 0, 0}}, header));
+    EXPECT_FALSE(protocol::decodeRequestHeader({{0, 0, 0, 1, 0x00, 0x01, 0x00, 0x01}}, header));
+    EXPECT_FALSE(protocol::decodeRequestHeader({{0, 0, 0, 0, 0, 0, 0, 0}}, header));
+}
+
+TEST(VerificationProtocolTests, shouldRoundTripResponseStatus)
+{
+    EXPECT_EQ(STATUS_OK, protocol::decodeResponse(protocol::encodeResponse(STATUS_OK)));
+    EXPECT_EQ(STATUS_TCB_OUT_OF_DATE, protocol::decodeResponse(protocol::encodeResponse(STATUS_TCB_OUT_OF_DATE)));
+}
+
+#ifdef __linux__
+
+struct VerificationServerTests: public Test
+{
+    std::shared_ptr<StrictMock<test::AttestationLibraryAdapterMock>> attestationLibraryMock =
+        std::make_shared<StrictMock<test::AttestationLibraryAdapterMock>>();
+    QuoteCollateral collateral{"pckCert content", "intermediateCaCrl content", "tcbInfo content", "qeIdentity content", nullptr};
+    std::string socketPath = "/tmp/qvl_server_test_" + std::to_string(getpid()) + ".sock";
+    std::stringstream log;
+
+    sockaddr_un address() const
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+
+    int connect() const
+    {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        const auto serverAddress = address();
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&serverAddress), sizeof(serverAddress)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    static Status exchange(int fd, const std::vector<uint8_t>& quote, const std::string& pckCertificate)
+    {
+        const auto request = protocol::encodeRequest(quote, pckCertificate);
+        EXPECT_EQ(static_cast<ssize_t>(request.size()), send(fd, request.data(), request.size(), 0));
+        std::array<uint8_t, protocol::RESPONSE_SIZE> response{};
+        EXPECT_EQ(static_cast<ssize_t>(response.size()), recv(fd, response.data(), response.size(), MSG_WAITALL));
+        return protocol::decodeResponse(response);
+    }
+
+    static bool waitFor(const std::function<bool()>& condition)
+    {
+        for (int i = 0; i < 5000 && !condition(); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return condition();
+    }
+};
+
+TEST_F(VerificationServerTests, shouldVerifyRequestedQuotesAgainstLoadedCollateral)
+{
+    const std::vector<uint8_t> firstQuote = {1, 2, 3};
+    const std::vector<uint8_t> secondQuote = {4, 5};
+    const std::string pckCertificate = "other pckCert";
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(firstQuote, "", Field(&QuoteCollateral::tcbInfo, "tcbInfo content")))
+        .WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(secondQuote, pckCertificate, _))
+        .WillOnce(Return(STATUS_TCB_REVOKED));
+
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    std::thread serverThread([&server] { server.run(); });
+
+    const auto fd = connect();
+    ASSERT_NE(-1, fd);
+    EXPECT_EQ(STATUS_OK, exchange(fd, firstQuote, ""));
+    EXPECT_EQ(STATUS_TCB_REVOKED, exchange(fd, secondQuote, pckCertificate));
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+}
+
+TEST_F(VerificationServerTests, shouldDropConnectionWhenRequestExceedsLimits)
+{
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    std::thread serverThread([&server] { server.run(); });
+
+    const auto fd = connect();
+    ASSERT_NE(-1, fd);
+    const std::array<uint8_t, protocol::REQUEST_HEADER_SIZE> header{{0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0}};
+    EXPECT_EQ(static_cast<ssize_t>(header.size()), send(fd, header.data(), header.size(), 0));
+    uint8_t byte = 0;
+    EXPECT_EQ(0, recv(fd, &byte, 1, 0));
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+}
+
+TEST_F(VerificationServerTests, shouldRemoveSocketFileWhenDestroyed)
+{
+    {
+        VerificationServer server(attestationLibraryMock, collateral);
+        ASSERT_TRUE(server.listen(socketPath, log));
+        EXPECT_EQ(0, access(socketPath.c_str(), F_OK));
+    }
+    EXPECT_NE(0, access(socketPath.c_str(), F_OK));
+}
+
+TEST_F(VerificationServerTests, shouldRefuseToReplaceFileWhichIsNotSocket)
+{
+    {
+        std::ofstream file(socketPath);
+        file << "data";
+    }
+
+    VerificationServer server(attestationLibraryMock, collateral);
+    EXPECT_FALSE(server.listen(socketPath, log));
+    EXPECT_FALSE(log.str().empty());
+    unlink(socketPath.c_str());
+}
+
+TEST_F(VerificationServerTests, shouldRefuseToTakeOverSocketOfRunningServer)
+{
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    std::thread serverThread([&server] { server.run(); });
+
+    {
+        VerificationServer second(attestationLibraryMock, collateral);
+        EXPECT_FALSE(second.listen(socketPath, log));
+    }
+    EXPECT_EQ(0, access(socketPath.c_str(), F_OK));
+    const auto fd = connect();
+    EXPECT_NE(-1, fd);
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+}
+
+TEST_F(VerificationServerTests, shouldReplaceStaleSocketFile)
+{
+    {
+        const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+        const auto staleAddress = address();
+        ASSERT_EQ(0, bind(stale, reinterpret_cast<const sockaddr*>(&staleAddress), sizeof(staleAddress)));
+        close(stale);
+    }
+
+    VerificationServer server(attestationLibraryMock, collateral);
+    EXPECT_TRUE(server.listen(socketPath, log));
+}
+
+TEST_F(VerificationServerTests, shouldShedPendingConnectionWhenOutOfDescriptors)
+{
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    bool listening = false;
+    std::thread serverThread([&server, &listening] { listening = server.run(); });
+
+    const int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_NE(-1, client);
+    const timeval timeout{5, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    const int lowestFree = open("/dev/null", O_RDONLY);
+    ASSERT_NE(-1, lowestFree);
+    close(lowestFree);
+
+    // no new descriptor can be created until the limit is restored
+    rlimit limits{};
+    ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &limits));
+    rlimit exhausted = limits;
+    exhausted.rlim_cur = static_cast<rlim_t>(lowestFree);
+    ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &exhausted));
+    const auto serverAddress = address();
+    const auto connected = ::connect(client, reinterpret_cast<const sockaddr*>(&serverAddress), sizeof(serverAddress));
+    uint8_t byte = 0;
+    const auto received = recv(client, &byte, 1, 0);
+    setrlimit(RLIMIT_NOFILE, &limits);
+
+    EXPECT_EQ(0, connected);
+    EXPECT_EQ(0, received);
+    close(client);
+    const auto fd = connect();
+    EXPECT_NE(-1, fd);
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+    EXPECT_TRUE(listening);
+}
+
+TEST_F(VerificationServerTests, shouldVerifyWithReloadedCollateralAfterReload)
+{
+    const std::vector<uint8_t> quote = {1, 2, 3};
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(quote, "", Field(&QuoteCollateral::tcbInfo, "tcbInfo content")))
+        .WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(quote, "", Field(&QuoteCollateral::tcbInfo, "reloaded tcbInfo")))
+        .WillOnce(Return(STATUS_TCB_OUT_OF_DATE));
+
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    ASSERT_TRUE(server.enableReload([this](QuoteCollateral& next) {
+        next = collateral;
+        next.tcbInfo = "reloaded tcbInfo";
+        return true;
+    }, {}, log));
+    std::thread serverThread([&server] { server.run(); });
+
+    const auto fd = connect();
+    ASSERT_NE(-1, fd);
+    EXPECT_EQ(STATUS_OK, exchange(fd, quote, ""));
+    server.reload();
+    EXPECT_TRUE(waitFor([&server] { return server.getReloadCount() == 1; }));
+    EXPECT_EQ(STATUS_TCB_OUT_OF_DATE, exchange(fd, quote, ""));
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+}
+
+TEST_F(VerificationServerTests, shouldKeepCollateralWhenReloadFails)
+{
+    const std::vector<uint8_t> quote = {1, 2, 3};
+    std::atomic<int> loads{0};
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteWithCollateral(quote, "", Field(&QuoteCollateral::tcbInfo, "tcbInfo content")))
+        .WillOnce(Return(STATUS_OK));
+
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    ASSERT_TRUE(server.enableReload([&loads](QuoteCollateral&) {
+        ++loads;
+        return false;
+    }, {}, log));
+    std::thread serverThread([&server] { server.run(); });
+
+    server.reload();
+    EXPECT_TRUE(waitFor([&loads] { return loads == 1; }));
+    const auto fd = connect();
+    ASSERT_NE(-1, fd);
+    EXPECT_EQ(STATUS_OK, exchange(fd, quote, ""));
+    close(fd);
+
+    server.stop();
+    serverThread.join();
+    EXPECT_EQ(0u, server.getReloadCount());
+}
+
+TEST_F(VerificationServerTests, shouldReloadWhenFileInWatchedDirectoryChanges)
+{
+    char directory[] = "/tmp/qvl_collateral_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(directory));
+    const std::string tcbInfoPath = std::string(directory) + "/tcbInfo.json";
+
+    VerificationServer server(attestationLibraryMock, collateral);
+    ASSERT_TRUE(server.listen(socketPath, log));
+    ASSERT_TRUE(server.enableReload([this](QuoteCollateral& next) {
+        next = collateral;
+        return true;
+    }, {directory}, log));
+    std::thread serverThread([&server] { server.run(); });
+
+    {
+        std::ofstream file(tcbInfoPath);
+        file << "{}";
+    }
+    EXPECT_TRUE(waitFor([&server] { return server.getReloadCount() == 1; }));
+
+    server.stop();
+    serverThread.join();
+    unlink(tcbInfoPath.c_str());
+    rmdir(directory);
+}
+
+#endif // __linux__
@@ -36,6 +36,7 @@
 #include <stdexcept>
 #include <ctype.h>
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <iterator>
 #include <cstdint>
@@ -73,7 +74,7 @@ inline Bytes operator+(const Bytes& lhs, const Bytes& rhs)
     return retVal;
 }
 
-inline Bytes hexStringToBytes(const std::string& hexEncoded)
+inline Bytes hexStringToBytes(std::string_view hexEncoded)
 {
     try{
         if (hexEncoded.length() % 2 == 1) {
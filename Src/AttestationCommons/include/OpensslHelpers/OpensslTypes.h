@@ -71,6 +71,7 @@ using EC_GROUP_uptr                 = std::unique_ptr<EC_GROUP,
 using EC_POINT_uptr                 = std::unique_ptr<EC_POINT,                 decltype(&EC_POINT_free)>;
 using ECDSA_SIG_uptr                = std::unique_ptr<ECDSA_SIG,                decltype(&ECDSA_SIG_free)>;
 using EVP_CIPHER_CTX_uptr           = std::unique_ptr<EVP_CIPHER_CTX,           decltype(&freeEVP_CIPHER_CTX)>;
+using EVP_MD_uptr                   = std::unique_ptr<EVP_MD,                   decltype(&EVP_MD_free)>;
 using EVP_MD_CTX_uptr               = std::unique_ptr<EVP_MD_CTX,               decltype(&freeEVP_MD_CTX)>;
 using EVP_PKEY_uptr                 = std::unique_ptr<EVP_PKEY,                 decltype(&EVP_PKEY_free)>;
 using EVP_PKEY_sptr                 = std::shared_ptr<EVP_PKEY>;
@@ -207,6 +208,12 @@ inline EVP_CIPHER_CTX_uptr make_unique(EVP_CIPHER_CTX* raw_pointer)
     return EVP_CIPHER_CTX_uptr(raw_pointer, freeEVP_CIPHER_CTX);
 }
 
+template<>
+inline EVP_MD_uptr make_unique(EVP_MD* raw_pointer)
+{
+    return EVP_MD_uptr(raw_pointer, EVP_MD_free);
+}
+
 template<>
 inline EVP_MD_CTX_uptr make_unique(EVP_MD_CTX* raw_pointer)
 {
@@ -44,7 +44,15 @@
 #include "spdlog/pattern_formatter.h"
 #include <fmt/ranges.h>
 
-#define LOG(level, ...) spdlog::log(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, level, __VA_ARGS__)
+// arguments such as hex dumps of quote fields are evaluated only when the message is going to be logged
+#define LOG(level, ...)                                                                                  \
+    do                                                                                                   \
+    {                                                                                                    \
+        if (spdlog::default_logger_raw()->should_log(level))                                             \
+        {                                                                                                \
+            spdlog::log(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, level, __VA_ARGS__);    \
+        }                                                                                                \
+    } while (false)
 #define LOG_TRACE(...) LOG(spdlog::level::trace, __VA_ARGS__)
 #define LOG_DEBUG(...) LOG(spdlog::level::debug, __VA_ARGS__)
 #define LOG_INFO(...) LOG(spdlog::level::info, __VA_ARGS__)
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_COMMONS_SCRATCHBUFFER_H
+#define SGX_DCAP_COMMONS_SCRATCHBUFFER_H
+
+#include <cstddef>
+
+namespace intel { namespace sgx { namespace dcap { namespace scratch {
+
+/**
+ * Size in bytes of every scratch buffer. Large enough to hold the DOM of a TCB Info with all of its levels.
+ */
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+/**
+ * Take a buffer of BUFFER_SIZE bytes, aligned for any fundamental type, from the calling thread's pool.
+ * A new buffer is allocated only when the pool is empty, so a thread verifying quotes in a loop
+ * keeps reusing the same few buffers instead of going to the heap for every collateral.
+ */
+void* acquire();
+
+/**
+ * Give a buffer obtained from acquire() back to the calling thread's pool, it does not need to be
+ * the thread that acquired it. Buffers above the pool capacity are freed.
+ *
+ * @param buffer - may be NULL
+ */
+void release(void* buffer) noexcept;
+
+/**
+ * Number of buffers currently held in the calling thread's pool.
+ */
+size_t getPooledCount() noexcept;
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace scratch {
+
+#endif //SGX_DCAP_COMMONS_SCRATCHBUFFER_H
@@ -33,8 +33,10 @@
 #define SGX_DCAP_PARSERS_TIMEUTILS_H
 
 
+#include <cstdint>
 #include <ctime>
 #include <string>
+#include <string_view>
 
 namespace intel { namespace sgx { namespace dcap {
 
@@ -45,6 +47,45 @@ struct tm getTimeFromString(const std::string& date);
 time_t getEpochTimeFromString(const std::string& date);
 bool isValidTimeString(const std::string& timeString);
 
+/**
+ * Number of days between 1970-01-01 and given proleptic Gregorian date.
+ * Plain integer arithmetic, no struct tm nor timezone lookup is involved.
+ *
+ * @param year - full year, e.g. 2021
+ * @param month - 1..12
+ * @param day - 1..31, not validated against month length
+ */
+constexpr int64_t daysFromCivil(int64_t year, uint32_t month, uint32_t day) noexcept
+{
+    // March based year so the leap day is the last day of a year
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Parse ISO 8601 date in the form used by collaterals: YYYY-MM-DDThh:mm:ssZ
+ *
+ * @param timeString - date to parse, must not contain anything else
+ * @param result - seconds since epoch, written only on success
+ * @return false when format does not match or date does not exist (e.g. 2019-02-29)
+ */
+bool parseIsoTime(std::string_view timeString, time_t& result);
+
+/**
+ * Parse content octets of ASN.1 UTCTime (YYMMDDhhmmssZ) or GeneralizedTime (YYYYMMDDhhmmssZ)
+ * in the restricted form mandated by RFC 5280. UTCTime years below 50 are mapped to 20YY.
+ *
+ * @param asn1Time - content octets of the time value
+ * @param generalizedTime - true for GeneralizedTime, false for UTCTime
+ * @param result - seconds since epoch, written only on success
+ * @return false when the value is not in the RFC 5280 form (offsets, fractions) or date does not exist
+ */
+bool parseAsn1Time(std::string_view asn1Time, bool generalizedTime, time_t& result);
+
 #ifndef SGX_TRUSTED
 namespace standard
 {
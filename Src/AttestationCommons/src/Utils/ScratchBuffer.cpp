@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "ScratchBuffer.h"
+
+#include <array>
+#include <new>
+
+namespace intel { namespace sgx { namespace dcap { namespace scratch {
+
+namespace {
+
+#ifndef SGX_TRUSTED
+
+// enough for the TCB Info and the QE Identity of one verification plus a nested parse
+constexpr size_t POOL_CAPACITY = 4;
+
+// trivially destructible, so it can still be read while other thread locals are destroyed
+thread_local bool poolDestroyed = false;
+
+struct Pool
+{
+    ~Pool()
+    {
+        poolDestroyed = true;
+        for (size_t i = 0; i < count; ++i)
+        {
+            ::operator delete(buffers[i]);
+        }
+    }
+
+    std::array<void*, POOL_CAPACITY> buffers{};
+    size_t count = 0;
+};
+
+thread_local Pool pool;
+
+#endif // SGX_TRUSTED
+
+} // anonymous namespace
+
+void* acquire()
+{
+#ifndef SGX_TRUSTED
+    if (!poolDestroyed && pool.count > 0)
+    {
+        return pool.buffers[--pool.count];
+    }
+#endif // SGX_TRUSTED
+    return ::operator new(BUFFER_SIZE);
+}
+
+void release(void* buffer) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return;
+    }
+#ifndef SGX_TRUSTED
+    if (!poolDestroyed && pool.count < POOL_CAPACITY)
+    {
+        pool.buffers[pool.count++] = buffer;
+        return;
+    }
+#endif // SGX_TRUSTED
+    ::operator delete(buffer);
+}
+
+size_t getPooledCount() noexcept
+{
+#ifndef SGX_TRUSTED
+    return poolDestroyed ? 0 : pool.count;
+#else
+    return 0;
+#endif // SGX_TRUSTED
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace scratch {
@@ -86,6 +86,12 @@ tm getTimeFromString(const std::string& date)
 
 time_t getEpochTimeFromString(const std::string& date)
 {
+    time_t result = 0;
+    if (parseIsoTime(date, result))
+    {
+        return result;
+    }
+
     auto time = getTimeFromString(date);
 #ifdef SGX_TRUSTED
     return enclave::mktime(&time);
@@ -96,11 +102,99 @@ time_t getEpochTimeFromString(const std::string& date)
 
 bool isValidTimeString(const std::string& timeString)
 {
-#ifdef SGX_TRUSTED
-    return enclave::isValidTimeString(timeString);
-#else
-    return standard::isValidTimeString(timeString);
-#endif // SGX_TRUSTED
+    time_t ignored = 0;
+    return parseIsoTime(timeString, ignored);
+}
+
+namespace {
+
+constexpr int64_t SECONDS_IN_A_DAY = 24 * 60 * 60;
+
+// Reads exactly count decimal digits, rejects anything else including signs and spaces
+bool readDigits(std::string_view input, size_t offset, size_t count, uint32_t& value)
+{
+    value = 0;
+    for (size_t i = offset; i < offset + count; ++i)
+    {
+        const auto digit = static_cast<uint32_t>(static_cast<unsigned char>(input[i]) - '0');
+        if (digit > 9)
+        {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+constexpr bool isLeapYear(int64_t year)
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+uint32_t daysInMonth(int64_t year, uint32_t month)
+{
+    constexpr uint8_t DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : DAYS[month - 1];
+}
+
+bool toEpoch(int64_t year, uint32_t month, uint32_t day,
+             uint32_t hour, uint32_t minute, uint32_t second, time_t& result)
+{
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) ||
+        hour > 23 || minute > 59 || second > 59)
+    {
+        return false;
+    }
+    result = static_cast<time_t>(daysFromCivil(year, month, day) * SECONDS_IN_A_DAY +
+                                 hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+} // anonymous namespace
+
+bool parseIsoTime(std::string_view timeString, time_t& result)
+{
+    // YYYY-MM-DDThh:mm:ssZ
+    constexpr size_t ISO_TIME_LENGTH = 20;
+    if (timeString.size() != ISO_TIME_LENGTH ||
+        timeString[4] != '-' || timeString[7] != '-' || timeString[10] != 'T' ||
+        timeString[13] != ':' || timeString[16] != ':' || timeString[19] != 'Z')
+    {
+        return false;
+    }
+
+    uint32_t year, month, day, hour, minute, second;
+    if (!readDigits(timeString, 0, 4, year) || !readDigits(timeString, 5, 2, month) ||
+        !readDigits(timeString, 8, 2, day) || !readDigits(timeString, 11, 2, hour) ||
+        !readDigits(timeString, 14, 2, minute) || !readDigits(timeString, 17, 2, second))
+    {
+        return false;
+    }
+    return toEpoch(year, month, day, hour, minute, second, result);
+}
+
+bool parseAsn1Time(std::string_view asn1Time, bool generalizedTime, time_t& result)
+{
+    const size_t yearDigits = generalizedTime ? 4 : 2;
+    // [YY]YYMMDDhhmmssZ
+    if (asn1Time.size() != yearDigits + 11 || asn1Time.back() != 'Z')
+    {
+        return false;
+    }
+
+    uint32_t year, month, day, hour, minute, second;
+    if (!readDigits(asn1Time, 0, yearDigits, year) || !readDigits(asn1Time, yearDigits, 2, month) ||
+        !readDigits(asn1Time, yearDigits + 2, 2, day) || !readDigits(asn1Time, yearDigits + 4, 2, hour) ||
+        !readDigits(asn1Time, yearDigits + 6, 2, minute) || !readDigits(asn1Time, yearDigits + 8, 2, second))
+    {
+        return false;
+    }
+    if (!generalizedTime)
+    {
+        // RFC 5280 4.1.2.5.1
+        year += year < 50 ? 2000 : 1900;
+    }
+    return toEpoch(year, month, day, hour, minute, second, result);
 }
 
 #ifndef SGX_TRUSTED
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "Utils/ScratchBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace intel::sgx::dcap;
+using namespace ::testing;
+
+struct ScratchBufferUT: public testing::Test
+{
+    void TearDown() override
+    {
+        // leave an empty pool so tests do not depend on each other
+        while (scratch::getPooledCount() > 0)
+        {
+            ::operator delete(scratch::acquire());
+        }
+    }
+};
+
+TEST_F(ScratchBufferUT, releasedBufferShouldBeReusedBySameThread)
+{
+    auto* first = scratch::acquire();
+    scratch::release(first);
+
+    EXPECT_EQ(1u, scratch::getPooledCount());
+    auto* second = scratch::acquire();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(0u, scratch::getPooledCount());
+    scratch::release(second);
+}
+
+TEST_F(ScratchBufferUT, buffersHeldAtSameTimeShouldBeDistinctAndUsable)
+{
+    auto* first = static_cast<uint8_t*>(scratch::acquire());
+    auto* second = static_cast<uint8_t*>(scratch::acquire());
+
+    ASSERT_NE(first, second);
+    std::fill_n(first, scratch::BUFFER_SIZE, uint8_t{0xAA});
+    std::fill_n(second, scratch::BUFFER_SIZE, uint8_t{0x55});
+    EXPECT_EQ(0xAA, first[scratch::BUFFER_SIZE - 1]);
+
+    scratch::release(first);
+    scratch::release(second);
+    EXPECT_EQ(2u, scratch::getPooledCount());
+}
+
+TEST_F(ScratchBufferUT, poolShouldBeBoundedAndFreeOverflow)
+{
+    std::vector<void*> buffers(16);
+    for (auto& buffer : buffers)
+    {
+        buffer = scratch::acquire();
+    }
+    for (auto* buffer : buffers)
+    {
+        scratch::release(buffer);
+    }
+
+    EXPECT_LT(scratch::getPooledCount(), buffers.size());
+    EXPECT_GT(scratch::getPooledCount(), 0u);
+}
+
+TEST_F(ScratchBufferUT, bufferShouldBeReleasableOnOtherThreadAndNullIgnored)
+{
+    auto* buffer = scratch::acquire();
+
+    std::thread other([buffer] {
+        scratch::release(buffer);
+        EXPECT_EQ(1u, scratch::getPooledCount());
+    });
+    other.join();
+
+    scratch::release(nullptr);
+    EXPECT_EQ(0u, scratch::getPooledCount());
+}
@@ -34,6 +34,10 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cstdio>
+#include <memory>
+
+#include <openssl/asn1.h>
 
 using namespace intel::sgx::dcap;
 using namespace ::testing;
@@ -139,4 +143,99 @@ TEST_F(TimeUtilsUT, isValidTimeStringIncorrectDate)
 {
     auto date = std::string("2017-06-31T11:10:45Z");
     assertIsValidTimeString(date, false);
-}
\ No newline at end of file
+}
+namespace {
+
+std::string formatIsoTime(int year, int month, int day, int hour, int minute, int second)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02dZ", year, month, day, hour, minute, second);
+    return buffer;
+}
+
+} // anonymous namespace
+
+TEST_F(TimeUtilsUT, daysFromCivil)
+{
+    static_assert(daysFromCivil(1970, 1, 1) == 0, "epoch");
+    static_assert(daysFromCivil(1969, 12, 31) == -1, "day before epoch");
+    static_assert(daysFromCivil(2000, 3, 1) == 11017, "day after leap day of 400 year cycle");
+    ASSERT_EQ(daysFromCivil(1900, 1, 1), -25567);
+}
+
+TEST_F(TimeUtilsUT, parseIsoTimeMatchesStandardImplementationOverWideRange)
+{
+    // every day from 1900 to 2400, rotating the time of day so all fields take many values
+    time_t day = daysFromCivil(1900, 1, 1) * 86400;
+    const time_t end = daysFromCivil(2401, 1, 1) * 86400;
+    for (int64_t i = 0; day < end; day += 86400, ++i)
+    {
+        const time_t expected = day + (i * 7919) % 86400;
+        const auto tm = *standard::gmtime(&expected);
+        const auto date = formatIsoTime(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+
+        time_t parsed = 0;
+        ASSERT_TRUE(parseIsoTime(date, parsed)) << date;
+        ASSERT_EQ(parsed, expected) << date;
+        ASSERT_EQ(getEpochTimeFromString(date), expected) << date;
+        ASSERT_TRUE(isValidTimeString(date)) << date;
+    }
+}
+
+TEST_F(TimeUtilsUT, parseIsoTimeRejectsSameInputsAsStandardImplementation)
+{
+    const std::string invalid[] = {
+        "", "2017-10-04T11:10:45", "2017-10-04T11:10:45Z ", " 2017-10-04T11:10:45Z", "2017-10-04 11:10:45Z",
+        "2017/10/04T11:10:45Z", "2017-1a-04T11:10:45Z", "2017-+1-04T11:10:45Z", "2017-10-04T11:10:45.1Z",
+        "2017-00-10T11:10:45Z", "2017-13-10T11:10:45Z", "2017-10-00T11:10:45Z", "2017-06-31T11:10:45Z",
+        "2019-02-29T00:00:00Z", "1900-02-29T00:00:00Z", "2100-02-29T00:00:00Z", "2017-10-04T24:00:00Z",
+        "2017-10-04T11:60:00Z", "2017-10-04T11:10:60Z"
+    };
+    for (const auto& date : invalid)
+    {
+        time_t parsed = 0;
+        EXPECT_FALSE(parseIsoTime(date, parsed)) << date;
+        EXPECT_FALSE(standard::isValidTimeString(date)) << date;
+        EXPECT_FALSE(isValidTimeString(date)) << date;
+    }
+
+    time_t parsed = 0;
+    EXPECT_TRUE(parseIsoTime("2000-02-29T23:59:59Z", parsed));
+    EXPECT_TRUE(standard::isValidTimeString("2000-02-29T23:59:59Z"));
+    EXPECT_TRUE(parseIsoTime("2024-02-29T00:00:00Z", parsed));
+}
+
+TEST_F(TimeUtilsUT, parseAsn1TimeMatchesOpenssl)
+{
+    // UTCTime covers 1950-2049, OpenSSL switches to GeneralizedTime outside of it
+    const time_t step = 86400 * 3 + 3727;
+    for (time_t time = daysFromCivil(1950, 1, 1) * 86400; time < daysFromCivil(2200, 1, 1) * 86400; time += step)
+    {
+        std::unique_ptr<ASN1_TIME, decltype(&ASN1_TIME_free)> asn1Time(ASN1_TIME_set(nullptr, time), ASN1_TIME_free);
+        ASSERT_NE(asn1Time, nullptr);
+
+        const std::string_view content(reinterpret_cast<const char*>(ASN1_STRING_get0_data(asn1Time.get())),
+                                       static_cast<size_t>(ASN1_STRING_length(asn1Time.get())));
+        time_t parsed = 0;
+        ASSERT_TRUE(parseAsn1Time(content, ASN1_STRING_type(asn1Time.get()) == V_ASN1_GENERALIZEDTIME, parsed)) << content;
+        ASSERT_EQ(parsed, time) << content;
+    }
+}
+
+TEST_F(TimeUtilsUT, parseAsn1TimeFormats)
+{
+    time_t parsed = 0;
+    ASSERT_TRUE(parseAsn1Time("490101000000Z", false, parsed));
+    EXPECT_EQ(parsed, daysFromCivil(2049, 1, 1) * 86400);
+    ASSERT_TRUE(parseAsn1Time("500101000000Z", false, parsed));
+    EXPECT_EQ(parsed, daysFromCivil(1950, 1, 1) * 86400);
+    ASSERT_TRUE(parseAsn1Time("20500101000000Z", true, parsed));
+    EXPECT_EQ(parsed, daysFromCivil(2050, 1, 1) * 86400);
+
+    // forms outside of RFC 5280 profile are left to OpenSSL
+    EXPECT_FALSE(parseAsn1Time("4901010000Z", false, parsed));
+    EXPECT_FALSE(parseAsn1Time("490101000000+0100", false, parsed));
+    EXPECT_FALSE(parseAsn1Time("20500101000000.5Z", true, parsed));
+    EXPECT_FALSE(parseAsn1Time("20500101000000Z", false, parsed));
+    EXPECT_FALSE(parseAsn1Time("490230000000Z", false, parsed));
+}
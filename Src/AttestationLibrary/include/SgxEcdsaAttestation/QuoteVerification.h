@@ -168,7 +168,8 @@ typedef enum _status
     STATUS_TDX_MODULE_MISMATCH,
     STATUS_SGX_ENCLAVE_REPORT_ISVSVN_NOT_SUPPORTED,
     STATUS_TCB_TD_RELAUNCH_ADVISED,
-    STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED
+    STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED,
+    STATUS_BUSY
 } Status;
 
 /**
@@ -209,6 +210,401 @@ typedef enum _status
  */
 QVL_API Status sgxAttestationVerifyQuote(const uint8_t* quote, uint32_t quoteSize, const char *pemPckCertificate, const char* intermediateCrl, const char* tcbInfoJson, const char* qeIdentityJson);
 
+/**
+ * This function is responsible for verifying provided quote against PCK certificate chain embedded in the quote
+ * (QE Certification Data of type PCK Certificate Chain (5)). The quote is parsed once, the chain is verified
+ * in the same way as by sgxAttestationVerifyPCKCertificate and the quote in the same way as by sgxAttestationVerifyQuote,
+ * so there is no need to extract the chain with sgxAttestationGetQECertificationData first.
+ *
+ * @param quote - Buffer with serialized quote structure.
+ * @param quoteSize - Size of quote buffer. Function heavily relies on this input as internal buffer is allocated based on it without boundaries check! It's user responsibility to provide proper validation.
+ * @param crls - Table with two, null terminated PEM formatted x.509 CRLs. Function will try to access two indexes:
+ *      - crls[0] - PEM or DER(hex encoded) formatted CRL issued by root CA
+ *      - crls[1] - PEM or DER(hex encoded) formatted Intel SGX PCK Processor/Platform CRL
+ * @param pemRootCaCertificate - Null terminated Intel SGX Root CA certificate (x.509, self-signed) in PEM format.
+ * @param tcbInfoJson - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param qeIdentityJson - QE Identity structure in JSON format signed by Intel SGX TCB Signing Certificate. Optional.
+ * @param expirationCheckDate - Time stamp used to verify if the certificates & CRLs have not expired.
+ *        This parameter is optional if the function is executed in SW mode and mandatory if it is executed inside an SGX Enclave.
+ * @return Status code of the operation, one of:
+ *      - STATUS_INVALID_PARAMETER
+ *      - STATUS_UNSUPPORTED_PCK_CERT_FORMAT when quote does not carry PCK certificate chain
+ *      - any status returned by sgxAttestationVerifyPCKCertificate
+ *      - any status returned by sgxAttestationVerifyQuote
+ */
+QVL_API Status sgxAttestationVerifyQuoteWithCertificationData(const uint8_t* quote, uint32_t quoteSize, const char *const crls[],
+                                                              const char *pemRootCaCertificate, const char* tcbInfoJson,
+                                                              const char* qeIdentityJson, const time_t* expirationCheckDate);
+
+/**
+ * Opaque handle of collateral parsed once and shared by many quote verifications: PCK CRL, TCB Info, optional
+ * QE Identity and optional default PCK certificate. The handle is immutable, it can be used from many threads
+ * at the same time.
+ */
+typedef struct _verification_collateral VerificationCollateral;
+
+/**
+ * Parses collateral for sgxAttestationVerifyQuoteWithCollateral. Signatures of the collateral are not verified here,
+ * callers are expected to check them once with sgxAttestationVerifyPCKCertificate, sgxAttestationVerifyTCBInfo
+ * and sgxAttestationVerifyEnclaveIdentity.
+ *
+ * @param pemPckCertificate - Null terminated x.509 PCK Certificate in PEM format used when a verification does not
+ *        provide its own. Optional.
+ * @param intermediateCrl - Null terminated, PEM or DER(hex encoded) formatted x.509 Intel SGX PCK Processor/Platform CRL
+ * @param tcbInfoJson - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param qeIdentityJson - QE Identity structure in JSON format signed by Intel SGX TCB Signing Certificate. Optional.
+ * @param collateral - Out parameter, parsed collateral to be released with sgxAttestationCollateralDestroy.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_UNSUPPORTED_PCK_CERT_FORMAT
+ *      - STATUS_INVALID_PCK_CERT
+ *      - STATUS_UNSUPPORTED_PCK_RL_FORMAT
+ *      - STATUS_UNSUPPORTED_TCB_INFO_FORMAT
+ *      - STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT
+ */
+QVL_API Status sgxAttestationCollateralCreate(const char* pemPckCertificate, const char* intermediateCrl, const char* tcbInfoJson,
+                                              const char* qeIdentityJson, VerificationCollateral** collateral);
+
+/**
+ * Releases collateral created by sgxAttestationCollateralCreate, NULL is ignored.
+ */
+QVL_API void sgxAttestationCollateralDestroy(VerificationCollateral* collateral);
+
+/**
+ * Verifies quote the same way as sgxAttestationVerifyQuote, using collateral parsed beforehand.
+ *
+ * @param quote - Buffer with serialized quote structure.
+ * @param quoteSize - Size of quote buffer.
+ * @param pemPckCertificate - Null terminated x.509 PCK Certificate in PEM format. When NULL the default certificate
+ *        of the collateral is used.
+ * @param collateral - Collateral created with sgxAttestationCollateralCreate.
+ * @return Status code of the operation, one of:
+ *      - STATUS_MISSING_PARAMETERS also when neither pemPckCertificate nor collateral default certificate is present
+ *      - any status returned by sgxAttestationVerifyQuote
+ */
+QVL_API Status sgxAttestationVerifyQuoteWithCollateral(const uint8_t* quote, uint32_t quoteSize, const char* pemPckCertificate,
+                                                       const VerificationCollateral* collateral);
+
+/**
+ * Verifies many quotes against the same collateral and PCK certificate, each the same way as
+ * sgxAttestationVerifyQuoteWithCollateral. PCK certificate is parsed once, and signed data and QE Report data of
+ * all quotes are hashed together, several messages at once when CPU allows.
+ *
+ * @param quotes - Table of quoteCount buffers with serialized quote structures.
+ * @param quoteSizes - Table of quoteCount sizes of quote buffers.
+ * @param quoteCount - Number of quotes.
+ * @param pemPckCertificate - Null terminated x.509 PCK Certificate in PEM format. When NULL the default certificate
+ *        of the collateral is used.
+ * @param collateral - Collateral created with sgxAttestationCollateralCreate.
+ * @param statuses - Out parameter, table of quoteCount statuses, one for every quote as returned by
+ *        sgxAttestationVerifyQuoteWithCollateral. STATUS_MISSING_PARAMETERS for a NULL quote.
+ * @return Status code of the operation, statuses are written only when it is STATUS_OK, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS also when neither pemPckCertificate nor collateral default certificate is present
+ *      - STATUS_UNSUPPORTED_PCK_CERT_FORMAT
+ *      - STATUS_INVALID_PCK_CERT
+ */
+QVL_API Status sgxAttestationVerifyQuoteBatch(const uint8_t* const quotes[], const uint32_t quoteSizes[], uint32_t quoteCount,
+                                              const char* pemPckCertificate, const VerificationCollateral* collateral,
+                                              Status statuses[]);
+
+/**
+ * Opaque handle of coalescing context: concurrent verifications of the same quote, PCK certificate and collateral
+ * made through one context are computed once, duplicates wait for the result of the first one. Results are not
+ * cached beyond that. Every collateral created by sgxAttestationCollateralCreate is a separate snapshot, so requests
+ * made with a reloaded collateral are never coalesced with ones in flight on the previous collateral.
+ * Not available inside SGX Enclave.
+ */
+typedef struct _coalescing_context CoalescingContext;
+
+/**
+ * Counters of coalescing context, coalesced / requests is the deduplication hit rate.
+ */
+typedef struct _coalescing_metrics
+{
+    uint64_t requests;      // verifications requested through the context
+    uint64_t coalesced;     // requests which waited for a concurrent identical one instead of being verified
+    uint32_t inFlight;      // distinct verifications running now
+} CoalescingMetrics;
+
+/**
+ * Creates coalescing context.
+ *
+ * @param ctx - Out parameter, created context.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ */
+QVL_API Status sgxAttestationCoalescingContextCreate(CoalescingContext** ctx);
+
+/**
+ * Destroys coalescing context, no verification may be in flight on it.
+ *
+ * @param ctx - Context created by sgxAttestationCoalescingContextCreate, may be NULL.
+ */
+QVL_API void sgxAttestationCoalescingContextDestroy(CoalescingContext* ctx);
+
+/**
+ * Verifies quote the same way as sgxAttestationVerifyQuoteWithCollateral. When an identical request (same quote bytes,
+ * PCK certificate and collateral) is being verified on the context by another thread, waits for its result instead.
+ *
+ * @param ctx - Coalescing context.
+ * @return Status code of the operation, one of:
+ *      - STATUS_MISSING_PARAMETERS when ctx is NULL
+ *      - any status returned by sgxAttestationVerifyQuoteWithCollateral
+ */
+QVL_API Status sgxAttestationVerifyQuoteCoalesced(CoalescingContext* ctx, const uint8_t* quote, uint32_t quoteSize,
+                                                  const char* pemPckCertificate, const VerificationCollateral* collateral);
+
+/**
+ * Reads counters of coalescing context.
+ *
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ */
+QVL_API Status sgxAttestationCoalescingContextGetMetrics(const CoalescingContext* ctx, CoalescingMetrics* metrics);
+
+/**
+ * Opaque handle of verification result cache: bounded map of (quote, PCK certificate, collateral) to the final status.
+ * Thread safe. Not available inside SGX Enclave.
+ */
+typedef struct _result_cache ResultCache;
+
+/**
+ * Counters of result cache, hits / (hits + misses) is the cache hit rate.
+ */
+typedef struct _result_cache_metrics
+{
+    uint64_t hits;          // requests answered from cache
+    uint64_t misses;        // requests verified, expirations included
+    uint64_t evictions;     // least recently used entries dropped to make room
+    uint64_t expirations;   // entries found expired on lookup
+    uint32_t entries;       // entries held now
+} ResultCacheMetrics;
+
+/**
+ * Creates result cache.
+ *
+ * @param capacity - Maximal number of cached results, 0 disables caching.
+ * @param ttlSeconds - Maximal time result is cached for. Results never outlive the collateral they were verified with,
+ *                     entries also expire at the earliest nextUpdate of CRL, TCB Info and QE Identity or at notAfter
+ *                     of PCK certificate kept in collateral.
+ * @param cache - Out parameter, created cache.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ */
+QVL_API Status sgxAttestationResultCacheCreate(uint32_t capacity, uint32_t ttlSeconds, ResultCache** cache);
+
+/**
+ * Destroys result cache.
+ *
+ * @param cache - Cache created by sgxAttestationResultCacheCreate, may be NULL.
+ */
+QVL_API void sgxAttestationResultCacheDestroy(ResultCache* cache);
+
+/**
+ * Verifies quote the same way as sgxAttestationVerifyQuoteWithCollateral unless the status of identical request
+ * (same quote bytes, PCK certificate and collateral) is cached and not expired yet.
+ *
+ * @param cache - Result cache.
+ * @param expirationDate - Optional. Time to check cache entries against, current time when NULL.
+ * @return Status code of the operation, one of:
+ *      - STATUS_MISSING_PARAMETERS when cache is NULL
+ *      - STATUS_INVALID_PARAMETER when current time can't be read
+ *      - any status returned by sgxAttestationVerifyQuoteWithCollateral
+ */
+QVL_API Status sgxAttestationVerifyQuoteCached(ResultCache* cache, const uint8_t* quote, uint32_t quoteSize,
+                                               const char* pemPckCertificate, const VerificationCollateral* collateral,
+                                               const time_t* expirationDate);
+
+/**
+ * Reads counters of result cache.
+ *
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ */
+QVL_API Status sgxAttestationResultCacheGetMetrics(const ResultCache* cache, ResultCacheMetrics* metrics);
+
+/**
+ * Opaque handle of asynchronous verification context: library owned worker threads with bounded number of requests
+ * in flight and a queue of completed ones. Not available inside SGX Enclave.
+ *
+ * Verification runs as a pipeline of stages, each with its own queue and worker threads:
+ *  - parsing of quote, CRL, TCB Info, QE Identity and PCK certificate
+ *  - checks of PCK certificate and CRL against each other and against TCB Info
+ *  - ECDSA signature verification of QE Report and Quote
+ *  - QE Identity and TCB level evaluation
+ * A request failing a stage completes without entering the following ones.
+ */
+typedef struct _async_verification_context AsyncVerificationContext;
+
+/**
+ * Input of sgxAttestationVerifyQuoteAsync, fields have the same meaning as sgxAttestationVerifyQuote parameters.
+ * All buffers are copied before sgxAttestationVerifyQuoteAsync returns.
+ */
+typedef struct _verify_quote_input
+{
+    const uint8_t* quote;
+    uint32_t quoteSize;
+    const char* pemPckCertificate;
+    const char* intermediateCrl;
+    const char* tcbInfoJson;
+    const char* qeIdentityJson;
+} VerifyQuoteInput;
+
+/**
+ * Stages of asynchronous verification, see AsyncVerificationContext.
+ */
+typedef enum _async_stage
+{
+    ASYNC_STAGE_PARSE = 0,
+    ASYNC_STAGE_COLLATERAL,
+    ASYNC_STAGE_SIGNATURE,
+    ASYNC_STAGE_EVALUATION
+} AsyncStage;
+
+/**
+ * Bind every worker thread to a single CPU (Linux only). Workers are spread across NUMA nodes in turn and idle ones
+ * steal work from workers of their own node first.
+ */
+#define ASYNC_PIPELINE_PIN_WORKERS 0x1u
+
+/**
+ * Keep precomputed multiples of P-256 public keys after 16 of their signatures verified successfully in the context,
+ * so their later signatures verify faster. Keys with invalid signatures are never counted. Tables of at most 32 keys
+ * (about 88 KB each) are kept, the least recently used key is evicted first.
+ */
+#define ASYNC_PIPELINE_P256_KEY_TABLES 0x2u
+
+/**
+ * Worker threads of each stage (0 selects number of hardware threads), limit of accepted, not completed requests
+ * and ASYNC_PIPELINE_* flags.
+ */
+typedef struct _async_pipeline_config
+{
+    uint32_t parseWorkers;
+    uint32_t collateralWorkers;
+    uint32_t signatureWorkers;
+    uint32_t evaluationWorkers;
+    uint32_t maxInFlight;
+    uint32_t flags;
+} AsyncPipelineConfig;
+
+/**
+ * Counters of a single stage.
+ */
+typedef struct _async_stage_metrics
+{
+    uint32_t queueDepth;        // requests waiting for a worker of the stage now
+    uint32_t peakQueueDepth;    // highest queueDepth observed
+    uint64_t processed;         // requests the stage has finished working on
+    uint64_t earlyExits;        // requests rejected by the stage, they did not enter following stages
+} AsyncStageMetrics;
+
+/**
+ * Result of asynchronous verification delivered through the completion queue.
+ */
+typedef struct _async_completion
+{
+    Status status;
+    void* userData;
+} AsyncCompletion;
+
+/**
+ * Completion callback, called on one of the context worker threads. It must not destroy the context.
+ */
+typedef void (*VerifyQuoteCallback)(Status status, void* userData);
+
+/**
+ * Creates asynchronous verification context.
+ *
+ * @param workerCount - Number of signature verification threads, 0 selects number of hardware threads.
+ *                      Remaining stages get a quarter of it, at least one thread each.
+ * @param queueDepth - Maximum number of accepted, not completed requests on top of workerCount, must be greater than 0.
+ * @param ctx - Out parameter, created context.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_INVALID_PARAMETER
+ */
+QVL_API Status sgxAttestationAsyncContextCreate(uint32_t workerCount, uint32_t queueDepth, AsyncVerificationContext** ctx);
+
+/**
+ * Creates asynchronous verification context with explicit stage configuration.
+ *
+ * @param config - Worker threads of each stage and limit of requests in flight, which must be greater than 0.
+ * @param ctx - Out parameter, created context.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_INVALID_PARAMETER
+ */
+QVL_API Status sgxAttestationAsyncContextCreateWithConfig(const AsyncPipelineConfig* config, AsyncVerificationContext** ctx);
+
+/**
+ * Destroys asynchronous verification context. Requests already accepted are verified and their callbacks called
+ * before this function returns, results not yet taken from the completion queue are dropped.
+ *
+ * @param ctx - Context created by sgxAttestationAsyncContextCreate, may be NULL.
+ */
+QVL_API void sgxAttestationAsyncContextDestroy(AsyncVerificationContext* ctx);
+
+/**
+ * Schedules sgxAttestationVerifyQuote on the context worker pool and returns without waiting for the result.
+ *
+ * @param ctx - Asynchronous verification context.
+ * @param input - Quote and collateral to verify, copied by this function.
+ * @param callback - Called with the result on a worker thread. When NULL, the result together with userData is
+ *                   pushed to the context completion queue, see sgxAttestationAsyncPollCompletions.
+ * @param userData - Passed unchanged to the callback or completion.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK when request was accepted, the verification result is delivered asynchronously
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_BUSY when the limit of requests in flight is reached, nothing was scheduled
+ */
+QVL_API Status sgxAttestationVerifyQuoteAsync(AsyncVerificationContext* ctx, const VerifyQuoteInput* input,
+                                              VerifyQuoteCallback callback, void* userData);
+
+/**
+ * Takes completed results from the context completion queue without blocking.
+ *
+ * @param ctx - Asynchronous verification context.
+ * @param completions - Buffer for at least maxCompletions results.
+ * @param maxCompletions - Size of the completions buffer.
+ * @param completionsCount - Out parameter, number of results written, 0 when nothing has completed.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ */
+QVL_API Status sgxAttestationAsyncPollCompletions(AsyncVerificationContext* ctx, AsyncCompletion* completions,
+                                                  uint32_t maxCompletions, uint32_t* completionsCount);
+
+/**
+ * Reads counters of a verification stage, they can be sampled at any time from any thread.
+ *
+ * @param ctx - Asynchronous verification context.
+ * @param stage - Stage to read.
+ * @param metrics - Out parameter.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_INVALID_PARAMETER for unknown stage
+ */
+QVL_API Status sgxAttestationAsyncGetStageMetrics(const AsyncVerificationContext* ctx, AsyncStage stage, AsyncStageMetrics* metrics);
+
+/**
+ * Returns file descriptor which is readable while the completion queue is not empty, so it can be registered
+ * in epoll/poll based event loop. The descriptor is owned by the context and must not be read nor closed.
+ *
+ * @param ctx - Asynchronous verification context.
+ * @return File descriptor, -1 when ctx is NULL or the platform does not support it (results still can be polled).
+ */
+QVL_API int sgxAttestationAsyncGetCompletionFd(const AsyncVerificationContext* ctx);
+
 /**
  *
  * @param enclaveReport - Buffer with serialized Enclave Report  structure.
@@ -236,6 +632,20 @@ QVL_API Status sgxAttestationVerifyEnclaveReport(const uint8_t* enclaveReport, c
  */
 QVL_API const char* sgxAttestationGetVersion(void);
 
+/**
+ * Selects OpenSSL library context verification fetches its algorithm implementations from. SHA-256 and P-256 key
+ * management are fetched once and shared by all verification threads, by default from the default library context.
+ * Verifications started after the call use the new implementations, the replaced ones are freed when verifications
+ * in flight complete. A context may be freed after another one (e.g. NULL) is selected and those verifications returned.
+ *
+ * @param libCtx - OpenSSL OSSL_LIB_CTX, not owned and must outlive verifications using it. NULL is the default library context.
+ * @param propertyQuery - Optional. Property query used for fetching, "fips=yes" when NULL and FIPS provider is available.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_INVALID_PARAMETER when SHA-256 or P-256 can't be fetched, algorithms in use are kept then
+ */
+QVL_API Status sgxAttestationSetCryptoContext(struct ossl_lib_ctx_st* libCtx, const char* propertyQuery);
+
 /**
  * This function returns version information (Supported by SGX Enclave)
  * @param [OUT] version - Provided buffer that output will be copied to.
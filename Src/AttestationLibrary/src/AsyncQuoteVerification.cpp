@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#ifndef SGX_TRUSTED
+
+#include "OpensslHelpers/PrecomputedP256Backend.h"
+#include "Pipeline/VerificationPipeline.h"
+
+#include <Utils/Logger.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+class CompletionQueue
+{
+public:
+    CompletionQueue()
+    {
+#ifdef __linux__
+        _fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+    }
+
+    ~CompletionQueue()
+    {
+#ifdef __linux__
+        if (_fd != -1)
+        {
+            close(_fd);
+        }
+#endif
+    }
+
+    CompletionQueue(const CompletionQueue&) = delete;
+    CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+    void push(const AsyncCompletion& completion)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _completions.push_back(completion);
+        signal(true);
+    }
+
+    uint32_t pop(AsyncCompletion* completions, uint32_t maxCompletions)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto count = static_cast<uint32_t>(std::min<size_t>(maxCompletions, _completions.size()));
+        std::copy_n(_completions.begin(), count, completions);
+        _completions.erase(_completions.begin(), std::next(_completions.begin(), count));
+        if (_completions.empty())
+        {
+            signal(false);
+        }
+        return count;
+    }
+
+    int getFd() const
+    {
+        return _fd;
+    }
+
+private:
+    // Keeps the descriptor readable exactly while there are completions, called under _mutex
+    void signal(bool readable)
+    {
+#ifdef __linux__
+        if (_fd == -1)
+        {
+            return;
+        }
+        eventfd_t value = 0;
+        if (readable)
+        {
+            eventfd_write(_fd, 1);
+        }
+        else
+        {
+            eventfd_read(_fd, &value);
+        }
+#else
+        (void) readable;
+#endif
+    }
+
+    int _fd = -1;
+    std::mutex _mutex;
+    std::deque<AsyncCompletion> _completions;
+};
+
+} // anonymous namespace
+
+namespace {
+
+// a table costs about as much as 16 verifications, keys of a platform repeat across its quotes
+constexpr uint32_t HOT_P256_KEY_THRESHOLD = 16;
+constexpr size_t MAX_P256_KEY_TABLES = 32;
+
+VerificationPipeline::Config withCryptoBackend(VerificationPipeline::Config config, const crypto::CryptoBackend* backend)
+{
+    config.cryptoBackend = backend;
+    return config;
+}
+
+} // anonymous namespace
+
+struct _async_verification_context
+{
+    _async_verification_context(const VerificationPipeline::Config& config, bool withP256KeyTables):
+        p256KeyTables(withP256KeyTables
+                      ? std::make_unique<crypto::PrecomputedP256Backend>(HOT_P256_KEY_THRESHOLD, MAX_P256_KEY_TABLES)
+                      : nullptr),
+        pipeline(withCryptoBackend(config, p256KeyTables.get()))
+    {}
+
+    // destroyed after the pipeline, workers push completions until they are joined
+    CompletionQueue completions;
+    std::unique_ptr<crypto::PrecomputedP256Backend> p256KeyTables;
+    VerificationPipeline pipeline;
+};
+
+Status sgxAttestationAsyncContextCreate(uint32_t workerCount, uint32_t queueDepth, AsyncVerificationContext** ctx)
+{
+    if (ctx == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    if (queueDepth == 0)
+    {
+        LOG_ERROR("Asynchronous verification queue depth must be greater than 0");
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    // signature verification dominates, the remaining stages get a quarter of the threads
+    const uint32_t workers = workerCount != 0 ? workerCount : std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t lightWorkers = std::max(1u, workers / 4);
+    const AsyncPipelineConfig config{lightWorkers, lightWorkers, workers, lightWorkers, queueDepth + workers, 0};
+    return sgxAttestationAsyncContextCreateWithConfig(&config, ctx);
+}
+
+Status sgxAttestationAsyncContextCreateWithConfig(const AsyncPipelineConfig* config, AsyncVerificationContext** ctx)
+{
+    if (config == nullptr || ctx == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    if (config->maxInFlight == 0)
+    {
+        LOG_ERROR("Asynchronous verification in flight limit must be greater than 0");
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    const VerificationPipeline::Config pipelineConfig{
+        {config->parseWorkers, config->collateralWorkers, config->signatureWorkers, config->evaluationWorkers},
+        config->maxInFlight,
+        (config->flags & ASYNC_PIPELINE_PIN_WORKERS) != 0
+    };
+    *ctx = new AsyncVerificationContext(pipelineConfig, (config->flags & ASYNC_PIPELINE_P256_KEY_TABLES) != 0);
+    return STATUS_OK;
+}
+
+void sgxAttestationAsyncContextDestroy(AsyncVerificationContext* ctx)
+{
+    delete ctx;
+}
+
+Status sgxAttestationVerifyQuoteAsync(AsyncVerificationContext* ctx, const VerifyQuoteInput* input,
+                                      VerifyQuoteCallback callback, void* userData)
+{
+    if (ctx == nullptr || input == nullptr ||
+        !input->quote || !input->pemPckCertificate || !input->intermediateCrl || !input->tcbInfoJson)
+    {
+        LOG_ERROR("ctx, input, quote, pemPckCertificate, intermediateCrl or tcbInfoJson was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    auto request = std::make_shared<const VerifyQuoteRequest>(*input);
+    auto& completions = ctx->completions;
+    const bool accepted = ctx->pipeline.trySubmit(std::move(request), [callback, userData, &completions](Status status) {
+        if (callback != nullptr)
+        {
+            callback(status, userData);
+        }
+        else
+        {
+            completions.push(AsyncCompletion{status, userData});
+        }
+    });
+
+    if (!accepted)
+    {
+        LOG_ERROR("Asynchronous verification limit of requests in flight reached");
+        return STATUS_BUSY;
+    }
+    return STATUS_OK;
+}
+
+Status sgxAttestationAsyncPollCompletions(AsyncVerificationContext* ctx, AsyncCompletion* completions,
+                                          uint32_t maxCompletions, uint32_t* completionsCount)
+{
+    if (ctx == nullptr || completionsCount == nullptr || (completions == nullptr && maxCompletions != 0))
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    *completionsCount = ctx->completions.pop(completions, maxCompletions);
+    return STATUS_OK;
+}
+
+Status sgxAttestationAsyncGetStageMetrics(const AsyncVerificationContext* ctx, AsyncStage stage, AsyncStageMetrics* metrics)
+{
+    if (ctx == nullptr || metrics == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    if (stage < ASYNC_STAGE_PARSE || stage > ASYNC_STAGE_EVALUATION)
+    {
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    const auto stageMetrics = ctx->pipeline.getMetrics(static_cast<VerificationPipeline::Stage>(stage));
+    metrics->queueDepth = static_cast<uint32_t>(stageMetrics.queueDepth);
+    metrics->peakQueueDepth = static_cast<uint32_t>(stageMetrics.peakQueueDepth);
+    metrics->processed = stageMetrics.processed;
+    metrics->earlyExits = stageMetrics.earlyExits;
+    return STATUS_OK;
+}
+
+int sgxAttestationAsyncGetCompletionFd(const AsyncVerificationContext* ctx)
+{
+    return ctx == nullptr ? -1 : ctx->completions.getFd();
+}
+
+#endif // SGX_TRUSTED
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#ifndef SGX_TRUSTED
+
+#include "Utils/StatusCache.h"
+#include "Utils/TimeUtils.h"
+#include "Verifiers/QuoteCollateral.h"
+
+#include <Utils/Logger.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace intel::sgx::dcap;
+
+struct _result_cache
+{
+    _result_cache(uint32_t capacity, uint32_t ttlSeconds): results(capacity), ttl(ttlSeconds)
+    {}
+
+    StatusCache results;
+    const std::time_t ttl;
+};
+
+Status sgxAttestationResultCacheCreate(uint32_t capacity, uint32_t ttlSeconds, ResultCache** cache)
+{
+    if (cache == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    *cache = new ResultCache(capacity, ttlSeconds);
+    return STATUS_OK;
+}
+
+void sgxAttestationResultCacheDestroy(ResultCache* cache)
+{
+    delete cache;
+}
+
+Status sgxAttestationVerifyQuoteCached(ResultCache* cache, const uint8_t* quote, uint32_t quoteSize,
+                                       const char* pemPckCertificate, const VerificationCollateral* collateral,
+                                       const time_t* expirationDate)
+{
+    if (cache == nullptr || !quote || !collateral)
+    {
+        LOG_ERROR("cache, quote or collateral was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    time_t currentTime;
+    try
+    {
+        currentTime = getCurrentTime(expirationDate);
+    }
+    catch (const std::runtime_error&)
+    {
+        LOG_ERROR("Can't get current time or it was not provided");
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    DigestKey key{};
+    if (!getVerificationRequestKey(quote, quoteSize, pemPckCertificate, *collateral, key))
+    {
+        LOG_ERROR("Digest of cached request failed, verifying without cache");
+        return sgxAttestationVerifyQuoteWithCollateral(quote, quoteSize, pemPckCertificate, collateral);
+    }
+
+    auto status = STATUS_OK;
+    if (cache->results.find(key, currentTime, status))
+    {
+        return status;
+    }
+
+    status = sgxAttestationVerifyQuoteWithCollateral(quote, quoteSize, pemPckCertificate, collateral);
+    cache->results.insert(key, status, std::min(currentTime + cache->ttl, getExpirationTime(*collateral)));
+    return status;
+}
+
+Status sgxAttestationResultCacheGetMetrics(const ResultCache* cache, ResultCacheMetrics* metrics)
+{
+    if (cache == nullptr || metrics == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    const auto counters = cache->results.getMetrics();
+    *metrics = ResultCacheMetrics{counters.hits, counters.misses, counters.evictions, counters.expirations, counters.entries};
+    return STATUS_OK;
+}
+
+#endif // SGX_TRUSTED
@@ -39,22 +39,25 @@
 namespace intel { namespace sgx { namespace dcap {
 
 
-Status CertificateChain::parse(const std::string& pemCertChain)
+Status CertificateChain::parse(std::string_view pemCertChain)
 {
     const auto certStrs = splitChain(pemCertChain);
 
     certs.reserve(certStrs.size());
+    names.reserve(certStrs.size());
     for(const auto& certPem : certStrs)
     {
         try {
             auto cert = std::make_shared<dcap::parser::x509::Certificate>(dcap::parser::x509::Certificate::parse(certPem));
+            CertNames certNames{InternedName(cert->getSubject()), InternedName(cert->getIssuer())};
 
-            if (cert->getSubject() == cert->getIssuer())
+            if (certNames.subject == certNames.issuer)
             {
                 rootCert = cert;
             }
 
             certs.emplace_back(cert);
+            names.push_back(certNames);
         }
         // any cert in chain has wrong format
         // then whole chain should be considered invalid
@@ -93,14 +96,16 @@ Status CertificateChain::parse(const std::string& pemCertChain)
         }
     }
 
-    for(auto const &cert: certs)
+    for(size_t i = 0; i < certs.size(); ++i)
     {
-        auto signedCertIter = std::find_if(certs.cbegin(), certs.cend(), [cert](const std::shared_ptr<const dcap::parser::x509::Certificate> &found)
+        const auto& cert = certs[i];
+        const auto& subject = names[i].subject;
+        auto signedCertIter = std::find_if(names.cbegin(), names.cend(), [&subject](const CertNames &found)
         {
-            return found->getSubject() != cert->getSubject()
-                   && found->getIssuer() == cert->getSubject();
+            return found.subject != subject
+                   && found.issuer == subject;
         });
-        if(signedCertIter == certs.cend())
+        if(signedCertIter == names.cend())
         {
             topmostCert = cert;
         }
@@ -139,29 +144,28 @@ size_t CertificateChain::length() const
 
 std::shared_ptr<const dcap::parser::x509::Certificate> CertificateChain::get(const dcap::parser::x509::DistinguishedName &subject) const
 {
-    auto it = std::find_if(certs.cbegin(), certs.cend(), [&subject](const std::shared_ptr<const dcap::parser::x509::Certificate> &cert)
+    const InternedName wanted(subject);
+    auto it = std::find_if(names.cbegin(), names.cend(), [&wanted](const CertNames &found)
     {
-        return cert->getSubject() == subject;
+        return found.subject == wanted;
     });
-    if(it == certs.end())
+    if(it == names.end())
     {
         return nullptr;
     }
-    return *it;
+    return certs[static_cast<size_t>(it - names.cbegin())];
 }
 
 std::shared_ptr<const dcap::parser::x509::Certificate> CertificateChain::getIntermediateCert() const
 {
-    auto verifier = _baseVerifier;
-    auto it = std::find_if(certs.cbegin(), certs.cend(), [&verifier](const std::shared_ptr<const dcap::parser::x509::Certificate> &cert)
+    for(size_t i = 0; i < certs.size(); ++i)
     {
-        return cert->getSubject() != cert->getIssuer() && verifier.commonNameContains(cert->getSubject(), constants::SGX_INTERMEDIATE_CN_PHRASE);
-    });
-    if(it == certs.end())
-    {
-        return nullptr;
+        if(names[i].subject != names[i].issuer && _baseVerifier.commonNameContains(certs[i]->getSubject(), constants::SGX_INTERMEDIATE_CN_PHRASE))
+        {
+            return certs[i];
+        }
     }
-    return *it;
+    return nullptr;
 }
 
 std::shared_ptr<const dcap::parser::x509::Certificate> CertificateChain::getRootCert() const
@@ -184,28 +188,29 @@ std::vector<std::shared_ptr<const dcap::parser::x509::Certificate>> CertificateC
     return certs;
 }
 
-std::vector<std::string> CertificateChain::splitChain(const std::string &pemChain) const
+std::vector<std::string_view> CertificateChain::splitChain(std::string_view pemChain) const
 {
     if(pemChain.empty())
     {
         return {};
     }
 
-    const std::string begCert = "-----BEGIN CERTIFICATE-----";
-    const std::string endCert = "-----END CERTIFICATE-----";
+    constexpr std::string_view begCert = "-----BEGIN CERTIFICATE-----";
+    constexpr std::string_view endCert = "-----END CERTIFICATE-----";
 
     const size_t begPos = pemChain.find(begCert);
     const size_t endPos = pemChain.find(endCert);
 
-    if(begPos == std::string::npos || endPos == std::string::npos || begPos >= endPos)
+    if(begPos == std::string_view::npos || endPos == std::string_view::npos || begPos >= endPos)
     {
         return {};
     }
 
-    std::vector<std::string> ret;
+    // returned views point into pemChain, no certificate text is copied here
+    std::vector<std::string_view> ret;
     size_t newStartPos = begPos;
     size_t foundEndPos = endPos;
-    while(foundEndPos != std::string::npos)
+    while(foundEndPos != std::string_view::npos)
     {
         // second loop to be evenatually run in second and
         // further iteration
@@ -215,11 +220,11 @@ std::vector<std::string> CertificateChain::splitChain(const std::string &pemChai
         while(pemChain.at(newStartPos) != '-') ++newStartPos;
 
         const size_t newEndPos = foundEndPos + endCert.size();
-        const std::string cert = pemChain.substr(newStartPos, newEndPos - newStartPos);
+        const std::string_view cert = pemChain.substr(newStartPos, newEndPos - newStartPos);
 
         // we do not check for this in second and further iteration
         // and it's cheaper to check on shorter string
-        if(cert.find(begCert) != std::string::npos)
+        if(cert.find(begCert) != std::string_view::npos)
         {
             ret.push_back(cert);
         }
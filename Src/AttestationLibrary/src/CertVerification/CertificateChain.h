@@ -33,8 +33,10 @@
 #define SGX_ECDSA_CERTIFICATECHAIN_H_
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <CertVerification/InternedName.h>
 #include <PckParser/PckParser.h>
 #include <Verifiers/BaseVerifier.h>
 #include <SgxEcdsaAttestation/AttestationParsers.h>
@@ -59,10 +61,10 @@ public:
     * Parse certificate chain.
     * Check if there is at least one valid x.509 certificate in the chain.
     *
-    * @param pemCertChain - string of concatenated PEM certificates
+    * @param pemCertChain - string of concatenated PEM certificates, only has to outlive this call
     * @return true if chain has been successfully parsed
     */
-    virtual Status parse(const std::string& pemCertChain);
+    virtual Status parse(std::string_view pemCertChain);
 
     /**
     * Get length of the parsed chain
@@ -116,8 +118,16 @@ public:
 private:
     BaseVerifier _baseVerifier{};
 
-    std::vector<std::string> splitChain(const std::string &pemChain) const;
+    // interned once per certificate, chain lookups compare them by identity
+    struct CertNames
+    {
+        InternedName subject;
+        InternedName issuer;
+    };
+
+    std::vector<std::string_view> splitChain(std::string_view pemChain) const;
     std::vector<std::shared_ptr<const dcap::parser::x509::Certificate>> certs{};
+    std::vector<CertNames> names{}; // same order as certs
     std::shared_ptr<const dcap::parser::x509::Certificate> rootCert{};
     std::shared_ptr<const dcap::parser::x509::Certificate> topmostCert{};
     std::shared_ptr<const dcap::parser::x509::PckCertificate> pckCert{};
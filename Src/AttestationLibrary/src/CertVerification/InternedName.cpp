@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "InternedName.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
+namespace intel { namespace sgx { namespace dcap {
+
+struct InternedName::Components
+{
+    std::string commonName;
+    std::string countryName;
+    std::string organizationName;
+    std::string locationName;
+    std::string stateName;
+    size_t hash;
+};
+
+namespace {
+
+/*
+ * Table of shared immutable values split into shards by hash, so concurrent verifications only
+ * contend when they look up names falling into the same shard. Entries are held weakly and a shard
+ * sweeps its expired slots whenever it doubles.
+ */
+template<typename T>
+class InternTable
+{
+public:
+    template<typename Equal, typename Make>
+    std::shared_ptr<const T> intern(size_t hash, Equal equal, Make make)
+    {
+        auto& shard = _shards[hash % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto range = shard.entries.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto existing = it->second.lock();
+            if (existing && equal(*existing))
+            {
+                return existing;
+            }
+        }
+        std::shared_ptr<const T> created = make();
+        shard.entries.emplace(hash, created);
+
+        if (shard.entries.size() >= shard.sweepThreshold)
+        {
+            shard.sweep();
+        }
+        return created;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t MIN_SWEEP_THRESHOLD = 16;
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::unordered_multimap<size_t, std::weak_ptr<const T>> entries;
+        size_t sweepThreshold = MIN_SWEEP_THRESHOLD;
+
+        void sweep()
+        {
+            for (auto it = entries.begin(); it != entries.end();)
+            {
+                it = it->second.expired() ? entries.erase(it) : std::next(it);
+            }
+            sweepThreshold = std::max(MIN_SWEEP_THRESHOLD, 2 * entries.size());
+        }
+    };
+
+    std::array<Shard, SHARD_COUNT> _shards;
+};
+
+// Function local statics so names can be interned from globals of other translation units
+InternTable<std::string>& rawTable()
+{
+    static InternTable<std::string> table;
+    return table;
+}
+
+// templated as Components is private to InternedName
+template<typename T>
+InternTable<T>& componentsTable()
+{
+    static InternTable<T> table;
+    return table;
+}
+
+void combineHash(size_t& seed, const std::string& value)
+{
+    seed ^= std::hash<std::string>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+} // anonymous namespace
+
+InternedName::InternedName(): InternedName(dcap::parser::x509::DistinguishedName{})
+{}
+
+InternedName::InternedName(const dcap::parser::x509::DistinguishedName& name)
+{
+    const auto& raw = name.getRaw();
+    _raw = rawTable().intern(std::hash<std::string>{}(raw),
+                             [&raw](const std::string& existing) { return existing == raw; },
+                             [&raw] { return std::make_shared<const std::string>(raw); });
+
+    // hashed field by field, so ("ab", "c") and ("a", "bc") land in different entries
+    size_t hash = 0;
+    combineHash(hash, name.getCommonName());
+    combineHash(hash, name.getCountryName());
+    combineHash(hash, name.getOrganizationName());
+    combineHash(hash, name.getLocationName());
+    combineHash(hash, name.getStateName());
+
+    _components = componentsTable<Components>().intern(hash,
+        [&name](const Components& existing) {
+            return existing.commonName == name.getCommonName() &&
+                   existing.countryName == name.getCountryName() &&
+                   existing.organizationName == name.getOrganizationName() &&
+                   existing.locationName == name.getLocationName() &&
+                   existing.stateName == name.getStateName();
+        },
+        [&name, hash] {
+            return std::make_shared<const Components>(Components{name.getCommonName(), name.getCountryName(),
+                                                                 name.getOrganizationName(), name.getLocationName(),
+                                                                 name.getStateName(), hash});
+        });
+}
+
+bool InternedName::operator==(const InternedName& other) const
+{
+    return _components == other._components;
+}
+
+bool InternedName::operator!=(const InternedName& other) const
+{
+    return !(*this == other);
+}
+
+bool InternedName::hasSameRaw(const InternedName& other) const
+{
+    return _raw == other._raw;
+}
+
+const std::string& InternedName::getRaw() const
+{
+    return *_raw;
+}
+
+size_t InternedName::getHash() const
+{
+    return _components->hash;
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
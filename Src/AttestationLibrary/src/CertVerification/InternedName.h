@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_ECDSA_INTERNEDNAME_H_
+#define SGX_ECDSA_INTERNEDNAME_H_
+
+#include <SgxEcdsaAttestation/AttestationParsers.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Handle to a process-wide interned copy of a distinguished name, used where names are compared
+ * repeatedly (chain building, CRL issuer checks). Equal components share one entry and equal raw
+ * forms share another, so both comparisons are pointer compares. Public parser types are not changed.
+ */
+class InternedName
+{
+public:
+    InternedName();
+    explicit InternedName(const dcap::parser::x509::DistinguishedName& name);
+
+    // no move operations, a moved-from handle keeps pointing at its entries
+    InternedName(const InternedName&) = default;
+    InternedName& operator=(const InternedName&) = default;
+
+    /**
+     * Compares name components only, raw form is not compared as order may differ
+     */
+    bool operator==(const InternedName& other) const;
+    bool operator!=(const InternedName& other) const;
+
+    bool hasSameRaw(const InternedName& other) const;
+    const std::string& getRaw() const;
+    size_t getHash() const;
+
+private:
+    struct Components;
+
+    std::shared_ptr<const std::string> _raw;
+    std::shared_ptr<const Components> _components;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_ECDSA_INTERNEDNAME_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#ifndef SGX_TRUSTED
+
+#include "Utils/SingleFlight.h"
+#include "Verifiers/QuoteCollateral.h"
+
+#include <Utils/Logger.h>
+
+using namespace intel::sgx::dcap;
+
+struct _coalescing_context
+{
+    SingleFlight flights;
+};
+
+Status sgxAttestationCoalescingContextCreate(CoalescingContext** ctx)
+{
+    if (ctx == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    *ctx = new CoalescingContext();
+    return STATUS_OK;
+}
+
+void sgxAttestationCoalescingContextDestroy(CoalescingContext* ctx)
+{
+    delete ctx;
+}
+
+Status sgxAttestationVerifyQuoteCoalesced(CoalescingContext* ctx, const uint8_t* quote, uint32_t quoteSize,
+                                          const char* pemPckCertificate, const VerificationCollateral* collateral)
+{
+    if (ctx == nullptr || !quote || !collateral)
+    {
+        LOG_ERROR("ctx, quote or collateral was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    const auto verify = [&] {
+        return sgxAttestationVerifyQuoteWithCollateral(quote, quoteSize, pemPckCertificate, collateral);
+    };
+    SingleFlight::Key key{};
+    if (!getVerificationRequestKey(quote, quoteSize, pemPckCertificate, *collateral, key))
+    {
+        LOG_ERROR("Digest of coalesced request failed, verifying without coalescing");
+        return verify();
+    }
+    return ctx->flights.run(key, verify);
+}
+
+Status sgxAttestationCoalescingContextGetMetrics(const CoalescingContext* ctx, CoalescingMetrics* metrics)
+{
+    if (ctx == nullptr || metrics == nullptr)
+    {
+        return STATUS_MISSING_PARAMETERS;
+    }
+    const auto counters = ctx->flights.getMetrics();
+    *metrics = CoalescingMetrics{counters.requests, counters.coalesced, counters.inFlight};
+    return STATUS_OK;
+}
+
+#endif // SGX_TRUSTED
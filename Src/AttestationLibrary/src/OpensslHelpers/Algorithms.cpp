@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "Algorithms.h"
+
+#include <openssl/provider.h>
+
+#include <memory>
+#include <mutex>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+namespace {
+
+const char* FIPS_PROVIDER_NAME = "fips";
+const char* FIPS_PROPERTY_QUERY = "fips=yes";
+
+EVP_PKEY_uptr generateP256Parameters(OSSL_LIB_CTX* libCtx, const char* propertyQuery)
+{
+    auto parameters = crypto::make_unique<EVP_PKEY>(nullptr);
+    auto paramBld = crypto::make_unique<OSSL_PARAM_BLD>(OSSL_PARAM_BLD_new());
+    if (paramBld == nullptr
+        || OSSL_PARAM_BLD_push_utf8_string(paramBld.get(), "group", SN_X9_62_prime256v1, 0) != 1)
+    {
+        return parameters;
+    }
+    auto params = crypto::make_unique<OSSL_PARAM>(OSSL_PARAM_BLD_to_param(paramBld.get()));
+    auto ctx = crypto::make_unique<EVP_PKEY_CTX>(EVP_PKEY_CTX_new_from_name(libCtx, "EC", propertyQuery));
+    EVP_PKEY* raw = nullptr;
+    if (ctx != nullptr
+        && params != nullptr
+        && EVP_PKEY_fromdata_init(ctx.get()) > 0
+        && EVP_PKEY_fromdata(ctx.get(), &raw, OSSL_KEYMGMT_SELECT_DOMAIN_PARAMETERS, params.get()) > 0)
+    {
+        parameters.reset(raw);
+    }
+    return parameters;
+}
+
+// replaced algorithms are freed once the last verification holding a snapshot of them drops it
+std::mutex algorithmsMutex;
+std::shared_ptr<const Algorithms> currentAlgorithms;
+
+} // anonymous namespace
+
+Algorithms::Algorithms(OSSL_LIB_CTX* libCtx, const char* propertyQuery):
+    _libCtx(libCtx),
+    _propertyQuery(propertyQuery != nullptr ? propertyQuery : ""),
+    _hasPropertyQuery(propertyQuery != nullptr),
+    _sha256(crypto::make_unique<EVP_MD>(nullptr)),
+    _p256Parameters(crypto::make_unique<EVP_PKEY>(nullptr))
+{
+    if (!_hasPropertyQuery && OSSL_PROVIDER_available(libCtx, FIPS_PROVIDER_NAME))
+    {
+        _propertyQuery = FIPS_PROPERTY_QUERY;
+        _hasPropertyQuery = true;
+    }
+    _sha256.reset(EVP_MD_fetch(_libCtx, "SHA256", getPropertyQuery()));
+    _p256Parameters = generateP256Parameters(_libCtx, getPropertyQuery());
+}
+
+bool Algorithms::isValid() const
+{
+    return _sha256 != nullptr && _p256Parameters != nullptr;
+}
+
+OSSL_LIB_CTX* Algorithms::getLibraryContext() const
+{
+    return _libCtx;
+}
+
+const char* Algorithms::getPropertyQuery() const
+{
+    return _hasPropertyQuery ? _propertyQuery.c_str() : nullptr;
+}
+
+const EVP_MD* Algorithms::getSha256() const
+{
+    return _sha256.get();
+}
+
+const EVP_PKEY* Algorithms::getP256Parameters() const
+{
+    return _p256Parameters.get();
+}
+
+std::shared_ptr<const Algorithms> getAlgorithms()
+{
+    std::lock_guard<std::mutex> lock(algorithmsMutex);
+    if (currentAlgorithms == nullptr)
+    {
+        currentAlgorithms = std::make_shared<const Algorithms>(nullptr, nullptr);
+    }
+    return currentAlgorithms;
+}
+
+bool setAlgorithmsContext(OSSL_LIB_CTX* libCtx, const char* propertyQuery)
+{
+    auto algorithms = std::make_shared<const Algorithms>(libCtx, propertyQuery);
+    if (!algorithms->isValid())
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(algorithmsMutex);
+        currentAlgorithms.swap(algorithms);
+    }
+    // previous algorithms are released outside of the lock, freed here unless a verification still holds them
+    return true;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_ALGORITHMS_H_
+#define INTEL_SGX_QVL_ALGORITHMS_H_
+
+#include "OpensslHelpers/OpensslTypes.h"
+
+#include <memory>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+/**
+ * Algorithm implementations fetched once from OpenSSL library context and shared by all verification threads,
+ * so verification does not take provider and name map locks of implicit fetches.
+ */
+class Algorithms
+{
+public:
+    /**
+     * @param libCtx - Not owned, NULL is the default library context.
+     * @param propertyQuery - Properties implementations are fetched with. When NULL and FIPS provider is available
+     *                        in libCtx, "fips=yes" is used.
+     */
+    Algorithms(OSSL_LIB_CTX* libCtx, const char* propertyQuery);
+
+    bool isValid() const;
+
+    OSSL_LIB_CTX* getLibraryContext() const;
+    const char* getPropertyQuery() const;
+    /**
+     * @return NULL when not valid
+     */
+    const EVP_MD* getSha256() const;
+
+    /**
+     * @return P-256 key without public point or NULL when not valid, EVP_PKEY_dup it to get a key of the same implementation
+     */
+    const EVP_PKEY* getP256Parameters() const;
+
+private:
+    OSSL_LIB_CTX* _libCtx;
+    std::string _propertyQuery;
+    bool _hasPropertyQuery;
+    EVP_MD_uptr _sha256;
+    EVP_PKEY_uptr _p256Parameters;
+};
+
+/**
+ * @return algorithms fetched from context set by setAlgorithmsContext, from default library context when it was never called.
+ *         Hold the snapshot as long as anything taken from it is used, replaced algorithms are freed with the last one.
+ */
+std::shared_ptr<const Algorithms> getAlgorithms();
+
+/**
+ * Fetches algorithms from given library context, verifications started afterwards use them. Algorithms of the
+ * previous context are freed once no verification holds them, so that context may be freed after that.
+ *
+ * @return false when SHA-256 or P-256 is not available in libCtx, algorithms in use are kept then
+ */
+bool setAlgorithmsContext(OSSL_LIB_CTX* libCtx, const char* propertyQuery);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // INTEL_SGX_QVL_ALGORITHMS_H_
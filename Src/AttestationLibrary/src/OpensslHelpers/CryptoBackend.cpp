@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CryptoBackend.h"
+#include "DigestUtils.h"
+#include "KeyUtils.h"
+#include "PrecomputedP256Backend.h"
+#include "SignatureVerification.h"
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+namespace {
+
+class OpensslP256PublicKey : public P256PublicKey
+{
+public:
+    explicit OpensslP256PublicKey(EVP_PKEY_uptr key): _key(std::move(key))
+    {}
+
+    const EVP_PKEY& get() const
+    {
+        return *_key;
+    }
+
+private:
+    EVP_PKEY_uptr _key;
+};
+
+class OpensslCryptoBackend : public CryptoBackend
+{
+public:
+    const char* getName() const override
+    {
+        return "openssl";
+    }
+
+    Bytes sha256(const uint8_t* data, size_t size) const override
+    {
+        Sha256 hash;
+        hash.update(data, size);
+        return hash.finalize();
+    }
+
+    P256PublicKeyPtr importP256PublicKey(const RawP256PublicKey& rawKey) const override
+    {
+        auto key = rawToP256PubKey(rawKey);
+        if (key == nullptr)
+        {
+            return nullptr;
+        }
+        return std::make_unique<OpensslP256PublicKey>(std::move(key));
+    }
+
+    bool verifyP256Signature(const P256PublicKey& publicKey, const RawP256Signature& signature,
+                             const Bytes& digest) const override
+    {
+        const auto* key = dynamic_cast<const OpensslP256PublicKey*>(&publicKey);
+        return key != nullptr && verifyEcdsaSignatureOfSha256Digest(signature, digest, key->get());
+    }
+};
+
+} // anonymous namespace
+
+const CryptoBackend& getOpensslCryptoBackend()
+{
+    static const OpensslCryptoBackend backend;
+    return backend;
+}
+
+const std::vector<const CryptoBackend*>& getCryptoBackends()
+{
+#ifndef SGX_TRUSTED
+    // tables of every key, so the table arithmetic is what gets tested and measured
+    static const PrecomputedP256Backend precomputedP256(0, 16);
+    static const std::vector<const CryptoBackend*> backends{&getOpensslCryptoBackend(), &precomputedP256};
+#else
+    static const std::vector<const CryptoBackend*> backends{&getOpensslCryptoBackend()};
+#endif
+    return backends;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
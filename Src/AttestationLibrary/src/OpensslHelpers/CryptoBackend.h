@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_CRYPTO_BACKEND_H_
+#define INTEL_SGX_QVL_CRYPTO_BACKEND_H_
+
+#include <OpensslHelpers/Bytes.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+using RawP256PublicKey = std::array<uint8_t, 64>;   // X || Y, big endian
+using RawP256Signature = std::array<uint8_t, 64>;   // r || s, big endian
+
+/**
+ * P-256 public key imported by a backend, only the backend that imported it can verify with it.
+ */
+class P256PublicKey
+{
+public:
+    virtual ~P256PublicKey() = default;
+};
+
+using P256PublicKeyPtr = std::unique_ptr<const P256PublicKey>;
+
+/**
+ * Cryptography used to verify quote signatures: SHA-256, import of raw P-256 public keys and verification of raw
+ * ECDSA P-256 signatures. Implementations must be thread safe, one backend serves all verifications made with it.
+ */
+class CryptoBackend
+{
+public:
+    virtual ~CryptoBackend() = default;
+
+    virtual const char* getName() const = 0;
+
+    /**
+     * @return digest or empty bytes when it could not be computed
+     */
+    virtual Bytes sha256(const uint8_t* data, size_t size) const = 0;
+
+    /**
+     * @return NULL when key is not a point on P-256
+     */
+    virtual P256PublicKeyPtr importP256PublicKey(const RawP256PublicKey& rawKey) const = 0;
+
+    /**
+     * @param publicKey - Key imported by this backend, false is returned for a key of another backend.
+     * @param digest - SHA-256 of signed message.
+     */
+    virtual bool verifyP256Signature(const P256PublicKey& publicKey, const RawP256Signature& signature,
+                                     const Bytes& digest) const = 0;
+};
+
+/**
+ * Default backend, OpenSSL with algorithms returned by getAlgorithms().
+ */
+const CryptoBackend& getOpensslCryptoBackend();
+
+/**
+ * @return every backend built into the library, default one first
+ */
+const std::vector<const CryptoBackend*>& getCryptoBackends();
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // INTEL_SGX_QVL_CRYPTO_BACKEND_H_
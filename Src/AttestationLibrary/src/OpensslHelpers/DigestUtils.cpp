@@ -31,6 +31,7 @@
 
 
 #include "DigestUtils.h"
+#include "Algorithms.h"
 #include "OpensslHelpers/OpensslTypes.h"
 
 #include <openssl/sha.h>
@@ -40,10 +41,11 @@ namespace intel { namespace sgx { namespace dcap { namespace crypto {
 Bytes sha256Digest(const Bytes& bytes)
 {
     auto ctx = crypto::make_unique(EVP_MD_CTX_new());
-    const EVP_MD* md = EVP_sha256();
+    const auto algorithms = getAlgorithms();
+    const EVP_MD* md = algorithms->getSha256();
     Bytes hash(SHA256_DIGEST_LENGTH);
     uint32_t hashLen;
-    if (ctx.get() != nullptr &&
+    if (ctx.get() != nullptr && md != nullptr &&
         EVP_DigestInit_ex(ctx.get(), md, nullptr) == 1 &&
         EVP_DigestUpdate(ctx.get(), bytes.data(), bytes.size()) == 1 &&
         EVP_DigestFinal_ex(ctx.get(), hash.data(), &hashLen) == 1 &&
@@ -54,4 +56,30 @@ Bytes sha256Digest(const Bytes& bytes)
     return Bytes{};
 }
 
+Sha256::Sha256():
+    _ctx(crypto::make_unique(EVP_MD_CTX_new())),
+    _valid(false)
+{
+    // initialized context keeps its own reference to the digest
+    const auto algorithms = getAlgorithms();
+    const EVP_MD* md = algorithms->getSha256();
+    _valid = _ctx != nullptr && md != nullptr && EVP_DigestInit_ex(_ctx.get(), md, nullptr) == 1;
+}
+
+void Sha256::update(const uint8_t* data, size_t size)
+{
+    _valid = _valid && EVP_DigestUpdate(_ctx.get(), data, size) == 1;
+}
+
+Bytes Sha256::finalize()
+{
+    Bytes hash(SHA256_DIGEST_LENGTH);
+    uint32_t hashLen = 0;
+    const auto finalized = _valid &&
+        EVP_DigestFinal_ex(_ctx.get(), hash.data(), &hashLen) == 1 &&
+        hashLen == SHA256_DIGEST_LENGTH;
+    _valid = false; // context is not initialized anymore
+    return finalized ? hash : Bytes{};
+}
+
 }}}}
@@ -33,11 +33,32 @@
 #define INTEL_SGX_QVL_DIGEST_UTILS_H_
 
 #include <OpensslHelpers/Bytes.h>
+#include <OpensslHelpers/OpensslTypes.h>
 
 namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 Bytes sha256Digest(const Bytes& data);
 
+/**
+ * Incremental SHA-256, for data hashed in parts as it is walked through without gathering it in one buffer first.
+ */
+class Sha256
+{
+public:
+    Sha256();
+
+    void update(const uint8_t* data, size_t size);
+
+    /**
+     * @return digest of all updates or empty bytes when any OpenSSL call failed
+     */
+    Bytes finalize();
+
+private:
+    EVP_MD_CTX_uptr _ctx;
+    bool _valid;
+};
+
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 #endif // INTEL_SGX_QVL_DIGEST_UTILS_H_
@@ -30,8 +30,7 @@
  */
 
 #include "KeyUtils.h"
-
-#include <openssl/param_build.h>
+#include "Algorithms.h"
 
 #include <algorithm>
 #include <array>
@@ -41,38 +40,21 @@ namespace intel::sgx::dcap::crypto {
 
 crypto::EVP_PKEY_uptr rawToP256PubKey(const std::array<uint8_t, 64>& rawKey)
 {
-    // prepare key structs
-    EVP_PKEY *pubKey = nullptr;
-    auto pkey = crypto::make_unique<EVP_PKEY>(nullptr);
     // prepare public key raw data
     auto data = std::vector<uint8_t>();
     data.reserve(rawKey.size() + 1);
     data.insert(data.begin(), POINT_CONVERSION_UNCOMPRESSED);
     std::copy(rawKey.begin(), rawKey.end(), std::back_inserter(data));
-    // prepare OSSL params
-    OSSL_PARAM_BLD_uptr param_bld = crypto::make_unique<OSSL_PARAM_BLD>(OSSL_PARAM_BLD_new());
-    if (param_bld.get() == nullptr
-        || OSSL_PARAM_BLD_push_utf8_string(param_bld.get(), "group",SN_X9_62_prime256v1, 0) != 1)
-    {
-        return pkey; // empty key
-    }
-    OSSL_PARAM_uptr params = crypto::make_unique<OSSL_PARAM>(OSSL_PARAM_BLD_to_param(param_bld.get()));
-    EVP_PKEY_CTX_uptr ctx = crypto::make_unique<EVP_PKEY_CTX>(EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr));
-    if (ctx.get() == nullptr
-        || params.get() == nullptr
-        || EVP_PKEY_fromdata_init(ctx.get()) <= 0
-        || EVP_PKEY_fromdata(ctx.get(), &pubKey, OSSL_KEYMGMT_SELECT_DOMAIN_PARAMETERS, params.get()) <= 0)
+    // copy of P-256 parameters shares key management fetched once instead of fetching "EC" by name
+    const auto algorithms = getAlgorithms();
+    const auto* parameters = algorithms->getP256Parameters();
+    if (parameters == nullptr)
     {
-        return pkey; // empty key
-    }
-    pkey.reset(pubKey);
-    if (pkey.get() == nullptr)
-    {
-        return pkey; // empty key
+        return crypto::make_unique<EVP_PKEY>(nullptr); // empty key
     }
-    const auto *pp = data.data();
-    auto ret = d2i_PublicKey(EVP_PKEY_EC, &pubKey, &pp, static_cast<long>(data.size()));
-    if (ret == nullptr)
+    auto pkey = crypto::make_unique<EVP_PKEY>(EVP_PKEY_dup(const_cast<EVP_PKEY*>(parameters)));
+    if (pkey.get() == nullptr
+        || EVP_PKEY_set1_encoded_public_key(pkey.get(), data.data(), data.size()) != 1)
     {
         return crypto::make_unique<EVP_PKEY>(nullptr); // empty key
     }
@@ -0,0 +1,661 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "P256Table.h"
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+namespace {
+
+using Limbs = std::array<uint64_t, 4>; // 256 bit number, least significant limb first
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 Uint128;
+#endif
+
+// low half of a * b + c + d, the high half goes to high, the sum always fits in 128 bits
+uint64_t mulAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t& high)
+{
+#if defined(__SIZEOF_INT128__)
+    const Uint128 result = static_cast<Uint128>(a) * b + c + d;
+    high = static_cast<uint64_t>(result >> 64);
+    return static_cast<uint64_t>(result);
+#else
+    uint64_t resultHigh = 0;
+    uint64_t result = _umul128(a, b, &resultHigh);
+    result += c;
+    resultHigh += result < c;
+    result += d;
+    resultHigh += result < d;
+    high = resultHigh;
+    return result;
+#endif
+}
+
+// a + b + carry, carry is 0 or 1 on input and output
+uint64_t addCarry(uint64_t a, uint64_t b, uint64_t& carry)
+{
+#if defined(__SIZEOF_INT128__)
+    const Uint128 sum = static_cast<Uint128>(a) + b + carry;
+    carry = static_cast<uint64_t>(sum >> 64);
+    return static_cast<uint64_t>(sum);
+#else
+    const uint64_t partial = a + b;
+    const uint64_t sum = partial + carry;
+    carry = static_cast<uint64_t>(partial < a) | static_cast<uint64_t>(sum < partial);
+    return sum;
+#endif
+}
+
+// a - b - borrow, borrow is 0 or 1 on input and output
+uint64_t subBorrow(uint64_t a, uint64_t b, uint64_t& borrow)
+{
+#if defined(__SIZEOF_INT128__)
+    const Uint128 difference = static_cast<Uint128>(a) - b - borrow;
+    borrow = static_cast<uint64_t>(difference >> 64) & 1;
+    return static_cast<uint64_t>(difference);
+#else
+    const uint64_t partial = a - b;
+    const uint64_t difference = partial - borrow;
+    borrow = static_cast<uint64_t>(a < b) | static_cast<uint64_t>(partial < borrow);
+    return difference;
+#endif
+}
+
+Limbs addLimbs(const Limbs& a, const Limbs& b, uint64_t& carry)
+{
+    carry = 0;
+    const uint64_t sum0 = addCarry(a[0], b[0], carry);
+    const uint64_t sum1 = addCarry(a[1], b[1], carry);
+    const uint64_t sum2 = addCarry(a[2], b[2], carry);
+    const uint64_t sum3 = addCarry(a[3], b[3], carry);
+    return Limbs{sum0, sum1, sum2, sum3};
+}
+
+Limbs subLimbs(const Limbs& a, const Limbs& b, uint64_t& borrow)
+{
+    borrow = 0;
+    const uint64_t difference0 = subBorrow(a[0], b[0], borrow);
+    const uint64_t difference1 = subBorrow(a[1], b[1], borrow);
+    const uint64_t difference2 = subBorrow(a[2], b[2], borrow);
+    const uint64_t difference3 = subBorrow(a[3], b[3], borrow);
+    return Limbs{difference0, difference1, difference2, difference3};
+}
+
+bool isZero(const Limbs& a)
+{
+    return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+bool isEven(const Limbs& a)
+{
+    return (a[0] & 1) == 0;
+}
+
+bool isLess(const Limbs& a, const Limbs& b)
+{
+    uint64_t borrow = 0;
+    subLimbs(a, b, borrow);
+    return borrow != 0;
+}
+
+// (a + carry * 2^256) / 2
+Limbs halve(const Limbs& a, uint64_t carry)
+{
+    return Limbs{(a[0] >> 1) | (a[1] << 63), (a[1] >> 1) | (a[2] << 63), (a[2] >> 1) | (a[3] << 63),
+                 (a[3] >> 1) | (carry << 63)};
+}
+
+Limbs loadBigEndian(const uint8_t* bytes)
+{
+    Limbs number{};
+    for (size_t i = 0; i < 32; ++i)
+    {
+        number[3 - i / 8] = (number[3 - i / 8] << 8) | bytes[i];
+    }
+    return number;
+}
+
+/**
+ * Arithmetic modulo odd m, 2^255 < m < 2^256, on numbers in Montgomery form a * 2^256 mod m.
+ * Every result is fully reduced, so equal numbers have equal limbs.
+ */
+class Field
+{
+public:
+    explicit Field(const Limbs& modulus): _modulus(modulus)
+    {
+        // m^-1 mod 2^64 by Newton iteration, every step doubles the number of correct bits
+        uint64_t inverse = 1;
+        for (int i = 0; i < 6; ++i)
+        {
+            inverse *= 2 - _modulus[0] * inverse;
+        }
+        _minusInverse = 0 - inverse;
+
+        uint64_t borrow = 0;
+        _one = subLimbs(Limbs{}, _modulus, borrow); // 2^256 - m as m > 2^255
+        _rSquared = _one;
+        for (int i = 0; i < 256; ++i)
+        {
+            _rSquared = add(_rSquared, _rSquared);
+        }
+    }
+
+    const Limbs& getModulus() const
+    {
+        return _modulus;
+    }
+
+    const Limbs& one() const
+    {
+        return _one;
+    }
+
+    Limbs add(const Limbs& a, const Limbs& b) const
+    {
+        uint64_t carry = 0;
+        const auto sum = addLimbs(a, b, carry);
+        return reduceProduct(sum, carry);
+    }
+
+    Limbs sub(const Limbs& a, const Limbs& b) const
+    {
+        uint64_t borrow = 0;
+        const auto difference = subLimbs(a, b, borrow);
+        const auto mask = 0 - borrow;
+        uint64_t carry = 0;
+        return addLimbs(difference, Limbs{_modulus[0] & mask, _modulus[1] & mask, _modulus[2] & mask, _modulus[3] & mask},
+                        carry);
+    }
+
+    // coarsely integrated operand scanning Montgomery multiplication, a * b * 2^-256 mod m
+    Limbs mul(const Limbs& a, const Limbs& b) const
+    {
+        std::array<uint64_t, 6> t{};
+        for (size_t i = 0; i < 4; ++i)
+        {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < 4; ++j)
+            {
+                t[j] = mulAdd(a[j], b[i], t[j], carry, carry);
+            }
+            t[4] = mulAdd(1, t[4], carry, 0, t[5]);
+
+            // adding q * m clears the lowest limb, which is shifted out
+            const uint64_t q = t[0] * _minusInverse;
+            mulAdd(q, _modulus[0], t[0], 0, carry);
+            for (size_t j = 1; j < 4; ++j)
+            {
+                t[j - 1] = mulAdd(q, _modulus[j], t[j], carry, carry);
+            }
+            t[3] = mulAdd(1, t[4], carry, 0, carry);
+            t[4] = t[5] + carry;
+        }
+        return reduceProduct(Limbs{t[0], t[1], t[2], t[3]}, t[4]);
+    }
+
+    Limbs toMontgomery(const Limbs& a) const
+    {
+        return mul(a, _rSquared);
+    }
+
+    // a mod m for a < 2m
+    Limbs reduce(const Limbs& a) const
+    {
+        return reduceProduct(a, 0);
+    }
+
+protected:
+    const Limbs& getRSquared() const
+    {
+        return _rSquared;
+    }
+
+    // (a + carry * 2^256) mod m for a + carry * 2^256 < 2m, without branches as they are hard to predict
+    Limbs reduceProduct(const Limbs& a, uint64_t carry) const
+    {
+        uint64_t borrow = 0;
+        const auto difference = subLimbs(a, _modulus, borrow);
+        const auto keep = 0 - (borrow & (carry ^ 1)); // a < m
+        return Limbs{(a[0] & keep) | (difference[0] & ~keep), (a[1] & keep) | (difference[1] & ~keep),
+                     (a[2] & keep) | (difference[2] & ~keep), (a[3] & keep) | (difference[3] & ~keep)};
+    }
+
+private:
+    Limbs _modulus;
+    uint64_t _minusInverse;
+    Limbs _one;
+    Limbs _rSquared;
+};
+
+// 2^256 - 2^224 + 2^192 + 2^96 - 1
+const Limbs P256_P{0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF, 0x0000000000000000, 0xFFFFFFFF00000001};
+const Limbs P256_N{0xF3B9CAC2FC632551, 0xBCE6FAADA7179E84, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF00000000};
+const Limbs P256_B{0x3BCE3C3E27D2604B, 0x651D06B0CC53B0F6, 0xB3EBBD55769886BC, 0x5AC635D8AA3A93E7};
+const Limbs P256_GX{0xF4A13945D898C296, 0x77037D812DEB33A0, 0xF8BCE6E563A440F2, 0x6B17D1F2E12C4247};
+const Limbs P256_GY{0xCBB6406837BF51F5, 0x2BCE33576B315ECE, 0x8EE7EB4A7C0F9E16, 0x4FE342E2FE1A7F9B};
+
+/**
+ * Field of P-256 coordinates. Lowest limb of p is 2^64 - 1 and the next two are 2^32 - 1 and 0, so every step
+ * of Montgomery reduction takes a single multiplication.
+ */
+class CoordinateField : public Field
+{
+public:
+    CoordinateField(): Field(P256_P)
+    {}
+
+    Limbs mul(const Limbs& a, const Limbs& b) const
+    {
+        uint64_t t0 = 0;
+        uint64_t t1 = 0;
+        uint64_t t2 = 0;
+        uint64_t t3 = 0;
+        uint64_t t4 = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            uint64_t carry = 0;
+            t0 = mulAdd(a[0], b[i], t0, 0, carry);
+            t1 = mulAdd(a[1], b[i], t1, carry, carry);
+            t2 = mulAdd(a[2], b[i], t2, carry, carry);
+            t3 = mulAdd(a[3], b[i], t3, carry, carry);
+            uint64_t t5 = 0;
+            t4 = addCarry(t4, carry, t5);
+
+            // -p^-1 mod 2^64 is 1, so q = t0 and t + q * p = t - t0 + q * 2^96 + q * p[3] * 2^192, shifted by a limb
+            const uint64_t q = t0;
+            carry = 0;
+            t0 = addCarry(t1, q << 32, carry);
+            t1 = addCarry(t2, q >> 32, carry);
+            uint64_t high = 0;
+            t2 = mulAdd(q, P256_P[3], t3, carry, high);
+            carry = 0;
+            t3 = addCarry(t4, high, carry);
+            t4 = t5 + carry;
+        }
+        return reduceProduct(Limbs{t0, t1, t2, t3}, t4);
+    }
+
+    Limbs sqr(const Limbs& a) const
+    {
+        return mul(a, a);
+    }
+
+    Limbs toMontgomery(const Limbs& a) const
+    {
+        return mul(a, getRSquared());
+    }
+
+    // a^(p - 2), used while building tables only
+    Limbs inverse(const Limbs& a) const
+    {
+        const Limbs two{2, 0, 0, 0};
+        uint64_t borrow = 0;
+        const auto exponent = subLimbs(getModulus(), two, borrow);
+        auto result = one();
+        for (size_t bit = 256; bit-- > 0;)
+        {
+            result = sqr(result);
+            if (((exponent[bit / 64] >> (bit % 64)) & 1) != 0)
+            {
+                result = mul(result, a);
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * Field of P-256 scalars.
+ */
+class ScalarField : public Field
+{
+public:
+    ScalarField(): Field(P256_N)
+    {}
+
+    // a^-1 mod n for 0 < a < n by binary extended Euclid, on plain numbers
+    Limbs inverse(const Limbs& a) const
+    {
+        const auto& n = getModulus();
+        auto u = a;
+        auto v = n;
+        Limbs x1{1, 0, 0, 0};
+        Limbs x2{};
+        const Limbs unit{1, 0, 0, 0};
+        while (u != unit && v != unit)
+        {
+            halveWhileEven(u, x1);
+            halveWhileEven(v, x2);
+            uint64_t borrow = 0;
+            if (!isLess(u, v))
+            {
+                u = subLimbs(u, v, borrow);
+                x1 = sub(x1, x2);
+            }
+            else
+            {
+                v = subLimbs(v, u, borrow);
+                x2 = sub(x2, x1);
+            }
+        }
+        return u == unit ? x1 : x2;
+    }
+
+private:
+    // keeps u == x * a mod n while dividing u by 2
+    void halveWhileEven(Limbs& u, Limbs& x) const
+    {
+        while (isEven(u))
+        {
+            u = halve(u, 0);
+            if (isEven(x))
+            {
+                x = halve(x, 0);
+            }
+            else
+            {
+                uint64_t carry = 0;
+                const auto sum = addLimbs(x, getModulus(), carry);
+                x = halve(sum, carry);
+            }
+        }
+    }
+};
+
+const CoordinateField& coordinateField()
+{
+    static const CoordinateField field;
+    return field;
+}
+
+const ScalarField& scalarField()
+{
+    static const ScalarField field;
+    return field;
+}
+
+// coordinates in Montgomery form modulo p
+struct AffinePoint
+{
+    Limbs x;
+    Limbs y;
+};
+
+// (X / Z^2, Y / Z^3), Z = 0 for the point at infinity
+struct JacobianPoint
+{
+    Limbs x;
+    Limbs y;
+    Limbs z;
+};
+
+// dbl-2001-b from Explicit-Formulas Database, curve parameter a = -3
+JacobianPoint doublePoint(const CoordinateField& f, const JacobianPoint& point)
+{
+    if (isZero(point.z))
+    {
+        return point;
+    }
+    const auto delta = f.sqr(point.z);
+    const auto gamma = f.sqr(point.y);
+    const auto beta = f.mul(point.x, gamma);
+    const auto product = f.mul(f.sub(point.x, delta), f.add(point.x, delta));
+    const auto alpha = f.add(f.add(product, product), product);
+    const auto beta2 = f.add(beta, beta);
+    const auto beta4 = f.add(beta2, beta2);
+    const auto gammaSquared = f.sqr(gamma);
+    const auto gammaSquared2 = f.add(gammaSquared, gammaSquared);
+    const auto gammaSquared4 = f.add(gammaSquared2, gammaSquared2);
+
+    JacobianPoint result{};
+    result.x = f.sub(f.sqr(alpha), f.add(beta4, beta4));
+    result.z = f.sub(f.sub(f.sqr(f.add(point.y, point.z)), gamma), delta);
+    result.y = f.sub(f.mul(alpha, f.sub(beta4, result.x)), f.add(gammaSquared4, gammaSquared4));
+    return result;
+}
+
+// madd-2007-bl from Explicit-Formulas Database, handles doubling and opposite points too
+JacobianPoint addAffinePoint(const CoordinateField& f, const JacobianPoint& point, const AffinePoint& other)
+{
+    if (isZero(point.z))
+    {
+        return JacobianPoint{other.x, other.y, f.one()};
+    }
+    const auto z1z1 = f.sqr(point.z);
+    const auto u2 = f.mul(other.x, z1z1);
+    const auto s2 = f.mul(other.y, f.mul(point.z, z1z1));
+    const auto h = f.sub(u2, point.x);
+    const auto yDifference = f.sub(s2, point.y);
+    if (isZero(h))
+    {
+        return isZero(yDifference) ? doublePoint(f, point) : JacobianPoint{};
+    }
+    const auto hh = f.sqr(h);
+    const auto hh2 = f.add(hh, hh);
+    const auto i = f.add(hh2, hh2);
+    const auto j = f.mul(h, i);
+    const auto r = f.add(yDifference, yDifference);
+    const auto v = f.mul(point.x, i);
+    const auto y1j = f.mul(point.y, j);
+
+    JacobianPoint result{};
+    result.x = f.sub(f.sub(f.sqr(r), j), f.add(v, v));
+    result.y = f.sub(f.mul(r, f.sub(v, result.x)), f.add(y1j, y1j));
+    result.z = f.sub(f.sub(f.sqr(f.add(point.z, h)), z1z1), hh);
+    return result;
+}
+
+AffinePoint toAffine(const CoordinateField& f, const JacobianPoint& point)
+{
+    const auto zInverse = f.inverse(point.z);
+    const auto zInverse2 = f.sqr(zInverse);
+    return AffinePoint{f.mul(point.x, zInverse2), f.mul(point.y, f.mul(zInverse2, zInverse))};
+}
+
+constexpr size_t WINDOW_BITS = 6;
+constexpr size_t WINDOW_COUNT = 43;                           // 258 bits, room for the carry of signed digits
+constexpr size_t POINTS_PER_WINDOW = 1 << (WINDOW_BITS - 1);  // |digit| <= 32
+
+using Digits = std::array<int, WINDOW_COUNT>;
+
+// scalar = sum of digits[i] * 2^(6 * i), -32 < digits[i] <= 32
+Digits recodeScalar(const Limbs& scalar)
+{
+    constexpr int WINDOW_SIZE = 1 << WINDOW_BITS;
+    Digits digits{};
+    int carry = 0;
+    for (size_t window = 0; window < WINDOW_COUNT; ++window)
+    {
+        const size_t bit = window * WINDOW_BITS;
+        const size_t limb = bit / 64;
+        const size_t shift = bit % 64;
+        uint64_t bits = scalar[limb] >> shift;
+        if (shift > 64 - WINDOW_BITS && limb + 1 < scalar.size())
+        {
+            bits |= scalar[limb + 1] << (64 - shift);
+        }
+        const int value = static_cast<int>(bits & (WINDOW_SIZE - 1)) + carry;
+        carry = value > WINDOW_SIZE / 2 ? 1 : 0;
+        digits[window] = value - carry * WINDOW_SIZE;
+    }
+    return digits;
+}
+
+} // anonymous namespace
+
+class P256Table
+{
+public:
+    explicit P256Table(const AffinePoint& point)
+    {
+        const auto& f = coordinateField();
+
+        // every window starts from 2^6 times the base of previous one, which is twice its last multiple
+        std::vector<JacobianPoint> multiples(WINDOW_COUNT * POINTS_PER_WINDOW);
+        auto base = point;
+        for (size_t window = 0; window < WINDOW_COUNT; ++window)
+        {
+            JacobianPoint multiple{};
+            for (size_t k = 0; k < POINTS_PER_WINDOW; ++k)
+            {
+                multiple = addAffinePoint(f, multiple, base);
+                multiples[window * POINTS_PER_WINDOW + k] = multiple;
+            }
+            if (window + 1 < WINDOW_COUNT)
+            {
+                base = toAffine(f, doublePoint(f, multiple));
+            }
+        }
+
+        // one inversion for all points, k * 2^(6 * i) is never a multiple of the group order so no Z is 0
+        std::vector<Limbs> zProducts(multiples.size());
+        auto product = f.one();
+        for (size_t i = 0; i < multiples.size(); ++i)
+        {
+            zProducts[i] = product;
+            product = f.mul(product, multiples[i].z);
+        }
+        auto inverse = f.inverse(product);
+        for (size_t i = multiples.size(); i-- > 0;)
+        {
+            const auto zInverse = f.mul(inverse, zProducts[i]);
+            inverse = f.mul(inverse, multiples[i].z);
+            const auto zInverse2 = f.sqr(zInverse);
+            _points[i] = AffinePoint{f.mul(multiples[i].x, zInverse2), f.mul(multiples[i].y, f.mul(zInverse2, zInverse))};
+        }
+    }
+
+    // adds sum of digit * 2^(6 * i) * Q over all digits of scalar to accumulator
+    void multiplyAdd(const Limbs& scalar, JacobianPoint& accumulator) const
+    {
+        const auto& f = coordinateField();
+        const auto digits = recodeScalar(scalar);
+        for (size_t window = 0; window < WINDOW_COUNT; ++window)
+        {
+            const int digit = digits[window];
+            if (digit == 0)
+            {
+                continue;
+            }
+            const auto& point = _points[window * POINTS_PER_WINDOW + static_cast<size_t>(std::abs(digit)) - 1];
+            accumulator = addAffinePoint(f, accumulator, digit > 0 ? point : AffinePoint{point.x, f.sub(Limbs{}, point.y)});
+        }
+    }
+
+private:
+    std::array<AffinePoint, WINDOW_COUNT * POINTS_PER_WINDOW> _points;
+};
+
+namespace {
+
+const P256Table& generatorTable()
+{
+    static const P256Table table(AffinePoint{coordinateField().toMontgomery(P256_GX),
+                                             coordinateField().toMontgomery(P256_GY)});
+    return table;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const P256Table> buildP256Table(const RawP256PublicKey& rawKey)
+{
+    const auto& f = coordinateField();
+    const auto x = loadBigEndian(rawKey.data());
+    const auto y = loadBigEndian(rawKey.data() + 32);
+    if (!isLess(x, f.getModulus()) || !isLess(y, f.getModulus()))
+    {
+        return nullptr;
+    }
+
+    // y^2 = x^3 - 3x + b, cofactor is 1 so every point of the curve has order n
+    const AffinePoint point{f.toMontgomery(x), f.toMontgomery(y)};
+    const auto xCubed = f.mul(f.sqr(point.x), point.x);
+    const auto x3 = f.add(f.add(point.x, point.x), point.x);
+    if (f.sqr(point.y) != f.add(f.sub(xCubed, x3), f.toMontgomery(P256_B)))
+    {
+        return nullptr;
+    }
+    return std::make_shared<const P256Table>(point);
+}
+
+size_t getP256TableSize()
+{
+    return sizeof(P256Table);
+}
+
+bool verifyP256SignatureWithTable(const P256Table& publicKey, const RawP256Signature& signature, const Bytes& digest)
+{
+    const auto& f = coordinateField();
+    const auto& n = scalarField();
+    if (digest.size() != 32)
+    {
+        return false;
+    }
+    const auto r = loadBigEndian(signature.data());
+    const auto s = loadBigEndian(signature.data() + 32);
+    if (isZero(r) || isZero(s) || !isLess(r, n.getModulus()) || !isLess(s, n.getModulus()))
+    {
+        return false;
+    }
+
+    // Montgomery product of plain numbers taken to Montgomery form is their plain product
+    const auto e = n.reduce(loadBigEndian(digest.data()));
+    const auto sInverse = n.inverse(s);
+    JacobianPoint sum{};
+    generatorTable().multiplyAdd(n.toMontgomery(n.mul(e, sInverse)), sum);
+    publicKey.multiplyAdd(n.toMontgomery(n.mul(r, sInverse)), sum);
+    if (isZero(sum.z))
+    {
+        return false;
+    }
+
+    // X / Z^2 < p equals r mod n, so it is either r or r + n, compared without inverting Z
+    const auto zz = f.sqr(sum.z);
+    if (f.mul(f.toMontgomery(r), zz) == sum.x)
+    {
+        return true;
+    }
+    uint64_t carry = 0;
+    const auto rPlusN = addLimbs(r, n.getModulus(), carry);
+    return carry == 0 && isLess(rPlusN, f.getModulus()) && f.mul(f.toMontgomery(rPlusN), zz) == sum.x;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
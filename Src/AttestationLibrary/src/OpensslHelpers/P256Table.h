@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_P256_TABLE_H_
+#define INTEL_SGX_QVL_P256_TABLE_H_
+
+#include <OpensslHelpers/Bytes.h>
+#include <OpensslHelpers/CryptoBackend.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+/**
+ * Multiples k * 2^(6 * i) * Q, k = 1..32, of P-256 point Q for every 6 bit window i of a scalar.
+ * Multiplication of Q by a scalar then takes one point addition per window and no doublings.
+ */
+class P256Table;
+
+/**
+ * Builds table of public key, takes about as long as 16 signature verifications with OpenSSL.
+ *
+ * @return NULL when rawKey is not a point on P-256
+ */
+std::shared_ptr<const P256Table> buildP256Table(const RawP256PublicKey& rawKey);
+
+/**
+ * @return bytes of memory taken by one table
+ */
+size_t getP256TableSize();
+
+/**
+ * Verifies ECDSA signature of SHA-256 digest with tables of public key and of P-256 generator.
+ * Does not run in constant time, all its inputs are public.
+ */
+bool verifyP256SignatureWithTable(const P256Table& publicKey, const RawP256Signature& signature, const Bytes& digest);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // INTEL_SGX_QVL_P256_TABLE_H_
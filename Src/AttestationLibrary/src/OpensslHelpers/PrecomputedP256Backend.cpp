@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_TRUSTED
+
+#include "PrecomputedP256Backend.h"
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+namespace {
+
+// a key of a table is tracked while it verifies its first signatures, a few candidates per table are enough
+constexpr size_t CANDIDATES_PER_TABLE = 8;
+
+class PrecomputedP256PublicKey : public P256PublicKey
+{
+public:
+    explicit PrecomputedP256PublicKey(std::shared_ptr<const P256Table> table): _table(std::move(table))
+    {}
+
+    PrecomputedP256PublicKey(P256PublicKeyPtr opensslKey, const RawP256PublicKey& rawKey):
+        _opensslKey(std::move(opensslKey)), _rawKey(rawKey)
+    {}
+
+    const P256Table* getTable() const
+    {
+        return _table.get();
+    }
+
+    const P256PublicKey& getOpensslKey() const
+    {
+        return *_opensslKey;
+    }
+
+    const RawP256PublicKey& getRawKey() const
+    {
+        return _rawKey;
+    }
+
+private:
+    std::shared_ptr<const P256Table> _table;   // shared, so eviction does not free table of a key in use
+    P256PublicKeyPtr _opensslKey;
+    RawP256PublicKey _rawKey{};                 // set for keys without table, credited once they verify
+};
+
+} // anonymous namespace
+
+PrecomputedP256Backend::Lru::Lru(size_t capacity): _capacity(capacity)
+{}
+
+PrecomputedP256Backend::Entry* PrecomputedP256Backend::Lru::find(const RawP256PublicKey& key)
+{
+    const auto found = _index.find(key);
+    if (found == _index.end())
+    {
+        return nullptr;
+    }
+    _entries.splice(_entries.begin(), _entries, found->second);
+    return &_entries.front();
+}
+
+bool PrecomputedP256Backend::Lru::insert(Entry entry)
+{
+    if (_capacity == 0)
+    {
+        return false;
+    }
+    erase(entry.key);
+
+    bool evicted = false;
+    if (_entries.size() == _capacity)
+    {
+        _index.erase(_entries.back().key);
+        _entries.pop_back();
+        evicted = true;
+    }
+    _entries.push_front(std::move(entry));
+    _index.emplace(_entries.front().key, _entries.begin());
+    return evicted;
+}
+
+void PrecomputedP256Backend::Lru::erase(const RawP256PublicKey& key)
+{
+    const auto found = _index.find(key);
+    if (found != _index.end())
+    {
+        _entries.erase(found->second);
+        _index.erase(found);
+    }
+}
+
+size_t PrecomputedP256Backend::Lru::size() const
+{
+    return _entries.size();
+}
+
+size_t PrecomputedP256Backend::Lru::getCapacity() const
+{
+    return _capacity;
+}
+
+PrecomputedP256Backend::PrecomputedP256Backend(uint32_t hotKeyThreshold, size_t maxTables):
+    _hotKeyThreshold(hotKeyThreshold),
+    _tables(maxTables),
+    _candidates(maxTables * CANDIDATES_PER_TABLE)
+{}
+
+const char* PrecomputedP256Backend::getName() const
+{
+    return "p256_tables";
+}
+
+Bytes PrecomputedP256Backend::sha256(const uint8_t* data, size_t size) const
+{
+    return getOpensslCryptoBackend().sha256(data, size);
+}
+
+P256PublicKeyPtr PrecomputedP256Backend::importP256PublicKey(const RawP256PublicKey& rawKey) const
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (const auto* entry = _tables.find(rawKey))
+        {
+            ++_tableHits;
+            return std::make_unique<PrecomputedP256PublicKey>(entry->table);
+        }
+    }
+
+    // importing is not counted, keys come from requests before any signature of them is checked
+    auto opensslKey = getOpensslCryptoBackend().importP256PublicKey(rawKey);
+    if (opensslKey == nullptr)
+    {
+        return nullptr;
+    }
+    return std::make_unique<PrecomputedP256PublicKey>(std::move(opensslKey), rawKey);
+}
+
+bool PrecomputedP256Backend::verifyP256Signature(const P256PublicKey& publicKey, const RawP256Signature& signature,
+                                                 const Bytes& digest) const
+{
+    const auto* key = dynamic_cast<const PrecomputedP256PublicKey*>(&publicKey);
+    if (key == nullptr)
+    {
+        return false;
+    }
+    if (key->getTable() != nullptr)
+    {
+        return verifyP256SignatureWithTable(*key->getTable(), signature, digest);
+    }
+    if (!getOpensslCryptoBackend().verifyP256Signature(key->getOpensslKey(), signature, digest))
+    {
+        return false;
+    }
+    creditVerifiedKey(key->getRawKey());
+    return true;
+}
+
+void PrecomputedP256Backend::creditVerifiedKey(const RawP256PublicKey& rawKey) const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_tables.getCapacity() == 0 || _tables.find(rawKey) != nullptr)
+    {
+        return;
+    }
+
+    uint32_t verifications = 1;
+    if (auto* candidate = _candidates.find(rawKey))
+    {
+        verifications = ++candidate->verifications;
+    }
+    else
+    {
+        _candidates.insert(Entry{rawKey, verifications, nullptr});
+    }
+    if (verifications < _hotKeyThreshold)
+    {
+        return;
+    }
+
+    // building takes a while, other keys are served meanwhile
+    _candidates.erase(rawKey);
+    lock.unlock();
+    auto table = buildP256Table(rawKey);
+    if (table == nullptr)
+    {
+        return;
+    }
+
+    lock.lock();
+    ++_tablesBuilt;
+    if (_tables.insert(Entry{rawKey, verifications, std::move(table)}))
+    {
+        ++_evictions;
+    }
+}
+
+PrecomputedP256Backend::Metrics PrecomputedP256Backend::getMetrics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Metrics{_tableHits, _tablesBuilt, _evictions, static_cast<uint32_t>(_tables.size())};
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // SGX_TRUSTED
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_PRECOMPUTED_P256_BACKEND_H_
+#define INTEL_SGX_QVL_PRECOMPUTED_P256_BACKEND_H_
+
+#ifndef SGX_TRUSTED
+
+#include <OpensslHelpers/CryptoBackend.h>
+#include <OpensslHelpers/P256Table.h>
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+/**
+ * Backend keeping precomputed multiples (see P256Table) of P-256 public keys which verified at least
+ * hotKeyThreshold signatures (at least one when 0), later imports of such keys verify without point doublings.
+ * Only successful verifications are counted, so keys of requests with bad signatures never get a table or
+ * evict one. Keys used less often are verified with OpenSSL backend. At most maxTables tables of
+ * getP256TableSize() bytes are kept, the least recently imported one is evicted first. Verification counts
+ * are kept for a bounded number of keys too.
+ */
+class PrecomputedP256Backend : public CryptoBackend
+{
+public:
+    struct Metrics
+    {
+        uint64_t tableHits;     // imports of keys that had a table already
+        uint64_t tablesBuilt;
+        uint64_t evictions;     // tables dropped to make room for new ones
+        uint32_t tables;
+    };
+
+    PrecomputedP256Backend(uint32_t hotKeyThreshold, size_t maxTables);
+
+    const char* getName() const override;
+    Bytes sha256(const uint8_t* data, size_t size) const override;
+    P256PublicKeyPtr importP256PublicKey(const RawP256PublicKey& rawKey) const override;
+    bool verifyP256Signature(const P256PublicKey& publicKey, const RawP256Signature& signature,
+                             const Bytes& digest) const override;
+
+    Metrics getMetrics() const;
+
+private:
+    void creditVerifiedKey(const RawP256PublicKey& rawKey) const;
+
+    struct RawKeyHash
+    {
+        size_t operator()(const RawP256PublicKey& key) const
+        {
+            // X coordinate of a point is as good as random
+            size_t hash = 0;
+            std::memcpy(&hash, key.data(), sizeof(hash));
+            return hash;
+        }
+    };
+
+    struct Entry
+    {
+        RawP256PublicKey key;
+        uint32_t verifications;
+        std::shared_ptr<const P256Table> table;
+    };
+
+    // entries of distinct keys, most recently used first
+    class Lru
+    {
+    public:
+        explicit Lru(size_t capacity);
+
+        // moves found entry to the front
+        Entry* find(const RawP256PublicKey& key);
+
+        // @return true when least recently used entry was evicted to make room
+        bool insert(Entry entry);
+
+        void erase(const RawP256PublicKey& key);
+
+        size_t size() const;
+        size_t getCapacity() const;
+
+    private:
+        using Entries = std::list<Entry>;
+
+        const size_t _capacity;
+        Entries _entries;
+        std::unordered_map<RawP256PublicKey, Entries::iterator, RawKeyHash> _index;
+    };
+
+    const uint32_t _hotKeyThreshold;
+    mutable std::mutex _mutex;
+    mutable Lru _tables;
+    mutable Lru _candidates;    // keys without table yet and their verification counts
+    mutable uint64_t _tableHits = 0;
+    mutable uint64_t _tablesBuilt = 0;
+    mutable uint64_t _evictions = 0;
+};
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // SGX_TRUSTED
+
+#endif // INTEL_SGX_QVL_PRECOMPUTED_P256_BACKEND_H_
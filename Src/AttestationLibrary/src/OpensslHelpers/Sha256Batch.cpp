@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "Sha256Batch.h"
+#include "Algorithms.h"
+#include "DigestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(SGX_TRUSTED)
+#define QVL_SHA256_AVX2
+#define QVL_TARGET_AVX2 __attribute__((target("avx2")))
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+namespace {
+
+Bytes sha256OpenSsl(const Sha256BatchInput& input)
+{
+    Sha256 hash;
+    hash.update(input.data, input.size);
+    hash.update(input.suffix, input.suffixSize);
+    return hash.finalize();
+}
+
+#ifdef QVL_SHA256_AVX2
+
+constexpr size_t LANES = 8;
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t LENGTH_SIZE = 8;
+constexpr size_t DIGEST_SIZE = 32;
+
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+}};
+
+constexpr std::array<uint32_t, 8> INITIAL_STATE = {{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+}};
+
+// walks padded SHA-256 blocks of a message, blocks lying within one part are read in place
+class PaddedBlocks
+{
+public:
+    explicit PaddedBlocks(const Sha256BatchInput& input):
+        _input(input),
+        _size(input.size + input.suffixSize),
+        _count((_size + LENGTH_SIZE) / BLOCK_SIZE + 1),
+        _scratch{}
+    {}
+
+    size_t count() const
+    {
+        return _count;
+    }
+
+    // returned block is valid until next call
+    const uint8_t* block(size_t index)
+    {
+        const auto begin = index * BLOCK_SIZE;
+        if (begin + BLOCK_SIZE <= _input.size)
+        {
+            return _input.data + begin;
+        }
+        if (begin >= _input.size && begin + BLOCK_SIZE <= _size)
+        {
+            return _input.suffix + (begin - _input.size);
+        }
+
+        _scratch.fill(0x00);
+        size_t filled = 0;
+        if (begin < _input.size)
+        {
+            filled = std::min(BLOCK_SIZE, _input.size - begin);
+            std::copy_n(_input.data + begin, filled, _scratch.begin());
+        }
+        if (filled < BLOCK_SIZE && begin + filled < _size)
+        {
+            const auto suffixBegin = begin + filled - _input.size;
+            const auto suffixPart = std::min(BLOCK_SIZE - filled, _input.suffixSize - suffixBegin);
+            std::copy_n(_input.suffix + suffixBegin, suffixPart, _scratch.begin() + static_cast<std::ptrdiff_t>(filled));
+            filled += suffixPart;
+        }
+        if (filled < BLOCK_SIZE && begin + filled == _size)
+        {
+            _scratch[filled] = 0x80;
+        }
+        if (index + 1 == _count)
+        {
+            const auto bitLength = static_cast<uint64_t>(_size) * 8;
+            for (size_t i = 0; i < LENGTH_SIZE; ++i)
+            {
+                _scratch[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(bitLength >> (8 * i));
+            }
+        }
+        return _scratch.data();
+    }
+
+private:
+    Sha256BatchInput _input;
+    size_t _size;
+    size_t _count;
+    std::array<uint8_t, BLOCK_SIZE> _scratch;
+};
+
+QVL_TARGET_AVX2 inline __m256i rotr(__m256i x, int bits)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, bits), _mm256_slli_epi32(x, 32 - bits));
+}
+
+QVL_TARGET_AVX2 inline __m256i xor3(__m256i a, __m256i b, __m256i c)
+{
+    return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+}
+
+QVL_TARGET_AVX2 inline __m256i add4(__m256i a, __m256i b, __m256i c, __m256i d)
+{
+    return _mm256_add_epi32(_mm256_add_epi32(a, b), _mm256_add_epi32(c, d));
+}
+
+// loads eight big endian words at offset of every block, transposed so that words[N] holds word N of all lanes
+QVL_TARGET_AVX2 void loadWords(const std::array<const uint8_t*, LANES>& blocks, size_t offset, __m256i* words)
+{
+    const auto byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                           3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i rows[LANES];
+    for (size_t lane = 0; lane < LANES; ++lane)
+    {
+        const auto* row = reinterpret_cast<const __m256i*>(blocks[lane] + offset);
+        rows[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256(row), byteSwap);
+    }
+
+    // 8x8 transpose of 32-bit words: pairs of lanes, then quads, then 128-bit halves
+    const auto pairs01Low = _mm256_unpacklo_epi32(rows[0], rows[1]);
+    const auto pairs01High = _mm256_unpackhi_epi32(rows[0], rows[1]);
+    const auto pairs23Low = _mm256_unpacklo_epi32(rows[2], rows[3]);
+    const auto pairs23High = _mm256_unpackhi_epi32(rows[2], rows[3]);
+    const auto pairs45Low = _mm256_unpacklo_epi32(rows[4], rows[5]);
+    const auto pairs45High = _mm256_unpackhi_epi32(rows[4], rows[5]);
+    const auto pairs67Low = _mm256_unpacklo_epi32(rows[6], rows[7]);
+    const auto pairs67High = _mm256_unpackhi_epi32(rows[6], rows[7]);
+
+    const __m256i quads[8] = {
+        _mm256_unpacklo_epi64(pairs01Low, pairs23Low), _mm256_unpackhi_epi64(pairs01Low, pairs23Low),
+        _mm256_unpacklo_epi64(pairs01High, pairs23High), _mm256_unpackhi_epi64(pairs01High, pairs23High),
+        _mm256_unpacklo_epi64(pairs45Low, pairs67Low), _mm256_unpackhi_epi64(pairs45Low, pairs67Low),
+        _mm256_unpacklo_epi64(pairs45High, pairs67High), _mm256_unpackhi_epi64(pairs45High, pairs67High)
+    };
+    for (size_t word = 0; word < 4; ++word)
+    {
+        words[word] = _mm256_permute2x128_si256(quads[word], quads[word + 4], 0x20);
+        words[word + 4] = _mm256_permute2x128_si256(quads[word], quads[word + 4], 0x31);
+    }
+}
+
+// SHA-256 state words of all lanes, vector arrays can't be std::array elements without dropping their alignment
+struct LaneState
+{
+    __m256i words[8];
+};
+
+// one SHA-256 compression in each 32-bit lane, lane N hashes blocks[N] into its part of state
+QVL_TARGET_AVX2 void compressLanes(LaneState& state, const std::array<const uint8_t*, LANES>& blocks)
+{
+    __m256i w[64];
+    loadWords(blocks, 0, w);
+    loadWords(blocks, BLOCK_SIZE / 2, w + 8);
+    for (size_t t = 16; t < 64; ++t)
+    {
+        const auto s0 = xor3(rotr(w[t - 15], 7), rotr(w[t - 15], 18), _mm256_srli_epi32(w[t - 15], 3));
+        const auto s1 = xor3(rotr(w[t - 2], 17), rotr(w[t - 2], 19), _mm256_srli_epi32(w[t - 2], 10));
+        w[t] = add4(w[t - 16], s0, w[t - 7], s1);
+    }
+
+    auto a = state.words[0], b = state.words[1], c = state.words[2], d = state.words[3];
+    auto e = state.words[4], f = state.words[5], g = state.words[6], h = state.words[7];
+    for (size_t t = 0; t < 64; ++t)
+    {
+        const auto sum1 = xor3(rotr(e, 6), rotr(e, 11), rotr(e, 25));
+        const auto choice = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        const auto roundConstant = _mm256_set1_epi32(static_cast<int>(ROUND_CONSTANTS[t]));
+        const auto temp1 = _mm256_add_epi32(add4(h, sum1, choice, roundConstant), w[t]);
+        const auto sum0 = xor3(rotr(a, 2), rotr(a, 13), rotr(a, 22));
+        const auto majority = xor3(_mm256_and_si256(a, b), _mm256_and_si256(a, c), _mm256_and_si256(b, c));
+        const auto temp2 = _mm256_add_epi32(sum0, majority);
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(temp1, temp2);
+    }
+
+    const __m256i working[8] = {a, b, c, d, e, f, g, h};
+    for (size_t i = 0; i < 8; ++i)
+    {
+        state.words[i] = _mm256_add_epi32(state.words[i], working[i]);
+    }
+}
+
+// hashes up to LANES inputs, lanes whose message ends earlier keep compressing idle blocks until the longest one ends
+QVL_TARGET_AVX2 void hashLanes(const std::vector<Sha256BatchInput>& inputs, const size_t* indices, size_t laneCount,
+                               std::vector<Bytes>& digests)
+{
+    static const std::array<uint8_t, BLOCK_SIZE> idleBlock{};
+
+    std::vector<PaddedBlocks> lanes;
+    lanes.reserve(laneCount);
+    size_t blockCount = 0;
+    for (size_t lane = 0; lane < laneCount; ++lane)
+    {
+        lanes.emplace_back(inputs[indices[lane]]);
+        blockCount = std::max(blockCount, lanes.back().count());
+    }
+
+    LaneState state;
+    for (size_t i = 0; i < INITIAL_STATE.size(); ++i)
+    {
+        state.words[i] = _mm256_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+    }
+
+    std::array<const uint8_t*, LANES> blocks;
+    blocks.fill(idleBlock.data());
+    for (size_t block = 0; block < blockCount; ++block)
+    {
+        bool anyLaneEnds = false;
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            const auto laneBlocks = lanes[lane].count();
+            blocks[lane] = block < laneBlocks ? lanes[lane].block(block) : idleBlock.data();
+            anyLaneEnds = anyLaneEnds || block + 1 == laneBlocks;
+        }
+
+        compressLanes(state, blocks);
+        if (!anyLaneEnds)
+        {
+            continue;
+        }
+
+        std::array<std::array<uint32_t, LANES>, 8> words;
+        for (size_t i = 0; i < words.size(); ++i)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[i].data()), state.words[i]);
+        }
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            if (block + 1 != lanes[lane].count())
+            {
+                continue;
+            }
+            auto& digest = digests[indices[lane]];
+            digest.resize(DIGEST_SIZE);
+            for (size_t i = 0; i < words.size(); ++i)
+            {
+                for (size_t byte = 0; byte < 4; ++byte)
+                {
+                    digest[i * 4 + byte] = static_cast<uint8_t>(words[i][lane] >> (24 - 8 * byte));
+                }
+            }
+        }
+    }
+}
+
+void sha256Avx2(const std::vector<Sha256BatchInput>& inputs, std::vector<Bytes>& digests)
+{
+    // messages of similar length share lanes, so fewer idle blocks are compressed
+    std::vector<size_t> indices(inputs.size());
+    std::iota(indices.begin(), indices.end(), size_t{0});
+    std::stable_sort(indices.begin(), indices.end(), [&inputs](size_t left, size_t right) {
+        return inputs[left].size + inputs[left].suffixSize > inputs[right].size + inputs[right].suffixSize;
+    });
+
+    for (size_t first = 0; first < indices.size(); first += LANES)
+    {
+        hashLanes(inputs, indices.data() + first, std::min(LANES, indices.size() - first), digests);
+    }
+}
+
+bool cpuHasShaExtensions()
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0 && (ebx & bit_SHA) != 0;
+}
+
+#endif // QVL_SHA256_AVX2
+
+} // anonymous namespace
+
+bool isSha256KernelSupported(Sha256Kernel kernel)
+{
+    if (kernel != Sha256Kernel::AVX2)
+    {
+        return true;
+    }
+#ifdef QVL_SHA256_AVX2
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2") != 0;
+    return hasAvx2;
+#else
+    return false;
+#endif
+}
+
+Sha256Kernel selectSha256Kernel()
+{
+    if (getAlgorithms()->getPropertyQuery() != nullptr)
+    {
+        return Sha256Kernel::OPENSSL;
+    }
+#ifdef QVL_SHA256_AVX2
+    static const bool preferAvx2 = !cpuHasShaExtensions() && isSha256KernelSupported(Sha256Kernel::AVX2);
+    if (preferAvx2)
+    {
+        return Sha256Kernel::AVX2;
+    }
+#endif
+    return Sha256Kernel::OPENSSL;
+}
+
+std::vector<Bytes> sha256Batch(const std::vector<Sha256BatchInput>& inputs, Sha256Kernel kernel)
+{
+    std::vector<Bytes> digests(inputs.size());
+    const auto selected = kernel == Sha256Kernel::AUTO ? selectSha256Kernel() : kernel;
+#ifdef QVL_SHA256_AVX2
+    if (selected == Sha256Kernel::AVX2 && inputs.size() > 1 && isSha256KernelSupported(selected))
+    {
+        sha256Avx2(inputs, digests);
+        return digests;
+    }
+#else
+    (void) selected;
+#endif
+    std::transform(inputs.cbegin(), inputs.cend(), digests.begin(), sha256OpenSsl);
+    return digests;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_SHA256_BATCH_H_
+#define INTEL_SGX_QVL_SHA256_BATCH_H_
+
+#include <OpensslHelpers/Bytes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+/**
+ * Message hashed by sha256Batch, made of two parts that are hashed as if they were one buffer.
+ * Second part is optional, QE Report data covers attestation key followed by QE Authentication Data.
+ */
+struct Sha256BatchInput
+{
+    const uint8_t* data;
+    size_t size;
+    const uint8_t* suffix;
+    size_t suffixSize;
+};
+
+enum class Sha256Kernel
+{
+    AUTO,     // fastest kernel supported by CPU and allowed by algorithms configuration
+    OPENSSL,  // one message after another with SHA-256 fetched by getAlgorithms()
+    AVX2      // eight messages at once in 32-bit lanes of AVX2 registers
+};
+
+/**
+ * @return true when kernel can run on this CPU, AUTO and OPENSSL always can
+ */
+bool isSha256KernelSupported(Sha256Kernel kernel);
+
+/**
+ * @return kernel AUTO resolves to. OPENSSL when CPU has SHA extensions, OpenSSL uses them and is faster then,
+ *         and when algorithms were fetched with a property query (e.g. FIPS provider), as the other kernels
+ *         are not part of the provider.
+ */
+Sha256Kernel selectSha256Kernel();
+
+/**
+ * Computes SHA-256 of every input.
+ *
+ * @return digests in order of inputs, a digest is empty when it could not be computed.
+ *         Unsupported kernel falls back to OPENSSL.
+ */
+std::vector<Bytes> sha256Batch(const std::vector<Sha256BatchInput>& inputs, Sha256Kernel kernel = Sha256Kernel::AUTO);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // INTEL_SGX_QVL_SHA256_BATCH_H_
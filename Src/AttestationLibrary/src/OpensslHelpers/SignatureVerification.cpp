@@ -31,8 +31,11 @@
 
 #include <algorithm>
 #include "SignatureVerification.h"
+#include "Algorithms.h"
 #include "KeyUtils.h"
 
+#include <openssl/sha.h>
+
 namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 bool verifySignature(const pckparser::CrlStore& crl, const std::vector<uint8_t>& pubKey)
@@ -47,13 +50,18 @@ bool verifySignature(const pckparser::CrlStore& crl, const std::vector<uint8_t>&
 
 bool verifySha256Signature(const Bytes& signature, const Bytes& message, const EVP_PKEY& pubKey)
 {
+    const auto algorithms = getAlgorithms();
+    // given key context makes EVP_DigestVerifyInit use configured library context, fetched SHA-256 spares digest fetch
+    auto pkeyCtx = crypto::make_unique(EVP_PKEY_CTX_new_from_pkey(algorithms->getLibraryContext(), &const_cast<EVP_PKEY&>(pubKey),
+                                                                  algorithms->getPropertyQuery()));
     auto ctx = crypto::make_unique(EVP_MD_CTX_new());
-    if (!ctx)
+    if (!ctx || !pkeyCtx || algorithms->getSha256() == nullptr)
     {
         return false;
     }
+    EVP_MD_CTX_set_pkey_ctx(ctx.get(), pkeyCtx.get());
 
-    return (EVP_DigestVerifyInit(ctx.get(), nullptr, EVP_sha256(), nullptr, &const_cast<EVP_PKEY&>(pubKey)) == 1)
+    return (EVP_DigestVerifyInit(ctx.get(), nullptr, algorithms->getSha256(), nullptr, &const_cast<EVP_PKEY&>(pubKey)) == 1)
         && (EVP_DigestVerifyUpdate(ctx.get(), message.data(), message.size()) == 1)
         && (EVP_DigestVerifyFinal(ctx.get(), signature.data(), signature.size()) == 1);
 }
@@ -116,4 +124,17 @@ bool verifySha256EcdsaSignature(const dcap::parser::x509::Signature &signature,
     return verifySha256Signature(signature.getRawDer(), message, *pubKey);
 }
 
+bool verifyEcdsaSignatureOfSha256Digest(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                                        const Bytes &digest, const EVP_PKEY &publicKey)
+{
+    const auto algorithms = getAlgorithms();
+    const auto derSignature = rawEcdsaSignatureToDER(signature);
+    auto ctx = crypto::make_unique(EVP_PKEY_CTX_new_from_pkey(algorithms->getLibraryContext(), &const_cast<EVP_PKEY&>(publicKey),
+                                                              algorithms->getPropertyQuery()));
+    return !derSignature.empty() && digest.size() == SHA256_DIGEST_LENGTH && ctx
+        && (EVP_PKEY_verify_init(ctx.get()) == 1)
+        && (EVP_PKEY_CTX_set_signature_md(ctx.get(), algorithms->getSha256()) == 1)
+        && (EVP_PKEY_verify(ctx.get(), derSignature.data(), derSignature.size(), digest.data(), digest.size()) == 1);
+}
+
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
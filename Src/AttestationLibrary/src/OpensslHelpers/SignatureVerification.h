@@ -69,6 +69,12 @@ bool verifySha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_
 
 bool verifySha256EcdsaSignature(const dcap::parser::x509::Signature &signature, const std::vector<uint8_t> &message, const std::vector<uint8_t> &publicKey);
 
+/**
+ * Verifies raw ECDSA signature over SHA-256 digest computed by the caller, the message itself is not needed.
+ */
+bool verifyEcdsaSignatureOfSha256Digest(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                                        const Bytes &digest, const EVP_PKEY &publicKey);
+
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 
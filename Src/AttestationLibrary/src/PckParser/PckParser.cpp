@@ -57,43 +57,6 @@ bool Extension::operator!=(const Extension& other) const
     return !(*this == other);
 }
 
-bool Issuer::operator==(const Issuer& other) const
-{
-    return commonName == other.commonName
-        && countryName == other.countryName
-        && locationName == other.locationName
-        && stateName == other.stateName
-        && organizationName == other.organizationName;
-}
-
-bool Issuer::operator!=(const Issuer& other) const
-{
-    return !(*this == other);
-}
-
-bool Issuer::operator==(const Subject& subject) const
-{
-    return commonName == subject.commonName
-        && countryName == subject.countryName
-        && locationName == subject.locationName
-        && stateName == subject.stateName
-        && organizationName == subject.organizationName;
-}
-
-bool Issuer::operator!=(const Subject& subject) const
-{
-    return !(*this == subject);
-}
-
-bool Subject::operator==(const Subject& other) const
-{
-    return commonName == other.commonName
-        && countryName == other.countryName
-        && locationName == other.locationName
-        && stateName == other.stateName
-        && organizationName == other.organizationName;
-}
-
 bool Revoked::operator==(const Revoked& other) const
 {
     return serialNumber == other.serialNumber;
@@ -104,25 +67,6 @@ bool Revoked::operator!=(const Revoked& other) const
     return !(*this == other);
 }
 
-bool Subject::operator!=(const Subject& other) const
-{
-    return !(*this == other);
-}
-
-bool Subject::operator==(const Issuer& issuer) const
-{
-    return commonName == issuer.commonName
-        && countryName == issuer.countryName
-        && locationName == issuer.locationName
-        && stateName == issuer.stateName
-        && organizationName == issuer.organizationName;
-}
-
-bool Subject::operator!=(const Issuer& issuer) const
-{
-    return !(*this == issuer);
-}
-
 bool Validity::isValid(const time_t& expirationDate) const
 {
     return expirationDate <= notAfterTime && expirationDate >= notBeforeTime;
@@ -205,10 +149,7 @@ std::string x509NameToString(const X509_NAME* name)
 
     // dataStart ptr is not null terminated
     // we need to rely on returned size
-    std::string ret;
-    std::copy_n(dataStart, nameLength, std::back_inserter(ret));
-
-    return ret;
+    return std::string(dataStart, static_cast<size_t>(nameLength));
 }
 
 std::string getNameEntry(X509_NAME* name, int nid)
@@ -268,11 +209,7 @@ std::string getNameEntry(X509_NAME* name, int nid)
     }
 
 
-    std::string ret;
-    const auto staticCaster = [](unsigned char chr){ return static_cast<char>(chr); };
-    std::transform(strBuff.get(), strBuff.get() + len, std::back_inserter(ret), staticCaster);
-
-    return ret;
+    return std::string(reinterpret_cast<const char*>(strBuff.get()), static_cast<size_t>(len));
 }
 
 std::string asn1ToString(const ASN1_TIME* time)
@@ -416,6 +353,19 @@ std::time_t asn1TimeToTimet(
     static_assert(sizeof(std::time_t) >= sizeof(int64_t), "std::time_t size too small, the dates may overflow");
     static constexpr int64_t SECONDS_IN_A_DAY = 24 * 60 * 60;
 
+    // RFC 5280 profile times are converted directly, other encodings go through OpenSSL
+    const auto type = ASN1_STRING_type(asn1Time);
+    if(type == V_ASN1_UTCTIME || type == V_ASN1_GENERALIZEDTIME)
+    {
+        const std::string_view content(reinterpret_cast<const char*>(ASN1_STRING_get0_data(asn1Time)),
+                                       static_cast<size_t>(ASN1_STRING_length(asn1Time)));
+        time_t converted = 0;
+        if(parseAsn1Time(content, type == V_ASN1_GENERALIZEDTIME, converted))
+        {
+            return converted;
+        }
+    }
+
     int pday;
     int psec;
     auto from = crypto::make_unique(ASN1_TIME_new());
@@ -510,14 +460,14 @@ Issuer getIssuer(const X509_CRL& crl)
         throw FormatException(getLastError());
     }
 
-    return Issuer{
+    return Issuer(
         x509NameToString(issuer),
         getNameEntry(issuer, NID_commonName),
         getNameEntry(issuer, NID_countryName),
         getNameEntry(issuer, NID_organizationName),
         getNameEntry(issuer, NID_localityName),
         getNameEntry(issuer, NID_stateOrProvinceName)
-    };
+    );
 }
 
 int getExtensionCount(const X509_CRL& crl)
@@ -42,44 +42,16 @@
 
 #include <OpensslHelpers/OpensslTypes.h>
 #include <OpensslHelpers/Bytes.h>
+#include <SgxEcdsaAttestation/AttestationParsers.h>
 #include <iostream>
 
 using namespace intel::sgx::dcap;
 
 namespace intel { namespace sgx { namespace dcap { namespace pckparser {
 
-struct Subject;
-struct Issuer
-{
-    std::string raw;
-    std::string commonName;
-    std::string countryName;
-    std::string organizationName;
-    std::string locationName;
-    std::string stateName;
-
-    bool operator ==(const Issuer& other) const;
-    bool operator !=(const Issuer& other) const;
-
-    bool operator ==(const Subject& subject) const;
-    bool operator !=(const Subject& subject) const;
-};
-
-struct Subject
-{
-    std::string raw;
-    std::string commonName;
-    std::string countryName;
-    std::string organizationName;
-    std::string locationName;
-    std::string stateName;
-
-    bool operator ==(const Subject& other) const;
-    bool operator !=(const Subject& other) const;
-
-    bool operator ==(const Issuer& issuer) const;
-    bool operator !=(const Issuer& issuer) const;
-};
+// CRL issuers share the certificate name type so both compare through the interned components
+using Issuer = dcap::parser::x509::DistinguishedName;
+using Subject = dcap::parser::x509::DistinguishedName;
 
 struct Validity
 {
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_TRUSTED
+
+#include "VerificationPipeline.h"
+
+#include "OpensslHelpers/CryptoBackend.h"
+#include "PckParser/CrlStore.h"
+#include "QuoteVerification/Quote.h"
+#include "Verifiers/EnclaveReportVerifier.h"
+#include "Verifiers/QuoteCollateral.h"
+#include "Verifiers/QuoteVerifier.h"
+
+#include <SgxEcdsaAttestation/AttestationParsers.h>
+#include <Utils/Logger.h>
+
+namespace intel { namespace sgx { namespace dcap {
+
+VerifyQuoteRequest::VerifyQuoteRequest(const VerifyQuoteInput& input):
+    quote(input.quote, input.quote + input.quoteSize),
+    pemPckCertificate(input.pemPckCertificate),
+    intermediateCrl(input.intermediateCrl),
+    tcbInfoJson(input.tcbInfoJson),
+    hasQeIdentity(input.qeIdentityJson != nullptr),
+    qeIdentityJson(hasQeIdentity ? input.qeIdentityJson : "")
+{}
+
+struct VerificationPipeline::Job
+{
+    explicit Job(const crypto::CryptoBackend& cryptoBackend): verifier(cryptoBackend)
+    {}
+
+    std::shared_ptr<const VerifyQuoteRequest> request;
+    Completion completion;
+
+    Quote quote;
+    pckparser::CrlStore crl;
+    parser::json::TcbInfo tcbInfo;
+    std::unique_ptr<EnclaveIdentityV2> enclaveIdentity;
+    parser::x509::PckCertificate pckCert;
+    QuoteVerifier verifier;
+    QuoteVerifier::State state;
+};
+
+VerificationPipeline::VerificationPipeline(const Config& config):
+    _maxInFlight(config.maxInFlight),
+    _cryptoBackend(config.cryptoBackend != nullptr ? *config.cryptoBackend : crypto::getOpensslCryptoBackend())
+{
+    // every stage can hold all requests in flight, so handing over to the next stage never fails
+    WorkerPool::Placement placement;
+    placement.pinToCpu = config.pinWorkers;
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage)
+    {
+        _stages[stage] = std::make_unique<WorkerPool>(config.workers[stage], _maxInFlight, placement);
+        placement.firstCpu += _stages[stage]->getWorkerCount();
+    }
+}
+
+VerificationPipeline::~VerificationPipeline()
+{
+    // upstream stage drains into the next one, which must still accept work
+    for (auto& stage : _stages)
+    {
+        stage.reset();
+    }
+}
+
+bool VerificationPipeline::trySubmit(std::shared_ptr<const VerifyQuoteRequest> request, Completion completion)
+{
+    auto inFlight = _inFlight.load();
+    do
+    {
+        if (inFlight >= _maxInFlight)
+        {
+            return false;
+        }
+    } while (!_inFlight.compare_exchange_weak(inFlight, inFlight + 1));
+
+    auto job = std::make_shared<Job>(_cryptoBackend);
+    job->request = std::move(request);
+    job->completion = std::move(completion);
+    schedule(PARSE, std::move(job));
+    return true;
+}
+
+VerificationPipeline::StageMetrics VerificationPipeline::getMetrics(Stage stage) const
+{
+    const auto& counters = _counters.at(stage);
+    return StageMetrics{counters.queued.load(), counters.peakQueued.load(),
+                        counters.processed.load(), counters.earlyExits.load()};
+}
+
+void VerificationPipeline::schedule(Stage stage, std::shared_ptr<Job> job)
+{
+    auto& counters = _counters[stage];
+    const auto queued = ++counters.queued;
+    auto peak = counters.peakQueued.load();
+    while (queued > peak && !counters.peakQueued.compare_exchange_weak(peak, queued))
+    {}
+
+    if (!_stages[stage]->trySubmit([this, stage, job] { execute(stage, job); }))
+    {
+        --counters.queued;
+        LOG_ERROR("Verification pipeline stage {} rejected request", static_cast<size_t>(stage));
+        complete(stage, *job, STATUS_BUSY);
+    }
+}
+
+void VerificationPipeline::execute(Stage stage, const std::shared_ptr<Job>& job)
+{
+    --_counters[stage].queued;
+    const auto status = run(stage, *job);
+    ++_counters[stage].processed;
+
+    if (status != STATUS_OK || stage == EVALUATION)
+    {
+        complete(stage, *job, status);
+        return;
+    }
+    schedule(static_cast<Stage>(stage + 1), job);
+}
+
+Status VerificationPipeline::run(Stage stage, Job& job)
+{
+    const auto& request = *job.request;
+    try
+    {
+        switch (stage)
+        {
+            case PARSE:
+            {
+                /// 4.1.2.4.2
+                if (!job.quote.parse(request.quote) || !job.quote.validate())
+                {
+                    LOG_ERROR("Quote format verification failure");
+                    return STATUS_UNSUPPORTED_QUOTE_FORMAT;
+                }
+                /// 4.1.2.4.5
+                if (!job.crl.parse(request.intermediateCrl))
+                {
+                    LOG_ERROR("PCK Revocation list is invalid. pckCrl: {}", request.intermediateCrl);
+                    return STATUS_UNSUPPORTED_PCK_RL_FORMAT;
+                }
+                const auto collateralStatus = parseQuoteCollateral(request.tcbInfoJson.c_str(),
+                                                                   request.hasQeIdentity ? request.qeIdentityJson.c_str() : nullptr,
+                                                                   job.tcbInfo, job.enclaveIdentity);
+                if (collateralStatus != STATUS_OK)
+                {
+                    return collateralStatus;
+                }
+                job.pckCert = parser::x509::PckCertificate::parse(request.pemPckCertificate);
+                return STATUS_OK;
+            }
+            case COLLATERAL:
+                return job.verifier.verifyCollateral(job.quote, job.pckCert, job.crl, job.tcbInfo, job.state);
+            case SIGNATURE:
+                job.verifier.verifySignatures(job.quote, job.state);
+                return STATUS_OK;
+            case EVALUATION:
+            default:
+                return job.verifier.evaluate(job.quote, job.pckCert, job.tcbInfo, job.enclaveIdentity.get(),
+                                             EnclaveReportVerifier(), job.state);
+        }
+    }
+    catch (const parser::FormatException& ex) /// 4.1.2.4.3
+    {
+        LOG_ERROR("PCK Certificate format error: {}", ex.what());
+        return STATUS_UNSUPPORTED_PCK_CERT_FORMAT;
+    }
+    catch (const parser::InvalidExtensionException& ex) /// 4.1.2.4.4
+    {
+        LOG_ERROR("PCK Certificate invalid extension error: {}", ex.what());
+        return STATUS_INVALID_PCK_CERT;
+    }
+}
+
+void VerificationPipeline::complete(Stage stage, Job& job, Status status)
+{
+    if (stage != EVALUATION)
+    {
+        ++_counters[stage].earlyExits;
+    }
+    job.completion(status);
+    --_inFlight;
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
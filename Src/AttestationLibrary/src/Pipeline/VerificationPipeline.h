@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_VERIFICATIONPIPELINE_H
+#define SGXECDSAATTESTATION_VERIFICATIONPIPELINE_H
+
+#ifndef SGX_TRUSTED
+
+#include "Utils/WorkerPool.h"
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace crypto {
+class CryptoBackend;
+}
+
+/**
+ * Owned copy of sgxAttestationVerifyQuote input, the caller may release its buffers once the request is accepted
+ */
+struct VerifyQuoteRequest
+{
+    explicit VerifyQuoteRequest(const VerifyQuoteInput& input);
+
+    std::vector<uint8_t> quote;
+    std::string pemPckCertificate;
+    std::string intermediateCrl;
+    std::string tcbInfoJson;
+    bool hasQeIdentity;
+    std::string qeIdentityJson;
+};
+
+/**
+ * Quote verification split into stages, each served by its own worker pool:
+ *  - PARSE: quote, CRL, TCB Info, QE Identity and PCK certificate parsing
+ *  - COLLATERAL: PCK certificate and CRL checks against each other and against TCB Info
+ *  - SIGNATURE: ECDSA verification of QE Report and Quote
+ *  - EVALUATION: QE Identity and TCB level evaluation
+ * A request failing a stage completes right away without entering the next ones. Results are the same as returned
+ * by sgxAttestationVerifyQuote for the same input.
+ */
+class VerificationPipeline
+{
+public:
+    enum Stage : size_t
+    {
+        PARSE = 0,
+        COLLATERAL,
+        SIGNATURE,
+        EVALUATION,
+        STAGE_COUNT
+    };
+
+    struct Config
+    {
+        std::array<size_t, STAGE_COUNT> workers; // 0 selects number of hardware threads
+        size_t maxInFlight;                      // accepted and not completed requests
+        bool pinWorkers = false;                 // bind workers to CPUs, stages get consecutive CPUs
+        const crypto::CryptoBackend* cryptoBackend = nullptr; // not owned, NULL selects OpenSSL
+    };
+
+    struct StageMetrics
+    {
+        size_t queueDepth;      // requests waiting for a worker of the stage
+        size_t peakQueueDepth;
+        uint64_t processed;     // requests the stage has finished working on
+        uint64_t earlyExits;    // requests completed by the stage before reaching EVALUATION
+    };
+
+    using Completion = std::function<void(Status)>;
+
+    explicit VerificationPipeline(const Config& config);
+
+    /**
+     * Completes all accepted requests, stage by stage
+     */
+    ~VerificationPipeline();
+
+    VerificationPipeline(const VerificationPipeline&) = delete;
+    VerificationPipeline& operator=(const VerificationPipeline&) = delete;
+
+    /**
+     * @return false when maxInFlight requests are already in the pipeline, completion is not called then
+     */
+    bool trySubmit(std::shared_ptr<const VerifyQuoteRequest> request, Completion completion);
+
+    StageMetrics getMetrics(Stage stage) const;
+
+private:
+    struct Job;
+
+    struct Counters
+    {
+        std::atomic<size_t> queued{0};
+        std::atomic<size_t> peakQueued{0};
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> earlyExits{0};
+    };
+
+    void schedule(Stage stage, std::shared_ptr<Job> job);
+    void execute(Stage stage, const std::shared_ptr<Job>& job);
+    static Status run(Stage stage, Job& job);
+    void complete(Stage stage, Job& job, Status status);
+
+    const size_t _maxInFlight;
+    const crypto::CryptoBackend& _cryptoBackend;
+    std::atomic<size_t> _inFlight{0};
+    std::array<Counters, STAGE_COUNT> _counters;
+    std::array<std::unique_ptr<WorkerPool>, STAGE_COUNT> _stages;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
+
+#endif //SGXECDSAATTESTATION_VERIFICATIONPIPELINE_H
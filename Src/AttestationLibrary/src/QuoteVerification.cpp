@@ -30,11 +30,15 @@
  */
 
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <algorithm>
 #include <openssl/provider.h>
 
+#include "OpensslHelpers/Algorithms.h"
+#include "OpensslHelpers/Sha256Batch.h"
 #include "PckParser/CrlStore.h"
 #include "CertVerification/CertificateChain.h"
 #include "QuoteVerification/Quote.h"
@@ -49,6 +53,7 @@
 #include "Verifiers/QuoteVerifier.h"
 #include "Verifiers/EnclaveIdentityParser.h"
 #include "Verifiers/EnclaveIdentityV2.h"
+#include "Verifiers/QuoteCollateral.h"
 #include "Utils/TimeUtils.h"
 #include "Utils/SafeMemcpy.h"
 
@@ -75,6 +80,17 @@ const char* sgxAttestationGetVersion()
     return ver;
 }
 
+Status sgxAttestationSetCryptoContext(OSSL_LIB_CTX* libCtx, const char* propertyQuery)
+{
+    if (!dcap::crypto::setAlgorithmsContext(libCtx, propertyQuery))
+    {
+        LOG_ERROR("SHA-256 or P-256 can't be fetched from library context with property query: {}",
+                  propertyQuery != nullptr ? propertyQuery : "");
+        return STATUS_INVALID_PARAMETER;
+    }
+    return STATUS_OK;
+}
+
 void sgxEnclaveAttestationGetVersion(char *version, size_t len)
 {
     auto ver = std::string(sgxAttestationGetVersion());
@@ -373,48 +389,288 @@ Status sgxAttestationVerifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, co
         return STATUS_UNSUPPORTED_PCK_RL_FORMAT;
     }
 
-    /// 4.1.2.4.8
     dcap::parser::json::TcbInfo tcbInfo;
+    std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentity;
+    const auto collateralStatus = dcap::parseQuoteCollateral(tcbInfoJson, qeIdentityJson, tcbInfo, enclaveIdentity);
+    if (collateralStatus != STATUS_OK)
+    {
+        return collateralStatus;
+    }
+
     try
     {
-        tcbInfo = dcap::parser::json::TcbInfo::parse(tcbInfoJson);
+        auto pckCert = dcap::parser::x509::PckCertificate::parse(pemPckCertificate);
+        return dcap::QuoteVerifier{}.verify(quote, pckCert, pckCrlStore, tcbInfo, enclaveIdentity.get(), dcap::EnclaveReportVerifier());
     }
-    catch (const dcap::parser::FormatException& ex)
+    catch (const dcap::parser::FormatException& ex) /// 4.1.2.4.3
     {
-        LOG_ERROR("TcbInfo format error: {}", ex.what());
-        return STATUS_UNSUPPORTED_TCB_INFO_FORMAT;
+        LOG_ERROR("PCK Certificate format error: {}", ex.what());
+        return STATUS_UNSUPPORTED_PCK_CERT_FORMAT;
     }
-    catch (const dcap::parser::InvalidExtensionException& ex)
+    catch (const dcap::parser::InvalidExtensionException& ex) /// 4.1.2.4.4
+    {
+        LOG_ERROR("PCK Certificate invalid extension error: {}", ex.what());
+        return STATUS_INVALID_PCK_CERT;
+    }
+}
+
+Status sgxAttestationCollateralCreate(const char* pemPckCertificate, const char* intermediateCrl, const char* tcbInfoJson,
+                                      const char* qeIdentityJson, VerificationCollateral** collateral)
+{
+    if (!intermediateCrl || !tcbInfoJson || !collateral)
     {
-        LOG_ERROR("TcbInfo invalid extension error: {}", ex.what());
-        return STATUS_UNSUPPORTED_TCB_INFO_FORMAT;
+        LOG_ERROR("intermediateCrl, tcbInfoJson or collateral was not provided");
+        return STATUS_MISSING_PARAMETERS;
     }
 
-    dcap::EnclaveIdentityParser parser;
-    std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentity;
-    if (qeIdentityJson != nullptr)
+    auto parsed = std::make_unique<VerificationCollateral>();
+    if (!parsed->crl.parse(intermediateCrl))
     {
-        try {
-            enclaveIdentity = parser.parse(qeIdentityJson);
+        LOG_ERROR("PCK Revocation list is invalid. pckCrl: {}", intermediateCrl);
+        return STATUS_UNSUPPORTED_PCK_RL_FORMAT;
+    }
+
+    const auto collateralStatus = dcap::parseQuoteCollateral(tcbInfoJson, qeIdentityJson, parsed->tcbInfo, parsed->enclaveIdentity);
+    if (collateralStatus != STATUS_OK)
+    {
+        return collateralStatus;
+    }
+
+    if (pemPckCertificate)
+    {
+        auto pckCert = std::make_unique<dcap::parser::x509::PckCertificate>();
+        const auto pckStatus = dcap::parsePckCertificate(pemPckCertificate, *pckCert);
+        if (pckStatus != STATUS_OK)
+        {
+            return pckStatus;
         }
-        catch (const dcap::ParserException& ex)
+        parsed->pckCert = std::move(pckCert);
+    }
+
+    static std::atomic<uint64_t> nextSnapshotId{1};
+    parsed->snapshotId = nextSnapshotId++;
+    *collateral = parsed.release();
+    return STATUS_OK;
+}
+
+void sgxAttestationCollateralDestroy(VerificationCollateral* collateral)
+{
+    delete collateral;
+}
+
+Status sgxAttestationVerifyQuoteWithCollateral(const uint8_t* rawQuote, uint32_t quoteSize, const char* pemPckCertificate,
+                                               const VerificationCollateral* collateral)
+{
+    if (!rawQuote || !collateral || (!pemPckCertificate && !collateral->pckCert))
+    {
+        LOG_ERROR("rawQuote, collateral or PCK certificate was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    const std::vector<uint8_t> vecQuote(rawQuote, std::next(rawQuote, quoteSize));
+
+    /// 4.1.2.4.2
+    dcap::Quote quote;
+    if (!quote.parse(vecQuote) || !quote.validate())
+    {
+        LOG_ERROR("Quote format verification failure");
+        return Status::STATUS_UNSUPPORTED_QUOTE_FORMAT;
+    }
+
+    const auto verifyWith = [&](const dcap::parser::x509::PckCertificate& pckCert) {
+        return dcap::QuoteVerifier{}.verify(quote, pckCert, collateral->crl, collateral->tcbInfo,
+                                           collateral->enclaveIdentity.get(), dcap::EnclaveReportVerifier());
+    };
+
+    if (!pemPckCertificate)
+    {
+        return verifyWith(*collateral->pckCert);
+    }
+
+    dcap::parser::x509::PckCertificate pckCert;
+    const auto pckStatus = dcap::parsePckCertificate(pemPckCertificate, pckCert);
+    return pckStatus != STATUS_OK ? pckStatus : verifyWith(pckCert);
+}
+
+Status sgxAttestationVerifyQuoteBatch(const uint8_t* const quotes[], const uint32_t quoteSizes[], uint32_t quoteCount,
+                                      const char* pemPckCertificate, const VerificationCollateral* collateral,
+                                      Status statuses[])
+{
+    if ((quoteCount != 0 && (!quotes || !quoteSizes || !statuses)) || !collateral ||
+        (!pemPckCertificate && !collateral->pckCert))
+    {
+        LOG_ERROR("quotes, statuses, collateral or PCK certificate was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    dcap::parser::x509::PckCertificate parsedPckCert;
+    if (pemPckCertificate)
+    {
+        const auto pckStatus = dcap::parsePckCertificate(pemPckCertificate, parsedPckCert);
+        if (pckStatus != STATUS_OK)
+        {
+            return pckStatus;
+        }
+    }
+    const auto& pckCert = pemPckCertificate ? parsedPckCert : *collateral->pckCert;
+
+    /// 4.1.2.4.2
+    std::vector<std::vector<uint8_t>> rawQuotes(quoteCount);
+    std::vector<dcap::Quote> parsedQuotes(quoteCount);
+    std::vector<uint32_t> parsedIndices;
+    std::vector<dcap::crypto::Sha256BatchInput> hashInputs;
+    hashInputs.reserve(2 * static_cast<size_t>(quoteCount));
+    for (uint32_t i = 0; i < quoteCount; ++i)
+    {
+        if (!quotes[i])
+        {
+            statuses[i] = STATUS_MISSING_PARAMETERS;
+            continue;
+        }
+        rawQuotes[i].assign(quotes[i], std::next(quotes[i], quoteSizes[i]));
+        auto& quote = parsedQuotes[i];
+        if (!quote.parse(rawQuotes[i], dcap::Quote::Digests::DEFERRED) || !quote.validate())
+        {
+            LOG_ERROR("Quote format verification failure");
+            statuses[i] = STATUS_UNSUPPORTED_QUOTE_FORMAT;
+            continue;
+        }
+        parsedIndices.push_back(i);
+        hashInputs.push_back({rawQuotes[i].data(), quote.getSignedDataSize(), nullptr, 0});
+        hashInputs.push_back({quote.getAttestKeyData().data(), quote.getAttestKeyData().size(),
+                              quote.getQeAuthData().data(), quote.getQeAuthData().size()});
+    }
+
+    auto digests = dcap::crypto::sha256Batch(hashInputs);
+    for (size_t parsed = 0; parsed < parsedIndices.size(); ++parsed)
+    {
+        const auto i = parsedIndices[parsed];
+        parsedQuotes[i].setDigests(std::move(digests[2 * parsed]), std::move(digests[2 * parsed + 1]));
+        statuses[i] = dcap::QuoteVerifier{}.verify(parsedQuotes[i], pckCert, collateral->crl, collateral->tcbInfo,
+                                                   collateral->enclaveIdentity.get(), dcap::EnclaveReportVerifier());
+    }
+    return STATUS_OK;
+}
+
+Status sgxAttestationVerifyQuoteWithCertificationData(const uint8_t* rawQuote, uint32_t quoteSize, const char *const crls[],
+                                                      const char *pemRootCaCertificate, const char* tcbInfoJson,
+                                                      const char* qeIdentityJson, const time_t* expirationDate)
+{
+    time_t currentTime;
+    try
+    {
+        currentTime = dcap::getCurrentTime(expirationDate);
+    }
+    catch (const std::runtime_error&)
+    {
+        LOG_ERROR("Can't get current time or it was not provided");
+        return STATUS_INVALID_PARAMETER;
+    }
+
+    if(!rawQuote ||
+       !crls ||
+       !crls[0] ||
+       !crls[1] ||
+       !pemRootCaCertificate ||
+       !tcbInfoJson)
+    {
+        LOG_ERROR("rawQuote, CRLs (RootCaCrl, IntermediateCaCrl), pemRootCaCertificate, tcbInfoJson was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    const std::vector<uint8_t> vecQuote(rawQuote, std::next(rawQuote, quoteSize));
+
+    dcap::Quote quote;
+    if(!quote.parse(vecQuote) || !quote.validate())
+    {
+        LOG_ERROR("Quote format verification failure");
+        return Status::STATUS_UNSUPPORTED_QUOTE_FORMAT;
+    }
+
+    const auto& certificationData = quote.getCertificationData();
+    if(certificationData.type != dcap::constants::PCK_ID_PCK_CERT_CHAIN)
+    {
+        LOG_ERROR("Quote does not carry PCK certificate chain. Certification data type: {}", certificationData.type);
+        return STATUS_UNSUPPORTED_PCK_CERT_FORMAT;
+    }
+
+    // Chain is parsed straight from the quote buffer, certificates are the only copies made
+    const std::string_view pemCertChain(reinterpret_cast<const char*>(certificationData.data.data()), certificationData.data.size());
+    dcap::CertificateChain chain;
+    const auto chainStatus = chain.parse(pemCertChain);
+    if(chainStatus != STATUS_OK)
+    {
+        LOG_ERROR("PCK Cert Chain parse error: {}", chainStatus);
+        return chainStatus;
+    }
+
+    if(chain.length() != EXPECTED_CERTIFICATE_COUNT_IN_PCK_CHAIN)
+    {
+        LOG_ERROR("PCK chain length is not correct. Expected: {}, actual: {}",
+                  EXPECTED_CERTIFICATE_COUNT_IN_PCK_CHAIN, chain.length());
+        return STATUS_UNSUPPORTED_CERT_FORMAT;
+    }
+
+    // Intermediate CA CRL is parsed once and serves both chain and quote verification
+    dcap::pckparser::CrlStore rootCaCrl, intermediateCrl;
+    if(!rootCaCrl.parse(crls[0]))
+    {
+        LOG_ERROR("rootCaCrl parsing failed. RootCaCrl: {}", crls[0]);
+        return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
+    }
+
+    if(!intermediateCrl.parse(crls[1]))
+    {
+        LOG_ERROR("IntermediateCaCrl parsing failed. IntermediateCaCrl: {}", crls[1]);
+        return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
+    }
+
+    dcap::parser::json::TcbInfo tcbInfo;
+    std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentity;
+    const auto collateralStatus = dcap::parseQuoteCollateral(tcbInfoJson, qeIdentityJson, tcbInfo, enclaveIdentity);
+    if (collateralStatus != STATUS_OK)
+    {
+        return collateralStatus;
+    }
+
+    try
+    {
+        const auto rootCa = dcap::parser::x509::Certificate::parse(pemRootCaCertificate);
+        const auto chainVerificationStatus = dcap::PckCertVerifier{}.verify(chain, rootCaCrl, intermediateCrl, rootCa, currentTime);
+        if(chainVerificationStatus != STATUS_OK)
         {
-            LOG_ERROR("Enclave Identity parsing error: {}", ex.what());
-            return STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT;
+            LOG_ERROR("PCK Cert Chain verification failed: {}", chainVerificationStatus);
+            return chainVerificationStatus;
         }
     }
+    catch (const dcap::parser::FormatException& ex)
+    {
+        LOG_ERROR("Trusted RootCA parsing failed: {}", ex.what());
+        return STATUS_TRUSTED_ROOT_CA_UNSUPPORTED_FORMAT;
+    }
+    catch (const dcap::parser::InvalidExtensionException& ex)
+    {
+        LOG_ERROR("Trusted RootCA parsing failed: {}", ex.what());
+        return STATUS_TRUSTED_ROOT_CA_UNSUPPORTED_FORMAT;
+    }
+
+    const auto pckCert = chain.getPckCert();
+    if(!pckCert)
+    {
+        LOG_ERROR("PCK Certificate not found in PCK Cert Chain");
+        return STATUS_SGX_PCK_MISSING;
+    }
 
     try
     {
-        auto pckCert = dcap::parser::x509::PckCertificate::parse(pemPckCertificate);
-        return dcap::QuoteVerifier{}.verify(quote, pckCert, pckCrlStore, tcbInfo, enclaveIdentity.get(), dcap::EnclaveReportVerifier());
+        return dcap::QuoteVerifier{}.verify(quote, *pckCert, intermediateCrl, tcbInfo, enclaveIdentity.get(), dcap::EnclaveReportVerifier());
     }
-    catch (const dcap::parser::FormatException& ex) /// 4.1.2.4.3
+    catch (const dcap::parser::FormatException& ex)
     {
         LOG_ERROR("PCK Certificate format error: {}", ex.what());
         return STATUS_UNSUPPORTED_PCK_CERT_FORMAT;
     }
-    catch (const dcap::parser::InvalidExtensionException& ex) /// 4.1.2.4.4
+    catch (const dcap::parser::InvalidExtensionException& ex)
     {
         LOG_ERROR("PCK Certificate invalid extension error: {}", ex.what());
         return STATUS_INVALID_PCK_CERT;
@@ -31,15 +31,65 @@
 
 #include "Quote.h"
 #include "QuoteParsers.h"
+#include "OpensslHelpers/DigestUtils.h"
 #include "Utils/Logger.h"
 
 #include <algorithm>
 #include <iterator>
+#include <optional>
 
 namespace intel { namespace sgx { namespace dcap {
 using namespace constants;
 
-bool Quote::parse(const std::vector<uint8_t>& rawQuote)
+namespace {
+
+// hashes quote section the parser has just walked through, from its first byte up to the current position
+void hashSection(std::optional<crypto::Sha256>& hash, std::vector<uint8_t>::const_iterator sectionBegin,
+                 std::vector<uint8_t>::const_iterator from)
+{
+    if (hash)
+    {
+        hash->update(&*sectionBegin, static_cast<size_t>(std::distance(sectionBegin, from)));
+    }
+}
+
+// zero-filled structure returned for parts the parsed quote doesn't carry
+template<typename T>
+const T& empty()
+{
+    static const T value{};
+    return value;
+}
+
+template<typename T, typename Variant>
+const T& storedOrEmpty(const Variant& stored)
+{
+    const auto* value = std::get_if<T>(&stored);
+    return value != nullptr ? *value : empty<T>();
+}
+
+// reads report of given body type, which must match declared report size
+template<size_t BodyType, typename Report>
+bool readReport(Report& report, uint32_t declaredSize, std::vector<uint8_t>::const_iterator& from,
+                const std::vector<uint8_t>::const_iterator& end)
+{
+    using Traits = ReportTraits<BodyType>;
+    if (declaredSize != Traits::BYTE_LEN)
+    {
+        LOG_ERROR("Unexpected {} size. Expected size: {}", Traits::NAME, Traits::BYTE_LEN);
+        return false;
+    }
+    if (!copyAndAdvance(report.template emplace<typename Traits::Type>(), from, Traits::BYTE_LEN, end))
+    {
+        LOG_ERROR("Can't read {} from quote. Expected size: {}", Traits::NAME, Traits::BYTE_LEN);
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool Quote::parse(const std::vector<uint8_t>& rawQuote, Digests digests)
 {
     if(rawQuote.size() < QUOTE_MIN_BYTE_LEN)
     {
@@ -48,19 +98,24 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     }
 
     auto from = rawQuote.cbegin();
+    std::optional<crypto::Sha256> signedDataHash;
+    if (digests == Digests::COMPUTE)
+    {
+        signedDataHash.emplace();
+    }
     Header localHeader{};
     if (!copyAndAdvance(localHeader, from, HEADER_BYTE_LEN, rawQuote.cend())) {
         LOG_ERROR("Can't read header from quote. Expected size: {}", HEADER_BYTE_LEN);
         return false;
     }
+    hashSection(signedDataHash, rawQuote.cbegin(), from);
 
     header = localHeader;
 
     Body localBody{};
-    EnclaveReport localEnclaveReport{};
-    TDReport10 localTdReport10{};
-    TDReport15 localTdReport15{};
+    Report localReport{};
 
+    const auto reportBegin = from;
     if (localHeader.version > constants::QUOTE_VERSION_4)
     {
         if (!copyAndAdvance(localBody, from, BODY_BYTE_SIZE, rawQuote.end()))
@@ -69,72 +124,42 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
             return false;
         }
 
+        bool reportRead = false;
         switch (localBody.bodyType) {
-            case BODY_SGX_ENCLAVE_REPORT_TYPE: // SGX Enclave Report
-                if (localBody.size != ENCLAVE_REPORT_BYTE_LEN)
-                {
-                    LOG_ERROR("Unexpected SGX enclave report size. Expected size: {}", ENCLAVE_REPORT_BYTE_LEN);
-                    return false;
-                }
-                if (!copyAndAdvance(localEnclaveReport, from, ENCLAVE_REPORT_BYTE_LEN, rawQuote.end()))
-                {
-                    LOG_ERROR("Can't read SGX enclave report from quote. Expected size: {}", ENCLAVE_REPORT_BYTE_LEN);
-                    return false;
-                }
-                signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + BODY_BYTE_SIZE + QE_REPORT_BYTE_LEN);
+            case BODY_SGX_ENCLAVE_REPORT_TYPE:
+                reportRead = readReport<BODY_SGX_ENCLAVE_REPORT_TYPE>(localReport, localBody.size, from, rawQuote.end());
                 break;
-            case BODY_TD_REPORT10_TYPE: // TD Report for TDX 1.0
-                if (localBody.size != TD_REPORT10_BYTE_LEN)
-                {
-                    LOG_ERROR("Unexpected TDX TD Report 1.0 size. Expected size: {}", TD_REPORT10_BYTE_LEN);
-                    return false;
-                }
-                if (!copyAndAdvance(localTdReport10, from, TD_REPORT10_BYTE_LEN, rawQuote.end()))
-                {
-                    LOG_ERROR("Can't read TDX TD Report 1.0 from quote. Expected size: {}", TD_REPORT10_BYTE_LEN);
-                    return false;
-                }
-                signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + BODY_BYTE_SIZE + TD_REPORT10_BYTE_LEN);
+            case BODY_TD_REPORT10_TYPE:
+                reportRead = readReport<BODY_TD_REPORT10_TYPE>(localReport, localBody.size, from, rawQuote.end());
                 break;
-            case BODY_TD_REPORT15_TYPE: // TD Report for TDX 1.5
-                if (localBody.size != TD_REPORT15_BYTE_LEN)
-                {
-                    LOG_ERROR("Unexpected TDX TD Report 1.5 size. Expected size: {}", TD_REPORT15_BYTE_LEN);
-                    return false;
-                }
-                if (!copyAndAdvance(localTdReport15, from, TD_REPORT15_BYTE_LEN, rawQuote.end()))
-                {
-                    LOG_ERROR("Can't read TDX TD Report 1.5 from quote. Expected size: {}", TD_REPORT10_BYTE_LEN);
-                    return false;
-                }
-                signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + BODY_BYTE_SIZE + TD_REPORT15_BYTE_LEN);
+            case BODY_TD_REPORT15_TYPE:
+                reportRead = readReport<BODY_TD_REPORT15_TYPE>(localReport, localBody.size, from, rawQuote.end());
                 break;
             default: // Unknown body type
-                return false;
+                break;
+        }
+        if (!reportRead)
+        {
+            return false;
         }
     }
-    else
+    else // report type is implied by TEE type, quote of unknown TEE type carries no report
     {
-        if (localHeader.teeType == TEE_TYPE_SGX)
+        if (localHeader.teeType == TEE_TYPE_SGX &&
+            !readReport<BODY_SGX_ENCLAVE_REPORT_TYPE>(localReport, ENCLAVE_REPORT_BYTE_LEN, from, rawQuote.end()))
         {
-            if (!copyAndAdvance(localEnclaveReport, from, ENCLAVE_REPORT_BYTE_LEN, rawQuote.end()))
-            {
-                LOG_ERROR("Can't read SGX enclave report from quote. Expected size: {}", ENCLAVE_REPORT_BYTE_LEN);
-                return false;
-            }
-            signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + QE_REPORT_BYTE_LEN);
+            return false;
         }
-        else if (localHeader.teeType == TEE_TYPE_TDX)
+        if (localHeader.teeType == TEE_TYPE_TDX &&
+            !readReport<BODY_TD_REPORT10_TYPE>(localReport, TD_REPORT10_BYTE_LEN, from, rawQuote.end()))
         {
-            if (!copyAndAdvance(localTdReport10, from, TD_REPORT10_BYTE_LEN, rawQuote.end()))
-            {
-                LOG_ERROR("Can't read TDX TD Report 1.0 from quote. Expected size: {}", TD_REPORT10_BYTE_LEN);
-                return false;
-            }
-            signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + TD_REPORT10_BYTE_LEN);
+            return false;
         }
     }
 
+    hashSection(signedDataHash, reportBegin, from);
+    const auto localSignedDataSize = static_cast<size_t>(std::distance(rawQuote.cbegin(), from));
+
     uint32_t localAuthDataSize = 0;
     if (!copyAndAdvance(localAuthDataSize, from, rawQuote.end())) {
         LOG_ERROR("Can't read auth data size  from quote.");
@@ -147,52 +172,50 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
         return false;
     }
 
-    Ecdsa256BitQuoteV3AuthData localQuoteV3Auth{};
-    Ecdsa256BitQuoteV4AuthData localQuoteV4Auth{};
+    AuthData localAuthData{};
     if (localHeader.version == constants::QUOTE_VERSION_3)
     {
-        if (!copyAndAdvance(localQuoteV3Auth, from, static_cast<size_t>(localAuthDataSize), rawQuote.end()))
+        if (!copyAndAdvance(localAuthData.emplace<Ecdsa256BitQuoteV3AuthData>(), from,
+                            static_cast<size_t>(localAuthDataSize), rawQuote.end()))
         {
             LOG_ERROR("Can't read QUOTE v3 Auth data. Expected size: {}", localAuthDataSize);
             return false;
         }
-        qeReportSignature = localQuoteV3Auth.qeReportSignature.signature;
-        qeReport = localQuoteV3Auth.qeReport;
-        attestKeyData = localQuoteV3Auth.ecdsaAttestationKey.pubKey;
-        qeAuthData = localQuoteV3Auth.qeAuthData.data;
-        certificationData = localQuoteV3Auth.certificationData;
-        quoteSignature = localQuoteV3Auth.ecdsa256BitSignature.signature;
     }
     else if (localHeader.version > constants::QUOTE_VERSION_3)
     {
-        if (!copyAndAdvance(localQuoteV4Auth, from, static_cast<size_t>(localAuthDataSize), rawQuote.end()))
+        auto& localQuoteV4Auth = localAuthData.emplace<AuthDataV4>();
+        if (!copyAndAdvance(localQuoteV4Auth.authData, from, static_cast<size_t>(localAuthDataSize), rawQuote.end()))
         {
             LOG_ERROR("Can't read QUOTE v4 Auth data. Expected size: {}", localAuthDataSize);
             return false;
         }
-        
-        const auto reportBytes = localQuoteV4Auth.certificationData.data;
+
+        const auto& reportBytes = localQuoteV4Auth.authData.certificationData.data;
         auto beg = reportBytes.cbegin();
-        QEReportCertificationData qeReportData;
-        if (!qeReportData.insert(beg, reportBytes.cend()))
+        if (!localQuoteV4Auth.qeReportCertificationData.insert(beg, reportBytes.cend()))
         {
             return false;
         }
-        qeReportSignature = qeReportData.qeReportSignature.signature;
-        qeReport = qeReportData.qeReport;
-        qeAuthData = qeReportData.qeAuthData.data;
-        attestKeyData = localQuoteV4Auth.ecdsaAttestationKey.pubKey;
-        certificationData = qeReportData.certificationData;
-        quoteSignature = localQuoteV4Auth.ecdsa256BitSignature.signature;
     }
 
     body = localBody;
-    enclaveReport = localEnclaveReport;
-    tdReport10 = localTdReport10;
-    tdReport15 = localTdReport15;
+    report = std::move(localReport);
+    layoutId = quote::getLayoutId(localHeader.version, localHeader.teeType, localBody.bodyType);
     authDataSize = localAuthDataSize;
-    authDataV3 = std::move(localQuoteV3Auth);
-    authDataV4 = std::move(localQuoteV4Auth);
+    authData = std::move(localAuthData);
+    signedDataSize = localSignedDataSize;
+    if (signedDataHash)
+    {
+        crypto::Sha256 qeReportDataHash;
+        qeReportDataHash.update(getAttestKeyData().data(), getAttestKeyData().size());
+        qeReportDataHash.update(getQeAuthData().data(), getQeAuthData().size());
+        setDigests(signedDataHash->finalize(), qeReportDataHash.finalize());
+    }
+    else
+    {
+        setDigests(Bytes{}, Bytes{});
+    }
 
     return true;
 }
@@ -224,52 +247,35 @@ bool Quote::validate() const
         return false;
     }
 
+    if (layoutId == LayoutId::UNSUPPORTED)
+    {
+        LOG_ERROR("Quote v{} does not support TEE type {} with body type {}", header.version, header.teeType, body.bodyType);
+        return false;
+    }
+
     if (header.version == QUOTE_VERSION_3)
     {
-        if (header.teeType != TEE_TYPE_SGX)
-        {
-            LOG_ERROR("Quote v3 supports only SGX tee type but found {}", header.teeType);
-            return false;
-        }
-        if (authDataV3.certificationData.type < 1 || authDataV3.certificationData.type > 5) // QuoteV3 supports only 1-5 types
+        const auto& certificationData = getAuthDataV3().certificationData;
+        if (certificationData.type < 1 || certificationData.type > 5) // QuoteV3 supports only 1-5 types
         {
             LOG_ERROR("Quote v3 supports certification data types from 1 to 5 but found {}",
-                      authDataV3.certificationData.type);
+                      certificationData.type);
             return false;
         }
     }
 
     if(header.version == QUOTE_VERSION_4 || header.version == QUOTE_VERSION_5)
     {
-        if (authDataV4.certificationData.type != constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA)
+        if (getAuthDataV4().certificationData.type != constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA)
         {
             LOG_ERROR("Quote v4 supports only {} certification data type but found {}",
-                      constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA, authDataV4.certificationData.type);
+                      constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA, getAuthDataV4().certificationData.type);
             return false;
         }
-        if (certificationData.type < 1 || certificationData.type > 5)
+        if (getCertificationData().type < 1 || getCertificationData().type > 5)
         {
             LOG_ERROR("Quote v4 supports QE Report Certification data types from 1 to 5 but found: {}",
-                      certificationData.type);
-            return false;
-        }
-    }
-
-    if (header.version == QUOTE_VERSION_5)
-    {
-        if(std::find(ALLOWED_BODY_TYPES.begin(), ALLOWED_BODY_TYPES.end(), body.bodyType) ==
-           ALLOWED_BODY_TYPES.end())
-        {
-            return false;
-        }
-
-        if (header.teeType == TEE_TYPE_SGX && body.bodyType != BODY_SGX_ENCLAVE_REPORT_TYPE)
-        {
-            return false;
-        }
-
-        if (header.teeType != TEE_TYPE_SGX && body.bodyType == BODY_SGX_ENCLAVE_REPORT_TYPE)
-        {
+                      getCertificationData().type);
             return false;
         }
     }
@@ -277,6 +283,11 @@ bool Quote::validate() const
     return true;
 }
 
+LayoutId Quote::getLayoutId() const
+{
+    return layoutId;
+}
+
 const Header& Quote::getHeader() const
 {
     return header;
@@ -289,125 +300,138 @@ const Body& Quote::getBody() const
 
 const EnclaveReport& Quote::getEnclaveReport() const
 {
-    return enclaveReport;
+    return storedOrEmpty<EnclaveReport>(report);
 }
 
 const TDReport10& Quote::getTdReport10() const
 {
-    return tdReport10;
+    return storedOrEmpty<TDReport10>(report);
 }
 
 const TDReport15& Quote::getTdReport15() const
 {
-    return tdReport15;
+    return storedOrEmpty<TDReport15>(report);
 }
 
-uint32_t Quote::getAuthDataSize() const
+const TDReport10* Quote::getTdReport() const
 {
-    return authDataSize;
+    if (const auto* tdReport15 = std::get_if<TDReport15>(&report))
+    {
+        return tdReport15;
+    }
+    return std::get_if<TDReport10>(&report);
 }
 
-const std::vector<uint8_t>& Quote::getSignedData() const
+uint32_t Quote::getAuthDataSize() const
 {
-    return signedData;
+    return authDataSize;
 }
 
-const Ecdsa256BitQuoteV3AuthData& Quote::getAuthDataV3() const
+const Bytes& Quote::getSignedDataDigest() const
 {
-    return authDataV3;
+    return signedDataDigest;
 }
 
-const Ecdsa256BitQuoteV4AuthData& Quote::getAuthDataV4() const {
-    return authDataV4;
-}
-
-const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN> &Quote::getQeReportSignature() const {
-    return qeReportSignature;
-}
-
-const EnclaveReport &Quote::getQeReport() const {
-    return qeReport;
+const Bytes& Quote::getQeReportDataDigest() const
+{
+    return qeReportDataDigest;
 }
 
-const std::array<uint8_t, constants::ECDSA_PUBKEY_BYTE_LEN> &Quote::getAttestKeyData() const {
-    return attestKeyData;
+size_t Quote::getSignedDataSize() const
+{
+    return signedDataSize;
 }
 
-const std::vector<uint8_t> &Quote::getQeAuthData() const {
-    return qeAuthData;
+void Quote::setDigests(Bytes signedData, Bytes qeReportData)
+{
+    signedDataDigest = std::move(signedData);
+    qeReportDataDigest = std::move(qeReportData);
 }
 
-const CertificationData &Quote::getCertificationData() const {
-    return certificationData;
+const Ecdsa256BitQuoteV3AuthData& Quote::getAuthDataV3() const
+{
+    return storedOrEmpty<Ecdsa256BitQuoteV3AuthData>(authData);
 }
 
-const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN> &Quote::getQuoteSignature() const {
-    return quoteSignature;
+const Ecdsa256BitQuoteV4AuthData& Quote::getAuthDataV4() const
+{
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
+    {
+        return authDataV4->authData;
+    }
+    return empty<Ecdsa256BitQuoteV4AuthData>();
 }
 
-const std::array<uint8_t, 16> &Quote::getTeeTcbSvn() const {
-    if (header.version == QUOTE_VERSION_4)
+const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN>& Quote::getQeReportSignature() const
+{
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
     {
-        return tdReport10.teeTcbSvn;
+        return authDataV4->qeReportCertificationData.qeReportSignature.signature;
     }
-    else // Quote V5 and higher
+    return getAuthDataV3().qeReportSignature.signature;
+}
+
+const EnclaveReport& Quote::getQeReport() const
+{
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
     {
-        if (body.bodyType == dcap::constants::BODY_TD_REPORT10_TYPE)
-        {
-            return tdReport10.teeTcbSvn;
-        }
-        else
-        {
-            return tdReport15.teeTcbSvn;
-        }
+        return authDataV4->qeReportCertificationData.qeReport;
     }
+    return getAuthDataV3().qeReport;
 }
 
-const std::array<uint8_t, 48>& Quote::getMrSignerSeam() const
+const std::array<uint8_t, constants::ECDSA_PUBKEY_BYTE_LEN>& Quote::getAttestKeyData() const
 {
-    if (header.version == QUOTE_VERSION_4)
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
     {
-        return tdReport10.mrSignerSeam;
+        return authDataV4->authData.ecdsaAttestationKey.pubKey;
     }
-    else // Quote V5 and higher
+    return getAuthDataV3().ecdsaAttestationKey.pubKey;
+}
+
+const std::vector<uint8_t>& Quote::getQeAuthData() const
+{
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
     {
-        if (body.bodyType == dcap::constants::BODY_TD_REPORT10_TYPE)
-        {
-            return tdReport10.mrSignerSeam;
-        }
-        else
-        {
-            return tdReport15.mrSignerSeam;
-        }
+        return authDataV4->qeReportCertificationData.qeAuthData.data;
     }
+    return getAuthDataV3().qeAuthData.data;
 }
 
-const std::array<uint8_t, 8>& Quote::getSeamAttributes() const
+const CertificationData& Quote::getCertificationData() const
 {
-    if (header.version == QUOTE_VERSION_4)
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
     {
-        return tdReport10.seamAttributes;
+        return authDataV4->qeReportCertificationData.certificationData;
     }
-    else // Quote V5 and higher
+    return getAuthDataV3().certificationData;
+}
+
+const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN>& Quote::getQuoteSignature() const
+{
+    if (const auto* authDataV4 = std::get_if<AuthDataV4>(&authData))
     {
-        if (body.bodyType == dcap::constants::BODY_TD_REPORT10_TYPE)
-        {
-            return tdReport10.seamAttributes;
-        }
-        else
-        {
-            return tdReport15.seamAttributes;
-        }
+        return authDataV4->authData.ecdsa256BitSignature.signature;
     }
+    return getAuthDataV3().ecdsa256BitSignature.signature;
+}
+
+const std::array<uint8_t, 16>& Quote::getTeeTcbSvn() const
+{
+    const auto* tdReport = getTdReport();
+    return tdReport != nullptr ? tdReport->teeTcbSvn : empty<TDReport10>().teeTcbSvn;
 }
 
-std::vector<uint8_t> Quote::getDataToSignatureVerification(const std::vector<uint8_t>& rawQuote,
-                                                           const std::vector<uint8_t>::difference_type sizeToCopy) const
+const std::array<uint8_t, 48>& Quote::getMrSignerSeam() const
+{
+    const auto* tdReport = getTdReport();
+    return tdReport != nullptr ? tdReport->mrSignerSeam : empty<TDReport10>().mrSignerSeam;
+}
+
+const std::array<uint8_t, 8>& Quote::getSeamAttributes() const
 {
-    // private method, we call it at the end of parsing, so
-    // here we assume format is valid
-    std::vector<uint8_t> ret(rawQuote.begin(), std::next(rawQuote.begin(), sizeToCopy));
-    return ret;
+    const auto* tdReport = getTdReport();
+    return tdReport != nullptr ? tdReport->seamAttributes : empty<TDReport10>().seamAttributes;
 }
 
 }}} //namespace intel { namespace sgx { namespace dcap {
@@ -32,7 +32,11 @@
 #ifndef INTEL_SGX_QVL_QUOTE_H_
 #define INTEL_SGX_QVL_QUOTE_H_
 
+#include "QuoteLayout.h"
 #include "QuoteStructures.h"
+#include "OpensslHelpers/Bytes.h"
+
+#include <variant>
 
 namespace intel { namespace sgx { namespace dcap {
 using namespace intel::sgx::dcap::quote;
@@ -40,24 +44,49 @@ using namespace intel::sgx::dcap::quote;
 class Quote
 {
 public:
-    bool parse(const std::vector<uint8_t>& rawQuote);
+    enum class Digests
+    {
+        COMPUTE,  // parse hashes signed data and QE Report data
+        DEFERRED  // caller hashes them, e.g. many quotes at once, and hands digests over with setDigests
+    };
+
+    bool parse(const std::vector<uint8_t>& rawQuote, Digests digests = Digests::COMPUTE);
+
+    // Sets digests of a quote parsed with Digests::DEFERRED
+    void setDigests(Bytes signedData, Bytes qeReportData);
 
     bool validate() const;
 
+    // Supported layout of parsed quote, LayoutId::UNSUPPORTED quotes don't pass validate()
+    LayoutId getLayoutId() const;
+
+    // Report of quote whose layout id matches Layout
+    template<typename Layout>
+    const typename Layout::Report& getReport() const
+    {
+        return std::get<typename Layout::Report>(report);
+    }
+
     const Header& getHeader() const;
     const Body& getBody() const;
+    // Report getters return a zero-filled report when the quote carries another report type
     const EnclaveReport& getEnclaveReport() const;
     const TDReport10& getTdReport10() const;
     const TDReport15& getTdReport15() const;
     uint32_t getAuthDataSize() const;
 
     // Access helpers
-    const std::vector<uint8_t>& getSignedData() const;
+    // SHA-256 of header and report signed by attestation key, empty when it couldn't be computed
+    const Bytes& getSignedDataDigest() const;
+    // SHA-256 of attestation key and QE Authentication Data expected in QE Report data, empty when it couldn't be computed
+    const Bytes& getQeReportDataDigest() const;
+    // Number of leading raw quote bytes signed by attestation key
+    size_t getSignedDataSize() const;
     const std::array<uint8_t, 16>& getTeeTcbSvn() const;
     const std::array<uint8_t, 48>& getMrSignerSeam() const;
     const std::array<uint8_t, 8>& getSeamAttributes() const;
 
-    // Auth data getters
+    // Auth data getters, zero-filled when the quote carries another auth data version
     const Ecdsa256BitQuoteV3AuthData& getAuthDataV3() const;
     const Ecdsa256BitQuoteV4AuthData& getAuthDataV4() const;
     const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN>& getQeReportSignature() const;
@@ -68,27 +97,31 @@ public:
     const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN>& getQuoteSignature() const;
 
 protected:
+    // Quote v4 and v5 carry QE Report, its signature, QE Authentication Data and PCK certification data
+    // nested in certification data of type 6, kept here next to the raw auth data they were parsed from
+    struct AuthDataV4
+    {
+        Ecdsa256BitQuoteV4AuthData authData{};
+        QEReportCertificationData qeReportCertificationData{};
+    };
+
+    // Only the report and auth data layout selected by quote version, TEE type and body type is stored
+    using Report = std::variant<std::monostate, EnclaveReport, TDReport10, TDReport15>;
+    using AuthData = std::variant<std::monostate, Ecdsa256BitQuoteV3AuthData, AuthDataV4>;
+
+    // TD Report 1.0 fields of either TD Report version, nullptr for SGX quotes
+    const TDReport10* getTdReport() const;
+
     Header header{};
     Body body{};
-    EnclaveReport enclaveReport{};
-    TDReport10 tdReport10{};
-    TDReport15 tdReport15{};
-    uint32_t authDataSize;
-    std::vector<uint8_t> signedData{};
-
-    // Auth data
-    Ecdsa256BitQuoteV3AuthData authDataV3{};
-    Ecdsa256BitQuoteV4AuthData authDataV4{};
-    std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN> qeReportSignature{};
-    EnclaveReport qeReport{};
-    std::array<uint8_t, constants::ECDSA_PUBKEY_BYTE_LEN> attestKeyData{};
-    std::vector<uint8_t> qeAuthData{};
-    CertificationData certificationData{};
-    std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN> quoteSignature{};
-
-private:
-    std::vector<uint8_t> getDataToSignatureVerification(const std::vector<uint8_t>& rawQuote,
-                                                        const std::vector<uint8_t>::difference_type) const;
+    Report report{};
+    LayoutId layoutId = LayoutId::UNSUPPORTED;
+    uint32_t authDataSize = 0;
+    size_t signedDataSize = 0;
+    Bytes signedDataDigest{};
+
+    AuthData authData{};
+    Bytes qeReportDataDigest{};
 };
 
 }}} // namespace intel { namespace sgx { namespace dcap { namespace test {
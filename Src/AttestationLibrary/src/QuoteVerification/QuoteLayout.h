@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_QUOTE_LAYOUT_H_
+#define INTEL_SGX_QVL_QUOTE_LAYOUT_H_
+
+#include "QuoteConstants.h"
+#include "QuoteStructures.h"
+
+namespace intel { namespace sgx { namespace dcap { namespace quote {
+
+/**
+ * Report following quote header, or quote body since quote v5, selected by body type.
+ */
+template<size_t BodyType>
+struct ReportTraits;
+
+template<>
+struct ReportTraits<constants::BODY_SGX_ENCLAVE_REPORT_TYPE>
+{
+    using Type = EnclaveReport;
+    static constexpr size_t BYTE_LEN = constants::ENCLAVE_REPORT_BYTE_LEN;
+    static constexpr const char* NAME = "SGX enclave report";
+};
+
+template<>
+struct ReportTraits<constants::BODY_TD_REPORT10_TYPE>
+{
+    using Type = TDReport10;
+    static constexpr size_t BYTE_LEN = constants::TD_REPORT10_BYTE_LEN;
+    static constexpr const char* NAME = "TDX TD Report 1.0";
+};
+
+template<>
+struct ReportTraits<constants::BODY_TD_REPORT15_TYPE>
+{
+    using Type = TDReport15;
+    static constexpr size_t BYTE_LEN = constants::TD_REPORT15_BYTE_LEN;
+    static constexpr const char* NAME = "TDX TD Report 1.5";
+};
+
+/**
+ * Supported combination of quote version, TEE type and body type. Before quote v5 the body type is implied by
+ * TEE type. Checks depending on the layout are instantiated per layout and dispatched once with visitLayout.
+ */
+template<uint16_t Version, uint32_t TeeType, size_t BodyType>
+struct Layout
+{
+    static_assert(Version >= constants::QUOTE_VERSION_3 && Version <= constants::QUOTE_VERSION_5,
+                  "Unsupported quote version");
+    static_assert((TeeType == constants::TEE_TYPE_SGX) == (BodyType == constants::BODY_SGX_ENCLAVE_REPORT_TYPE),
+                  "SGX quotes carry SGX enclave report and TDX quotes carry TD Report");
+    static_assert(Version != constants::QUOTE_VERSION_3 || TeeType == constants::TEE_TYPE_SGX,
+                  "Quote v3 supports only SGX");
+    static_assert(Version == constants::QUOTE_VERSION_5 || BodyType != constants::BODY_TD_REPORT15_TYPE,
+                  "TD Report 1.5 is carried only by quote v5");
+
+    static constexpr uint16_t VERSION = Version;
+    static constexpr uint32_t TEE_TYPE = TeeType;
+    static constexpr size_t BODY_TYPE = BodyType;
+
+    static constexpr bool HAS_BODY = Version >= constants::QUOTE_VERSION_5;
+    static constexpr bool IS_TDX = TeeType == constants::TEE_TYPE_TDX;
+    // TD Report 1.5 carries second TEE TCB SVN, checked for TD relaunch
+    static constexpr bool HAS_TEE_TCB_SVN2 = BodyType == constants::BODY_TD_REPORT15_TYPE;
+
+    using Report = typename ReportTraits<BodyType>::Type;
+    static constexpr size_t REPORT_BYTE_LEN = ReportTraits<BodyType>::BYTE_LEN;
+};
+
+using SgxQuoteV3 = Layout<constants::QUOTE_VERSION_3, constants::TEE_TYPE_SGX, constants::BODY_SGX_ENCLAVE_REPORT_TYPE>;
+using SgxQuoteV4 = Layout<constants::QUOTE_VERSION_4, constants::TEE_TYPE_SGX, constants::BODY_SGX_ENCLAVE_REPORT_TYPE>;
+using TdxQuoteV4 = Layout<constants::QUOTE_VERSION_4, constants::TEE_TYPE_TDX, constants::BODY_TD_REPORT10_TYPE>;
+using SgxQuoteV5 = Layout<constants::QUOTE_VERSION_5, constants::TEE_TYPE_SGX, constants::BODY_SGX_ENCLAVE_REPORT_TYPE>;
+using Tdx10QuoteV5 = Layout<constants::QUOTE_VERSION_5, constants::TEE_TYPE_TDX, constants::BODY_TD_REPORT10_TYPE>;
+using Tdx15QuoteV5 = Layout<constants::QUOTE_VERSION_5, constants::TEE_TYPE_TDX, constants::BODY_TD_REPORT15_TYPE>;
+
+enum class LayoutId : uint8_t
+{
+    UNSUPPORTED,
+    SGX_V3,
+    SGX_V4,
+    TDX_V4,
+    SGX_V5,
+    TDX10_V5,
+    TDX15_V5
+};
+
+/**
+ * @param bodyType - body type of quote v5, ignored for earlier versions
+ */
+constexpr LayoutId getLayoutId(uint16_t version, uint32_t teeType, size_t bodyType)
+{
+    switch (version)
+    {
+        case constants::QUOTE_VERSION_3:
+            return teeType == constants::TEE_TYPE_SGX ? LayoutId::SGX_V3 : LayoutId::UNSUPPORTED;
+        case constants::QUOTE_VERSION_4:
+            if (teeType == constants::TEE_TYPE_SGX)
+            {
+                return LayoutId::SGX_V4;
+            }
+            return teeType == constants::TEE_TYPE_TDX ? LayoutId::TDX_V4 : LayoutId::UNSUPPORTED;
+        case constants::QUOTE_VERSION_5:
+            if (teeType == constants::TEE_TYPE_SGX)
+            {
+                return bodyType == constants::BODY_SGX_ENCLAVE_REPORT_TYPE ? LayoutId::SGX_V5 : LayoutId::UNSUPPORTED;
+            }
+            if (teeType == constants::TEE_TYPE_TDX)
+            {
+                switch (bodyType)
+                {
+                    case constants::BODY_TD_REPORT10_TYPE:
+                        return LayoutId::TDX10_V5;
+                    case constants::BODY_TD_REPORT15_TYPE:
+                        return LayoutId::TDX15_V5;
+                    default:
+                        return LayoutId::UNSUPPORTED;
+                }
+            }
+            return LayoutId::UNSUPPORTED;
+        default:
+            return LayoutId::UNSUPPORTED;
+    }
+}
+
+/**
+ * Calls visitor with default constructed Layout of given id.
+ *
+ * @return visitor result, or unsupported for LayoutId::UNSUPPORTED
+ */
+template<typename Result, typename Visitor>
+Result visitLayout(LayoutId id, Result unsupported, Visitor&& visitor)
+{
+    switch (id)
+    {
+        case LayoutId::SGX_V3:
+            return visitor(SgxQuoteV3{});
+        case LayoutId::SGX_V4:
+            return visitor(SgxQuoteV4{});
+        case LayoutId::TDX_V4:
+            return visitor(TdxQuoteV4{});
+        case LayoutId::SGX_V5:
+            return visitor(SgxQuoteV5{});
+        case LayoutId::TDX10_V5:
+            return visitor(Tdx10QuoteV5{});
+        case LayoutId::TDX15_V5:
+            return visitor(Tdx15QuoteV5{});
+        case LayoutId::UNSUPPORTED:
+        default:
+            return unsupported;
+    }
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace quote {
+
+#endif // INTEL_SGX_QVL_QUOTE_LAYOUT_H_
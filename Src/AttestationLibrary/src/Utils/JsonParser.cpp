@@ -32,37 +32,74 @@
 #include "JsonParser.h"
 
 #include "OpensslHelpers/Bytes.h"
+#include "Utils/ScratchBuffer.h"
 #include "Utils/TimeUtils.h"
 
 #include <rapidjson/stringbuffer.h>
 
-#include <tuple>
 #include <algorithm>
+#include <cstddef>
+#include <new>
+#include <tuple>
 
 namespace intel { namespace sgx { namespace dcap {
 
+namespace {
+
+// initial size of the parse stack, it grows inside the same pool when exceeded
+constexpr size_t STACK_CAPACITY = 1024;
+
+} // anonymous namespace
+
+struct JsonParser::Arena
+{
+    Arena(void* pool, size_t poolSize):
+        allocator(pool, poolSize),
+        document(&allocator, STACK_CAPACITY, &allocator)
+    {}
+
+    rapidjson::MemoryPoolAllocator<> allocator;
+    ScratchDocument document;
+};
+
+void JsonParser::ArenaDeleter::operator()(Arena* allocated) const noexcept
+{
+    allocated->~Arena();
+    scratch::release(allocated);
+}
+
 bool JsonParser::parse(const std::string& json)
 {
     if(json.empty())
     {
         return false;
     }
-    jsonDocument.Parse(json.c_str());
-    return !jsonDocument.HasParseError() && jsonDocument.IsObject();
+
+    // pool follows the arena in the same buffer, the DOM goes to the heap only when the buffer is full
+    constexpr size_t poolOffset = (sizeof(Arena) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    static_assert(poolOffset < scratch::BUFFER_SIZE, "Scratch buffer too small for JSON arena");
+
+    arena.reset();
+    auto* buffer = static_cast<uint8_t*>(scratch::acquire());
+    arena.reset(new (buffer) Arena(buffer + poolOffset, scratch::BUFFER_SIZE - poolOffset));
+
+    arena->document.Parse(json.c_str());
+    return !arena->document.HasParseError() && arena->document.IsObject();
 }
 
 const rapidjson::Value* JsonParser::getRoot() const
 {
-    return &jsonDocument;
+    static const rapidjson::Value nothingParsed;
+    return arena ? &arena->document : &nothingParsed;
 }
 
 const rapidjson::Value* JsonParser::getField(const std::string& fieldName) const
 {
-    if(!jsonDocument.IsObject() || !jsonDocument.HasMember(fieldName.c_str()))
+    if(!arena || !arena->document.IsObject() || !arena->document.HasMember(fieldName.c_str()))
     {
         return nullptr;
     }
-    return &jsonDocument[fieldName.c_str()];
+    return &arena->document[fieldName.c_str()];
 }
 
 std::pair<std::string, JsonParser::ParseStatus> JsonParser::getStringFieldOf(const ::rapidjson::Value &parent, const std::string &fieldName) const
@@ -94,7 +131,7 @@ std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getHexstrin
         return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Invalid);
     }
 
-    const std::string propertyStr = property_v.GetString();
+    const std::string_view propertyStr(property_v.GetString(), property_v.GetStringLength());
     if(propertyStr.length() == length && isValidHexstring(propertyStr))
     {
         return std::make_pair(hexStringToBytes(propertyStr), ParseStatus::OK);
@@ -102,19 +139,20 @@ std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getHexstrin
     return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Invalid);
 }
 
-std::pair<tm, JsonParser::ParseStatus> JsonParser::getDateFieldOf(
+std::pair<time_t, JsonParser::ParseStatus> JsonParser::getDateFieldOf(
         const ::rapidjson::Value& parent, const std::string& fieldName) const
 {
     if(!parent.IsObject() || !parent.HasMember(fieldName.c_str()))
     {
-        return std::make_pair(tm{}, ParseStatus::Missing);
+        return std::make_pair(time_t{}, ParseStatus::Missing);
     }
     const auto& date = parent[fieldName.c_str()];
-    if(!date.IsString() || !isValidTimeString(date.GetString()))
+    time_t epochTime{};
+    if(!date.IsString() || !parseIsoTime({date.GetString(), date.GetStringLength()}, epochTime))
     {
-        return std::make_pair(tm{}, ParseStatus::Invalid);
+        return std::make_pair(time_t{}, ParseStatus::Invalid);
     }
-    return std::make_pair(getTimeFromString(date.GetString()), ParseStatus::OK);
+    return std::make_pair(epochTime, ParseStatus::OK);
 }
 
 JsonParser::ParseStatus JsonParser::checkDateFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName) const
@@ -154,7 +192,7 @@ std::pair<int, JsonParser::ParseStatus> JsonParser::getIntFieldOf(
     return std::make_pair(value.GetInt(), ParseStatus::OK);
 }
 
-bool JsonParser::isValidHexstring(const std::string& hexString) const
+bool JsonParser::isValidHexstring(std::string_view hexString) const
 {
     return std::find_if(hexString.cbegin(), hexString.cend(),
                         [](const char c){return !::isxdigit(static_cast<unsigned char>(c));}) == hexString.cend();
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_TRUSTED
+
+#include "SingleFlight.h"
+
+namespace intel { namespace sgx { namespace dcap {
+
+Status SingleFlight::run(const Key& key, const std::function<Status()>& compute)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    ++_requests;
+    const auto flight = _flights.find(key);
+    if (flight != _flights.end())
+    {
+        ++_coalesced;
+        const auto result = flight->second;
+        lock.unlock();
+        return result.get();
+    }
+
+    std::promise<Status> promise;
+    _flights.emplace(key, promise.get_future().share());
+    lock.unlock();
+
+    try
+    {
+        const auto status = compute();
+        promise.set_value(status);
+        lock.lock();
+        _flights.erase(key);
+        return status;
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+        lock.lock();
+        _flights.erase(key);
+        throw;
+    }
+}
+
+SingleFlight::Metrics SingleFlight::getMetrics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Metrics{_requests, _coalesced, static_cast<uint32_t>(_flights.size())};
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_SINGLEFLIGHT_H
+#define SGXECDSAATTESTATION_SINGLEFLIGHT_H
+
+#ifndef SGX_TRUSTED
+
+#include "DigestKey.h"
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Coalesces concurrent calls with the same key: the first one computes the status, calls made while it runs
+ * wait for its result instead of computing it again. Nothing is cached, a call made after the first one
+ * completed computes the status anew.
+ */
+class SingleFlight
+{
+public:
+    using Key = DigestKey;
+
+    struct Metrics
+    {
+        uint64_t requests;
+        uint64_t coalesced;
+        uint32_t inFlight;
+    };
+
+    /**
+     * @return status computed by compute, or by compute of a concurrent call with the same key.
+     *         Exceptions thrown by compute are rethrown to all of them.
+     */
+    Status run(const Key& key, const std::function<Status()>& compute);
+
+    Metrics getMetrics() const;
+
+private:
+    mutable std::mutex _mutex;
+    std::unordered_map<Key, std::shared_future<Status>, DigestKeyHash> _flights;
+    uint64_t _requests = 0;
+    uint64_t _coalesced = 0;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
+
+#endif //SGXECDSAATTESTATION_SINGLEFLIGHT_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_TRUSTED
+
+#include "StatusCache.h"
+
+namespace intel { namespace sgx { namespace dcap {
+
+StatusCache::StatusCache(size_t capacity): _capacity(capacity)
+{}
+
+bool StatusCache::find(const Key& key, std::time_t currentTime, Status& status)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto found = _index.find(key);
+    if (found == _index.end())
+    {
+        ++_misses;
+        return false;
+    }
+
+    const auto entry = found->second;
+    if (entry->expirationTime <= currentTime)
+    {
+        ++_misses;
+        ++_expirations;
+        _entries.erase(entry);
+        _index.erase(found);
+        return false;
+    }
+
+    ++_hits;
+    _entries.splice(_entries.begin(), _entries, entry);
+    status = entry->status;
+    return true;
+}
+
+void StatusCache::insert(const Key& key, Status status, std::time_t expirationTime)
+{
+    if (_capacity == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto found = _index.find(key);
+    if (found != _index.end())
+    {
+        // concurrent misses of the same request computed the same status
+        found->second->status = status;
+        found->second->expirationTime = expirationTime;
+        _entries.splice(_entries.begin(), _entries, found->second);
+        return;
+    }
+
+    if (_entries.size() == _capacity)
+    {
+        _index.erase(_entries.back().key);
+        _entries.pop_back();
+        ++_evictions;
+    }
+    _entries.push_front(Entry{key, status, expirationTime});
+    _index.emplace(key, _entries.begin());
+}
+
+StatusCache::Metrics StatusCache::getMetrics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Metrics{_hits, _misses, _evictions, _expirations, static_cast<uint32_t>(_entries.size())};
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
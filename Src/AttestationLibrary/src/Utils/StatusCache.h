@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_STATUSCACHE_H
+#define SGXECDSAATTESTATION_STATUSCACHE_H
+
+#ifndef SGX_TRUSTED
+
+#include "DigestKey.h"
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+
+#include <ctime>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Bounded map of verification request keys to final statuses. Each entry carries its own expiration time
+ * and is dropped once it passes, the least recently used entry is evicted when capacity is reached.
+ */
+class StatusCache
+{
+public:
+    using Key = DigestKey;
+
+    struct Metrics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;     // entries dropped to make room for new ones
+        uint64_t expirations;   // entries found expired on lookup
+        uint32_t entries;
+    };
+
+    explicit StatusCache(size_t capacity);
+
+    /**
+     * @return true and sets status when key is cached and its entry expires after currentTime
+     */
+    bool find(const Key& key, std::time_t currentTime, Status& status);
+
+    /**
+     * Caches status until expirationTime, nothing is cached when capacity is 0.
+     */
+    void insert(const Key& key, Status status, std::time_t expirationTime);
+
+    Metrics getMetrics() const;
+
+private:
+    struct Entry
+    {
+        Key key;
+        Status status;
+        std::time_t expirationTime;
+    };
+    using Entries = std::list<Entry>;
+
+    const size_t _capacity;
+    mutable std::mutex _mutex;
+    Entries _entries; // most recently used first
+    std::unordered_map<Key, Entries::iterator, DigestKeyHash> _index;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+    uint64_t _evictions = 0;
+    uint64_t _expirations = 0;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
+
+#endif //SGXECDSAATTESTATION_STATUSCACHE_H
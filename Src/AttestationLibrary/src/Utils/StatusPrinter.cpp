@@ -35,7 +35,7 @@
 
 namespace intel::sgx::dcap {
 
-static constexpr Status MAX_STATUS = STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED;
+static constexpr Status MAX_STATUS = STATUS_BUSY;
 
 std::string printStatus(const Status s)
 {
@@ -147,7 +147,8 @@ std::string printStatusOnly(const Status s)
         "STATUS_TDX_MODULE_MISMATCH",
         "STATUS_SGX_ENCLAVE_REPORT_ISVSVN_NOT_SUPPORTED",
         "STATUS_TCB_TD_RELAUNCH_ADVISED",
-        "STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED"
+        "STATUS_TCB_TD_RELAUNCH_ADVISED_CONFIGURATION_NEEDED",
+        "STATUS_BUSY"
     }};
     if (s > MAX_STATUS)
     {
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_TRUSTED
+
+#include "WorkerPool.h"
+
+#include <Utils/Logger.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+thread_local const WorkerPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+struct Cpu
+{
+    int id;
+    size_t node;
+};
+
+#ifdef __linux__
+// Parses sysfs cpu list format, e.g. "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::istringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        int first = 0;
+        int last = 0;
+        const auto dash = range.find('-');
+        try
+        {
+            first = std::stoi(range.substr(0, dash));
+            last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        }
+        catch (const std::exception&)
+        {
+            continue;
+        }
+        for (int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+#endif
+
+/**
+ * CPUs this process may run on, taking nodes in turn (node0 cpu, node1 cpu, node0 cpu, ...) so consecutive workers
+ * are spread over memory controllers. Machines without NUMA information form a single node.
+ */
+std::vector<Cpu> getCpuOrder()
+{
+    std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool hasAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    const auto isAllowed = [&](int cpu) {
+        return !hasAffinity || (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(static_cast<size_t>(cpu), &allowed));
+    };
+
+    for (size_t node = 0;; ++node)
+    {
+        std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!cpuList || !std::getline(cpuList, list))
+        {
+            break;
+        }
+        auto cpus = parseCpuList(list);
+        cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&](int cpu) { return !isAllowed(cpu); }), cpus.end());
+        if (!cpus.empty())
+        {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+
+    if (nodes.empty())
+    {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (hasAffinity && isAllowed(cpu))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        nodes.push_back(std::move(cpus));
+    }
+#endif
+    if (nodes.empty() || nodes.front().empty())
+    {
+        nodes.assign(1, std::vector<int>(std::max(1u, std::thread::hardware_concurrency())));
+        for (size_t i = 0; i < nodes[0].size(); ++i)
+        {
+            nodes[0][i] = static_cast<int>(i);
+        }
+    }
+
+    std::vector<Cpu> order;
+    for (size_t depth = 0; ; ++depth)
+    {
+        const auto before = order.size();
+        for (size_t node = 0; node < nodes.size(); ++node)
+        {
+            if (depth < nodes[node].size())
+            {
+                order.push_back(Cpu{nodes[node][depth], node});
+            }
+        }
+        if (order.size() == before)
+        {
+            return order;
+        }
+    }
+}
+
+void pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<size_t>(cpu), &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+    {
+        LOG_WARN("Binding worker thread to CPU {} failed", cpu);
+    }
+#else
+    (void) cpu;
+#endif
+}
+
+} // anonymous namespace
+
+struct WorkerPool::Worker
+{
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+    std::vector<size_t> victims; // workers to steal from, same NUMA node first
+    int cpu = -1;                // bound CPU, -1 when not pinned
+    std::thread thread;
+};
+
+WorkerPool::WorkerPool(size_t workerCount, size_t queueDepth): WorkerPool(workerCount, queueDepth, Placement{})
+{}
+
+WorkerPool::WorkerPool(size_t workerCount, size_t queueDepth, const Placement& placement): _queueDepth(queueDepth)
+{
+    if (workerCount == 0)
+    {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<size_t> nodes(workerCount, 0);
+    _workers.reserve(workerCount);
+    const auto cpuOrder = placement.pinToCpu ? getCpuOrder() : std::vector<Cpu>{};
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(std::make_unique<Worker>());
+        if (!cpuOrder.empty())
+        {
+            const auto& cpu = cpuOrder[(placement.firstCpu + i) % cpuOrder.size()];
+            _workers[i]->cpu = cpu.id;
+            nodes[i] = cpu.node;
+        }
+    }
+
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        auto& victims = _workers[i]->victims;
+        for (size_t distance = 1; distance < workerCount; ++distance)
+        {
+            victims.push_back((i + distance) % workerCount);
+        }
+        std::stable_partition(victims.begin(), victims.end(), [&](size_t victim) { return nodes[victim] == nodes[i]; });
+    }
+
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        _workers[i]->thread = std::thread(&WorkerPool::run, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _taskAvailable.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker->thread.join();
+    }
+}
+
+bool WorkerPool::trySubmit(std::function<void()> task)
+{
+    auto pending = _pending.load();
+    do
+    {
+        if (pending >= _queueDepth)
+        {
+            return false;
+        }
+    } while (!_pending.compare_exchange_weak(pending, pending + 1));
+
+    // the slot is reserved before checking _stopping, so a stopping worker either sees it or we see the flag
+    if (_stopping.load())
+    {
+        --_pending;
+        return false;
+    }
+
+    const auto index = currentPool == this ? currentWorker : _nextWorker++ % _workers.size();
+    {
+        std::lock_guard<std::mutex> lock(_workers[index]->mutex);
+        _workers[index]->tasks.push_back(std::move(task));
+    }
+
+    if (_idle.load() > 0)
+    {
+        // taking the lock orders this notification after the idle worker checked for pending tasks
+        std::lock_guard<std::mutex> lock(_mutex);
+        _taskAvailable.notify_one();
+    }
+    return true;
+}
+
+size_t WorkerPool::getWorkerCount() const
+{
+    return _workers.size();
+}
+
+uint64_t WorkerPool::getStolenCount() const
+{
+    return _stolen.load();
+}
+
+bool WorkerPool::tryTake(size_t index, std::function<void()>& task)
+{
+    const auto takeOldest = [&task](Worker& worker) {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty())
+        {
+            return false;
+        }
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        return true;
+    };
+
+    auto& self = *_workers[index];
+    bool taken = takeOldest(self);
+    for (auto victim = self.victims.begin(); !taken && victim != self.victims.end(); ++victim)
+    {
+        if (takeOldest(*_workers[*victim]))
+        {
+            taken = true;
+            ++_stolen;
+        }
+    }
+
+    if (taken)
+    {
+        --_pending;
+    }
+    return taken;
+}
+
+void WorkerPool::run(size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+    if (_workers[index]->cpu >= 0)
+    {
+        pinCurrentThread(_workers[index]->cpu);
+    }
+
+    for (;;)
+    {
+        std::function<void()> task;
+        if (tryTake(index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++_idle;
+        _taskAvailable.wait(lock, [this] { return _stopping.load() || _pending.load() > 0; });
+        --_idle;
+        if (_pending.load() == 0)
+        {
+            return; // stopping and drained
+        }
+    }
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
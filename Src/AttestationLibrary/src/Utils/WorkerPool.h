@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_WORKERPOOL_H
+#define SGXECDSAATTESTATION_WORKERPOOL_H
+
+#ifndef SGX_TRUSTED
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Fixed size pool of work-stealing threads. Every worker owns a deque of tasks, tasks submitted from outside of
+ * the pool are spread over the deques round robin and tasks submitted by a worker stay on its own deque. Idle workers
+ * steal the oldest task of another worker, those placed on the same NUMA node first, so a few expensive tasks
+ * (TDX quotes) do not leave the remaining workers idle.
+ *
+ * The number of tasks waiting for a free worker is bounded, submission fails instead of growing the queues so callers
+ * can apply backpressure.
+ */
+class WorkerPool
+{
+public:
+    struct Placement
+    {
+        bool pinToCpu = false;  // bind every worker to a single CPU, Linux only
+        size_t firstCpu = 0;    // offset in the CPU order, lets several pools share a machine without overlapping
+    };
+
+    /**
+     * @param workerCount - number of threads, 0 selects std::thread::hardware_concurrency()
+     * @param queueDepth - maximum number of tasks waiting for a worker
+     */
+    WorkerPool(size_t workerCount, size_t queueDepth);
+
+    /**
+     * @param placement - CPU binding of workers. Pinned workers are spread across NUMA nodes in turn
+     */
+    WorkerPool(size_t workerCount, size_t queueDepth, const Placement& placement);
+
+    /**
+     * Executes all tasks already accepted and joins the workers
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @return false when the queue is full, the task is not executed then
+     */
+    bool trySubmit(std::function<void()> task);
+
+    size_t getWorkerCount() const;
+
+    /**
+     * @return number of tasks workers took from deques of other workers
+     */
+    uint64_t getStolenCount() const;
+
+private:
+    struct Worker;
+
+    void run(size_t index);
+    bool tryTake(size_t index, std::function<void()>& task);
+
+    const size_t _queueDepth;
+    std::atomic<size_t> _pending{0};
+    std::atomic<size_t> _nextWorker{0};
+    std::atomic<uint64_t> _stolen{0};
+    std::atomic<size_t> _idle{0};
+    std::atomic<bool> _stopping{false};
+    std::mutex _mutex;
+    std::condition_variable _taskAvailable;
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
+
+#endif //SGXECDSAATTESTATION_WORKERPOOL_H
@@ -33,16 +33,6 @@
 
 namespace intel { namespace sgx { namespace dcap {
 
-    bool BaseVerifier::commonNameContains(const pckparser::Subject &subject, const std::string& pattern) const
-    {
-        return subject.commonName.find(pattern) != std::string::npos;
-    }
-
-    bool BaseVerifier::commonNameContains(const pckparser::Issuer &issuer, const std::string& pattern) const
-    {
-        return issuer.commonName.find(pattern) != std::string::npos;
-    }
-
     bool BaseVerifier::commonNameContains(const dcap::parser::x509::DistinguishedName &name, const std::string& pattern) const
     {
         return name.getCommonName().find(pattern) != std::string::npos;
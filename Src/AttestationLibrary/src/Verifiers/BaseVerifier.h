@@ -39,8 +39,6 @@ namespace intel { namespace sgx { namespace dcap {
 
             class BaseVerifier {
             public:
-                bool commonNameContains(const pckparser::Subject &subject, const std::string& pattern) const;
-                bool commonNameContains(const pckparser::Issuer &issuer, const std::string& pattern) const;
                 bool commonNameContains(const dcap::parser::x509::DistinguishedName &name, const std::string& pattern) const;
             };
 
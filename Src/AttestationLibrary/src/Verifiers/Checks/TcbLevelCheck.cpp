@@ -125,15 +125,16 @@ Status convergeTcbStatusWithQeTcbStatus(Status tcbLevelStatus, Status qeTcbStatu
     }
 }
 
-std::tuple<Optional<TcbLevel>, Optional<TcbLevel>>
+// selected levels point into tcbLevels, which outlives the match, so no level is copied
+std::tuple<const TcbLevel*, const TcbLevel*>
 matchTcbLevels(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels,
                const parser::x509::Tcb& tcb,
                const Optional<std::array<uint8_t, 16>>& teeTcbSvn)
 {
     LOG_INFO("PCK TCB - cpuSvn: {}, pceSvn: {}", bytesToHexString(tcb.getCpuSvn()), tcb.getPceSvn());
 
-    Optional<TcbLevel> sgxTcbLevel;
-    Optional<TcbLevel> tdxTcbLevel;
+    const TcbLevel* sgxTcbLevel = nullptr;
+    const TcbLevel* tdxTcbLevel = nullptr;
     for (const auto& tcbLevel : tcbLevels)
     {
         /// 4.1.2.4.17.1 & 4.1.2.4.17.2
@@ -144,7 +145,7 @@ matchTcbLevels(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels,
             {
                 if (!sgxTcbLevel)
                 {
-                    sgxTcbLevel = tcbLevel;
+                    sgxTcbLevel = &tcbLevel;
                     LOG_INFO("Selected SGX TCB Level - sgxSvn: {}, tdxSvn: {}, pceSvn: {}, status: {}",
                              bytesToHexString(sgxTcbLevel->getCpuSvn()),
                              bytesToHexString(tcbComponentsToVectorOfBytes(sgxTcbLevel->getTdxTcbComponents())),
@@ -154,7 +155,7 @@ matchTcbLevels(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels,
 
                 if (isTdxTcbHigherOrEqual(teeTcbSvn.value(), tcbLevel))
                 {
-                    tdxTcbLevel = tcbLevel;
+                    tdxTcbLevel = &tcbLevel;
                     LOG_INFO("Selected TDX TCB Level - sgxSvn: {}, tdxSvn: {}, pceSvn: {}, status: {}",
                              bytesToHexString(tdxTcbLevel->getCpuSvn()),
                              bytesToHexString(tcbComponentsToVectorOfBytes(tdxTcbLevel->getTdxTcbComponents())),
@@ -173,7 +174,7 @@ matchTcbLevels(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels,
                          bytesToHexString(tcb.getCpuSvn()),
                          tcb.getPceSvn());
 
-                return { tcbLevel, tdxTcbLevel };
+                return { &tcbLevel, tdxTcbLevel };
             }
         }
     }
@@ -183,21 +184,33 @@ matchTcbLevels(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels,
 Status checkTcbLevel(const TcbInfo &tcbInfo, const parser::x509::PckCertificate &pckCert, const Quote &quote,
                      const Optional<Status> &qeTcbStatus, Optional<TdxModuleIdentity> &tdxModuleIdentity)
 {
-    const auto isTdx = tcbInfo.getVersion() >= 3 &&
-                       tcbInfo.getId() == parser::json::TcbInfo::TDX_ID &&
-                       quote.getHeader().teeType == constants::TEE_TYPE_TDX;
+    return quote::visitLayout(quote.getLayoutId(), STATUS_UNSUPPORTED_QUOTE_FORMAT, [&](auto layout) {
+        return checkTcbLevel<decltype(layout)>(tcbInfo, pckCert, quote, qeTcbStatus, tdxModuleIdentity);
+    });
+}
+
+template<typename Layout>
+Status checkTcbLevel(const TcbInfo &tcbInfo, const parser::x509::PckCertificate &pckCert, const Quote &quote,
+                     const Optional<Status> &qeTcbStatus, Optional<TdxModuleIdentity> &tdxModuleIdentity)
+{
+    const auto isTdx = Layout::IS_TDX &&
+                       tcbInfo.getVersion() >= 3 &&
+                       tcbInfo.getId() == parser::json::TcbInfo::TDX_ID;
 
     Optional<std::array<uint8_t, 16>> teeTcbSvn;
-    if (isTdx)
+    if constexpr (Layout::IS_TDX)
     {
-        LOG_INFO("TD Report - tdxSvn: {}",
-                 bytesToHexString(std::vector<uint8_t>(begin(quote.getTeeTcbSvn()), end(quote.getTeeTcbSvn()))));
-        teeTcbSvn = quote.getTeeTcbSvn();
+        if (isTdx)
+        {
+            const auto& tdReport = quote.getReport<Layout>();
+            LOG_INFO("TD Report - tdxSvn: {}",
+                     bytesToHexString(std::vector<uint8_t>(begin(tdReport.teeTcbSvn), end(tdReport.teeTcbSvn))));
+            teeTcbSvn = tdReport.teeTcbSvn;
+        }
     }
-    std::tuple<Optional<TcbLevel>, Optional<TcbLevel>> tcbLevels =
-            matchTcbLevels(tcbInfo.getTcbLevels(), pckCert.getTcb(), teeTcbSvn);
-    Optional<TcbLevel> sgxTcbLevel = std::get<0>(tcbLevels);
-    Optional<TcbLevel> tdxTcbLevel = std::get<1>(tcbLevels);
+    const TcbLevel* sgxTcbLevel = nullptr;
+    const TcbLevel* tdxTcbLevel = nullptr;
+    std::tie(sgxTcbLevel, tdxTcbLevel) = matchTcbLevels(tcbInfo.getTcbLevels(), pckCert.getTcb(), teeTcbSvn);
 
     if (!sgxTcbLevel)
     {
@@ -244,9 +257,9 @@ Status checkTcbLevel(const TcbInfo &tcbInfo, const parser::x509::PckCertificate
     }
 
     /// 4.1.2.4.17.4.3
-    if (quote.getBody().bodyType == constants::BODY_TD_REPORT15_TYPE)
+    if constexpr (Layout::HAS_TEE_TCB_SVN2)
     {
-        tdxTcbStatus = checkForRelaunch(quote.getTdReport15().teeTcbSvn2, tcbInfo,
+        tdxTcbStatus = checkForRelaunch(quote.getReport<Layout>().teeTcbSvn2, tcbInfo,
                                         sgxTcbStatus, tdxTcbStatus, tdxModuleTcbStatus, qeTcbStatus);
     }
 
@@ -258,5 +271,17 @@ Status checkTcbLevel(const TcbInfo &tcbInfo, const parser::x509::PckCertificate
     return tdxTcbStatus;
 }
 
+template Status checkTcbLevel<quote::SgxQuoteV3>(const TcbInfo&, const parser::x509::PckCertificate&, const Quote&,
+                                                 const Optional<Status>&, Optional<TdxModuleIdentity>&);
+template Status checkTcbLevel<quote::SgxQuoteV4>(const TcbInfo&, const parser::x509::PckCertificate&, const Quote&,
+                                                 const Optional<Status>&, Optional<TdxModuleIdentity>&);
+template Status checkTcbLevel<quote::TdxQuoteV4>(const TcbInfo&, const parser::x509::PckCertificate&, const Quote&,
+                                                 const Optional<Status>&, Optional<TdxModuleIdentity>&);
+template Status checkTcbLevel<quote::SgxQuoteV5>(const TcbInfo&, const parser::x509::PckCertificate&, const Quote&,
+                                                 const Optional<Status>&, Optional<TdxModuleIdentity>&);
+template Status checkTcbLevel<quote::Tdx10QuoteV5>(const TcbInfo&, const parser::x509::PckCertificate&, const Quote&,
+                                                   const Optional<Status>&, Optional<TdxModuleIdentity>&);
+template Status checkTcbLevel<quote::Tdx15QuoteV5>(const TcbInfo&, const parser::x509::PckCertificate&, const Quote&,
+                                                   const Optional<Status>&, Optional<TdxModuleIdentity>&);
 
 } // namespace intel::sgx::dcap
\ No newline at end of file
@@ -43,6 +43,11 @@ using namespace intel::sgx::dcap::parser::json;
 
 namespace intel::sgx::dcap {
 
+Status checkTcbLevel(const TcbInfo &tcbInfo, const parser::x509::PckCertificate &pckCert, const Quote &quote,
+                     const Optional<Status> &qeTcbStatus, Optional<TdxModuleIdentity> &tdxModuleIdentity);
+
+// Same as above for quote of given quote::Layout, instantiated for every supported layout
+template<typename Layout>
 Status checkTcbLevel(const TcbInfo &tcbInfo, const parser::x509::PckCertificate &pckCert, const Quote &quote,
                      const Optional<Status> &qeTcbStatus, Optional<TdxModuleIdentity> &tdxModuleIdentity);
 
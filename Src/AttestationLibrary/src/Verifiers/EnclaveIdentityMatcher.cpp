@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "EnclaveIdentityMatcher.h"
+#include "EnclaveIdentityV2.h"
+
+#include <OpensslHelpers/Bytes.h>
+#include <Utils/Logger.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+uint32_t loadUint32(const uint8_t* bytes)
+{
+    // same byte order as miscselect field of enclave report
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+} // anonymous namespace
+
+EnclaveIdentityMatcher::EnclaveIdentityMatcher(const EnclaveIdentityV2& enclaveIdentity):
+    _attributes(enclaveIdentity.getAttributesValue()),
+    _attributesMask(enclaveIdentity.getAttributesMaskValue()),
+    _hasMrsigner(!enclaveIdentity.getMrsigner().empty()),
+    _mrsigner(enclaveIdentity.getMrsignerValue()),
+    _isvProdId(enclaveIdentity.getIsvProdId())
+{
+    _miscselect = loadUint32(enclaveIdentity.getMiscselectValue().data());
+    _miscselectMask = loadUint32(enclaveIdentity.getMiscselectMaskValue().data());
+
+    // first level in identity order covering ISVSVN wins, so status at each distinct ISVSVN
+    // comes from the lowest level index among all levels with ISVSVN not greater than it
+    const auto& tcbLevels = enclaveIdentity.getTcbLevels();
+    std::vector<size_t> order(tcbLevels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&tcbLevels](size_t lhs, size_t rhs) {
+        return tcbLevels[lhs].getIsvsvn() < tcbLevels[rhs].getIsvsvn();
+    });
+
+    auto firstLevel = std::numeric_limits<size_t>::max();
+    for (auto index = order.begin(); index != order.end(); ++index)
+    {
+        firstLevel = std::min(firstLevel, *index);
+        const auto isvSvn = tcbLevels[*index].getIsvsvn();
+        if (std::next(index) != order.end() && tcbLevels[*std::next(index)].getIsvsvn() == isvSvn)
+        {
+            continue;
+        }
+        const auto tcbStatus = tcbLevels[firstLevel].getTcbStatus();
+        if (_tcbSteps.empty() || _tcbSteps.back().tcbStatus != tcbStatus)
+        {
+            _tcbSteps.push_back({isvSvn, tcbStatus});
+        }
+    }
+}
+
+bool EnclaveIdentityMatcher::getTcbStatus(uint16_t isvSvn, TcbStatus& tcbStatus) const
+{
+    const auto step = std::upper_bound(_tcbSteps.begin(), _tcbSteps.end(), isvSvn,
+                                       [](uint32_t value, const TcbStep& tcbStep) { return value < tcbStep.isvSvn; });
+    if (step == _tcbSteps.begin())
+    {
+        return false;
+    }
+    tcbStatus = std::prev(step)->tcbStatus;
+    return true;
+}
+
+Status EnclaveIdentityMatcher::match(const quote::EnclaveReport& enclaveReport) const
+{
+    /// 4.1.2.9.5
+    if ((enclaveReport.miscSelect & _miscselectMask) != _miscselect)
+    {
+        LOG_ERROR("MiscSelect value from Enclave Report: {} does not match miscSelect value from Enclave Identity: {}",
+                  enclaveReport.miscSelect & _miscselectMask, _miscselect);
+        return STATUS_SGX_ENCLAVE_REPORT_MISCSELECT_MISMATCH;
+    }
+
+    /// 4.1.2.9.6
+    if (!parser::SgxAttributes(enclaveReport.attributes).matches(_attributes, _attributesMask))
+    {
+        LOG_ERROR("Attributes value from Enclave Report does not match attributes from Enclave Identity");
+        return STATUS_SGX_ENCLAVE_REPORT_ATTRIBUTES_MISMATCH;
+    }
+
+    /// 4.1.2.9.7
+    if (_hasMrsigner && _mrsigner != enclaveReport.mrSigner)
+    {
+        LOG_ERROR("Enclave Identity contains MRSIGNER field: {} which does not match MRSIGNER value from Enclave Report: {}",
+                  bytesToHexString(_mrsigner.toVector()),
+                  bytesToHexString(Bytes(enclaveReport.mrSigner.begin(), enclaveReport.mrSigner.end())));
+        return STATUS_SGX_ENCLAVE_REPORT_MRSIGNER_MISMATCH;
+    }
+
+    /// 4.1.2.9.8
+    if (enclaveReport.isvProdID != _isvProdId)
+    {
+        LOG_ERROR("Enclave Identity contains IsvProdId field: {} which does not match IsvProdId value from Enclave Report: {}",
+                  _isvProdId, enclaveReport.isvProdID);
+        return STATUS_SGX_ENCLAVE_REPORT_ISVPRODID_MISMATCH;
+    }
+
+    /// 4.1.2.9.9 & 4.1.2.9.10
+    TcbStatus tcbStatus;
+    if (!getTcbStatus(enclaveReport.isvSvn, tcbStatus))
+    {
+        return STATUS_SGX_ENCLAVE_REPORT_ISVSVN_NOT_SUPPORTED;
+    }
+    if (tcbStatus == TcbStatus::Revoked)
+    {
+        LOG_ERROR("Value of tcbStatus for the selected Enclave's Identity tcbLevel (isvSvn: {}) is \"Revoked\"",
+                  enclaveReport.isvSvn);
+        return STATUS_SGX_ENCLAVE_REPORT_ISVSVN_REVOKED;
+    }
+    if (tcbStatus != TcbStatus::UpToDate)
+    {
+        LOG_ERROR("Value of tcbStatus for the selected Enclave's Identity tcbLevel (isvSvn: {}) is \"OutOfDate\"",
+                  enclaveReport.isvSvn);
+        return STATUS_SGX_ENCLAVE_REPORT_ISVSVN_OUT_OF_DATE;
+    }
+
+    /// 4.1.2.9.11
+    return STATUS_OK;
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_ENCLAVEIDENTITYMATCHER_H
+#define SGXECDSAATTESTATION_ENCLAVEIDENTITYMATCHER_H
+
+#include "QuoteVerification/QuoteStructures.h"
+#include "TcbStatus.h"
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <SgxEcdsaAttestation/FixedBytes.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+class EnclaveIdentityV2;
+
+/**
+ * Enclave Identity reduced to what is needed to check an enclave report against it (4.1.2.9.5 - 4.1.2.9.10).
+ * Built once per identity, so checking a report is a few fixed-size compares and a binary search over TCB levels.
+ */
+class EnclaveIdentityMatcher
+{
+public:
+    EnclaveIdentityMatcher() = default;
+    explicit EnclaveIdentityMatcher(const EnclaveIdentityV2& enclaveIdentity);
+
+    Status match(const quote::EnclaveReport& enclaveReport) const;
+
+    /**
+     * @return false when no TCB level of identity covers given ISVSVN
+     */
+    bool getTcbStatus(uint16_t isvSvn, TcbStatus& tcbStatus) const;
+
+private:
+    struct TcbStep
+    {
+        uint32_t isvSvn;
+        TcbStatus tcbStatus;
+    };
+
+    uint32_t _miscselect = 0;
+    uint32_t _miscselectMask = 0;
+    parser::SgxAttributes _attributes;
+    parser::SgxAttributes _attributesMask;
+    bool _hasMrsigner = false;
+    parser::MrSigner _mrsigner;
+    uint32_t _isvProdId = 0;
+    // sorted by ISVSVN, each step holds TcbStatus of first matching TCB level for ISVSVN from it up to the next step,
+    // ISVSVN below first step is not supported
+    std::vector<TcbStep> _tcbSteps;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif //SGXECDSAATTESTATION_ENCLAVEIDENTITYMATCHER_H
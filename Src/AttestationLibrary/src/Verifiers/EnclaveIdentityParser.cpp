@@ -75,7 +75,7 @@ namespace intel { namespace sgx { namespace dcap {
             throw ParserException(STATUS_SGX_ENCLAVE_IDENTITY_INVALID);
         }
 
-        auto signatureBytes = hexStringToBytes(signature->GetString());
+        auto signatureBytes = hexStringToBytes({signature->GetString(), signature->GetStringLength()});
 
         uint32_t version = 0;
         auto status = JsonParser::ParseStatus::Missing;
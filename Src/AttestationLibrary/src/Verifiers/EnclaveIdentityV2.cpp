@@ -66,6 +66,17 @@ namespace intel { namespace sgx { namespace dcap {
             return;
         }
 
+        // report checks only look at fixed-size values, a field of other size must not turn into a zero mask
+        if(!miscselectValue.assign(miscselect) || !miscselectMaskValue.assign(miscselectMask)
+           || !attributesValue.assign(attributes) || !attributesMaskValue.assign(attributesMask)
+           || !mrsignerValue.assign(mrsigner))
+        {
+            LOG_ERROR("Enclave Identity miscselect, attributes or mrsigner field has unexpected size");
+            status = STATUS_SGX_ENCLAVE_IDENTITY_INVALID;
+            return;
+        }
+        matcher = EnclaveIdentityMatcher(*this);
+
         rapidjson::StringBuffer buffer;
         rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
         p_body.Accept(writer);
@@ -113,6 +124,31 @@ namespace intel { namespace sgx { namespace dcap {
         return mrsigner;
     }
 
+    const parser::Miscselect& EnclaveIdentityV2::getMiscselectValue() const
+    {
+        return miscselectValue;
+    }
+
+    const parser::Miscselect& EnclaveIdentityV2::getMiscselectMaskValue() const
+    {
+        return miscselectMaskValue;
+    }
+
+    const parser::SgxAttributes& EnclaveIdentityV2::getAttributesValue() const
+    {
+        return attributesValue;
+    }
+
+    const parser::SgxAttributes& EnclaveIdentityV2::getAttributesMaskValue() const
+    {
+        return attributesMaskValue;
+    }
+
+    const parser::MrSigner& EnclaveIdentityV2::getMrsignerValue() const
+    {
+        return mrsignerValue;
+    }
+
     uint32_t EnclaveIdentityV2::getIsvProdId() const
     {
         return isvProdId;
@@ -148,18 +184,14 @@ namespace intel { namespace sgx { namespace dcap {
     bool EnclaveIdentityV2::parseIssueDate(const rapidjson::Value &input)
     {
         auto l_status = JsonParser::ParseStatus::Missing;
-        struct tm issueDateTm{};
-        std::tie(issueDateTm, l_status) = jsonParser.getDateFieldOf(input, "issueDate");
-        issueDate = dcap::mktime(&issueDateTm);
+        std::tie(issueDate, l_status) = jsonParser.getDateFieldOf(input, "issueDate");
         return l_status == JsonParser::OK;
     }
 
     bool EnclaveIdentityV2::parseNextUpdate(const rapidjson::Value &input)
     {
         auto l_status = JsonParser::ParseStatus::Missing;
-        struct tm nextUpdateTm{};
-        std::tie(nextUpdateTm, l_status) = jsonParser.getDateFieldOf(input, "nextUpdate");
-        nextUpdate = dcap::mktime(&nextUpdateTm);
+        std::tie(nextUpdate, l_status) = jsonParser.getDateFieldOf(input, "nextUpdate");
         return l_status == JsonParser::OK;
     }
 
@@ -274,7 +306,7 @@ namespace intel { namespace sgx { namespace dcap {
         auto l_status = JsonParser::ParseStatus::Missing;
         for (rapidjson::Value::ConstValueIterator itr = l_tcbLevels.Begin(); itr != l_tcbLevels.End(); itr++)
         {
-            struct tm tcbDate{};
+            time_t tcbDate{};
             std::string tcbStatus;
             uint32_t isvsvn = 0;
 
@@ -345,12 +377,17 @@ namespace intel { namespace sgx { namespace dcap {
         return tcbLevels;
     }
 
+    const EnclaveIdentityMatcher& EnclaveIdentityV2::getMatcher() const
+    {
+        return matcher;
+    }
+
     uint32_t TCBLevel::getIsvsvn() const
     {
         return isvsvn;
     }
 
-    struct tm TCBLevel::getTcbDate() const
+    time_t TCBLevel::getTcbDate() const
     {
         return tcbDate;
     }
@@ -33,10 +33,12 @@
 #define SGXECDSAATTESTATION_ENCLAVEIDENTITYV2_H
 
 #include "OpensslHelpers/Bytes.h"
+#include "EnclaveIdentityMatcher.h"
 #include "Utils/JsonParser.h"
 #include "TcbStatus.h"
 
 #include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <SgxEcdsaAttestation/FixedBytes.h>
 
 #include <rapidjson/document.h>
 
@@ -55,15 +57,15 @@ namespace intel { namespace sgx { namespace dcap {
     {
     public:
         TCBLevel(const uint32_t p_isvsvn,
-                 const struct tm &p_tcbDate,
+                 const time_t p_tcbDate,
                  const TcbStatus p_tcbStatus):
                 isvsvn(p_isvsvn), tcbDate(p_tcbDate), tcbStatus(p_tcbStatus) {};
         uint32_t getIsvsvn() const;
-        struct tm getTcbDate() const;
+        time_t getTcbDate() const;
         TcbStatus getTcbStatus() const;
     protected:
         uint32_t isvsvn;
-        struct tm tcbDate;
+        time_t tcbDate;
         TcbStatus tcbStatus;
     };
 
@@ -89,6 +91,11 @@ namespace intel { namespace sgx { namespace dcap {
         virtual const std::vector<uint8_t>& getAttributes() const;
         virtual const std::vector<uint8_t>& getAttributesMask() const;
         virtual const std::vector<uint8_t>& getMrsigner() const;
+        const parser::Miscselect& getMiscselectValue() const;
+        const parser::Miscselect& getMiscselectMaskValue() const;
+        const parser::SgxAttributes& getAttributesValue() const;
+        const parser::SgxAttributes& getAttributesMaskValue() const;
+        const parser::MrSigner& getMrsignerValue() const;
         virtual uint32_t getIsvProdId() const;
         virtual int getVersion() const;
         virtual bool checkDateCorrectness(time_t expirationDate) const;
@@ -99,6 +106,11 @@ namespace intel { namespace sgx { namespace dcap {
         virtual uint32_t getTcbEvaluationDataNumber() const;
         virtual const std::vector<TCBLevel>& getTcbLevels() const;
 
+        /**
+         * Identity compiled for checking enclave reports, built once the identity is parsed
+         */
+        const EnclaveIdentityMatcher& getMatcher() const;
+
     protected:
         EnclaveIdentityV2() = default;
 
@@ -128,6 +140,12 @@ namespace intel { namespace sgx { namespace dcap {
         std::vector<uint8_t> attributes;
         std::vector<uint8_t> attributesMask;
         std::vector<uint8_t> mrsigner;
+        // fixed-size copies of the fields above, used for matching against enclave report
+        parser::Miscselect miscselectValue;
+        parser::Miscselect miscselectMaskValue;
+        parser::SgxAttributes attributesValue;
+        parser::SgxAttributes attributesMaskValue;
+        parser::MrSigner mrsignerValue;
         time_t issueDate = {};
         time_t nextUpdate = {};
         uint32_t isvProdId = 0;
@@ -135,6 +153,7 @@ namespace intel { namespace sgx { namespace dcap {
         EnclaveID id = EnclaveID::QE;
         uint32_t tcbEvaluationDataNumber;
         std::vector<TCBLevel> tcbLevels;
+        EnclaveIdentityMatcher matcher;
 
         Status status = STATUS_SGX_ENCLAVE_IDENTITY_UNSUPPORTED_FORMAT;
     };
@@ -45,9 +45,6 @@ class EnclaveReportVerifier {
 public:
     virtual ~EnclaveReportVerifier() = default;
     virtual Status verify(const EnclaveIdentityV2 *enclaveIdentity, const EnclaveReport& enclaveReport) const;
-
-private:
-    uint32_t vectorToUint32(const std::vector<uint8_t>& input) const;
 };
 
 }}} // namespace intel { namespace sgx { namespace dcap {
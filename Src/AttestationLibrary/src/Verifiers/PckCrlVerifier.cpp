@@ -33,6 +33,7 @@
 #include "Utils/Logger.h"
 
 #include <CertVerification/X509Constants.h>
+#include <CertVerification/InternedName.h>
 #include <OpensslHelpers/SignatureVerification.h>
 
 namespace intel { namespace sgx { namespace dcap {
@@ -48,15 +49,9 @@ PckCrlVerifier::PckCrlVerifier(std::unique_ptr<CommonVerifier>&& commonVerifier)
 
 Status PckCrlVerifier::verify(const pckparser::CrlStore &crl, const dcap::parser::x509::Certificate &cert) const
 {
-    const auto &crlIssuer = crl.getIssuer();
-    const auto &certSubject = cert.getSubject();
-    // this will have to go when CRLs get new parser
-    if(crlIssuer.raw != certSubject.getRaw() ||
-       crlIssuer.commonName != certSubject.getCommonName() ||
-       crlIssuer.countryName != certSubject.getCountryName() ||
-       crlIssuer.organizationName != certSubject.getOrganizationName() ||
-       crlIssuer.locationName != certSubject.getLocationName() ||
-       crlIssuer.stateName != certSubject.getStateName())
+    const InternedName crlIssuer(crl.getIssuer());
+    const InternedName certSubject(cert.getSubject());
+    if(crlIssuer != certSubject || !crlIssuer.hasSameRaw(certSubject))
     {
         LOG_ERROR("CRL has unknown issuer");
         return STATUS_SGX_CRL_UNKNOWN_ISSUER;
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteCollateral.h"
+#include "EnclaveIdentityParser.h"
+
+#include "OpensslHelpers/Algorithms.h"
+#include "OpensslHelpers/OpensslTypes.h"
+
+#include <Utils/Logger.h>
+
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap {
+
+Status parseQuoteCollateral(const char* tcbInfoJson, const char* qeIdentityJson,
+                            parser::json::TcbInfo& tcbInfo, std::unique_ptr<EnclaveIdentityV2>& enclaveIdentity)
+{
+    /// 4.1.2.4.8
+    try
+    {
+        tcbInfo = parser::json::TcbInfo::parse(tcbInfoJson);
+    }
+    catch (const parser::FormatException& ex)
+    {
+        LOG_ERROR("TcbInfo format error: {}", ex.what());
+        return STATUS_UNSUPPORTED_TCB_INFO_FORMAT;
+    }
+    catch (const parser::InvalidExtensionException& ex)
+    {
+        LOG_ERROR("TcbInfo invalid extension error: {}", ex.what());
+        return STATUS_UNSUPPORTED_TCB_INFO_FORMAT;
+    }
+
+    if (qeIdentityJson != nullptr)
+    {
+        EnclaveIdentityParser identityParser;
+        try {
+            enclaveIdentity = identityParser.parse(qeIdentityJson);
+        }
+        catch (const ParserException& ex)
+        {
+            LOG_ERROR("Enclave Identity parsing error: {}", ex.what());
+            return STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT;
+        }
+    }
+
+    return STATUS_OK;
+}
+
+Status parsePckCertificate(const char* pemPckCertificate, parser::x509::PckCertificate& pckCert)
+{
+    try
+    {
+        pckCert = parser::x509::PckCertificate::parse(pemPckCertificate);
+    }
+    catch (const parser::FormatException& ex) /// 4.1.2.4.3
+    {
+        LOG_ERROR("PCK Certificate format error: {}", ex.what());
+        return STATUS_UNSUPPORTED_PCK_CERT_FORMAT;
+    }
+    catch (const parser::InvalidExtensionException& ex) /// 4.1.2.4.4
+    {
+        LOG_ERROR("PCK Certificate invalid extension error: {}", ex.what());
+        return STATUS_INVALID_PCK_CERT;
+    }
+    return STATUS_OK;
+}
+
+std::time_t getExpirationTime(const VerificationCollateral& collateral)
+{
+    auto expiration = std::min(collateral.crl.getValidity().notAfterTime, collateral.tcbInfo.getNextUpdate());
+    if (collateral.enclaveIdentity)
+    {
+        expiration = std::min(expiration, collateral.enclaveIdentity->getNextUpdate());
+    }
+    if (collateral.pckCert)
+    {
+        expiration = std::min(expiration, collateral.pckCert->getValidity().getNotAfterTime());
+    }
+    return expiration;
+}
+
+namespace {
+
+bool updateDigest(EVP_MD_CTX& ctx, const void* data, size_t size)
+{
+    return EVP_DigestUpdate(&ctx, data, size) == 1;
+}
+
+} // anonymous namespace
+
+bool getVerificationRequestKey(const uint8_t* quote, uint32_t quoteSize, const char* pemPckCertificate,
+                               const VerificationCollateral& collateral, DigestKey& key)
+{
+    auto ctx = crypto::make_unique(EVP_MD_CTX_new());
+    const auto algorithms = crypto::getAlgorithms();
+    const auto* sha256 = algorithms->getSha256();
+    const uint8_t hasPckCertificate = pemPckCertificate != nullptr ? 1 : 0;
+    unsigned int keySize = 0;
+    return ctx != nullptr && sha256 != nullptr &&
+           EVP_DigestInit_ex(ctx.get(), sha256, nullptr) == 1 &&
+           updateDigest(*ctx, &collateral.snapshotId, sizeof(collateral.snapshotId)) &&
+           updateDigest(*ctx, &quoteSize, sizeof(quoteSize)) &&
+           updateDigest(*ctx, quote, quoteSize) &&
+           updateDigest(*ctx, &hasPckCertificate, sizeof(hasPckCertificate)) &&
+           (!hasPckCertificate || updateDigest(*ctx, pemPckCertificate, std::char_traits<char>::length(pemPckCertificate))) &&
+           EVP_DigestFinal_ex(ctx.get(), key.data(), &keySize) == 1 &&
+           keySize == key.size();
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
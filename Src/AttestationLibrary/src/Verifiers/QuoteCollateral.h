@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_QUOTECOLLATERAL_H
+#define SGXECDSAATTESTATION_QUOTECOLLATERAL_H
+
+#include "EnclaveIdentityV2.h"
+#include "PckParser/CrlStore.h"
+#include "Utils/DigestKey.h"
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <SgxEcdsaAttestation/AttestationParsers.h>
+
+#include <ctime>
+#include <memory>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Parses TCB Info and optional QE Identity consumed by quote verification.
+ *
+ * @param qeIdentityJson - may be NULL, enclaveIdentity is left empty then
+ * @return STATUS_OK, STATUS_UNSUPPORTED_TCB_INFO_FORMAT or STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT
+ */
+Status parseQuoteCollateral(const char* tcbInfoJson, const char* qeIdentityJson,
+                            parser::json::TcbInfo& tcbInfo, std::unique_ptr<EnclaveIdentityV2>& enclaveIdentity);
+
+/**
+ * Parses PCK certificate, format errors are reported as STATUS_UNSUPPORTED_PCK_CERT_FORMAT
+ * and missing extensions as STATUS_INVALID_PCK_CERT.
+ */
+Status parsePckCertificate(const char* pemPckCertificate, parser::x509::PckCertificate& pckCert);
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+struct _verification_collateral
+{
+    intel::sgx::dcap::pckparser::CrlStore crl;
+    intel::sgx::dcap::parser::json::TcbInfo tcbInfo;
+    std::unique_ptr<intel::sgx::dcap::EnclaveIdentityV2> enclaveIdentity;
+    std::unique_ptr<const intel::sgx::dcap::parser::x509::PckCertificate> pckCert; // null when not provided
+    uint64_t snapshotId = 0; // unique per created collateral, addresses are reused after destroy
+};
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Earliest of CRL and TCB Info nextUpdate, QE Identity nextUpdate and PCK certificate notAfter,
+ * the last two only when present in collateral.
+ */
+std::time_t getExpirationTime(const VerificationCollateral& collateral);
+
+/**
+ * Computes SHA-256 over everything the status of sgxAttestationVerifyQuoteWithCollateral depends on:
+ * collateral snapshot, quote bytes and PCK certificate given with the request.
+ *
+ * @return false when digest could not be computed
+ */
+bool getVerificationRequestKey(const uint8_t* quote, uint32_t quoteSize, const char* pemPckCertificate,
+                               const VerificationCollateral& collateral, DigestKey& key);
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif //SGXECDSAATTESTATION_QUOTECOLLATERAL_H
@@ -41,17 +41,22 @@
 #include <functional>
 
 #include <CertVerification/X509Constants.h>
+#include <CertVerification/InternedName.h>
 #include <QuoteVerification/QuoteConstants.h>
-#include <OpensslHelpers/DigestUtils.h>
-#include <OpensslHelpers/KeyUtils.h>
-#include <OpensslHelpers/SignatureVerification.h>
 #include <OpensslHelpers/Bytes.h>
 #include <Verifiers/PckCertVerifier.h>
+#include <SgxEcdsaAttestation/FixedBytes.h>
 
 using namespace intel::sgx::dcap::parser::json;
 
 namespace intel::sgx::dcap {
 
+QuoteVerifier::QuoteVerifier(): QuoteVerifier(crypto::getOpensslCryptoBackend())
+{}
+
+QuoteVerifier::QuoteVerifier(const crypto::CryptoBackend& cryptoBackend): _cryptoBackend(cryptoBackend)
+{}
+
 Status QuoteVerifier::verify(const Quote& quote,
                              const dcap::parser::x509::PckCertificate& pckCert,
                              const pckparser::CrlStore& crl,
@@ -59,8 +64,60 @@ Status QuoteVerifier::verify(const Quote& quote,
                              const EnclaveIdentityV2 *enclaveIdentity,
                              const EnclaveReportVerifier& enclaveReportVerifier)
 {
-    Optional<Status> qeIdentityStatus;
+    const auto pckCollateralStatus = verifyPckCollateral(pckCert, crl, tcbInfo);
+    if (pckCollateralStatus != STATUS_OK)
+    {
+        return pckCollateralStatus;
+    }
+
+    return quote::visitLayout(quote.getLayoutId(), STATUS_UNSUPPORTED_QUOTE_FORMAT, [&](auto layout) {
+        using Layout = decltype(layout);
+        State state;
+        const auto collateralStatus = verifyCollateral<Layout>(quote, pckCert, tcbInfo, state);
+        if (collateralStatus != STATUS_OK)
+        {
+            return collateralStatus;
+        }
+
+        verifySignatures(quote, state);
+
+        return evaluate<Layout>(quote, pckCert, tcbInfo, enclaveIdentity, enclaveReportVerifier, state);
+    });
+}
+
+Status QuoteVerifier::verifyCollateral(const Quote& quote,
+                                       const dcap::parser::x509::PckCertificate& pckCert,
+                                       const pckparser::CrlStore& crl,
+                                       const dcap::parser::json::TcbInfo& tcbInfo,
+                                       State& state) const
+{
+    const auto pckCollateralStatus = verifyPckCollateral(pckCert, crl, tcbInfo);
+    if (pckCollateralStatus != STATUS_OK)
+    {
+        return pckCollateralStatus;
+    }
 
+    return quote::visitLayout(quote.getLayoutId(), STATUS_UNSUPPORTED_QUOTE_FORMAT, [&](auto layout) {
+        return verifyCollateral<decltype(layout)>(quote, pckCert, tcbInfo, state);
+    });
+}
+
+Status QuoteVerifier::evaluate(const Quote& quote,
+                               const dcap::parser::x509::PckCertificate& pckCert,
+                               const dcap::parser::json::TcbInfo& tcbInfo,
+                               const EnclaveIdentityV2 *enclaveIdentity,
+                               const EnclaveReportVerifier& enclaveReportVerifier,
+                               State& state) const
+{
+    return quote::visitLayout(quote.getLayoutId(), STATUS_UNSUPPORTED_QUOTE_FORMAT, [&](auto layout) {
+        return evaluate<decltype(layout)>(quote, pckCert, tcbInfo, enclaveIdentity, enclaveReportVerifier, state);
+    });
+}
+
+Status QuoteVerifier::verifyPckCollateral(const dcap::parser::x509::PckCertificate& pckCert,
+                                          const pckparser::CrlStore& crl,
+                                          const dcap::parser::json::TcbInfo& tcbInfo) const
+{
     /// 4.1.2.4.4
     if (!_baseVerififer.commonNameContains(pckCert.getSubject(), constants::SGX_PCK_CN_PHRASE)) {
         LOG_ERROR("PCK Certificate. CN in Subject field does not contain \"SGX PCK Certificate\" phrase");
@@ -74,12 +131,12 @@ Status QuoteVerifier::verify(const Quote& quote,
         return STATUS_INVALID_PCK_CRL;
     }
 
-    const auto crlIssuerRaw = crl.getIssuer().raw;
-    const auto pckCertIssuerRaw = pckCert.getIssuer().getRaw();
-    if(crlIssuerRaw != pckCertIssuerRaw)
+    const InternedName crlIssuer(crl.getIssuer());
+    const InternedName pckCertIssuer(pckCert.getIssuer());
+    if(!crlIssuer.hasSameRaw(pckCertIssuer))
     {
         LOG_ERROR("Issuers in PCK revocation List and PCK Certificate are not the same. RL: {}, Cert: {}",
-                  crlIssuerRaw, pckCertIssuerRaw);
+                  crlIssuer.getRaw(), pckCertIssuer.getRaw());
         return STATUS_INVALID_PCK_CRL;
     }
 
@@ -90,15 +147,39 @@ Status QuoteVerifier::verify(const Quote& quote,
         return STATUS_PCK_REVOKED;
     }
 
-    /// 4.1.2.4.9
+    /// 4.1.2.4.10
+    if(pckCert.getFmspc() != tcbInfo.getFmspc())
+    {
+        LOG_ERROR("FMSPC value from TcbInfo ({}) and SGX Extension in PCK Cert ({}) do not match",
+                  bytesToHexString(tcbInfo.getFmspc()), bytesToHexString(pckCert.getFmspc()));
+        return STATUS_TCB_INFO_MISMATCH;
+    }
+
+    if(pckCert.getPceId() != tcbInfo.getPceId())
+    {
+        LOG_ERROR("PCEID value from TcbInfo ({}) and SGX Extension in PCK Cert ({}) do not match",
+                  bytesToHexString(tcbInfo.getPceId()), bytesToHexString(pckCert.getPceId()));
+        return STATUS_TCB_INFO_MISMATCH;
+    }
+
+    return STATUS_OK;
+}
+
+template<typename Layout>
+Status QuoteVerifier::verifyCollateral(const Quote& quote,
+                                       const dcap::parser::x509::PckCertificate& pckCert,
+                                       const dcap::parser::json::TcbInfo& tcbInfo,
+                                       State& state) const
+{
+    /// 4.1.2.4.9, checked after 4.1.2.4.10 as both report TCB Info mismatch
     if(tcbInfo.getVersion() >= 3)
     {
-        if(tcbInfo.getId() == parser::json::TcbInfo::TDX_ID && quote.getHeader().teeType != dcap::constants::TEE_TYPE_TDX)
+        if(tcbInfo.getId() == parser::json::TcbInfo::TDX_ID && !Layout::IS_TDX)
         {
             LOG_ERROR("TcbInfo is generated for TDX and does not match Quote's TEE");
             return STATUS_TCB_INFO_MISMATCH;
         }
-        if(tcbInfo.getId() == parser::json::TcbInfo::SGX_ID && quote.getHeader().teeType != dcap::constants::TEE_TYPE_SGX)
+        if(tcbInfo.getId() == parser::json::TcbInfo::SGX_ID && Layout::IS_TDX)
         {
             LOG_ERROR("TcbInfo is generated for SGX and does not match Quote's TEE");
             return STATUS_TCB_INFO_MISMATCH;
@@ -106,119 +187,156 @@ Status QuoteVerifier::verify(const Quote& quote,
     }
     else // deprecated
     {
-        if(quote.getHeader().teeType == dcap::constants::TEE_TYPE_TDX)
+        if(Layout::IS_TDX)
         {
             LOG_ERROR("TcbInfo version {} is invalid for TDX TEE", tcbInfo.getVersion());
             return STATUS_TCB_INFO_MISMATCH;
         }
     }
 
-    /// 4.1.2.4.10
-    if(pckCert.getFmspc() != tcbInfo.getFmspc())
-    {
-        LOG_ERROR("FMSPC value from TcbInfo ({}) and SGX Extension in PCK Cert ({}) do not match",
-                  bytesToHexString(tcbInfo.getFmspc()), bytesToHexString(pckCert.getFmspc()));
-        return STATUS_TCB_INFO_MISMATCH;
-    }
-
-    if(pckCert.getPceId() != tcbInfo.getPceId())
-    {
-        LOG_ERROR("PCEID value from TcbInfo ({}) and SGX Extension in PCK Cert ({}) do not match",
-                  bytesToHexString(tcbInfo.getPceId()), bytesToHexString(pckCert.getPceId()));
-        return STATUS_TCB_INFO_MISMATCH;
-    }
-
     const auto certificationDataVerificationStatus = verifyCertificationData(quote.getCertificationData());
     if(certificationDataVerificationStatus != STATUS_OK)
     {
         return certificationDataVerificationStatus;
     }
 
-    auto pubKey = crypto::rawToP256PubKey(pckCert.getPubKey());
-    if (pubKey == nullptr)
+    const auto& pckPubKey = pckCert.getPubKey();
+    crypto::RawP256PublicKey rawPckPubKey{};
+    if (pckPubKey.size() == rawPckPubKey.size() + 1) // skip header byte
+    {
+        std::copy(std::next(pckPubKey.begin()), pckPubKey.end(), rawPckPubKey.begin());
+        state.pckPubKey = _cryptoBackend.importP256PublicKey(rawPckPubKey);
+    }
+    if (state.pckPubKey == nullptr)
     {
         LOG_ERROR("Public key parsing error. PCK Certificate is invalid");
         return STATUS_INVALID_PCK_CERT; // if there were issues with parsing public key it means cert was invalid.
                                         // Probably it will never happen because parsing cert should fail earlier.
     }
 
-    Optional<TdxModuleIdentity> tdxModuleIdentity;
-
-    if (tcbInfo.getVersion() >= 3 && tcbInfo.getId() == parser::json::TcbInfo::TDX_ID)
+    if constexpr (Layout::IS_TDX)
     {
-        /// 4.1.2.4.11
-        const auto& tdxModule = tcbInfo.getTdxModule();
-        const auto& quoteMrSignerSeam = quote.getMrSignerSeam();
-        const auto& quoteSeamAttributes = quote.getSeamAttributes();
+        return verifyTdxModule(quote.template getReport<Layout>(), tcbInfo, state);
+    }
+    else
+    {
+        return STATUS_OK;
+    }
+}
 
-        const auto& tdxModuleVersion = quote.getTeeTcbSvn()[1];
-        auto tdxModuleMrSigner = tdxModule.getMrSigner(); // can be overwritten by value from TDX Module Identity
-        auto tdxModuleAttributes = tdxModule.getAttributes(); // can be overwritten by value from TDX Module Identity
-        auto tdxModuleAttributesMask = tdxModule.getAttributesMask(); // can be overwritten by value from TDX Module Identity
+Status QuoteVerifier::verifyTdxModule(const TDReport10& tdReport,
+                                      const dcap::parser::json::TcbInfo& tcbInfo,
+                                      State& state)
+{
+    auto& tdxModuleIdentity = state.tdxModuleIdentity;
 
-        if (quote.getHeader().version > constants::QUOTE_VERSION_3 && tdxModuleVersion > 0)
-        {
-            try
-            {
-                tcbInfo.getTdxModuleIdentities();
-            }
-            catch (const parser::FormatException& ex)
-            {
-                LOG_ERROR("TDX Module version is {} but TCB Info structure returned: {}", tdxModuleVersion, ex.what());
-                return STATUS_TCB_INFO_MISMATCH;
-            }
+    /// 4.1.2.4.11
+    const auto& tdxModule = tcbInfo.getTdxModule();
+    const auto& quoteMrSignerSeam = tdReport.mrSignerSeam;
+    const auto& quoteSeamAttributes = tdReport.seamAttributes;
 
-            tdxModuleIdentity = findTdxModuleIdentity(tcbInfo.getTdxModuleIdentities(), tdxModuleVersion);
-            if (!tdxModuleIdentity)
-            {
-                return STATUS_TDX_MODULE_MISMATCH;
-            }
-            tdxModuleMrSigner = tdxModuleIdentity->getMrSigner();
-            tdxModuleAttributes = tdxModuleIdentity->getAttributes();
-            tdxModuleAttributesMask = tdxModuleIdentity->getAttributesMask();
-        }
+    const auto& tdxModuleVersion = tdReport.teeTcbSvn[1];
+    // can be overwritten by values from TDX Module Identity
+    const std::vector<uint8_t>* tdxModuleMrSigner = &tdxModule.getMrSigner();
+    const std::vector<uint8_t>* tdxModuleAttributes = &tdxModule.getAttributes();
 
-        /// 4.1.2.4.11.1
-        if (quoteMrSignerSeam.size() != tdxModuleMrSigner.size())
+    if (tdxModuleVersion > 0) // TDX quotes are v4 or newer
+    {
+        try
         {
-            LOG_ERROR("MRSIGNERSEAM value size from TdReport in Quote ({}) and MRSIGNER value size from TcbInfo ({}) are not the same",
-                      quoteMrSignerSeam.size(), tdxModuleMrSigner.size());
-            return STATUS_TDX_MODULE_MISMATCH;
+            tcbInfo.getTdxModuleIdentities();
         }
-
-        for(uint32_t i = 0; i < tdxModuleMrSigner.size(); i++)
+        catch (const parser::FormatException& ex)
         {
-            if (tdxModuleMrSigner[i] != quoteMrSignerSeam[i])
-            {
-                LOG_ERROR("MRSIGNERSEAM value from TdReport in Quote ({}) and MRSIGNER value from TcbInfo ({}) are not the same",
-                          bytesToHexString(std::vector<uint8_t>(begin(quoteMrSignerSeam), end(quoteMrSignerSeam))),
-                          bytesToHexString(std::vector<uint8_t>(begin(tdxModuleMrSigner), end(tdxModuleMrSigner))));
-                return STATUS_TDX_MODULE_MISMATCH;
-            }
+            LOG_ERROR("TDX Module version is {} but TCB Info structure returned: {}", tdxModuleVersion, ex.what());
+            return STATUS_TCB_INFO_MISMATCH;
         }
 
-        /// 4.1.2.4.11.2
-        if (quoteSeamAttributes.size() != tdxModuleAttributes.size())
+        tdxModuleIdentity = findTdxModuleIdentity(tcbInfo.getTdxModuleIdentities(), tdxModuleVersion);
+        if (!tdxModuleIdentity)
         {
-            LOG_ERROR("SEAMATTRIBUTES value size from TdReport in Quote ({}) and TDXMODULEATTRIBUTES value size from TcbInfo ({}) are not the same",
-                      quoteMrSignerSeam.size(), tdxModuleMrSigner.size());
             return STATUS_TDX_MODULE_MISMATCH;
         }
+        tdxModuleMrSigner = &tdxModuleIdentity->getMrSigner();
+        tdxModuleAttributes = &tdxModuleIdentity->getAttributes();
+    }
 
-        for (uint32_t i = 0; i < quoteSeamAttributes.size(); i++)
-        {
-            if (quoteSeamAttributes[i] != 0 || quoteSeamAttributes[i] != tdxModuleAttributes[i])
-            {
-                LOG_ERROR("SEAMATTRIBUTES values from TdReport in Quote ({}) and TDXMODULEATTRIBUTES from TcbInfo ({}) are not the same or not zeroed",
-                          bytesToHexString(Bytes(quoteSeamAttributes.begin(), quoteSeamAttributes.end())),
-                          bytesToHexString(tdxModuleAttributes));
-                return STATUS_TDX_MODULE_MISMATCH;
-            }
-        }
+    /// 4.1.2.4.11.1
+    parser::MrSignerSeam expectedMrSigner;
+    if (!expectedMrSigner.assign(*tdxModuleMrSigner))
+    {
+        LOG_ERROR("MRSIGNERSEAM value size from TdReport in Quote ({}) and MRSIGNER value size from TcbInfo ({}) are not the same",
+                  quoteMrSignerSeam.size(), tdxModuleMrSigner->size());
+        return STATUS_TDX_MODULE_MISMATCH;
+    }
+
+    if (expectedMrSigner != quoteMrSignerSeam)
+    {
+        LOG_ERROR("MRSIGNERSEAM value from TdReport in Quote ({}) and MRSIGNER value from TcbInfo ({}) are not the same",
+                  bytesToHexString(Bytes(quoteMrSignerSeam.begin(), quoteMrSignerSeam.end())),
+                  bytesToHexString(*tdxModuleMrSigner));
+        return STATUS_TDX_MODULE_MISMATCH;
+    }
+
+    /// 4.1.2.4.11.2
+    parser::TdxModuleAttributes expectedAttributes;
+    if (!expectedAttributes.assign(*tdxModuleAttributes))
+    {
+        LOG_ERROR("SEAMATTRIBUTES value size from TdReport in Quote ({}) and TDXMODULEATTRIBUTES value size from TcbInfo ({}) are not the same",
+                  quoteSeamAttributes.size(), tdxModuleAttributes->size());
+        return STATUS_TDX_MODULE_MISMATCH;
+    }
+
+    static const parser::TdxModuleAttributes zeroedAttributes{};
+    if (zeroedAttributes != quoteSeamAttributes || expectedAttributes != quoteSeamAttributes)
+    {
+        LOG_ERROR("SEAMATTRIBUTES values from TdReport in Quote ({}) and TDXMODULEATTRIBUTES from TcbInfo ({}) are not the same or not zeroed",
+                  bytesToHexString(Bytes(quoteSeamAttributes.begin(), quoteSeamAttributes.end())),
+                  bytesToHexString(*tdxModuleAttributes));
+        return STATUS_TDX_MODULE_MISMATCH;
     }
 
+    return STATUS_OK;
+}
+
+void QuoteVerifier::verifySignatures(const Quote& quote, State& state) const
+{
     /// 4.1.2.4.12
-    if (!crypto::verifySha256EcdsaSignature(quote.getQeReportSignature(), quote.getQeReport().rawBlob(), *pubKey))
+    const auto qeReport = quote.getQeReport().rawBlob();
+    state.qeReportSignatureValid = state.pckPubKey != nullptr &&
+        _cryptoBackend.verifyP256Signature(*state.pckPubKey, quote.getQeReportSignature(),
+                                           _cryptoBackend.sha256(qeReport.data(), qeReport.size()));
+    if (!state.qeReportSignatureValid)
+    {
+        return;
+    }
+
+    /// 4.1.2.4.13
+    const auto& qeReportDataHash = quote.getQeReportDataDigest();
+    if (qeReportDataHash.empty() || !std::equal(qeReportDataHash.begin(), qeReportDataHash.end(),
+                                                quote.getQeReport().reportData.begin()))
+    {
+        return;
+    }
+
+    /// 4.1.2.4.16
+    state.attestKey = _cryptoBackend.importP256PublicKey(quote.getAttestKeyData());
+    state.quoteSignatureValid = state.attestKey != nullptr &&
+        _cryptoBackend.verifyP256Signature(*state.attestKey, quote.getQuoteSignature(), quote.getSignedDataDigest());
+}
+
+template<typename Layout>
+Status QuoteVerifier::evaluate(const Quote& quote,
+                               const dcap::parser::x509::PckCertificate& pckCert,
+                               const dcap::parser::json::TcbInfo& tcbInfo,
+                               const EnclaveIdentityV2 *enclaveIdentity,
+                               const EnclaveReportVerifier& enclaveReportVerifier,
+                               State& state) const
+{
+    Optional<Status> qeIdentityStatus;
+
+    /// 4.1.2.4.12
+    if (!state.qeReportSignatureValid)
     {
         LOG_ERROR("QE Report Signature extracted from quote ({}) cannot be verified with the Public Key extracted from PCK Certificate ({})",
                   bytesToHexString(std::vector<uint8_t>(begin(quote.getQeReportSignature()), end(quote.getQeReportSignature()))),
@@ -227,16 +345,7 @@ Status QuoteVerifier::verify(const Quote& quote,
     }
 
     /// 4.1.2.4.13
-    const auto hashedConcatOfAttestKeyAndQeReportData = [&]() -> std::vector<uint8_t>
-    {
-        std::vector<uint8_t> ret;
-        ret.reserve(quote.getAttestKeyData().size() + quote.getQeAuthData().size());
-        std::copy(quote.getAttestKeyData().begin(), quote.getAttestKeyData().end(), std::back_inserter(ret));
-        std::copy(quote.getQeAuthData().begin(), quote.getQeAuthData().end(), std::back_inserter(ret));
-
-        return crypto::sha256Digest(ret);
-    }();
-
+    const auto& hashedConcatOfAttestKeyAndQeReportData = quote.getQeReportDataDigest();
     if(hashedConcatOfAttestKeyAndQeReportData.empty() || !std::equal(hashedConcatOfAttestKeyAndQeReportData.begin(),
                                                                      hashedConcatOfAttestKeyAndQeReportData.end(),
                                                                      quote.getQeReport().reportData.begin()))
@@ -250,7 +359,7 @@ Status QuoteVerifier::verify(const Quote& quote,
     if (enclaveIdentity)
     {
         /// 4.1.2.4.14
-        if(quote.getHeader().teeType == dcap::constants::TEE_TYPE_TDX)
+        if constexpr (Layout::IS_TDX)
         {
             if(enclaveIdentity->getVersion() == 1)
             {
@@ -266,7 +375,7 @@ Status QuoteVerifier::verify(const Quote& quote,
                 }
             }
         }
-        else if(quote.getHeader().teeType == dcap::constants::TEE_TYPE_SGX)
+        else
         {
             if(enclaveIdentity->getID() != EnclaveID::QE)
             {
@@ -274,11 +383,6 @@ Status QuoteVerifier::verify(const Quote& quote,
                 return STATUS_QE_IDENTITY_MISMATCH;
             }
         }
-        else
-        {
-            LOG_ERROR("Unknown Quote's TEE. Enclave Identity cannot be valid");
-            return STATUS_QE_IDENTITY_MISMATCH;
-        }
 
         /// 4.1.2.4.15
         qeIdentityStatus = enclaveReportVerifier.verify(enclaveIdentity, quote.getQeReport());
@@ -302,16 +406,13 @@ Status QuoteVerifier::verify(const Quote& quote,
         }
     }
 
-    const auto attestKey = crypto::rawToP256PubKey(quote.getAttestKeyData());
-    if(!attestKey)
+    if(!state.attestKey)
     {
         return STATUS_UNSUPPORTED_QUOTE_FORMAT;
     }
 
     /// 4.1.2.4.16
-    if (!crypto::verifySha256EcdsaSignature(quote.getQuoteSignature(),
-                                            quote.getSignedData(),
-                                            *attestKey))
+    if (!state.quoteSignatureValid)
     {
         LOG_ERROR("Quote Signature ({}) cannot be verified with ECDSA Attestation Key ({})",
                   bytesToHexString(std::vector<uint8_t>(begin(quote.getQuoteSignature()), end(quote.getQuoteSignature()))),
@@ -322,7 +423,7 @@ Status QuoteVerifier::verify(const Quote& quote,
     try
     {
         /// 4.1.2.4.17
-        return checkTcbLevel(tcbInfo, pckCert, quote, qeIdentityStatus, tdxModuleIdentity);
+        return checkTcbLevel<Layout>(tcbInfo, pckCert, quote, qeIdentityStatus, state.tdxModuleIdentity);
     }
     catch (const RuntimeException &ex)
     {
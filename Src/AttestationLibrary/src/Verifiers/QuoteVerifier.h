@@ -40,12 +40,37 @@
 #include "EnclaveReportVerifier.h"
 #include "BaseVerifier.h"
 #include "EnclaveIdentityV2.h"
+#include "Utils/Optional.h"
+#include <OpensslHelpers/CryptoBackend.h>
 
 namespace intel { namespace sgx { namespace dcap {
 
 class QuoteVerifier
 {
 public:
+    /**
+     * Verifies signatures with the OpenSSL backend.
+     */
+    QuoteVerifier();
+
+    /**
+     * @param cryptoBackend - Not owned, must outlive the verifier.
+     */
+    explicit QuoteVerifier(const crypto::CryptoBackend& cryptoBackend);
+
+    /**
+     * Intermediate results passed between verification steps. Signature results are only recorded here,
+     * evaluate() reports them in the order mandated by the specification.
+     */
+    struct State
+    {
+        crypto::P256PublicKeyPtr pckPubKey;
+        Optional<parser::json::TdxModuleIdentity> tdxModuleIdentity;
+        bool qeReportSignatureValid = false;
+        crypto::P256PublicKeyPtr attestKey;
+        bool quoteSignatureValid = false;
+    };
+
     Status verify(const Quote& quote,
                   const dcap::parser::x509::PckCertificate& pckCert,
                   const pckparser::CrlStore& crl,
@@ -53,9 +78,57 @@ public:
                   const EnclaveIdentityV2 *enclaveIdentity,
                   const EnclaveReportVerifier& enclaveReportVerifier);
 
+    /**
+     * Cheap checks of PCK certificate and CRL against each other and against TCB Info, no signature is verified.
+     * First step of verify().
+     */
+    Status verifyCollateral(const Quote& quote,
+                            const dcap::parser::x509::PckCertificate& pckCert,
+                            const pckparser::CrlStore& crl,
+                            const dcap::parser::json::TcbInfo& tcbInfo,
+                            State& state) const;
+
+    /**
+     * ECDSA verification of QE Report and Quote and the QE Report Data digest. Never fails by itself,
+     * skips work whose result would not be reported. Second step of verify().
+     */
+    void verifySignatures(const Quote& quote, State& state) const;
+
+    /**
+     * Reports signature results, evaluates QE Identity and TCB level. Last step of verify().
+     */
+    Status evaluate(const Quote& quote,
+                    const dcap::parser::x509::PckCertificate& pckCert,
+                    const dcap::parser::json::TcbInfo& tcbInfo,
+                    const EnclaveIdentityV2 *enclaveIdentity,
+                    const EnclaveReportVerifier& enclaveReportVerifier,
+                    State& state) const;
+
 private:
+    // Collateral checks that don't depend on quote
+    Status verifyPckCollateral(const dcap::parser::x509::PckCertificate& pckCert,
+                               const pckparser::CrlStore& crl,
+                               const dcap::parser::json::TcbInfo& tcbInfo) const;
+
+    // Steps above for quote of given quote::Layout, the public ones dispatch on quote layout once
+    template<typename Layout>
+    Status verifyCollateral(const Quote& quote,
+                            const dcap::parser::x509::PckCertificate& pckCert,
+                            const dcap::parser::json::TcbInfo& tcbInfo,
+                            State& state) const;
+
+    template<typename Layout>
+    Status evaluate(const Quote& quote,
+                    const dcap::parser::x509::PckCertificate& pckCert,
+                    const dcap::parser::json::TcbInfo& tcbInfo,
+                    const EnclaveIdentityV2 *enclaveIdentity,
+                    const EnclaveReportVerifier& enclaveReportVerifier,
+                    State& state) const;
+
+    static Status verifyTdxModule(const TDReport10& tdReport, const dcap::parser::json::TcbInfo& tcbInfo, State& state);
     static Status verifyCertificationData(const CertificationData& certificationData) ;
     BaseVerifier _baseVerififer;
+    const crypto::CryptoBackend& _cryptoBackend;
 };
 
 }}}// namespace intel { namespace sgx { namespace dcap {
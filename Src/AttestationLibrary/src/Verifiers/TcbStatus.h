@@ -35,6 +35,7 @@
 #include <string>
 #include <set>
 #include <map>
+#include <stdexcept>
 #include "SgxEcdsaAttestation/QuoteVerification.h"
 #include "Utils/Logger.h"
 #include "Utils/RuntimeException.h"
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/DigestUtils.h>
+#include <OpensslHelpers/Sha256Batch.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+// per quote: SGX quote header with enclave report, then attestation key with 32 bytes of QE Authentication Data
+const Bytes SIGNED_DATA(432, 0x5a);
+const Bytes ATTEST_KEY(64, 0x3c);
+const Bytes QE_AUTH_DATA(32, 0xa5);
+
+std::vector<crypto::Sha256BatchInput> batchInputs(size_t quoteCount)
+{
+    std::vector<crypto::Sha256BatchInput> inputs;
+    for (size_t i = 0; i < quoteCount; ++i)
+    {
+        inputs.push_back({SIGNED_DATA.data(), SIGNED_DATA.size(), nullptr, 0});
+        inputs.push_back({ATTEST_KEY.data(), ATTEST_KEY.size(), QE_AUTH_DATA.data(), QE_AUTH_DATA.size()});
+    }
+    return inputs;
+}
+
+} // namespace
+
+static void BM_Sha256PerQuote(benchmark::State& state)
+{
+    const auto quoteCount = static_cast<size_t>(state.range(0));
+    Bytes qeReportData = ATTEST_KEY;
+    qeReportData.insert(qeReportData.end(), QE_AUTH_DATA.begin(), QE_AUTH_DATA.end());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < quoteCount; ++i)
+        {
+            benchmark::DoNotOptimize(crypto::sha256Digest(SIGNED_DATA));
+            benchmark::DoNotOptimize(crypto::sha256Digest(qeReportData));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sha256PerQuote)->Arg(8)->Arg(64)->Arg(512);
+
+// second argument is crypto::Sha256Kernel
+static void BM_Sha256Batch(benchmark::State& state)
+{
+    const auto kernel = static_cast<crypto::Sha256Kernel>(state.range(1));
+    if (!crypto::isSha256KernelSupported(kernel))
+    {
+        state.SkipWithError("SHA-256 kernel is not supported by this CPU");
+        return;
+    }
+    const auto inputs = batchInputs(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crypto::sha256Batch(inputs, kernel));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sha256Batch)->ArgsProduct({{8, 64, 512}, {static_cast<int64_t>(crypto::Sha256Kernel::OPENSSL),
+                                                       static_cast<int64_t>(crypto::Sha256Kernel::AVX2)}});
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/CryptoBackend.h>
+#include <OpensslHelpers/P256Table.h>
+
+#include <EcdsaSignatureGenerator.h>
+#include <KeyHelpers.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+const Bytes MESSAGE(432, 0x5a); // size of signed data of SGX quote
+
+struct SignedMessage
+{
+    crypto::RawP256PublicKey rawPublicKey;
+    crypto::RawP256Signature signature;
+};
+
+const SignedMessage& signedMessage()
+{
+    static const SignedMessage message = [] {
+        auto prv = test::priv(test::PEM_PRV);
+        auto pub = test::pub(test::PEM_PUB);
+        const auto rawSignature = EcdsaSignatureGenerator::signECDSA_SHA256(MESSAGE, prv.get());
+        SignedMessage signedMsg{test::getRawPub(*pub), {}};
+        std::copy_n(rawSignature.begin(), std::min(rawSignature.size(), signedMsg.signature.size()), signedMsg.signature.begin());
+        return signedMsg;
+    }();
+    return message;
+}
+
+void sha256(benchmark::State& state, const crypto::CryptoBackend* backend)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(backend->sha256(MESSAGE.data(), MESSAGE.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void importKey(benchmark::State& state, const crypto::CryptoBackend* backend)
+{
+    const auto& message = signedMessage();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(backend->importP256PublicKey(message.rawPublicKey));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// what one quote signature costs: key import, digest and verification
+void verify(benchmark::State& state, const crypto::CryptoBackend* backend)
+{
+    const auto& message = signedMessage();
+    for (auto _ : state)
+    {
+        const auto key = backend->importP256PublicKey(message.rawPublicKey);
+        if (key == nullptr ||
+            !backend->verifyP256Signature(*key, message.signature, backend->sha256(MESSAGE.data(), MESSAGE.size())))
+        {
+            state.SkipWithError("Signature verification failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// one-off cost paid by a key that becomes hot, to be weighed against time saved per verification
+void buildP256Table(benchmark::State& state)
+{
+    const auto& message = signedMessage();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crypto::buildP256Table(message.rawPublicKey));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// every backend built into the library runs the same benchmarks, named BM_CryptoBackend/<operation>/<backend>
+const bool registered = [] {
+    for (const auto* backend : crypto::getCryptoBackends())
+    {
+        const auto suffix = std::string("/") + backend->getName();
+        benchmark::RegisterBenchmark(("BM_CryptoBackend/Sha256" + suffix).c_str(), sha256, backend);
+        benchmark::RegisterBenchmark(("BM_CryptoBackend/ImportKey" + suffix).c_str(), importKey, backend);
+        benchmark::RegisterBenchmark(("BM_CryptoBackend/Verify" + suffix).c_str(), verify, backend)
+            ->ThreadRange(1, 8)->UseRealTime();
+    }
+    benchmark::RegisterBenchmark("BM_P256TableBuild", buildP256Table)->Unit(benchmark::kMicrosecond);
+    return true;
+}();
+
+} // namespace
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/DigestUtils.h>
+#include <OpensslHelpers/KeyUtils.h>
+#include <OpensslHelpers/SignatureVerification.h>
+
+#include <DigestUtils.h>
+#include <KeyHelpers.h>
+
+#include <benchmark/benchmark.h>
+
+#include <openssl/param_build.h>
+
+#include <algorithm>
+#include <array>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+const Bytes MESSAGE(384, 0x5a); // size of SGX quote header and enclave report
+
+struct SignedMessage
+{
+    std::array<uint8_t, 64> rawPublicKey;
+    Bytes signature;
+};
+
+const SignedMessage& signedMessage()
+{
+    static const SignedMessage message = [] {
+        auto prv = test::priv(test::PEM_PRV);
+        auto pub = test::pub(test::PEM_PUB);
+        const auto rawPub = test::getRawPub(*pub);
+        SignedMessage signedMsg{};
+        std::copy_n(rawPub.begin(), signedMsg.rawPublicKey.size(), signedMsg.rawPublicKey.begin());
+        signedMsg.signature = DigestUtils::signMessageSha256(MESSAGE, *prv);
+        return signedMsg;
+    }();
+    return message;
+}
+
+// What every call did before algorithms were fetched once: implicit SHA-256 and "EC" fetches by name
+Bytes sha256DigestImplicitFetch(const Bytes& bytes)
+{
+    auto ctx = crypto::make_unique(EVP_MD_CTX_new());
+    Bytes hash(SHA256_DIGEST_LENGTH);
+    unsigned int hashLen = 0;
+    if (ctx != nullptr &&
+        EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr) == 1 &&
+        EVP_DigestUpdate(ctx.get(), bytes.data(), bytes.size()) == 1 &&
+        EVP_DigestFinal_ex(ctx.get(), hash.data(), &hashLen) == 1)
+    {
+        return hash;
+    }
+    return Bytes{};
+}
+
+crypto::EVP_PKEY_uptr rawToP256PubKeyImplicitFetch(const std::array<uint8_t, 64>& rawKey)
+{
+    Bytes data{POINT_CONVERSION_UNCOMPRESSED};
+    data.insert(data.end(), rawKey.begin(), rawKey.end());
+    auto paramBld = crypto::make_unique<OSSL_PARAM_BLD>(OSSL_PARAM_BLD_new());
+    OSSL_PARAM_BLD_push_utf8_string(paramBld.get(), "group", SN_X9_62_prime256v1, 0);
+    auto params = crypto::make_unique<OSSL_PARAM>(OSSL_PARAM_BLD_to_param(paramBld.get()));
+    auto ctx = crypto::make_unique<EVP_PKEY_CTX>(EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr));
+    EVP_PKEY* key = nullptr;
+    if (ctx == nullptr || EVP_PKEY_fromdata_init(ctx.get()) <= 0 ||
+        EVP_PKEY_fromdata(ctx.get(), &key, OSSL_KEYMGMT_SELECT_DOMAIN_PARAMETERS, params.get()) <= 0)
+    {
+        return crypto::make_unique<EVP_PKEY>(nullptr);
+    }
+    auto pkey = crypto::make_unique<EVP_PKEY>(key);
+    const auto* pp = data.data();
+    if (d2i_PublicKey(EVP_PKEY_EC, &key, &pp, static_cast<long>(data.size())) == nullptr)
+    {
+        return crypto::make_unique<EVP_PKEY>(nullptr);
+    }
+    return pkey;
+}
+
+bool verifyImplicitFetch(const SignedMessage& message)
+{
+    const auto key = rawToP256PubKeyImplicitFetch(message.rawPublicKey);
+    auto ctx = crypto::make_unique(EVP_MD_CTX_new());
+    return key != nullptr && ctx != nullptr &&
+           EVP_DigestVerifyInit(ctx.get(), nullptr, EVP_sha256(), nullptr, key.get()) == 1 &&
+           EVP_DigestVerifyUpdate(ctx.get(), MESSAGE.data(), MESSAGE.size()) == 1 &&
+           EVP_DigestVerifyFinal(ctx.get(), message.signature.data(), message.signature.size()) == 1;
+}
+
+bool verifyFetchedOnce(const SignedMessage& message)
+{
+    const auto key = crypto::rawToP256PubKey(message.rawPublicKey);
+    return key != nullptr && crypto::verifySha256Signature(message.signature, MESSAGE, *key);
+}
+
+} // namespace
+
+// Items per second should grow with threads, flat throughput means threads serialize on OpenSSL locks
+static void BM_Sha256ImplicitFetch(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(sha256DigestImplicitFetch(MESSAGE));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Sha256ImplicitFetch)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_Sha256FetchedOnce(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crypto::sha256Digest(MESSAGE));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Sha256FetchedOnce)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_VerifySignatureImplicitFetch(benchmark::State& state)
+{
+    const auto& message = signedMessage();
+    for (auto _ : state)
+    {
+        if (!verifyImplicitFetch(message))
+        {
+            state.SkipWithError("Signature verification failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifySignatureImplicitFetch)->ThreadRange(1, 32)->UseRealTime();
+
+static void BM_VerifySignatureFetchedOnce(benchmark::State& state)
+{
+    const auto& message = signedMessage();
+    for (auto _ : state)
+    {
+        if (!verifyFetchedOnce(message))
+        {
+            state.SkipWithError("Signature verification failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VerifySignatureFetchedOnce)->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <SgxEcdsaAttestation/AttestationParsers.h>
+#include <CertVerification/X509Constants.h>
+#include <QuoteVerification/QuoteConstants.h>
+
+#include <DigestUtils.h>
+#include <EcdsaSignatureGenerator.h>
+#include <EnclaveIdentityGenerator.h>
+#include <KeyHelpers.h>
+#include <QuoteV3Generator.h>
+#include <QuoteV4Generator.h>
+#include <TcbInfoJsonGenerator.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <future>
+#include <thread>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct QuoteInput
+{
+    Bytes quote;
+    std::string tcbInfoJson;
+    std::string qeIdentityJson;
+};
+
+std::vector<uint8_t> concat(std::vector<uint8_t> lhs, const std::vector<uint8_t>& rhs)
+{
+    lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+    return lhs;
+}
+
+template<size_t N>
+std::vector<uint8_t> concat(const std::array<uint8_t, N>& lhs, const std::vector<uint8_t>& rhs)
+{
+    return concat(std::vector<uint8_t>(lhs.begin(), lhs.end()), rhs);
+}
+
+std::array<uint8_t, 64> signAndGetRaw(const std::vector<uint8_t>& data, EVP_PKEY& key)
+{
+    const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(data, &key);
+    std::array<uint8_t, 64> raw{};
+    std::copy_n(signature.begin(), raw.size(), raw.begin());
+    return raw;
+}
+
+std::array<uint8_t, 64> reportDataFor(EVP_PKEY& key, const std::vector<uint8_t>& qeAuthData)
+{
+    std::array<uint8_t, 64> reportData{};
+    const auto hash = DigestUtils::sha256DigestArray(concat(getRawPub(key), qeAuthData));
+    std::copy(hash.begin(), hash.end(), reportData.begin());
+    return reportData;
+}
+
+std::string signedTcbInfo(const std::string& body, EVP_PKEY& key)
+{
+    const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(Bytes(body.begin(), body.end()), &key);
+    return tcbInfoJsonGenerator(body, EcdsaSignatureGenerator::signatureToHexString(signature));
+}
+
+std::string signedEnclaveIdentity(const std::string& body, EVP_PKEY& key)
+{
+    const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(Bytes(body.begin(), body.end()), &key);
+    return enclaveIdentityJsonWithSignature(body, EcdsaSignatureGenerator::signatureToHexString(signature));
+}
+
+/**
+ * Valid SGX quote v3 and TDX quote v4 sharing one PCK certificate, built the same way as in VerifyQuoteIT
+ */
+class MixedQuoteCorpus
+{
+public:
+    MixedQuoteCorpus()
+    {
+        X509CertGenerator certGenerator;
+        X509CrlGenerator crlGenerator;
+        const Bytes sn{0x23, 0x45};
+        const Bytes ppid(16, 0xaa);
+        const Bytes cpusvn(16, 0xff);
+        const Bytes pceId{0x04, 0xf3};
+        const Bytes fmspc{0x04, 0xf3, 0x44, 0x45, 0xaa, 0x00};
+        const Bytes pcesvnLE{0x01, 0x02};
+        const Bytes pcesvnBE{0x02, 0x01};
+
+        auto keyInt = certGenerator.generateEcKeypair();
+        _key = certGenerator.generateEcKeypair();
+        const auto cert = certGenerator.generatePCKCert(2, sn, 0, 3600, _key.get(), keyInt.get(),
+                                                        constants::PCK_SUBJECT, constants::PLATFORM_CA_SUBJECT,
+                                                        ppid, cpusvn, pcesvnBE, pceId, fmspc, 0);
+        const parser::x509::DistinguishedName caName{"", "Intel SGX PCK Platform CA", "US", "Intel Corporation", "Santa Clara", "CA"};
+        const auto interCert = certGenerator.generateCaCert(2, sn, 0, 3600, _key.get(), keyInt.get(), caName, caName);
+        const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, interCert,
+                                                  std::vector<Bytes>{{0x12, 0x10, 0x13, 0x11}});
+        pckPem = certGenerator.x509ToString(cert.get());
+        pckCrl = X509CrlGenerator::x509CrlToDERString(crl.get());
+
+        buildSgx(ppid, cpusvn, pcesvnLE);
+        buildTdx();
+    }
+
+    std::string pckPem;
+    std::string pckCrl;
+    QuoteInput sgx;
+    QuoteInput tdx;
+
+private:
+    void buildSgx(const Bytes& ppid, const Bytes& cpusvn, const Bytes& pcesvnLE)
+    {
+        QuoteV3Generator generator;
+        QuoteV3Generator::CertificationData certificationData;
+        certificationData.keyDataType = constants::PCK_ID_PLAIN_PPID;
+        certificationData.keyData = concat(ppid, concat(cpusvn, pcesvnLE));
+        certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+        generator.withcertificationData(certificationData);
+        generator.getAuthSize() += static_cast<uint32_t>(certificationData.keyData.size());
+        generator.getAuthData().ecdsaAttestationKey.publicKey = getRawPub(*_key);
+
+        EnclaveIdentityVectorModel model;
+        QuoteV3Generator::EnclaveReport qeReport;
+        model.applyTo(qeReport);
+        qeReport.reportData = reportDataFor(*_key, generator.getAuthData().qeAuthData.data);
+        generator.getAuthData().qeReport = qeReport;
+        generator.getAuthData().qeReportSignature.signature = signAndGetRaw(qeReport.bytes(), *_key);
+        generator.getAuthData().ecdsaSignature.signature =
+                signAndGetRaw(concat(generator.getHeader().bytes(), generator.getEnclaveReport().bytes()), *_key);
+
+        sgx.quote = generator.buildQuote();
+        sgx.tcbInfoJson = signedTcbInfo(tcbInfoJsonV2Body(2, "2018-08-22T10:09:10Z", "2118-08-23T10:09:10Z", "04F34445AA00",
+                                                          "04F3", getRandomTcb(), 1, "UpToDate", 0, 1,
+                                                          "2018-08-01T10:00:00Z"), *_key);
+        sgx.qeIdentityJson = signedEnclaveIdentity(model.toV2JSON(), *_key);
+    }
+
+    void buildTdx()
+    {
+        const TdxModule tdxModule{std::vector<uint8_t>(48, 0x00), std::vector<uint8_t>(8, 0x00), std::vector<uint8_t>(8, 0xFF)};
+        std::vector<TcbLevelV3> tcbLevels{TcbLevelV3{getRandomTcbComponent(), getRandomTcbComponent(), 5, "UpToDate",
+                                                     "2058-08-23T10:09:10Z"}};
+        tcbLevels[0].tdxTcbComponents[1].svn = 0; // TDX module major version 0, no TDX module identity matching
+
+        QuoteV4Generator generator;
+        generator.getHeader().teeType = constants::TEE_TYPE_TDX;
+        std::copy_n(tdxModule.mrsigner.begin(), tdxModule.mrsigner.size(), generator.getTdReport().mrSignerSeam.begin());
+        generator.getTdReport().seamAttributes.fill(0x00);
+        generator.getTdReport().teeTcbSvn.fill(0xFF);
+        generator.getTdReport().teeTcbSvn[1] = tcbLevels[0].tdxTcbComponents[1].svn;
+
+        EnclaveIdentityVectorModel model;
+        model.version = 2;
+        model.id = "TD_QE";
+
+        QuoteV4Generator::QEReportCertificationData qeReportCertificationData;
+        qeReportCertificationData.qeAuthData.data = {};
+        qeReportCertificationData.qeAuthData.size = 0;
+        model.applyTo(qeReportCertificationData.qeReport);
+        qeReportCertificationData.certificationData.keyDataType = constants::PCK_ID_PCK_CERT_CHAIN;
+        qeReportCertificationData.certificationData.keyData = {};
+        qeReportCertificationData.certificationData.size = 0;
+        qeReportCertificationData.qeReport.reportData = reportDataFor(*_key, {});
+        qeReportCertificationData.qeReportSignature.signature = signAndGetRaw(qeReportCertificationData.qeReport.bytes(), *_key);
+
+        QuoteV4Generator::CertificationData certificationData;
+        certificationData.keyDataType = constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA;
+        certificationData.keyData = qeReportCertificationData.bytes();
+        certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+        generator.withCertificationData(certificationData);
+        generator.getAuthSize() = 134 + static_cast<uint32_t>(certificationData.keyData.size());
+        generator.getAuthData().ecdsaAttestationKey.publicKey = getRawPub(*_key);
+        generator.getAuthData().ecdsaSignature.signature =
+                signAndGetRaw(concat(generator.getHeader().bytes(), generator.getTdReport().bytes()), *_key);
+
+        tdx.quote = generator.buildTdxQuote();
+        tdx.tcbInfoJson = signedTcbInfo(tcbInfoJsonV3Body("TDX", 3, "2018-08-22T10:09:10Z", "2118-08-23T10:09:10Z",
+                                                          "04F34445AA00", "04F3", 0, 1, tcbLevels, true, tdxModule), *_key);
+        tdx.qeIdentityJson = signedEnclaveIdentity(model.toV2JSON(), *_key);
+    }
+
+    crypto::EVP_PKEY_uptr _key = crypto::make_unique<EVP_PKEY>(nullptr);
+};
+
+const MixedQuoteCorpus& corpus()
+{
+    static const MixedQuoteCorpus instance;
+    return instance;
+}
+
+constexpr size_t BATCH_SIZE = 256;
+
+// TDX quotes arrive grouped at the front of the batch, as when a batch is collected per platform
+std::vector<const QuoteInput*> mixedBatch(int64_t tdxPercent)
+{
+    const auto tdxCount = BATCH_SIZE * static_cast<size_t>(tdxPercent) / 100;
+    std::vector<const QuoteInput*> batch(BATCH_SIZE, &corpus().sgx);
+    std::fill_n(batch.begin(), tdxCount, &corpus().tdx);
+    return batch;
+}
+
+Status verify(const QuoteInput& input)
+{
+    return sgxAttestationVerifyQuote(input.quote.data(), static_cast<uint32_t>(input.quote.size()), corpus().pckPem.c_str(),
+                                     corpus().pckCrl.c_str(), input.tcbInfoJson.c_str(), input.qeIdentityJson.c_str());
+}
+
+size_t threadCount()
+{
+    return std::max(2u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Latencies are measured from the start of the batch, utilization is process CPU time over wall time of all threads
+ */
+class BatchStats
+{
+public:
+    void addBatch(std::vector<double> latenciesUs, double wallSeconds, double cpuSeconds)
+    {
+        _latenciesUs.insert(_latenciesUs.end(), latenciesUs.begin(), latenciesUs.end());
+        _wallSeconds += wallSeconds;
+        _cpuSeconds += cpuSeconds;
+    }
+
+    void report(benchmark::State& state, size_t threads)
+    {
+        std::sort(_latenciesUs.begin(), _latenciesUs.end());
+        const auto percentile = [this](double p) {
+            return _latenciesUs[static_cast<size_t>(p * static_cast<double>(_latenciesUs.size() - 1))];
+        };
+        state.counters["p50_us"] = percentile(0.50);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["max_us"] = _latenciesUs.back();
+        state.counters["core_utilization"] = _cpuSeconds / (_wallSeconds * static_cast<double>(threads));
+        state.SetItemsProcessed(static_cast<int64_t>(_latenciesUs.size()));
+    }
+
+private:
+    std::vector<double> _latenciesUs;
+    double _wallSeconds = 0;
+    double _cpuSeconds = 0;
+};
+
+double microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+double cpuSeconds()
+{
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+struct PipelineBatch
+{
+    Clock::time_point start;
+    std::vector<double> latenciesUs;
+    std::atomic<size_t> remaining{0};
+    std::promise<void> done;
+};
+
+struct PipelineRequest
+{
+    PipelineBatch* batch;
+    size_t index;
+};
+
+void onVerified(Status status, void* userData)
+{
+    const auto* request = static_cast<PipelineRequest*>(userData);
+    if (status != STATUS_OK)
+    {
+        std::abort();
+    }
+    request->batch->latenciesUs[request->index] = microsecondsSince(request->batch->start);
+    if (--request->batch->remaining == 0)
+    {
+        request->batch->done.set_value();
+    }
+}
+
+} // namespace
+
+// Baseline: the batch split into equal contiguous slices, one thread per slice
+static void BM_MixedBatchStaticPartition(benchmark::State& state)
+{
+    const auto batch = mixedBatch(state.range(0));
+    const auto threads = threadCount();
+    BatchStats stats;
+    for (auto _ : state)
+    {
+        std::vector<double> latenciesUs(batch.size());
+        const auto cpuStart = cpuSeconds();
+        const auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (size_t worker = 0; worker < threads; ++worker)
+        {
+            workers.emplace_back([&, worker] {
+                const auto first = batch.size() * worker / threads;
+                const auto last = batch.size() * (worker + 1) / threads;
+                for (auto i = first; i < last; ++i)
+                {
+                    benchmark::DoNotOptimize(verify(*batch[i]));
+                    latenciesUs[i] = microsecondsSince(start);
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        stats.addBatch(std::move(latenciesUs), microsecondsSince(start) / 1e6, cpuSeconds() - cpuStart);
+    }
+    stats.report(state, threads);
+}
+BENCHMARK(BM_MixedBatchStaticPartition)->Arg(10)->Arg(50)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Staged pipeline on work-stealing pools, second argument binds workers to CPUs
+static void BM_MixedBatchWorkStealing(benchmark::State& state)
+{
+    const auto batch = mixedBatch(state.range(0));
+    const auto threads = static_cast<uint32_t>(threadCount());
+    const auto lightWorkers = std::max(1u, threads / 4);
+    const AsyncPipelineConfig config{lightWorkers, lightWorkers, threads, lightWorkers, static_cast<uint32_t>(batch.size()),
+                                     state.range(1) != 0 ? ASYNC_PIPELINE_PIN_WORKERS : 0u};
+    AsyncVerificationContext* ctx = nullptr;
+    if (sgxAttestationAsyncContextCreateWithConfig(&config, &ctx) != STATUS_OK)
+    {
+        state.SkipWithError("Creating asynchronous verification context failed");
+        return;
+    }
+
+    BatchStats stats;
+    std::vector<PipelineRequest> requests(batch.size());
+    for (auto _ : state)
+    {
+        PipelineBatch pipelineBatch;
+        pipelineBatch.latenciesUs.resize(batch.size());
+        pipelineBatch.remaining = batch.size();
+        auto done = pipelineBatch.done.get_future();
+        const auto cpuStart = cpuSeconds();
+        pipelineBatch.start = Clock::now();
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            requests[i] = PipelineRequest{&pipelineBatch, i};
+            const VerifyQuoteInput input{batch[i]->quote.data(), static_cast<uint32_t>(batch[i]->quote.size()),
+                                         corpus().pckPem.c_str(), corpus().pckCrl.c_str(),
+                                         batch[i]->tcbInfoJson.c_str(), batch[i]->qeIdentityJson.c_str()};
+            if (sgxAttestationVerifyQuoteAsync(ctx, &input, &onVerified, &requests[i]) != STATUS_OK)
+            {
+                std::abort();
+            }
+        }
+        done.wait();
+        stats.addBatch(std::move(pipelineBatch.latenciesUs), microsecondsSince(pipelineBatch.start) / 1e6,
+                       cpuSeconds() - cpuStart);
+    }
+    sgxAttestationAsyncContextDestroy(ctx);
+    // stages overlap, utilization is reported against the signature workers which bound the throughput
+    stats.report(state, threads);
+}
+BENCHMARK(BM_MixedBatchWorkStealing)->Args({10, 0})->Args({50, 0})->Args({50, 1})->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_QUOTEWITHCERTIFICATIONDATAFIXTURE_H
+#define SGXECDSAATTESTATION_QUOTEWITHCERTIFICATIONDATAFIXTURE_H
+
+#include <gtest/gtest.h>
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <CertVerification/X509Constants.h>
+#include <QuoteV4Generator.h>
+#include <EnclaveIdentityGenerator.h>
+#include <EcdsaSignatureGenerator.h>
+#include <QuoteVerification/QuoteConstants.h>
+#include <TcbInfoJsonGenerator.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
+#include <DigestUtils.h>
+#include <KeyHelpers.h>
+
+#include <array>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
+
+// Builds a PCK chain, CRLs, signed collateral and quotes signed with the PCK key
+struct QuoteWithCertificationDataFixture : public Test
+{
+    int timeNow = 0;
+    int timeOneHour = 3600;
+
+    X509CertGenerator certGenerator;
+    X509CrlGenerator crlGenerator;
+    Bytes sn {0x23, 0x45};
+    Bytes ppid = Bytes(16, 0xaa);
+    Bytes cpusvn = Bytes(16, 0xff);
+    Bytes pceId = {0x04, 0xf3};
+    Bytes fmspc = {0x04, 0xf3, 0x44, 0x45, 0xaa, 0x00};
+    Bytes pcesvnBE = {0x02, 0x01};
+
+    crypto::EVP_PKEY_uptr keyRoot = crypto::make_unique<EVP_PKEY>(nullptr);
+    crypto::EVP_PKEY_uptr keyInt = crypto::make_unique<EVP_PKEY>(nullptr);
+    crypto::EVP_PKEY_uptr key = crypto::make_unique<EVP_PKEY>(nullptr);
+    crypto::X509_uptr rootCert = crypto::make_unique<X509>(nullptr);
+    crypto::X509_uptr intCert = crypto::make_unique<X509>(nullptr);
+    crypto::X509_uptr cert = crypto::make_unique<X509>(nullptr);
+
+    QuoteV4Generator quoteV4Generator;
+
+    std::string rootCertPem;
+    std::string pckCertChain;
+    std::string rootCaCrl;
+    std::string intermediateCaCrl;
+    std::array<const char*, 2> crls{};
+    std::string tcbInfoJson;
+    std::string qeIdentityJson;
+    test::QuoteV4Generator::EnclaveReport qeReport{};
+
+    QuoteWithCertificationDataFixture()
+    {
+        keyRoot = certGenerator.generateEcKeypair();
+        keyInt = certGenerator.generateEcKeypair();
+        key = certGenerator.generateEcKeypair();
+        rootCert = certGenerator.generateCaCert(2, sn, timeNow, timeOneHour, keyRoot.get(), keyRoot.get(),
+                                                constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+        intCert = certGenerator.generateCaCert(2, sn, timeNow, timeOneHour, keyInt.get(), keyRoot.get(),
+                                               constants::PLATFORM_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+        cert = certGenerator.generatePCKCert(2, sn, timeNow, timeOneHour, key.get(), keyInt.get(),
+                                             constants::PCK_SUBJECT, constants::PLATFORM_CA_SUBJECT,
+                                             ppid, cpusvn, pcesvnBE, pceId, fmspc, 0);
+
+        rootCertPem = certGenerator.x509ToString(rootCert.get());
+        pckCertChain = rootCertPem + certGenerator.x509ToString(intCert.get()) + certGenerator.x509ToString(cert.get());
+        rootCaCrl = getValidCrl(rootCert);
+        intermediateCaCrl = getValidCrl(intCert);
+        crls = {{rootCaCrl.c_str(), intermediateCaCrl.c_str()}};
+
+        const auto tcbInfoBody = tcbInfoJsonV2Body(2, "2018-08-22T10:09:10Z", "2118-08-23T10:09:10Z", "04F34445AA00", "04F3",
+                                                   getRandomTcb(), 1, "UpToDate", 0, 1, "2018-08-01T10:00:00Z");
+        tcbInfoJson = tcbInfoJsonGenerator(tcbInfoBody, sign(tcbInfoBody));
+
+        EnclaveIdentityVectorModel model;
+        const auto qeIdentityBody = model.toV2JSON();
+        qeIdentityJson = ::enclaveIdentityJsonWithSignature(qeIdentityBody, sign(qeIdentityBody));
+        model.applyTo(qeReport);
+    }
+
+    std::string getValidCrl(const crypto::X509_uptr &ucert)
+    {
+        auto revokedList = std::vector<Bytes>{{0x12, 0x10, 0x13, 0x11}, {0x11, 0x33, 0xff, 0x56}};
+        auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, ucert, revokedList);
+
+        return X509CrlGenerator::x509CrlToPEMString(crl.get());
+    }
+
+    std::string sign(const std::string& body)
+    {
+        const Bytes bodyBytes(body.begin(), body.end());
+        return EcdsaSignatureGenerator::signatureToHexString(EcdsaSignatureGenerator::signECDSA_SHA256(bodyBytes, key.get()));
+    }
+
+    std::array<uint8_t, 64> signAndGetRaw(const std::vector<uint8_t>& data, EVP_PKEY& ukey)
+    {
+        auto usignature = EcdsaSignatureGenerator::signECDSA_SHA256(data, &ukey);
+        std::array<uint8_t, 64> signatureArr{};
+        std::copy_n(usignature.begin(), signatureArr.size(), signatureArr.begin());
+        return signatureArr;
+    }
+
+    std::vector<uint8_t> buildSgxQuote(uint16_t certificationDataType, const std::string& certificationDataContent)
+    {
+        test::QuoteV4Generator::QeAuthData qeAuthData;
+        qeAuthData.data = {};
+        qeAuthData.size = 0;
+
+        test::QuoteV4Generator::CertificationData certificationData;
+        certificationData.keyDataType = certificationDataType;
+        certificationData.keyData = Bytes(certificationDataContent.begin(), certificationDataContent.end());
+        certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+
+        const auto attestationKey = test::getRawPub(*key);
+        Bytes reportDataSource(attestationKey.begin(), attestationKey.end());
+        const auto reportDataDigest = DigestUtils::sha256DigestArray(reportDataSource);
+
+        test::QuoteV4Generator::QEReportCertificationData qeReportCertificationData;
+        qeReportCertificationData.qeAuthData = qeAuthData;
+        qeReportCertificationData.qeReport = qeReport;
+        qeReportCertificationData.certificationData = certificationData;
+        qeReportCertificationData.qeReport.reportData = {};
+        std::copy_n(reportDataDigest.begin(), reportDataDigest.size(), qeReportCertificationData.qeReport.reportData.begin());
+        qeReportCertificationData.qeReportSignature.signature = signAndGetRaw(qeReportCertificationData.qeReport.bytes(), *key);
+
+        test::QuoteV4Generator::CertificationData qeCertificationData;
+        qeCertificationData.keyDataType = constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA;
+        qeCertificationData.keyData = qeReportCertificationData.bytes();
+        qeCertificationData.size = static_cast<uint16_t>(qeCertificationData.keyData.size());
+
+        quoteV4Generator.withCertificationData(qeCertificationData);
+        quoteV4Generator.getAuthSize() = 134 + (uint32_t) qeCertificationData.keyData.size();
+        quoteV4Generator.getAuthData().ecdsaAttestationKey.publicKey = attestationKey;
+
+        Bytes signedData = quoteV4Generator.getHeader().bytes();
+        const auto enclaveReportBytes = quoteV4Generator.getEnclaveReport().bytes();
+        signedData.insert(signedData.end(), enclaveReportBytes.begin(), enclaveReportBytes.end());
+        quoteV4Generator.getAuthData().ecdsaSignature.signature = signAndGetRaw(signedData, *key);
+
+        return quoteV4Generator.buildSgxQuote();
+    }
+};
+
+#endif //SGXECDSAATTESTATION_QUOTEWITHCERTIFICATIONDATAFIXTURE_H
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteWithCertificationDataFixture.h"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces global allocation functions of the test binary, only the thread that enabled counting is counted
+namespace {
+
+thread_local bool countAllocations = false;
+thread_local size_t allocationCount = 0;
+
+} // anonymous namespace
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations)
+    {
+        ++allocationCount;
+    }
+    if (auto* allocated = std::malloc(size != 0 ? size : 1))
+    {
+        return allocated;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* allocated) noexcept
+{
+    std::free(allocated);
+}
+
+void operator delete(void* allocated, std::size_t) noexcept
+{
+    std::free(allocated);
+}
+
+namespace {
+
+// Upper bounds for the steady state of a single thread, scratch buffers and interned names are already warm.
+// Most of what is left are vectors and strings owned by the parsed quote, certificate and collateral.
+constexpr size_t VERIFY_QUOTE_ALLOCATION_BUDGET = 160;
+constexpr size_t PER_TCB_LEVEL_ALLOCATION_BUDGET = 6;
+
+} // anonymous namespace
+
+struct VerifyQuoteAllocationsIT : public QuoteWithCertificationDataFixture
+{
+    std::string tcbInfoWithLevels(size_t levelCount)
+    {
+        std::vector<TcbLevelV3> levels;
+        for (size_t level = 0; level < levelCount; ++level)
+        {
+            levels.push_back(TcbLevelV3{getRandomTcbComponent(), {}, static_cast<int>(levelCount - level),
+                                        "UpToDate", "2018-08-01T10:00:00Z"});
+        }
+        const auto body = tcbInfoJsonV3Body("SGX", 3, "2018-08-22T10:09:10Z", "2118-08-23T10:09:10Z", "04F34445AA00",
+                                            "04F3", 0, 1, levels, false, ::TdxModule{});
+        return tcbInfoJsonGenerator(body, sign(body));
+    }
+
+    size_t countVerifyQuoteAllocations(const std::string& tcbInfo)
+    {
+        const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+        const auto pckPem = certGenerator.x509ToString(cert.get());
+        const auto verify = [&] {
+            return sgxAttestationVerifyQuote(quote.data(), (uint32_t) quote.size(), pckPem.c_str(), intermediateCaCrl.c_str(),
+                                             tcbInfo.c_str(), qeIdentityJson.c_str());
+        };
+
+        EXPECT_EQ(STATUS_OK, verify());
+
+        allocationCount = 0;
+        countAllocations = true;
+        const auto status = verify();
+        countAllocations = false;
+
+        EXPECT_EQ(STATUS_OK, status);
+        return allocationCount;
+    }
+};
+
+TEST_F(VerifyQuoteAllocationsIT, verifyQuoteShouldStayWithinAllocationBudget)
+{
+    // GIVEN
+    const auto tcbInfo = tcbInfoWithLevels(8);
+
+    // WHEN
+    const auto allocations = countVerifyQuoteAllocations(tcbInfo);
+
+    // THEN
+    EXPECT_LE(allocations, VERIFY_QUOTE_ALLOCATION_BUDGET);
+}
+
+TEST_F(VerifyQuoteAllocationsIT, tcbLevelShouldOnlyAllocateItsOwnData)
+{
+    // GIVEN
+    const auto singleLevel = tcbInfoWithLevels(1);
+    const auto manyLevels = tcbInfoWithLevels(9);
+
+    // WHEN
+    const auto singleLevelAllocations = countVerifyQuoteAllocations(singleLevel);
+    const auto manyLevelsAllocations = countVerifyQuoteAllocations(manyLevels);
+
+    // THEN
+    ASSERT_GE(manyLevelsAllocations, singleLevelAllocations);
+    EXPECT_LE((manyLevelsAllocations - singleLevelAllocations) / 8, PER_TCB_LEVEL_ALLOCATION_BUDGET);
+}
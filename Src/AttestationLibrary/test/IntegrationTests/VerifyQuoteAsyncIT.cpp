@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteWithCertificationDataFixture.h"
+
+#include <future>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
+
+struct VerifyQuoteAsyncIT : public QuoteWithCertificationDataFixture
+{
+    AsyncVerificationContext* ctx = nullptr;
+    std::vector<uint8_t> quote;
+    std::string pckPem;
+    VerifyQuoteInput input{};
+
+    VerifyQuoteAsyncIT()
+    {
+        quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+        pckPem = certGenerator.x509ToString(cert.get());
+        input = VerifyQuoteInput{quote.data(), (uint32_t) quote.size(), pckPem.c_str(), intermediateCaCrl.c_str(),
+                                 tcbInfoJson.c_str(), qeIdentityJson.c_str()};
+    }
+
+    ~VerifyQuoteAsyncIT() override
+    {
+        sgxAttestationAsyncContextDestroy(ctx);
+    }
+
+    std::vector<AsyncCompletion> waitForCompletions(size_t expected)
+    {
+        std::vector<AsyncCompletion> result;
+        while (result.size() < expected)
+        {
+            AsyncCompletion buffer[4];
+            uint32_t count = 0;
+            EXPECT_EQ(STATUS_OK, sgxAttestationAsyncPollCompletions(ctx, buffer, 4, &count));
+            result.insert(result.end(), buffer, buffer + count);
+            if (count == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        return result;
+    }
+
+    static void setPromise(Status status, void* userData)
+    {
+        static_cast<std::promise<Status>*>(userData)->set_value(status);
+    }
+};
+
+TEST_F(VerifyQuoteAsyncIT, callbackShouldReceiveSameStatusAsSynchronousCall)
+{
+    // GIVEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreate(2, 4, &ctx));
+    std::promise<Status> valid;
+    std::promise<Status> truncated;
+    auto truncatedInput = input;
+    truncatedInput.quoteSize -= 1;
+
+    // WHEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, &VerifyQuoteAsyncIT::setPromise, &valid));
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &truncatedInput, &VerifyQuoteAsyncIT::setPromise, &truncated));
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, valid.get_future().get());
+    EXPECT_EQ(sgxAttestationVerifyQuote(quote.data(), (uint32_t) quote.size() - 1, pckPem.c_str(), intermediateCaCrl.c_str(),
+                                        tcbInfoJson.c_str(), qeIdentityJson.c_str()),
+              truncated.get_future().get());
+}
+
+TEST_F(VerifyQuoteAsyncIT, inputBuffersCanBeReleasedOnceRequestIsAccepted)
+{
+    // GIVEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreate(1, 4, &ctx));
+    std::promise<Status> result;
+    auto quoteCopy = quote;
+    auto inputCopy = input;
+    inputCopy.quote = quoteCopy.data();
+
+    // WHEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &inputCopy, &VerifyQuoteAsyncIT::setPromise, &result));
+    std::fill(quoteCopy.begin(), quoteCopy.end(), 0);
+    quoteCopy.clear();
+    quoteCopy.shrink_to_fit();
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result.get_future().get());
+}
+
+TEST_F(VerifyQuoteAsyncIT, resultsShouldBeDeliveredToCompletionQueueWhenNoCallbackIsGiven)
+{
+    // GIVEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreate(2, 8, &ctx));
+    auto truncatedInput = input;
+    truncatedInput.quoteSize = 10;
+    int first = 1;
+    int second = 2;
+
+    // WHEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, &first));
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &truncatedInput, nullptr, &second));
+    auto completions = waitForCompletions(2);
+
+    // THEN
+    ASSERT_EQ(2u, completions.size());
+    std::sort(completions.begin(), completions.end(), [](const auto& a, const auto& b) {
+        return *static_cast<int*>(a.userData) < *static_cast<int*>(b.userData);
+    });
+    EXPECT_EQ(&first, completions[0].userData);
+    EXPECT_EQ(STATUS_OK, completions[0].status);
+    EXPECT_EQ(&second, completions[1].userData);
+    EXPECT_EQ(STATUS_UNSUPPORTED_QUOTE_FORMAT, completions[1].status);
+
+    uint32_t count = 1;
+    EXPECT_EQ(STATUS_OK, sgxAttestationAsyncPollCompletions(ctx, nullptr, 0, &count));
+    EXPECT_EQ(0u, count);
+}
+
+#ifdef __linux__
+TEST_F(VerifyQuoteAsyncIT, completionFdShouldBeReadableOnlyWhileCompletionsArePending)
+{
+    // GIVEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreate(1, 1, &ctx));
+    const int fd = sgxAttestationAsyncGetCompletionFd(ctx);
+    ASSERT_NE(-1, fd);
+    pollfd pfd{fd, POLLIN, 0};
+    ASSERT_EQ(0, poll(&pfd, 1, 0));
+
+    // WHEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, nullptr));
+
+    // THEN
+    ASSERT_EQ(1, poll(&pfd, 1, 10000));
+    AsyncCompletion completion{};
+    uint32_t count = 0;
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncPollCompletions(ctx, &completion, 1, &count));
+    EXPECT_EQ(1u, count);
+    EXPECT_EQ(STATUS_OK, completion.status);
+    EXPECT_EQ(0, poll(&pfd, 1, 0));
+}
+#endif
+
+TEST_F(VerifyQuoteAsyncIT, shouldReturnBusyInsteadOfQueueingBeyondDepth)
+{
+    // GIVEN one worker blocked in a callback and a queue of depth one
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreate(1, 1, &ctx));
+    struct Gate
+    {
+        std::promise<void> entered;
+        std::shared_future<void> release;
+    };
+    std::promise<void> release;
+    Gate gate{{}, release.get_future().share()};
+    auto entered = gate.entered.get_future();
+    const auto blockingCallback = [](Status, void* userData) {
+        auto* blockingGate = static_cast<Gate*>(userData);
+        blockingGate->entered.set_value();
+        blockingGate->release.wait();
+    };
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, blockingCallback, &gate));
+    entered.wait();
+
+    // WHEN
+    const auto queued = sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, nullptr);
+    const auto rejected = sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, nullptr);
+    release.set_value();
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, queued);
+    EXPECT_EQ(STATUS_BUSY, rejected);
+    EXPECT_EQ(1u, waitForCompletions(1).size());
+}
+
+TEST_F(VerifyQuoteAsyncIT, shouldValidateParameters)
+{
+    auto missingQuote = input;
+    missingQuote.quote = nullptr;
+    auto missingTcbInfo = input;
+    missingTcbInfo.tcbInfoJson = nullptr;
+
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationAsyncContextCreate(1, 1, nullptr));
+    EXPECT_EQ(STATUS_INVALID_PARAMETER, sgxAttestationAsyncContextCreate(1, 0, &ctx));
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreate(1, 1, &ctx));
+
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteAsync(nullptr, &input, nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteAsync(ctx, nullptr, nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteAsync(ctx, &missingQuote, nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteAsync(ctx, &missingTcbInfo, nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationAsyncPollCompletions(ctx, nullptr, 1, nullptr));
+    EXPECT_EQ(-1, sgxAttestationAsyncGetCompletionFd(nullptr));
+}
+
+TEST_F(VerifyQuoteAsyncIT, stagedContextShouldReturnSameStatusesAsSynchronousCall)
+{
+    // GIVEN
+    const AsyncPipelineConfig config{1, 1, 2, 1, 8, 0};
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreateWithConfig(&config, &ctx));
+    auto invalidSignatureQuote = quote;
+    invalidSignatureQuote[constants::HEADER_BYTE_LEN + 320] ^= 0x01; // first byte of enclave report data
+    auto truncatedInput = input;
+    truncatedInput.quoteSize -= 1;
+    auto invalidSignatureInput = input;
+    invalidSignatureInput.quote = invalidSignatureQuote.data();
+    auto invalidCrlInput = input;
+    invalidCrlInput.intermediateCrl = "not a CRL";
+    const std::array<const VerifyQuoteInput*, 4> inputs{{&input, &truncatedInput, &invalidSignatureInput, &invalidCrlInput}};
+    std::array<std::promise<Status>, 4> results;
+
+    // WHEN
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, inputs[i], &VerifyQuoteAsyncIT::setPromise, &results[i]));
+    }
+
+    // THEN
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        EXPECT_EQ(sgxAttestationVerifyQuote(inputs[i]->quote, inputs[i]->quoteSize, inputs[i]->pemPckCertificate,
+                                            inputs[i]->intermediateCrl, inputs[i]->tcbInfoJson, inputs[i]->qeIdentityJson),
+                  results[i].get_future().get());
+    }
+}
+
+TEST_F(VerifyQuoteAsyncIT, stageMetricsShouldCountProcessedRequestsAndEarlyExits)
+{
+    // GIVEN
+    const AsyncPipelineConfig config{1, 1, 1, 1, 4, 0};
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreateWithConfig(&config, &ctx));
+    auto truncatedInput = input;
+    truncatedInput.quoteSize = 10;
+    auto invalidCrlInput = input;
+    invalidCrlInput.intermediateCrl = "not a CRL";
+
+    // WHEN
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, nullptr));
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &truncatedInput, nullptr, nullptr));
+    ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &invalidCrlInput, nullptr, nullptr));
+    ASSERT_EQ(3u, waitForCompletions(3).size());
+
+    // THEN
+    std::array<AsyncStageMetrics, 4> metrics{};
+    for (size_t stage = 0; stage < metrics.size(); ++stage)
+    {
+        ASSERT_EQ(STATUS_OK, sgxAttestationAsyncGetStageMetrics(ctx, static_cast<AsyncStage>(stage), &metrics[stage]));
+        EXPECT_EQ(0u, metrics[stage].queueDepth);
+    }
+    EXPECT_EQ(3u, metrics[ASYNC_STAGE_PARSE].processed);
+    EXPECT_EQ(2u, metrics[ASYNC_STAGE_PARSE].earlyExits);
+    EXPECT_LE(1u, metrics[ASYNC_STAGE_PARSE].peakQueueDepth);
+    for (const auto stage : {ASYNC_STAGE_COLLATERAL, ASYNC_STAGE_SIGNATURE, ASYNC_STAGE_EVALUATION})
+    {
+        EXPECT_EQ(1u, metrics[stage].processed);
+        EXPECT_EQ(0u, metrics[stage].earlyExits);
+    }
+}
+
+TEST_F(VerifyQuoteAsyncIT, stagedContextWithPinnedWorkersShouldVerifyQuotes)
+{
+    // GIVEN
+    const AsyncPipelineConfig config{1, 1, 2, 1, 4, ASYNC_PIPELINE_PIN_WORKERS};
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreateWithConfig(&config, &ctx));
+
+    // WHEN
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, nullptr));
+    }
+    const auto completions = waitForCompletions(4);
+
+    // THEN
+    ASSERT_EQ(4u, completions.size());
+    for (const auto& completion : completions)
+    {
+        EXPECT_EQ(STATUS_OK, completion.status);
+    }
+}
+
+TEST_F(VerifyQuoteAsyncIT, stagedContextWithP256KeyTablesShouldReturnSameStatusesOnceKeysAreHot)
+{
+    // GIVEN
+    const AsyncPipelineConfig config{1, 1, 2, 1, 64, ASYNC_PIPELINE_P256_KEY_TABLES};
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreateWithConfig(&config, &ctx));
+    auto tamperedQuote = quote;
+    tamperedQuote[constants::HEADER_BYTE_LEN + 320] ^= 0x01; // first byte of enclave report data
+    auto tamperedInput = input;
+    tamperedInput.quote = tamperedQuote.data();
+    int valid = 0;
+    int tampered = 1;
+
+    // WHEN, keys of the platform become hot after 16 quotes
+    for (int i = 0; i < 20; ++i)
+    {
+        ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &input, nullptr, &valid));
+        ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteAsync(ctx, &tamperedInput, nullptr, &tampered));
+    }
+    const auto completions = waitForCompletions(40);
+
+    // THEN
+    ASSERT_EQ(40u, completions.size());
+    for (const auto& completion : completions)
+    {
+        EXPECT_EQ(completion.userData == &valid ? STATUS_OK : STATUS_INVALID_QUOTE_SIGNATURE, completion.status);
+    }
+}
+
+TEST_F(VerifyQuoteAsyncIT, stagedContextShouldValidateParameters)
+{
+    const AsyncPipelineConfig noInFlight{1, 1, 1, 1, 0, 0};
+    const AsyncPipelineConfig config{1, 1, 1, 1, 1, 0};
+    AsyncStageMetrics metrics{};
+
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationAsyncContextCreateWithConfig(nullptr, &ctx));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationAsyncContextCreateWithConfig(&config, nullptr));
+    EXPECT_EQ(STATUS_INVALID_PARAMETER, sgxAttestationAsyncContextCreateWithConfig(&noInFlight, &ctx));
+    ASSERT_EQ(STATUS_OK, sgxAttestationAsyncContextCreateWithConfig(&config, &ctx));
+
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationAsyncGetStageMetrics(nullptr, ASYNC_STAGE_PARSE, &metrics));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationAsyncGetStageMetrics(ctx, ASYNC_STAGE_PARSE, nullptr));
+}
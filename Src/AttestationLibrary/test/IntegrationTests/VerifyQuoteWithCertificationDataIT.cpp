@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteWithCertificationDataFixture.h"
+
+struct VerifyQuoteWithCertificationDataIT : public QuoteWithCertificationDataFixture
+{};
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnStatusOkWhenQuoteCarriesValidPckCertChain)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+                                                                       rootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       qeIdentityJson.c_str(), nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnStatusOkWhenEmbeddedChainIsNullTerminatedAndNoQeIdentity)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain + std::string(1, '\0'));
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+                                                                       rootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       nullptr, nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, separateChainAndQuoteCallsShouldAcceptSameInput)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+
+    // WHEN
+    const auto chainResult = sgxAttestationVerifyPCKCertificate(pckCertChain.c_str(), crls.data(), rootCertPem.c_str(), nullptr);
+    const auto quoteResult = sgxAttestationVerifyQuote(quote.data(), (uint32_t) quote.size(), pckPem.c_str(), intermediateCaCrl.c_str(),
+                                                       tcbInfoJson.c_str(), qeIdentityJson.c_str());
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, chainResult);
+    EXPECT_EQ(STATUS_OK, quoteResult);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnMissingParametersWhenArgumentIsNull)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const std::array<const char*, 2> missingCrl{{rootCaCrl.c_str(), nullptr}};
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCertificationData(nullptr, 0, crls.data(),
+              rootCertPem.c_str(), tcbInfoJson.c_str(), nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), nullptr,
+              rootCertPem.c_str(), tcbInfoJson.c_str(), nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), missingCrl.data(),
+              rootCertPem.c_str(), tcbInfoJson.c_str(), nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+              nullptr, tcbInfoJson.c_str(), nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+              rootCertPem.c_str(), nullptr, nullptr, nullptr));
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnUnsupportedQuoteFormatWhenQuoteIsTruncated)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size() - 1, crls.data(),
+                                                                       rootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       nullptr, nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_QUOTE_FORMAT, result);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnUnsupportedPckCertFormatWhenQuoteCarriesSinglePckCert)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERTIFICATE, certGenerator.x509ToString(cert.get()));
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+                                                                       rootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       nullptr, nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_CERT_FORMAT, result);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnUnsupportedCertFormatWhenEmbeddedChainIsIncomplete)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN,
+                                     certGenerator.x509ToString(intCert.get()) + certGenerator.x509ToString(cert.get()));
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+                                                                       rootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       nullptr, nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_CERT_FORMAT, result);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnChainStatusWhenEmbeddedChainIsNotTrusted)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto otherRootKey = certGenerator.generateEcKeypair();
+    const auto otherRootCert = certGenerator.generateCaCert(2, sn, timeNow, timeOneHour, otherRootKey.get(), otherRootKey.get(),
+                                                            constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+    const auto otherRootCertPem = certGenerator.x509ToString(otherRootCert.get());
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+                                                                       otherRootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       nullptr, nullptr);
+
+    // THEN
+    EXPECT_EQ(sgxAttestationVerifyPCKCertificate(pckCertChain.c_str(), crls.data(), otherRootCertPem.c_str(), nullptr), result);
+    EXPECT_NE(STATUS_OK, result);
+}
+
+TEST_F(VerifyQuoteWithCertificationDataIT, shouldReturnQuoteStatusWhenQuoteSignatureIsInvalid)
+{
+    // GIVEN
+    auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    quote[constants::HEADER_BYTE_LEN + 320] ^= 0x01; // first byte of enclave report data
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCertificationData(quote.data(), (uint32_t) quote.size(), crls.data(),
+                                                                       rootCertPem.c_str(), tcbInfoJson.c_str(),
+                                                                       nullptr, nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_INVALID_QUOTE_SIGNATURE, result);
+}
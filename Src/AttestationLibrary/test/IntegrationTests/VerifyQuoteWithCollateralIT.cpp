@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteWithCertificationDataFixture.h"
+
+#include <memory>
+#include <thread>
+
+struct VerifyQuoteWithCollateralIT : public QuoteWithCertificationDataFixture
+{
+    using CollateralPtr = std::unique_ptr<VerificationCollateral, decltype(&sgxAttestationCollateralDestroy)>;
+    using CoalescingContextPtr = std::unique_ptr<CoalescingContext, decltype(&sgxAttestationCoalescingContextDestroy)>;
+    using ResultCachePtr = std::unique_ptr<ResultCache, decltype(&sgxAttestationResultCacheDestroy)>;
+
+    CollateralPtr createCollateral(const char* pemPckCertificate, Status expectedStatus = STATUS_OK) const
+    {
+        VerificationCollateral* collateral = nullptr;
+        EXPECT_EQ(expectedStatus, sgxAttestationCollateralCreate(pemPckCertificate, intermediateCaCrl.c_str(), tcbInfoJson.c_str(),
+                                                                 qeIdentityJson.c_str(), &collateral));
+        return CollateralPtr(collateral, &sgxAttestationCollateralDestroy);
+    }
+
+    static CoalescingContextPtr createCoalescingContext()
+    {
+        CoalescingContext* ctx = nullptr;
+        EXPECT_EQ(STATUS_OK, sgxAttestationCoalescingContextCreate(&ctx));
+        return CoalescingContextPtr(ctx, &sgxAttestationCoalescingContextDestroy);
+    }
+
+    static CoalescingMetrics getMetrics(const CoalescingContext* ctx)
+    {
+        CoalescingMetrics metrics{};
+        EXPECT_EQ(STATUS_OK, sgxAttestationCoalescingContextGetMetrics(ctx, &metrics));
+        return metrics;
+    }
+
+    static ResultCachePtr createResultCache(uint32_t capacity, uint32_t ttlSeconds)
+    {
+        ResultCache* cache = nullptr;
+        EXPECT_EQ(STATUS_OK, sgxAttestationResultCacheCreate(capacity, ttlSeconds, &cache));
+        return ResultCachePtr(cache, &sgxAttestationResultCacheDestroy);
+    }
+
+    static ResultCacheMetrics getMetrics(const ResultCache* cache)
+    {
+        ResultCacheMetrics metrics{};
+        EXPECT_EQ(STATUS_OK, sgxAttestationResultCacheGetMetrics(cache, &metrics));
+        return metrics;
+    }
+};
+
+TEST_F(VerifyQuoteWithCollateralIT, shouldReturnStatusOkForCertificateLoadedWithCollateral)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(pckPem.c_str());
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCollateral(quote.data(), (uint32_t) quote.size(), nullptr, collateral.get());
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, shouldReturnSameStatusAsVerifyQuoteForCertificatePassedWithRequest)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(nullptr);
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteWithCollateral(quote.data(), (uint32_t) quote.size(), pckPem.c_str(), collateral.get());
+    const auto truncatedResult = sgxAttestationVerifyQuoteWithCollateral(quote.data(), (uint32_t) quote.size() - 1, pckPem.c_str(),
+                                                                         collateral.get());
+
+    // THEN
+    EXPECT_EQ(sgxAttestationVerifyQuote(quote.data(), (uint32_t) quote.size(), pckPem.c_str(), intermediateCaCrl.c_str(),
+                                        tcbInfoJson.c_str(), qeIdentityJson.c_str()), result);
+    EXPECT_EQ(STATUS_OK, result);
+    EXPECT_EQ(sgxAttestationVerifyQuote(quote.data(), (uint32_t) quote.size() - 1, pckPem.c_str(), intermediateCaCrl.c_str(),
+                                        tcbInfoJson.c_str(), qeIdentityJson.c_str()), truncatedResult);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, shouldReturnMissingParametersWhenNoCertificateIsAvailable)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto collateral = createCollateral(nullptr);
+    VerificationCollateral* notCreated = nullptr;
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCollateral(quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                                  collateral.get()));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteWithCollateral(quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                                  nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCollateralCreate(nullptr, nullptr, tcbInfoJson.c_str(), nullptr, &notCreated));
+    EXPECT_EQ(nullptr, notCreated);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, shouldRejectInvalidCollateral)
+{
+    // GIVEN
+    VerificationCollateral* collateral = nullptr;
+
+    // WHEN
+    const auto crlResult = sgxAttestationCollateralCreate(nullptr, "invalid crl", tcbInfoJson.c_str(), nullptr, &collateral);
+    const auto tcbInfoResult = sgxAttestationCollateralCreate(nullptr, intermediateCaCrl.c_str(), "{}", nullptr, &collateral);
+    const auto pckResult = sgxAttestationCollateralCreate("invalid pem", intermediateCaCrl.c_str(), tcbInfoJson.c_str(), nullptr,
+                                                          &collateral);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_RL_FORMAT, crlResult);
+    EXPECT_NE(STATUS_OK, tcbInfoResult);
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_CERT_FORMAT, pckResult);
+    EXPECT_EQ(nullptr, collateral);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, shouldVerifyConcurrentlyWithSharedCollateral)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(pckPem.c_str());
+    std::vector<Status> results(4, STATUS_UNSUPPORTED_QUOTE_FORMAT);
+
+    // WHEN
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back([&, i] {
+            results[i] = sgxAttestationVerifyQuoteWithCollateral(quote.data(), (uint32_t) quote.size(), nullptr, collateral.get());
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // THEN
+    for (const auto result : results)
+    {
+        EXPECT_EQ(STATUS_OK, result);
+    }
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, coalescedVerificationShouldReturnSameStatusAsVerificationWithCollateral)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    auto tamperedQuote = quote;
+    tamperedQuote[constants::HEADER_BYTE_LEN + 320] ^= 0x01; // first byte of enclave report data
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(nullptr);
+    const auto ctx = createCoalescingContext();
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteCoalesced(ctx.get(), quote.data(), (uint32_t) quote.size(), pckPem.c_str(),
+                                                           collateral.get());
+    const auto tamperedResult = sgxAttestationVerifyQuoteCoalesced(ctx.get(), tamperedQuote.data(), (uint32_t) tamperedQuote.size(),
+                                                                   pckPem.c_str(), collateral.get());
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+    EXPECT_EQ(STATUS_INVALID_QUOTE_SIGNATURE, tamperedResult);
+    const auto metrics = getMetrics(ctx.get());
+    EXPECT_EQ(2u, metrics.requests);
+    EXPECT_EQ(0u, metrics.coalesced);
+    EXPECT_EQ(0u, metrics.inFlight);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, concurrentCoalescedVerificationsShouldAllReturnStatus)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(pckPem.c_str());
+    const auto otherSnapshot = createCollateral(pckPem.c_str());
+    const auto ctx = createCoalescingContext();
+    std::vector<Status> results(8, STATUS_UNSUPPORTED_QUOTE_FORMAT);
+
+    // WHEN
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        threads.emplace_back([&, i] {
+            const auto* snapshot = i % 2 == 0 ? collateral.get() : otherSnapshot.get();
+            results[i] = sgxAttestationVerifyQuoteCoalesced(ctx.get(), quote.data(), (uint32_t) quote.size(), nullptr, snapshot);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // THEN
+    for (const auto result : results)
+    {
+        EXPECT_EQ(STATUS_OK, result);
+    }
+    const auto metrics = getMetrics(ctx.get());
+    EXPECT_EQ(results.size(), metrics.requests);
+    EXPECT_LE(metrics.coalesced, results.size() - 2); // at least one verification per snapshot
+    EXPECT_EQ(0u, metrics.inFlight);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, coalescedVerificationShouldReturnMissingParameters)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto collateral = createCollateral(nullptr);
+    const auto ctx = createCoalescingContext();
+    CoalescingMetrics metrics{};
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCoalescingContextCreate(nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteCoalesced(nullptr, quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                            collateral.get()));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteCoalesced(ctx.get(), quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                            nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteCoalesced(ctx.get(), quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                            collateral.get()));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCoalescingContextGetMetrics(ctx.get(), nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCoalescingContextGetMetrics(nullptr, &metrics));
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, repeatedPresentationShouldBeAnsweredFromResultCache)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    auto tamperedQuote = quote;
+    tamperedQuote[constants::HEADER_BYTE_LEN + 320] ^= 0x01; // first byte of enclave report data
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(pckPem.c_str());
+    const auto cache = createResultCache(16, 600);
+    const auto now = time(nullptr);
+
+    // WHEN
+    std::vector<Status> results;
+    for (const auto* presented : std::initializer_list<const std::vector<uint8_t>*>{&quote, &tamperedQuote, &quote, &tamperedQuote})
+    {
+        results.push_back(sgxAttestationVerifyQuoteCached(cache.get(), presented->data(), (uint32_t) presented->size(), nullptr,
+                                                          collateral.get(), &now));
+    }
+
+    // THEN
+    EXPECT_EQ((std::vector<Status>{STATUS_OK, STATUS_INVALID_QUOTE_SIGNATURE, STATUS_OK, STATUS_INVALID_QUOTE_SIGNATURE}), results);
+    const auto metrics = getMetrics(cache.get());
+    EXPECT_EQ(2u, metrics.hits);
+    EXPECT_EQ(2u, metrics.misses);
+    EXPECT_EQ(2u, metrics.entries);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, cachedResultShouldExpireWithTtlAndCollateral)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(nullptr);
+    const auto shortTtlCache = createResultCache(16, 60);
+    const auto longTtlCache = createResultCache(16, 365 * 24 * 3600);
+    const auto now = time(nullptr);
+    const auto afterTtl = now + 60;
+    const auto afterCrlNextUpdate = now + 2 * 24 * 3600;
+
+    // WHEN
+    for (auto* cache : {shortTtlCache.get(), longTtlCache.get()})
+    {
+        for (const auto* at : {&now, &afterTtl, &afterCrlNextUpdate})
+        {
+            EXPECT_EQ(STATUS_OK, sgxAttestationVerifyQuoteCached(cache, quote.data(), (uint32_t) quote.size(),
+                                                                 pckPem.c_str(), collateral.get(), at));
+        }
+    }
+
+    // THEN
+    const auto shortTtlMetrics = getMetrics(shortTtlCache.get());
+    EXPECT_EQ(0u, shortTtlMetrics.hits);
+    EXPECT_EQ(2u, shortTtlMetrics.expirations);
+    const auto longTtlMetrics = getMetrics(longTtlCache.get());
+    EXPECT_EQ(1u, longTtlMetrics.hits);
+    EXPECT_EQ(1u, longTtlMetrics.expirations);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, cachedVerificationShouldReturnMissingParameters)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const auto collateral = createCollateral(nullptr);
+    const auto cache = createResultCache(16, 600);
+    ResultCacheMetrics metrics{};
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationResultCacheCreate(16, 600, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteCached(nullptr, quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                         collateral.get(), nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteCached(cache.get(), quote.data(), (uint32_t) quote.size(), nullptr,
+                                                                         nullptr, nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationResultCacheGetMetrics(cache.get(), nullptr));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationResultCacheGetMetrics(nullptr, &metrics));
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, batchVerificationShouldReturnSameStatusesAsVerificationWithCollateral)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    auto tamperedQuote = quote;
+    tamperedQuote[constants::HEADER_BYTE_LEN + 320] ^= 0x01; // first byte of enclave report data
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto collateral = createCollateral(nullptr);
+
+    // more quotes than lanes of one multi-buffer hash, so the batch is hashed in several groups
+    std::vector<const uint8_t*> quotes(10, quote.data());
+    std::vector<uint32_t> quoteSizes(quotes.size(), (uint32_t) quote.size());
+    quotes[3] = tamperedQuote.data();
+    quoteSizes[5] = (uint32_t) quote.size() - 1;
+    quotes[7] = nullptr;
+    std::vector<Status> statuses(quotes.size(), STATUS_BUSY);
+
+    // WHEN
+    const auto result = sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), (uint32_t) quotes.size(), pckPem.c_str(),
+                                                       collateral.get(), statuses.data());
+
+    // THEN
+    ASSERT_EQ(STATUS_OK, result);
+    for (size_t i = 0; i < quotes.size(); ++i)
+    {
+        const auto expected = quotes[i] == nullptr ? STATUS_MISSING_PARAMETERS
+            : sgxAttestationVerifyQuoteWithCollateral(quotes[i], quoteSizes[i], pckPem.c_str(), collateral.get());
+        EXPECT_EQ(expected, statuses[i]) << "quote " << i;
+    }
+    EXPECT_EQ(STATUS_OK, statuses[0]);
+    EXPECT_EQ(STATUS_INVALID_QUOTE_SIGNATURE, statuses[3]);
+    EXPECT_EQ(STATUS_UNSUPPORTED_QUOTE_FORMAT, statuses[5]);
+}
+
+TEST_F(VerifyQuoteWithCollateralIT, batchVerificationShouldReturnMissingParametersAndPckCertificateStatus)
+{
+    // GIVEN
+    const auto quote = buildSgxQuote(constants::PCK_ID_PCK_CERT_CHAIN, pckCertChain);
+    const std::array<const uint8_t*, 1> quotes{{quote.data()}};
+    const std::array<uint32_t, 1> quoteSizes{{(uint32_t) quote.size()}};
+    std::array<Status, 1> statuses{{STATUS_BUSY}};
+    const auto collateral = createCollateral(nullptr);
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), 1, nullptr,
+                                                                        collateral.get(), statuses.data()));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), 1, "pem",
+                                                                        nullptr, statuses.data()));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), 1, "pem",
+                                                                        collateral.get(), nullptr));
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_CERT_FORMAT, sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), 1, "invalid pem",
+                                                                                 collateral.get(), statuses.data()));
+    EXPECT_EQ(STATUS_BUSY, statuses[0]);
+}
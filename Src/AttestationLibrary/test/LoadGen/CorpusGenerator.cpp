@@ -0,0 +1,528 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CorpusGenerator.h"
+
+#include <CertVerification/X509Constants.h>
+#include <QuoteVerification/QuoteConstants.h>
+
+#include <DigestUtils.h>
+#include <EcdsaSignatureGenerator.h>
+#include <EnclaveIdentityGenerator.h>
+#include <KeyHelpers.h>
+#include <QuoteV3Generator.h>
+#include <QuoteV4Generator.h>
+#include <QuoteV5Generator.h>
+#include <TcbInfoJsonGenerator.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
+
+namespace {
+
+constexpr long NOT_BEFORE_OFFSET = -24 * 3600;
+constexpr long NOT_AFTER_OFFSET = 10L * 365 * 24 * 3600;
+constexpr const char* ISSUE_DATE = "2018-08-22T10:09:10Z";
+constexpr const char* NEXT_UPDATE = "2118-08-23T10:09:10Z";
+constexpr const char* TCB_DATE = "2018-08-01T10:00:00Z";
+constexpr uint16_t PCESVN = 5;
+
+const Bytes PCE_ID{0x00, 0x00};
+const Bytes PPID(16, 0xaa);
+// PCK certificates carry highest SVNs, so the single TCB level of every TCB info matches
+const Bytes CPUSVN(16, 0xff);
+const Bytes PCESVN_LE{0x01, 0x02};
+const Bytes PCESVN_BE{0x02, 0x01};
+
+const TdxModule TDX_MODULE{std::vector<uint8_t>(48, 0x00), std::vector<uint8_t>(8, 0x00), std::vector<uint8_t>(8, 0xFF)};
+
+Bytes concat(Bytes lhs, const Bytes& rhs)
+{
+    lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+    return lhs;
+}
+
+template<size_t N>
+Bytes concat(const std::array<uint8_t, N>& lhs, const Bytes& rhs)
+{
+    return concat(Bytes(lhs.begin(), lhs.end()), rhs);
+}
+
+template<size_t N>
+void randomize(std::array<uint8_t, N>& bytes, std::mt19937& random)
+{
+    std::generate(bytes.begin(), bytes.end(), [&random] { return static_cast<uint8_t>(random()); });
+}
+
+std::array<uint8_t, 64> signAndGetRaw(const Bytes& data, EVP_PKEY& key)
+{
+    const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(data, &key);
+    std::array<uint8_t, 64> raw{};
+    std::copy_n(signature.begin(), raw.size(), raw.begin());
+    return raw;
+}
+
+std::array<uint8_t, 64> reportDataFor(EVP_PKEY& attestationKey, const Bytes& qeAuthData)
+{
+    std::array<uint8_t, 64> reportData{};
+    const auto hash = DigestUtils::sha256DigestArray(concat(getRawPub(attestationKey), qeAuthData));
+    std::copy(hash.begin(), hash.end(), reportData.begin());
+    return reportData;
+}
+
+std::string signedTcbInfo(const std::string& body, EVP_PKEY& key)
+{
+    const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(Bytes(body.begin(), body.end()), &key);
+    return tcbInfoJsonGenerator(body, EcdsaSignatureGenerator::signatureToHexString(signature));
+}
+
+std::string signedEnclaveIdentity(const std::string& body, EVP_PKEY& key)
+{
+    const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(Bytes(body.begin(), body.end()), &key);
+    return enclaveIdentityJsonWithSignature(body, EcdsaSignatureGenerator::signatureToHexString(signature));
+}
+
+std::string upperHex(const Bytes& bytes)
+{
+    auto hex = bytesToHexString(bytes);
+    std::transform(hex.begin(), hex.end(), hex.begin(), [](char c) { return static_cast<char>(std::toupper(c)); });
+    return hex;
+}
+
+Status tcbStatusToQuoteStatus(const std::string& tcbStatus)
+{
+    static const std::map<std::string, Status> statuses = {
+        {"UpToDate", STATUS_OK},
+        {"SWHardeningNeeded", STATUS_TCB_SW_HARDENING_NEEDED},
+        {"ConfigurationNeeded", STATUS_TCB_CONFIGURATION_NEEDED},
+        {"ConfigurationAndSWHardeningNeeded", STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED},
+        {"OutOfDate", STATUS_TCB_OUT_OF_DATE},
+        {"OutOfDateConfigurationNeeded", STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED},
+        {"Revoked", STATUS_TCB_REVOKED}
+    };
+    return statuses.at(tcbStatus);
+}
+
+Status expectedStatus(Defect defect, const Platform& platform)
+{
+    switch (defect)
+    {
+        case QUOTE_SIGNATURE_DEFECT:
+            return STATUS_INVALID_QUOTE_SIGNATURE;
+        case QE_REPORT_SIGNATURE_DEFECT:
+            return STATUS_INVALID_QE_REPORT_SIGNATURE;
+        case TRUNCATED_DEFECT:
+        case UNSUPPORTED_VERSION_DEFECT:
+            return STATUS_UNSUPPORTED_QUOTE_FORMAT;
+        case NO_DEFECT:
+        default:
+            return tcbStatusToQuoteStatus(platform.tcbStatus);
+    }
+}
+
+/**
+ * Keys of a platform and its QE report, signed once and shared by all quotes of the platform
+ */
+struct PlatformSigner
+{
+    crypto::EVP_PKEY_uptr pckKey = crypto::make_unique<EVP_PKEY>(nullptr);
+    crypto::EVP_PKEY_uptr attestationKey = crypto::make_unique<EVP_PKEY>(nullptr);
+    QuoteV3Generator::QeAuthData qeAuthDataV3;
+    QuoteV3Generator::EnclaveReport qeReportV3;
+    std::array<uint8_t, 64> qeReportSignatureV3;
+    // QE report certification data, same layout in quote v4 and v5
+    Bytes qeReportCertificationData;
+};
+
+void signQeReports(PlatformSigner& signer, EnclaveIdentityVectorModel& qeModel)
+{
+    QuoteV3Generator generatorV3;
+    signer.qeAuthDataV3 = generatorV3.getAuthData().qeAuthData;
+    signer.qeReportV3 = generatorV3.getAuthData().qeReport;
+    qeModel.applyTo(signer.qeReportV3);
+    signer.qeReportV3.reportData = reportDataFor(*signer.attestationKey, signer.qeAuthDataV3.data);
+    signer.qeReportSignatureV3 = signAndGetRaw(signer.qeReportV3.bytes(), *signer.pckKey);
+
+    QuoteV4Generator::QEReportCertificationData certificationData;
+    certificationData.qeAuthData.data = {};
+    certificationData.qeAuthData.size = 0;
+    qeModel.applyTo(certificationData.qeReport);
+    certificationData.certificationData.keyDataType = constants::PCK_ID_PCK_CERT_CHAIN;
+    certificationData.certificationData.keyData = {};
+    certificationData.certificationData.size = 0;
+    certificationData.qeReport.reportData = reportDataFor(*signer.attestationKey, {});
+    certificationData.qeReportSignature.signature = signAndGetRaw(certificationData.qeReport.bytes(), *signer.pckKey);
+    signer.qeReportCertificationData = certificationData.bytes();
+}
+
+Bytes qeReportCertificationData(const PlatformSigner& signer, Defect defect)
+{
+    auto certificationData = signer.qeReportCertificationData;
+    if (defect == QE_REPORT_SIGNATURE_DEFECT)
+    {
+        certificationData[constants::ENCLAVE_REPORT_BYTE_LEN] ^= 0x01; // first byte of QE report signature
+    }
+    return certificationData;
+}
+
+Bytes buildSgxQuoteV3(const PlatformSigner& signer, Defect defect, std::mt19937& random)
+{
+    QuoteV3Generator generator;
+    QuoteV3Generator::CertificationData certificationData;
+    certificationData.keyDataType = constants::PCK_ID_PLAIN_PPID;
+    certificationData.keyData = concat(PPID, concat(CPUSVN, PCESVN_LE));
+    certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+    generator.withcertificationData(certificationData);
+    generator.getAuthSize() += static_cast<uint32_t>(certificationData.keyData.size());
+    generator.getAuthData().ecdsaAttestationKey.publicKey = getRawPub(*signer.attestationKey);
+    generator.getAuthData().qeAuthData = signer.qeAuthDataV3;
+    generator.getAuthData().qeReport = signer.qeReportV3;
+    generator.getAuthData().qeReportSignature.signature = signer.qeReportSignatureV3;
+    if (defect == QE_REPORT_SIGNATURE_DEFECT)
+    {
+        generator.getAuthData().qeReportSignature.signature[0] ^= 0x01;
+    }
+
+    randomize(generator.getEnclaveReport().mrEnclave, random);
+    randomize(generator.getEnclaveReport().reportData, random);
+    generator.getAuthData().ecdsaSignature.signature =
+            signAndGetRaw(concat(generator.getHeader().bytes(), generator.getEnclaveReport().bytes()), *signer.attestationKey);
+    return generator.buildQuote();
+}
+
+Bytes buildQuoteV4(const PlatformSigner& signer, bool tdx, Defect defect, std::mt19937& random)
+{
+    QuoteV4Generator generator;
+    QuoteV4Generator::CertificationData certificationData;
+    certificationData.keyDataType = constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA;
+    certificationData.keyData = qeReportCertificationData(signer, defect);
+    certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+    generator.withCertificationData(certificationData);
+    generator.getAuthSize() = 134 + static_cast<uint32_t>(certificationData.keyData.size());
+    generator.getAuthData().ecdsaAttestationKey.publicKey = getRawPub(*signer.attestationKey);
+
+    if (!tdx)
+    {
+        randomize(generator.getEnclaveReport().mrEnclave, random);
+        randomize(generator.getEnclaveReport().reportData, random);
+        generator.getAuthData().ecdsaSignature.signature =
+                signAndGetRaw(concat(generator.getHeader().bytes(), generator.getEnclaveReport().bytes()), *signer.attestationKey);
+        return generator.buildSgxQuote();
+    }
+
+    auto& tdReport = generator.getTdReport();
+    generator.getHeader().teeType = constants::TEE_TYPE_TDX;
+    std::copy_n(TDX_MODULE.mrsigner.begin(), tdReport.mrSignerSeam.size(), tdReport.mrSignerSeam.begin());
+    tdReport.seamAttributes.fill(0x00);
+    tdReport.teeTcbSvn.fill(0xFF);
+    tdReport.teeTcbSvn[1] = 0; // TDX module major version 0, no TDX module identity matching
+    randomize(tdReport.mrTd, random);
+    randomize(tdReport.reportData, random);
+    generator.getAuthData().ecdsaSignature.signature =
+            signAndGetRaw(concat(generator.getHeader().bytes(), tdReport.bytes()), *signer.attestationKey);
+    return generator.buildTdxQuote();
+}
+
+Bytes buildTdxQuoteV5(const PlatformSigner& signer, Defect defect, std::mt19937& random)
+{
+    QuoteV5Generator generator;
+    generator.getHeader().teeType = constants::TEE_TYPE_TDX;
+    generator.withBody({static_cast<uint16_t>(constants::BODY_TD_REPORT10_TYPE), static_cast<uint32_t>(constants::TD_REPORT10_BYTE_LEN)});
+    QuoteV5Generator::CertificationData certificationData;
+    certificationData.keyDataType = constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA;
+    certificationData.keyData = qeReportCertificationData(signer, defect);
+    certificationData.size = static_cast<uint32_t>(certificationData.keyData.size());
+    generator.withCertificationData(certificationData);
+    generator.getAuthSize() = 134 + static_cast<uint32_t>(certificationData.keyData.size());
+    generator.getAuthData().ecdsaAttestationKey.publicKey = getRawPub(*signer.attestationKey);
+
+    QuoteV5Generator::TDReport10 tdReport{};
+    std::copy_n(TDX_MODULE.mrsigner.begin(), tdReport.mrSignerSeam.size(), tdReport.mrSignerSeam.begin());
+    tdReport.teeTcbSvn.fill(0xFF);
+    tdReport.teeTcbSvn[1] = 0;
+    randomize(tdReport.mrTd, random);
+    randomize(tdReport.reportData, random);
+    generator.withTDReport10(tdReport);
+    generator.getAuthData().ecdsaSignature.signature =
+            signAndGetRaw(concat(concat(generator.getHeader().bytes(), generator.getBody().bytes()), tdReport.bytes()),
+                          *signer.attestationKey);
+    return generator.buildTdx10Quote();
+}
+
+size_t bodyOffset(QuoteKind kind)
+{
+    return constants::HEADER_BYTE_LEN + (kind == TDX_QUOTE_V5 ? constants::BODY_BYTE_SIZE : 0);
+}
+
+size_t bodySize(QuoteKind kind)
+{
+    return isTdx(kind) ? constants::TD_REPORT10_BYTE_LEN : constants::ENCLAVE_REPORT_BYTE_LEN;
+}
+
+void applyDefect(Bytes& quote, QuoteKind kind, Defect defect)
+{
+    switch (defect)
+    {
+        case QUOTE_SIGNATURE_DEFECT:
+            quote[bodyOffset(kind) + bodySize(kind) - 1] ^= 0x01; // last byte of report data
+            break;
+        case TRUNCATED_DEFECT:
+            quote.resize(quote.size() / 2);
+            break;
+        case UNSUPPORTED_VERSION_DEFECT:
+            quote[0] = 2;
+            quote[1] = 0;
+            break;
+        case QE_REPORT_SIGNATURE_DEFECT: // applied while building
+        case NO_DEFECT:
+        default:
+            break;
+    }
+}
+
+void writeFile(const std::filesystem::path& path, const uint8_t* data, size_t size)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!file)
+    {
+        throw std::runtime_error("Can't write \"" + path.string() + "\"");
+    }
+}
+
+void writeFile(const std::filesystem::path& path, const std::string& content)
+{
+    writeFile(path, reinterpret_cast<const uint8_t*>(content.data()), content.size());
+}
+
+void writeFile(const std::filesystem::path& path, const Bytes& content)
+{
+    writeFile(path, content.data(), content.size());
+}
+
+} // namespace
+
+CorpusGenerator::CorpusGenerator(const LoadGenOptions& loadGenOptions): options(loadGenOptions)
+{}
+
+Corpus CorpusGenerator::generate() const
+{
+    std::mt19937 random(options.seed);
+    std::srand(options.seed); // TCB component generators use rand()
+
+    X509CertGenerator certGenerator;
+    X509CrlGenerator crlGenerator;
+    const auto rootKey = certGenerator.generateEcKeypair();
+    const auto platformCaKey = certGenerator.generateEcKeypair();
+    const auto tcbSigningKey = certGenerator.generateEcKeypair();
+    const auto rootCert = certGenerator.generateCaCert(2, {0x00, 0x45}, NOT_BEFORE_OFFSET, NOT_AFTER_OFFSET, rootKey.get(),
+                                                       rootKey.get(), constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+    const auto platformCaCert = certGenerator.generateCaCert(2, {0x00, 0x46}, NOT_BEFORE_OFFSET, NOT_AFTER_OFFSET,
+                                                             platformCaKey.get(), rootKey.get(),
+                                                             constants::PLATFORM_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+    const auto tcbSigningCert = certGenerator.generateTcbSigningCert(2, {0x00, 0x47}, NOT_BEFORE_OFFSET, NOT_AFTER_OFFSET,
+                                                                     tcbSigningKey.get(), rootKey.get(),
+                                                                     constants::TCB_SUBJECT, constants::ROOT_CA_SUBJECT);
+    const auto rootCaCrl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, NOT_BEFORE_OFFSET, NOT_AFTER_OFFSET, rootCert);
+    const auto intermediateCaCrl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, NOT_BEFORE_OFFSET, NOT_AFTER_OFFSET,
+                                                            platformCaCert, std::vector<Bytes>{{0x12, 0x10, 0x13, 0x11}});
+
+    Corpus corpus;
+    corpus.trustedRootCaCertPem = certGenerator.x509ToString(rootCert.get());
+    corpus.pckSigningChainPem = certGenerator.x509ToString(platformCaCert.get()) + corpus.trustedRootCaCertPem;
+    corpus.tcbSigningChainPem = certGenerator.x509ToString(tcbSigningCert.get()) + corpus.trustedRootCaCertPem;
+    corpus.rootCaCrlDer = hexStringToBytes(X509CrlGenerator::x509CrlToDERString(rootCaCrl.get()));
+    corpus.intermediateCaCrlDer = hexStringToBytes(X509CrlGenerator::x509CrlToDERString(intermediateCaCrl.get()));
+
+    // platforms of a TEE type are consecutive, quotes pick one of them at random
+    std::vector<PlatformSigner> signers;
+    std::array<size_t, 2> firstPlatform{};
+    std::set<Bytes> fmspcs;
+    for (const auto tdx : {false, true})
+    {
+        firstPlatform[tdx] = corpus.platforms.size();
+        for (uint32_t index = 0; index < options.platforms; ++index)
+        {
+            Bytes fmspc(6);
+            do
+            {
+                std::generate(fmspc.begin(), fmspc.end(), [&random] { return static_cast<uint8_t>(random()); });
+            } while (!fmspcs.insert(fmspc).second);
+
+            Platform platform;
+            platform.tdx = tdx;
+            platform.fmspc = upperHex(fmspc);
+            platform.name = (tdx ? "tdx-" : "sgx-") + platform.fmspc;
+            platform.tcbStatus = options.tcbStatuses[index % options.tcbStatuses.size()];
+
+            PlatformSigner signer;
+            signer.pckKey = certGenerator.generateEcKeypair();
+            signer.attestationKey = certGenerator.generateEcKeypair();
+            const Bytes serialNumber{0x01, static_cast<uint8_t>(corpus.platforms.size() >> 8),
+                                     static_cast<uint8_t>(corpus.platforms.size())};
+            const auto pckCert = certGenerator.generatePCKCert(2, serialNumber, NOT_BEFORE_OFFSET, NOT_AFTER_OFFSET,
+                                                               signer.pckKey.get(), platformCaKey.get(),
+                                                               constants::PCK_SUBJECT, constants::PLATFORM_CA_SUBJECT,
+                                                               PPID, CPUSVN, PCESVN_BE, PCE_ID, fmspc, 0);
+            platform.pckCertPem = certGenerator.x509ToString(pckCert.get());
+
+            EnclaveIdentityVectorModel qeModel;
+            qeModel.id = tdx ? "TD_QE" : "QE";
+            qeModel.nextUpdate = NEXT_UPDATE;
+            platform.qeIdentityJson = signedEnclaveIdentity(qeModel.toV2JSON(), *tcbSigningKey);
+            signQeReports(signer, qeModel);
+
+            auto tdxTcbComponents = getRandomTcbComponent();
+            tdxTcbComponents[1].svn = 0;
+            const std::vector<TcbLevelV3> tcbLevels{TcbLevelV3{getRandomTcbComponent(), tdxTcbComponents, PCESVN,
+                                                               platform.tcbStatus, TCB_DATE}};
+            platform.tcbInfoJson = signedTcbInfo(tcbInfoJsonV3Body(tdx ? "TDX" : "SGX", 3, ISSUE_DATE, NEXT_UPDATE, platform.fmspc,
+                                                                   upperHex(PCE_ID), 0, 1, tcbLevels, tdx, TDX_MODULE),
+                                                 *tcbSigningKey);
+
+            corpus.platforms.push_back(std::move(platform));
+            signers.push_back(std::move(signer));
+        }
+    }
+
+    std::discrete_distribution<size_t> kinds(options.mix.begin(), options.mix.end());
+    std::uniform_int_distribution<uint32_t> platforms(0, options.platforms - 1);
+    std::uniform_int_distribution<uint32_t> percent(0, 99);
+    std::uniform_int_distribution<size_t> defects(NO_DEFECT + 1, DEFECT_COUNT - 1);
+    corpus.quotes.reserve(options.count);
+    for (uint32_t index = 0; index < options.count; ++index)
+    {
+        GeneratedQuote quote;
+        quote.kind = static_cast<QuoteKind>(kinds(random));
+        quote.platform = firstPlatform[isTdx(quote.kind)] + platforms(random);
+        quote.defect = percent(random) < options.invalidPercent ? static_cast<Defect>(defects(random)) : NO_DEFECT;
+
+        const auto& signer = signers[quote.platform];
+        switch (quote.kind)
+        {
+            case SGX_QUOTE_V3:
+                quote.quote = buildSgxQuoteV3(signer, quote.defect, random);
+                break;
+            case SGX_QUOTE_V4:
+            case TDX_QUOTE_V4:
+                quote.quote = buildQuoteV4(signer, isTdx(quote.kind), quote.defect, random);
+                break;
+            case TDX_QUOTE_V5:
+            default:
+                quote.quote = buildTdxQuoteV5(signer, quote.defect, random);
+                break;
+        }
+        applyDefect(quote.quote, quote.kind, quote.defect);
+
+        const auto& platform = corpus.platforms[quote.platform];
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "%08u.dat", index);
+        quote.name = platform.name + "/quotes/" + fileName;
+        quote.expectedStatus = expectedStatus(quote.defect, platform);
+        corpus.quotes.push_back(std::move(quote));
+    }
+    return corpus;
+}
+
+void writeCorpus(const Corpus& corpus, const std::string& outputDir)
+{
+    const std::filesystem::path root(outputDir);
+    for (const auto& platform : corpus.platforms)
+    {
+        const auto directory = root / platform.name;
+        std::filesystem::create_directories(directory / "quotes");
+        writeFile(directory / "trustedRootCaCert.pem", corpus.trustedRootCaCertPem);
+        writeFile(directory / "pckSignChain.pem", corpus.pckSigningChainPem);
+        writeFile(directory / "tcbSignChain.pem", corpus.tcbSigningChainPem);
+        writeFile(directory / "rootCaCrl.der", corpus.rootCaCrlDer);
+        writeFile(directory / "intermediateCaCrl.der", corpus.intermediateCaCrlDer);
+        writeFile(directory / "pckCert.pem", platform.pckCertPem);
+        writeFile(directory / "tcbInfo.json", platform.tcbInfoJson);
+        writeFile(directory / "qeIdentity.json", platform.qeIdentityJson);
+    }
+
+    std::ofstream manifest(root / "manifest.csv");
+    manifest << "quote,platform,kind,tcbStatus,defect,expectedStatus\n";
+    for (const auto& quote : corpus.quotes)
+    {
+        writeFile(root / quote.name, quote.quote);
+        const auto& platform = corpus.platforms[quote.platform];
+        manifest << quote.name << ',' << platform.name << ',' << quoteKindName(quote.kind) << ',' << platform.tcbStatus << ','
+                 << defectName(quote.defect) << ',' << statusName(quote.expectedStatus) << '\n';
+    }
+    if (!manifest)
+    {
+        throw std::runtime_error("Can't write \"" + (root / "manifest.csv").string() + "\"");
+    }
+}
+
+const char* defectName(Defect defect)
+{
+    static const std::array<const char*, DEFECT_COUNT> names = {{"none", "quoteSignature", "qeReportSignature",
+                                                                 "truncated", "unsupportedVersion"}};
+    return names.at(defect);
+}
+
+std::string statusName(Status status)
+{
+    static const std::map<Status, std::string> names = {
+        {STATUS_OK, "STATUS_OK"},
+        {STATUS_UNSUPPORTED_QUOTE_FORMAT, "STATUS_UNSUPPORTED_QUOTE_FORMAT"},
+        {STATUS_INVALID_QUOTE_SIGNATURE, "STATUS_INVALID_QUOTE_SIGNATURE"},
+        {STATUS_INVALID_QE_REPORT_SIGNATURE, "STATUS_INVALID_QE_REPORT_SIGNATURE"},
+        {STATUS_TCB_OUT_OF_DATE, "STATUS_TCB_OUT_OF_DATE"},
+        {STATUS_TCB_REVOKED, "STATUS_TCB_REVOKED"},
+        {STATUS_TCB_CONFIGURATION_NEEDED, "STATUS_TCB_CONFIGURATION_NEEDED"},
+        {STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED, "STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED"},
+        {STATUS_TCB_SW_HARDENING_NEEDED, "STATUS_TCB_SW_HARDENING_NEEDED"},
+        {STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED, "STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED"}
+    };
+    const auto name = names.find(status);
+    const auto statusNumber = "(" + std::to_string(status) + ")";
+    return name == names.end() ? "Unknown status" + statusNumber : name->second + statusNumber;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace loadgen {
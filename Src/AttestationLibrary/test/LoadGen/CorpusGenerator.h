@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_LOADGEN_CORPUS_GENERATOR_H
+#define SGX_DCAP_LOADGEN_CORPUS_GENERATOR_H
+
+#include "LoadGenOptions.h"
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <OpensslHelpers/Bytes.h>
+
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+enum Defect
+{
+    NO_DEFECT,
+    QUOTE_SIGNATURE_DEFECT,
+    QE_REPORT_SIGNATURE_DEFECT,
+    TRUNCATED_DEFECT,
+    UNSUPPORTED_VERSION_DEFECT,
+    DEFECT_COUNT
+};
+
+/**
+ * Collateral of a single platform, verifiable with collateral shared by the whole corpus
+ */
+struct Platform
+{
+    std::string name;
+    bool tdx;
+    std::string fmspc;
+    std::string tcbStatus;
+    std::string pckCertPem;
+    std::string tcbInfoJson;
+    std::string qeIdentityJson;
+};
+
+struct GeneratedQuote
+{
+    // path relative to the corpus directory
+    std::string name;
+    size_t platform;
+    QuoteKind kind;
+    Defect defect;
+    Bytes quote;
+    Status expectedStatus;
+};
+
+struct Corpus
+{
+    std::string trustedRootCaCertPem;
+    std::string pckSigningChainPem;
+    std::string tcbSigningChainPem;
+    Bytes rootCaCrlDer;
+    Bytes intermediateCaCrlDer;
+    std::vector<Platform> platforms;
+    std::vector<GeneratedQuote> quotes;
+};
+
+/**
+ * Builds signed quotes with matching collateral from the test generators.
+ * Layout of the corpus (kinds, platforms, defects) depends only on options, keys are generated on every run.
+ */
+class CorpusGenerator
+{
+public:
+    explicit CorpusGenerator(const LoadGenOptions& loadGenOptions);
+
+    Corpus generate() const;
+
+private:
+    const LoadGenOptions& options;
+};
+
+/**
+ * Writes a directory per platform with collateral under the AttestationApp default names and its quotes
+ * in a quotes subdirectory, plus manifest.csv with expected status of every quote.
+ * Throws std::runtime_error when a file can't be written.
+ */
+void writeCorpus(const Corpus& corpus, const std::string& outputDir);
+
+const char* defectName(Defect defect);
+
+// same format as AttestationApp prints statuses, e.g. STATUS_OK(0)
+std::string statusName(Status status);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+#endif // SGX_DCAP_LOADGEN_CORPUS_GENERATOR_H
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "LoadDriver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct CollateralDeleter
+{
+    void operator()(VerificationCollateral* collateral) const
+    {
+        sgxAttestationCollateralDestroy(collateral);
+    }
+};
+
+using CollateralPtr = std::unique_ptr<VerificationCollateral, CollateralDeleter>;
+
+struct WorkerResult
+{
+    std::vector<double> latenciesUs;
+    size_t mismatches = 0;
+    std::string firstMismatch;
+};
+
+// nearest rank, the same as AttestationApp batch summary
+double percentile(const std::vector<double>& sorted, size_t percent)
+{
+    const auto rank = (sorted.size() * percent + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+} // namespace
+
+bool drive(const Corpus& corpus, const DriveOptions& options, std::ostream& logger)
+{
+    std::vector<CollateralPtr> collaterals;
+    for (const auto& platform : corpus.platforms)
+    {
+        const auto crl = bytesToHexString(corpus.intermediateCaCrlDer);
+        VerificationCollateral* collateral = nullptr;
+        const auto status = sgxAttestationCollateralCreate(platform.pckCertPem.c_str(), crl.c_str(), platform.tcbInfoJson.c_str(),
+                                                           platform.qeIdentityJson.c_str(), &collateral);
+        if (status != STATUS_OK)
+        {
+            logger << "Collateral of " << platform.name << " is invalid: " << statusName(status) << std::endl;
+            return false;
+        }
+        collaterals.emplace_back(collateral);
+    }
+
+    const auto threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    const std::chrono::duration<double> interval(options.rate != 0 ? 1.0 / options.rate : 0.0);
+    std::atomic<size_t> nextRequest{0};
+    std::vector<WorkerResult> results(threads);
+    std::vector<std::thread> workers;
+
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::seconds(options.durationSeconds);
+    for (uint32_t worker = 0; worker < threads; ++worker)
+    {
+        workers.emplace_back([&, worker] {
+            auto& result = results[worker];
+            while (true)
+            {
+                const auto request = nextRequest++;
+                // unthrottled requests are due as soon as a worker takes them
+                const auto scheduled = options.rate != 0
+                        ? start + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(request))
+                        : Clock::now();
+                if (scheduled >= end)
+                {
+                    return;
+                }
+                std::this_thread::sleep_until(scheduled);
+
+                const auto& quote = corpus.quotes[request % corpus.quotes.size()];
+                const auto status = sgxAttestationVerifyQuoteWithCollateral(quote.quote.data(), static_cast<uint32_t>(quote.quote.size()),
+                                                                            nullptr, collaterals[quote.platform].get());
+                result.latenciesUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - scheduled).count());
+                if (status != quote.expectedStatus && result.mismatches++ == 0)
+                {
+                    result.firstMismatch = quote.name + ": expected " + statusName(quote.expectedStatus) + ", got " + statusName(status);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    const auto elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    size_t mismatches = 0;
+    for (const auto& result : results)
+    {
+        latencies.insert(latencies.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+        mismatches += result.mismatches;
+        if (!result.firstMismatch.empty())
+        {
+            logger << result.firstMismatch << std::endl;
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    logger << "Requests: " << latencies.size() << ", threads: " << threads << ", elapsed: " << elapsedSeconds << " s" << std::endl;
+    if (latencies.empty())
+    {
+        return true;
+    }
+    logger << "Achieved rate: " << static_cast<double>(latencies.size()) / elapsedSeconds << " quotes/s"
+           << (options.rate != 0 ? ", target " + std::to_string(options.rate) + " quotes/s" : "") << std::endl;
+    logger << "Latency p50: " << percentile(latencies, 50) << " us, p99: " << percentile(latencies, 99)
+           << " us, max: " << latencies.back() << " us" << std::endl;
+    logger << "Unexpected results: " << mismatches << std::endl;
+    return mismatches == 0;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace loadgen {
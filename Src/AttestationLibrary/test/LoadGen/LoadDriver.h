@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_LOADGEN_LOAD_DRIVER_H
+#define SGX_DCAP_LOADGEN_LOAD_DRIVER_H
+
+#include "CorpusGenerator.h"
+
+#include <ostream>
+
+namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+struct DriveOptions
+{
+    // quotes per second, 0 runs unthrottled
+    uint32_t rate;
+    uint32_t durationSeconds;
+    // 0 uses all CPUs
+    uint32_t threads;
+};
+
+/**
+ * Verifies quotes of the corpus in process, cycling through it, with collateral parsed once per platform.
+ * Requests are scheduled open loop at the target rate and latency is measured from the scheduled time,
+ * so a verifier falling behind shows up as latency, not as a lower request rate.
+ * Returns false when any quote verifies with other status than expected.
+ */
+bool drive(const Corpus& corpus, const DriveOptions& options, std::ostream& logger);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+#endif // SGX_DCAP_LOADGEN_LOAD_DRIVER_H
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "LoadGenOptions.h"
+
+#include <argtable3.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+namespace {
+    static const std::array<const char*, QUOTE_KIND_COUNT> quoteKindNames = {{"sgx3", "sgx4", "tdx4", "tdx5"}};
+    static const std::array<const char*, 7> knownTcbStatuses = {{"UpToDate", "SWHardeningNeeded", "ConfigurationNeeded",
+                                                                 "ConfigurationAndSWHardeningNeeded", "OutOfDate",
+                                                                 "OutOfDateConfigurationNeeded", "Revoked"}};
+
+    static const std::string outputDirDefault = "";
+    static const std::string countDefault = "1000";
+    static const std::string seedDefault = "1";
+    static const std::string mixDefault = "sgx3=1,sgx4=1,tdx4=1,tdx5=1";
+    static const std::string platformsDefault = "2";
+    static const std::string tcbStatusDefault = "UpToDate,OutOfDate";
+    static const std::string invalidPercentDefault = "10";
+    static const std::string rateDefault = "0";
+    static const std::string durationDefault = "10";
+    static const std::string threadsDefault = "0";
+
+    std::vector<std::string> split(const std::string& list)
+    {
+        std::vector<std::string> items;
+        std::istringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    uint32_t toUint32(const std::string& value, const std::string& name)
+    {
+        const auto number = std::stoul(value);
+        if (number > UINT32_MAX || value.front() == '-')
+        {
+            throw std::out_of_range(name + " out of range");
+        }
+        return static_cast<uint32_t>(number);
+    }
+
+    std::vector<uint32_t> parseMix(const std::string& mix)
+    {
+        std::vector<uint32_t> weights(QUOTE_KIND_COUNT, 0);
+        for (const auto& item : split(mix))
+        {
+            const auto separator = item.find('=');
+            const auto name = item.substr(0, separator);
+            const auto kind = std::find_if(quoteKindNames.begin(), quoteKindNames.end(),
+                                           [&name](const char* kindName) { return name == kindName; });
+            if (kind == quoteKindNames.end() || separator == std::string::npos)
+            {
+                throw std::invalid_argument("unknown quote kind \"" + item + "\"");
+            }
+            weights[static_cast<size_t>(kind - quoteKindNames.begin())] = toUint32(item.substr(separator + 1), name);
+        }
+        if (std::all_of(weights.begin(), weights.end(), [](uint32_t weight) { return weight == 0; }))
+        {
+            throw std::invalid_argument("no quote kind selected");
+        }
+        return weights;
+    }
+
+    std::vector<std::string> parseTcbStatuses(const std::string& list)
+    {
+        auto statuses = split(list);
+        for (const auto& status : statuses)
+        {
+            if (std::find(knownTcbStatuses.begin(), knownTcbStatuses.end(), status) == knownTcbStatuses.end())
+            {
+                throw std::invalid_argument("unknown TCB status \"" + status + "\"");
+            }
+        }
+        if (statuses.empty())
+        {
+            throw std::invalid_argument("no TCB status selected");
+        }
+        return statuses;
+    }
+}
+
+const char* quoteKindName(QuoteKind kind)
+{
+    return quoteKindNames.at(kind);
+}
+
+bool isTdx(QuoteKind kind)
+{
+    return kind == TDX_QUOTE_V4 || kind == TDX_QUOTE_V5;
+}
+
+std::unique_ptr<LoadGenOptions> LoadGenOptionsParser::parse(int argc, char **argv, std::ostream& logger)
+{
+    auto outputDir = arg_str0(NULL, "output", NULL, "Directory the corpus is written to: collateral and quotes per platform plus manifest.csv [=]");
+    auto count = arg_str0(NULL, "count", NULL, "Number of quotes to generate [=1000]");
+    auto seed = arg_str0(NULL, "seed", NULL, "Seed of the corpus layout: quote kinds, platforms and defects. Keys are always fresh [=1]");
+    auto mix = arg_str0(NULL, "mix", NULL, "Relative shares of quote kinds sgx3, sgx4, tdx4 and tdx5 [=sgx3=1,sgx4=1,tdx4=1,tdx5=1]");
+    auto platforms = arg_str0(NULL, "platforms", NULL, "Number of platforms (FMSPCs) per TEE type, each with own PCK certificate and TCB info [=2]");
+    auto tcbStatus = arg_str0(NULL, "tcbStatus", NULL, "TCB statuses assigned to platforms round robin [=UpToDate,OutOfDate]");
+    auto invalidPercent = arg_str0(NULL, "invalidPercent", NULL, "Percentage of deliberately invalid quotes [=10]");
+    struct arg_lit* drive = arg_lit0(NULL, "drive", "Verify generated quotes in process and report throughput, latency and unexpected results");
+    auto rate = arg_str0(NULL, "rate", NULL, "Target rate of drive in quotes per second, 0 runs unthrottled [=0]");
+    auto duration = arg_str0(NULL, "duration", NULL, "Duration of drive in seconds [=10]");
+    auto threads = arg_str0(NULL, "threads", NULL, "Number of threads of drive, 0 uses all CPUs [=0]");
+    struct arg_lit* help = arg_lit0("h", "help", "Print this message");
+    auto end = arg_end(20);
+
+    void *argtable[] = {outputDir, count, seed, mix, platforms, tcbStatus, invalidPercent, drive, rate, duration, threads,
+                        help, end};
+
+    if (arg_nullcheck(argtable) != 0)
+    {
+        logger << "Can't create argtable" << std::endl;
+        return nullptr;
+    }
+
+    outputDir->sval[0] = outputDirDefault.c_str();
+    count->sval[0] = countDefault.c_str();
+    seed->sval[0] = seedDefault.c_str();
+    mix->sval[0] = mixDefault.c_str();
+    platforms->sval[0] = platformsDefault.c_str();
+    tcbStatus->sval[0] = tcbStatusDefault.c_str();
+    invalidPercent->sval[0] = invalidPercentDefault.c_str();
+    rate->sval[0] = rateDefault.c_str();
+    duration->sval[0] = durationDefault.c_str();
+    threads->sval[0] = threadsDefault.c_str();
+
+    auto nerrors = arg_parse(argc, argv, argtable);
+    if (end && nerrors > 0)
+    {
+        arg_print_errors(stdout, end, "qvl-loadgen");
+        printHelp(argtable);
+        arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
+        return nullptr;
+    }
+    if (help && help->count > 0)
+    {
+        printHelp(argtable);
+        arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
+        return nullptr;
+    }
+
+    auto options = std::make_unique<LoadGenOptions>();
+    options->outputDir = std::string(outputDir->sval[0]);
+    options->drive = drive->count > 0;
+    try
+    {
+        options->count = toUint32(count->sval[0], "count");
+        options->seed = toUint32(seed->sval[0], "seed");
+        options->mix = parseMix(mix->sval[0]);
+        options->platforms = toUint32(platforms->sval[0], "platforms");
+        options->tcbStatuses = parseTcbStatuses(tcbStatus->sval[0]);
+        options->invalidPercent = toUint32(invalidPercent->sval[0], "invalidPercent");
+        options->rate = toUint32(rate->sval[0], "rate");
+        options->duration = toUint32(duration->sval[0], "duration");
+        options->threads = toUint32(threads->sval[0], "threads");
+        if (options->count == 0 || options->platforms == 0)
+        {
+            throw std::invalid_argument("count and platforms have to be positive");
+        }
+        if (options->invalidPercent > 100)
+        {
+            throw std::out_of_range("invalidPercent out of range");
+        }
+        if (options->outputDir.empty() && !options->drive)
+        {
+            throw std::invalid_argument("nothing to do, give output or drive");
+        }
+    }
+    catch(std::exception& ex)
+    {
+        printf("Can't parse options: %s\n\n", ex.what());
+        printHelp(argtable);
+        arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
+        return nullptr;
+    }
+    arg_freetable(argtable, sizeof(argtable)/sizeof(argtable[0]));
+
+    return options;
+}
+
+void LoadGenOptionsParser::printHelp(void** argtable)
+{
+    printf("Usage: qvl-loadgen");
+    arg_print_syntax(stdout, argtable, "\n\n");
+    arg_print_glossary(stdout, argtable, "%-40s %s\n");
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace loadgen {
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_LOADGEN_LOADGEN_OPTIONS_H
+#define SGX_DCAP_LOADGEN_LOADGEN_OPTIONS_H
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+enum QuoteKind
+{
+    SGX_QUOTE_V3,
+    SGX_QUOTE_V4,
+    TDX_QUOTE_V4,
+    TDX_QUOTE_V5,
+    QUOTE_KIND_COUNT
+};
+
+struct LoadGenOptions
+{
+    std::string outputDir;
+    uint32_t count;
+    uint32_t seed;
+    // relative share of each quote kind, indexed by QuoteKind
+    std::vector<uint32_t> mix;
+    // platforms (FMSPCs) per TEE type, each with its own PCK certificate and TCB info
+    uint32_t platforms;
+    // TCB status of platforms, assigned round robin
+    std::vector<std::string> tcbStatuses;
+    uint32_t invalidPercent;
+
+    bool drive;
+    uint32_t rate;
+    uint32_t duration;
+    uint32_t threads;
+};
+
+const char* quoteKindName(QuoteKind kind);
+bool isTdx(QuoteKind kind);
+
+class LoadGenOptionsParser
+{
+public:
+    std::unique_ptr<LoadGenOptions> parse(int argc, char **argv, std::ostream& logger);
+
+private:
+    void printHelp(void** argtable);
+};
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace loadgen {
+
+#endif // SGX_DCAP_LOADGEN_LOADGEN_OPTIONS_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CorpusGenerator.h"
+#include "LoadDriver.h"
+#include "LoadGenOptions.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+using namespace intel::sgx::dcap::loadgen;
+
+int main(int argc, char* argv[])
+{
+    std::stringstream logger;
+    LoadGenOptionsParser optionsParser;
+    const auto options = optionsParser.parse(argc, argv, logger);
+    if (nullptr == options)
+    {
+        std::cout << logger.str();
+        return 0;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto corpus = CorpusGenerator(*options).generate();
+    std::cout << "Generated " << corpus.quotes.size() << " quotes for " << corpus.platforms.size() << " platforms in "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s" << std::endl;
+
+    if (!options->outputDir.empty())
+    {
+        try
+        {
+            writeCorpus(corpus, options->outputDir);
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "ERROR while writing corpus: " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "Corpus written to " << options->outputDir << std::endl;
+    }
+
+    if (options->drive)
+    {
+        return drive(corpus, DriveOptions{options->rate, options->duration, options->threads}, std::cout) ? 0 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/Algorithms.h>
+#include <OpensslHelpers/DigestUtils.h>
+#include <OpensslHelpers/KeyUtils.h>
+#include <OpensslHelpers/SignatureVerification.h>
+#include <gtest/gtest.h>
+
+#include "KeyHelpers.h"
+#include "DigestUtils.h"
+
+using namespace intel::sgx;
+using namespace ::testing;
+
+namespace {
+
+// SHA-256("abc") from FIPS 180-2
+const Bytes ABC_SHA256 = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+                          0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+
+} // anonymous namespace
+
+struct AlgorithmsUT : public Test
+{
+    void TearDown() override
+    {
+        ASSERT_TRUE(dcap::crypto::setAlgorithmsContext(nullptr, nullptr));
+    }
+
+    // keys created by tests from this context outlive them, it is left to the process exit
+    static OSSL_LIB_CTX* otherLibraryContext()
+    {
+        static OSSL_LIB_CTX* libCtx = OSSL_LIB_CTX_new();
+        return libCtx;
+    }
+};
+
+TEST_F(AlgorithmsUT, algorithmsShouldBeFetchedFromDefaultLibraryContext)
+{
+    const auto algorithms = dcap::crypto::getAlgorithms();
+
+    ASSERT_TRUE(algorithms->isValid());
+    EXPECT_EQ(nullptr, algorithms->getLibraryContext());
+    EXPECT_EQ(algorithms, dcap::crypto::getAlgorithms());
+    EXPECT_EQ(ABC_SHA256, dcap::crypto::sha256Digest(Bytes{'a', 'b', 'c'}));
+}
+
+TEST_F(AlgorithmsUT, verificationShouldUseAlgorithmsOfSetLibraryContext)
+{
+    // GIVEN
+    auto prv = dcap::test::priv(dcap::test::PEM_PRV);
+    auto pub = dcap::test::pub(dcap::test::PEM_PUB);
+    const Bytes data(150, 0xff);
+    const auto signature = dcap::DigestUtils::signMessageSha256(data, *prv);
+    const auto rawPub = dcap::test::getRawPub(*pub);
+    std::array<uint8_t, 64> raw{};
+    std::copy_n(rawPub.begin(), raw.size(), raw.begin());
+
+    // WHEN
+    ASSERT_TRUE(dcap::crypto::setAlgorithmsContext(otherLibraryContext(), nullptr));
+    const auto key = dcap::crypto::rawToP256PubKey(raw);
+
+    // THEN
+    const auto algorithms = dcap::crypto::getAlgorithms();
+    const auto defaultSha256 = dcap::crypto::make_unique(EVP_MD_fetch(nullptr, "SHA256", nullptr));
+    EXPECT_EQ(otherLibraryContext(), algorithms->getLibraryContext());
+    EXPECT_NE(EVP_MD_get0_provider(defaultSha256.get()), EVP_MD_get0_provider(algorithms->getSha256()));
+    ASSERT_NE(nullptr, key);
+    EXPECT_EQ(EVP_MD_get0_provider(algorithms->getSha256()), EVP_PKEY_get0_provider(key.get()));
+    EXPECT_TRUE(dcap::crypto::verifySha256Signature(signature, data, *key));
+    EXPECT_EQ(ABC_SHA256, dcap::crypto::sha256Digest(Bytes{'a', 'b', 'c'}));
+}
+
+TEST_F(AlgorithmsUT, shouldKeepAlgorithmsInUseWhenFetchFails)
+{
+    const auto algorithmsInUse = dcap::crypto::getAlgorithms();
+
+    EXPECT_FALSE(dcap::crypto::setAlgorithmsContext(otherLibraryContext(), "provider=nonexistent"));
+
+    EXPECT_EQ(algorithmsInUse, dcap::crypto::getAlgorithms());
+    EXPECT_EQ(ABC_SHA256, dcap::crypto::sha256Digest(Bytes{'a', 'b', 'c'}));
+}
+
+TEST_F(AlgorithmsUT, replacedAlgorithmsShouldBeFreedWhenLastUserReleasesThem)
+{
+    // GIVEN
+    auto* libCtx = OSSL_LIB_CTX_new();
+    ASSERT_NE(nullptr, libCtx);
+    ASSERT_TRUE(dcap::crypto::setAlgorithmsContext(libCtx, nullptr));
+    auto algorithmsInUse = dcap::crypto::getAlgorithms();
+    const std::weak_ptr<const dcap::crypto::Algorithms> replaced = algorithmsInUse;
+
+    // WHEN
+    ASSERT_TRUE(dcap::crypto::setAlgorithmsContext(nullptr, nullptr));
+
+    // THEN
+    ASSERT_FALSE(replaced.expired());
+    EXPECT_EQ(libCtx, algorithmsInUse->getLibraryContext());
+    EXPECT_NE(algorithmsInUse, dcap::crypto::getAlgorithms());
+    algorithmsInUse.reset();
+    EXPECT_TRUE(replaced.expired());
+
+    // nothing fetched from the context is left, it can be freed before the process exits
+    OSSL_LIB_CTX_free(libCtx);
+    EXPECT_EQ(ABC_SHA256, dcap::crypto::sha256Digest(Bytes{'a', 'b', 'c'}));
+}
+
+TEST_F(AlgorithmsUT, replacingAlgorithmsShouldNotKeepPreviousSetsAlive)
+{
+    std::weak_ptr<const dcap::crypto::Algorithms> first = dcap::crypto::getAlgorithms();
+
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(dcap::crypto::setAlgorithmsContext(i % 2 == 0 ? otherLibraryContext() : nullptr, nullptr));
+    }
+
+    EXPECT_TRUE(first.expired());
+}
@@ -55,8 +55,7 @@ TEST_P(BaseVerifierCommonNameParametrized, testAllMatches)
 {
 auto params = GetParam();
 
-pckparser::Subject subject;
-subject.commonName = params.commonName;
+const pckparser::Subject subject{"", params.commonName, "", "", "", ""};
 
 EXPECT_EQ(BaseVerifier{}.commonNameContains(subject, params.match), params.expected);
 }
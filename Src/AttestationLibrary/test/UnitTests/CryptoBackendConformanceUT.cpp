@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/CryptoBackend.h>
+#include <gtest/gtest.h>
+
+#include "EcdsaSignatureGenerator.h"
+#include "KeyHelpers.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace intel::sgx;
+using namespace ::testing;
+using dcap::Bytes;
+using dcap::crypto::CryptoBackend;
+using dcap::crypto::RawP256PublicKey;
+using dcap::crypto::RawP256Signature;
+
+namespace {
+
+template<size_t N>
+std::array<uint8_t, N> hexToArray(const std::string& hex)
+{
+    const auto bytes = dcap::hexStringToBytes(hex);
+    std::array<uint8_t, N> array{};
+    std::copy_n(bytes.begin(), std::min(N, bytes.size()), array.begin());
+    return array;
+}
+
+Bytes toBytes(const std::string& text)
+{
+    return Bytes(text.begin(), text.end());
+}
+
+// RFC 6979 A.2.5, ECDSA P-256 with SHA-256
+const auto RFC6979_KEY = hexToArray<64>("60FED4BA255A9D31C961EB74C6356D68C049B8923B61FA6CE669622E60F29FB6"
+                                        "7903FE1008B8BC99A41AE9E95628BC64F2F1B20C2D7E9F5177A3C294D4462299");
+const auto RFC6979_SAMPLE_SIGNATURE = hexToArray<64>("EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716"
+                                                     "F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8");
+const auto RFC6979_TEST_SIGNATURE = hexToArray<64>("F1ABB023518351CD71D881567B1EA663ED3EFCF6C5132B354F28D3B0B7D38367"
+                                                   "019F4113742A2B14BD25926B49C649155F267E60D3814B4C0CC84250E46F0083");
+const auto P256_ORDER = hexToArray<32>("FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551");
+
+// s replaced with n - s, the other valid signature of the same message
+RawP256Signature negateS(const RawP256Signature& signature)
+{
+    auto negated = signature;
+    int borrow = 0;
+    for (size_t i = P256_ORDER.size(); i-- > 0;)
+    {
+        const int difference = P256_ORDER[i] - signature[32 + i] - borrow;
+        borrow = difference < 0 ? 1 : 0;
+        negated[32 + i] = static_cast<uint8_t>(difference + 256 * borrow);
+    }
+    return negated;
+}
+
+} // anonymous namespace
+
+struct CryptoBackendConformanceUT : public TestWithParam<const CryptoBackend*>
+{
+    const CryptoBackend& backend = *GetParam();
+
+    bool verify(const RawP256PublicKey& rawKey, const RawP256Signature& signature, const Bytes& message) const
+    {
+        const auto key = backend.importP256PublicKey(rawKey);
+        return key != nullptr && backend.verifyP256Signature(*key, signature, backend.sha256(message.data(), message.size()));
+    }
+};
+
+TEST_P(CryptoBackendConformanceUT, sha256ShouldMatchFipsVectors)
+{
+    const auto digest = [this](const std::string& text) {
+        return backend.sha256(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    };
+
+    EXPECT_EQ(dcap::hexStringToBytes("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), digest(""));
+    EXPECT_EQ(dcap::hexStringToBytes("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), digest("abc"));
+    EXPECT_EQ(dcap::hexStringToBytes("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"),
+              digest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldAcceptRfc6979Signatures)
+{
+    EXPECT_TRUE(verify(RFC6979_KEY, RFC6979_SAMPLE_SIGNATURE, toBytes("sample")));
+    EXPECT_TRUE(verify(RFC6979_KEY, RFC6979_TEST_SIGNATURE, toBytes("test")));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldAcceptSignatureWithHighS)
+{
+    EXPECT_TRUE(verify(RFC6979_KEY, negateS(RFC6979_SAMPLE_SIGNATURE), toBytes("sample")));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldRejectSignatureOfOtherMessageOrModifiedSignature)
+{
+    auto modifiedR = RFC6979_SAMPLE_SIGNATURE;
+    modifiedR[31] ^= 0x01;
+    auto modifiedS = RFC6979_SAMPLE_SIGNATURE;
+    modifiedS[63] ^= 0x01;
+
+    EXPECT_FALSE(verify(RFC6979_KEY, RFC6979_SAMPLE_SIGNATURE, toBytes("test")));
+    EXPECT_FALSE(verify(RFC6979_KEY, RFC6979_TEST_SIGNATURE, toBytes("sample")));
+    EXPECT_FALSE(verify(RFC6979_KEY, modifiedR, toBytes("sample")));
+    EXPECT_FALSE(verify(RFC6979_KEY, modifiedS, toBytes("sample")));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldRejectSignatureWithZeroOrOutOfRangeScalars)
+{
+    auto zeroR = RFC6979_SAMPLE_SIGNATURE;
+    std::fill_n(zeroR.begin(), 32, 0x00);
+    auto zeroS = RFC6979_SAMPLE_SIGNATURE;
+    std::fill_n(zeroS.begin() + 32, 32, 0x00);
+    auto orderR = RFC6979_SAMPLE_SIGNATURE;
+    std::copy(P256_ORDER.begin(), P256_ORDER.end(), orderR.begin());
+    auto orderS = RFC6979_SAMPLE_SIGNATURE;
+    std::copy(P256_ORDER.begin(), P256_ORDER.end(), orderS.begin() + 32);
+
+    EXPECT_FALSE(verify(RFC6979_KEY, zeroR, toBytes("sample")));
+    EXPECT_FALSE(verify(RFC6979_KEY, zeroS, toBytes("sample")));
+    EXPECT_FALSE(verify(RFC6979_KEY, orderR, toBytes("sample")));
+    EXPECT_FALSE(verify(RFC6979_KEY, orderS, toBytes("sample")));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldRejectDigestOfWrongSize)
+{
+    const auto key = backend.importP256PublicKey(RFC6979_KEY);
+    const auto message = toBytes("sample");
+    auto digest = backend.sha256(message.data(), message.size());
+    digest.pop_back();
+
+    ASSERT_NE(nullptr, key);
+    EXPECT_FALSE(backend.verifyP256Signature(*key, RFC6979_SAMPLE_SIGNATURE, digest));
+    EXPECT_FALSE(backend.verifyP256Signature(*key, RFC6979_SAMPLE_SIGNATURE, Bytes{}));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldNotImportPointOutsideOfCurve)
+{
+    auto offCurve = RFC6979_KEY;
+    offCurve[63] ^= 0x01;
+
+    EXPECT_EQ(nullptr, backend.importP256PublicKey(offCurve));
+    EXPECT_EQ(nullptr, backend.importP256PublicKey(RawP256PublicKey{}));
+}
+
+TEST_P(CryptoBackendConformanceUT, shouldAcceptSignaturesMadeWithOpenssl)
+{
+    auto prv = dcap::test::priv(dcap::test::PEM_PRV);
+    auto pub = dcap::test::pub(dcap::test::PEM_PUB);
+    const auto rawKey = dcap::test::getRawPub(*pub);
+
+    for (size_t size : {0, 1, 64, 384, 1000})
+    {
+        const Bytes message(size, static_cast<uint8_t>(size));
+        const auto rawSignature = EcdsaSignatureGenerator::signECDSA_SHA256(message, prv.get());
+        RawP256Signature signature{};
+        ASSERT_EQ(signature.size(), rawSignature.size());
+        std::copy(rawSignature.begin(), rawSignature.end(), signature.begin());
+
+        EXPECT_TRUE(verify(rawKey, signature, message)) << "message size " << size;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, CryptoBackendConformanceUT, ValuesIn(dcap::crypto::getCryptoBackends()),
+                         [](const TestParamInfo<const CryptoBackend*>& backendInfo) {
+                             return std::string(backendInfo.param->getName());
+                         });
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "EnclaveIdentityGenerator.h"
+
+#include <Verifiers/EnclaveIdentityParser.h>
+#include <Verifiers/EnclaveIdentityV2.h>
+#include <Utils/StatusNotSupportedException.h>
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace ::intel::sgx::dcap;
+using namespace ::intel::sgx::dcap::test;
+
+struct EnclaveIdentityMatcherUT : public Test
+{
+    EnclaveIdentityParser parser;
+    EnclaveIdentityVectorModel model;
+
+    std::unique_ptr<EnclaveIdentityV2> parseModel()
+    {
+        return parser.parse(enclaveIdentityJsonWithSignature(model.toV2JSON()));
+    }
+};
+
+TEST_F(EnclaveIdentityMatcherUT, shouldResolveTcbStatusSameAsEnclaveIdentityForEveryIsvSvn)
+{
+    // levels deliberately not sorted, first level covering ISVSVN wins
+    model.tcbLevels = {{3, model.issueDate, "OutOfDate"},
+                       {9, model.issueDate, "UpToDate"},
+                       {5, model.issueDate, "Revoked"},
+                       {7, model.issueDate, "ConfigurationNeeded"}};
+    const auto enclaveIdentity = parseModel();
+    const auto& matcher = enclaveIdentity->getMatcher();
+
+    for (uint32_t isvSvn : {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 100u, 0xFFFFu})
+    {
+        TcbStatus tcbStatus;
+        if (isvSvn < 3)
+        {
+            EXPECT_FALSE(matcher.getTcbStatus(static_cast<uint16_t>(isvSvn), tcbStatus)) << isvSvn;
+            EXPECT_THROW(enclaveIdentity->getTcbStatus(isvSvn), StatusNotSupportedException);
+            continue;
+        }
+        ASSERT_TRUE(matcher.getTcbStatus(static_cast<uint16_t>(isvSvn), tcbStatus)) << isvSvn;
+        EXPECT_EQ(enclaveIdentity->getTcbStatus(isvSvn), tcbStatus) << isvSvn;
+    }
+}
+
+TEST_F(EnclaveIdentityMatcherUT, shouldResolveTcbStatusSameAsEnclaveIdentityForManyInterleavedLevels)
+{
+    // descending and ascending runs with repeated ISVSVN, so later levels are shadowed by earlier ones
+    const std::vector<std::string> statuses = {"UpToDate", "OutOfDate", "Revoked", "ConfigurationNeeded"};
+    model.tcbLevels.clear();
+    for (uint16_t i = 0; i < 200; ++i)
+    {
+        const auto isvSvn = static_cast<uint16_t>(i % 2 ? 1000 - i * 3 : 10 + i * 2);
+        model.tcbLevels.push_back({isvSvn, model.issueDate, statuses[i % statuses.size()]});
+    }
+    model.tcbLevels.push_back({0xFFFF, model.issueDate, "UpToDate"});
+    const auto enclaveIdentity = parseModel();
+    const auto& matcher = enclaveIdentity->getMatcher();
+
+    for (uint32_t isvSvn = 0; isvSvn <= 0xFFFF; isvSvn += isvSvn < 1100 ? 1 : 997)
+    {
+        TcbStatus tcbStatus;
+        if (isvSvn < 10)
+        {
+            EXPECT_FALSE(matcher.getTcbStatus(static_cast<uint16_t>(isvSvn), tcbStatus)) << isvSvn;
+            continue;
+        }
+        ASSERT_TRUE(matcher.getTcbStatus(static_cast<uint16_t>(isvSvn), tcbStatus)) << isvSvn;
+        EXPECT_EQ(enclaveIdentity->getTcbStatus(isvSvn), tcbStatus) << isvSvn;
+    }
+    TcbStatus tcbStatus;
+    ASSERT_TRUE(matcher.getTcbStatus(0xFFFF, tcbStatus));
+    EXPECT_EQ(enclaveIdentity->getTcbStatus(0xFFFF), tcbStatus);
+}
+
+TEST_F(EnclaveIdentityMatcherUT, shouldNotSupportIsvSvnBelowLowestTcbLevel)
+{
+    model.tcbLevels = {{2, model.issueDate, "UpToDate"}};
+    const auto enclaveIdentity = parseModel();
+
+    TcbStatus tcbStatus;
+    EXPECT_FALSE(enclaveIdentity->getMatcher().getTcbStatus(1, tcbStatus));
+    EXPECT_TRUE(enclaveIdentity->getMatcher().getTcbStatus(2, tcbStatus));
+    EXPECT_EQ(TcbStatus::UpToDate, tcbStatus);
+}
+
+TEST_F(EnclaveIdentityMatcherUT, shouldMatchReportOnlyOnMaskedBits)
+{
+    model.attributes = std::vector<uint8_t>(16, 0x00);
+    model.attributes[15] = 0x01;
+    model.attributesMask = std::vector<uint8_t>(16, 0x00);
+    model.attributesMask[15] = 0x0F;
+    model.miscselect = {0x01, 0x00, 0x00, 0x00};
+    model.miscselectMask = {0x0F, 0x00, 0x00, 0x00};
+    const auto enclaveIdentity = parseModel();
+
+    quote::EnclaveReport enclaveReport{};
+    enclaveReport.miscSelect = 0xFFFFFFF1;
+    enclaveReport.attributes.fill(0xFF);
+    enclaveReport.attributes[15] = 0xF1;
+    std::copy(model.mrsigner.begin(), model.mrsigner.end(), enclaveReport.mrSigner.begin());
+    enclaveReport.isvProdID = model.isvprodid;
+    enclaveReport.isvSvn = 6;
+
+    EXPECT_EQ(STATUS_OK, enclaveIdentity->getMatcher().match(enclaveReport));
+
+    enclaveReport.attributes[15] = 0xF2;
+    EXPECT_EQ(STATUS_SGX_ENCLAVE_REPORT_ATTRIBUTES_MISMATCH, enclaveIdentity->getMatcher().match(enclaveReport));
+
+    enclaveReport.attributes[15] = 0xF1;
+    enclaveReport.miscSelect = 0xFFFFFFF2;
+    EXPECT_EQ(STATUS_SGX_ENCLAVE_REPORT_MISCSELECT_MISMATCH, enclaveIdentity->getMatcher().match(enclaveReport));
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <CertVerification/InternedName.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <vector>
+
+using namespace intel::sgx::dcap;
+using namespace ::testing;
+using ::intel::sgx::dcap::parser::x509::DistinguishedName;
+
+struct InternedNameUT : public Test
+{
+    const DistinguishedName name{"CN=Intel SGX PCK Platform CA,O=Intel Corporation,L=Santa Clara,ST=CA,C=US",
+                                 "Intel SGX PCK Platform CA", "US", "Intel Corporation", "Santa Clara", "CA"};
+    const DistinguishedName reordered{"C=US,ST=CA,L=Santa Clara,O=Intel Corporation,CN=Intel SGX PCK Platform CA",
+                                      "Intel SGX PCK Platform CA", "US", "Intel Corporation", "Santa Clara", "CA"};
+};
+
+TEST_F(InternedNameUT, equalNamesShareInternedEntries)
+{
+    const InternedName first(name);
+    const InternedName second(DistinguishedName{name});
+    const InternedName other(reordered);
+
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(first.hasSameRaw(second));
+    EXPECT_EQ(&first.getRaw(), &second.getRaw());
+
+    EXPECT_EQ(first, other);
+    EXPECT_FALSE(first.hasSameRaw(other));
+    EXPECT_EQ(first.getHash(), other.getHash());
+}
+
+TEST_F(InternedNameUT, componentBoundariesAreKeptApart)
+{
+    const InternedName first(DistinguishedName{"", "ab", "c", "", "", ""});
+    const InternedName second(DistinguishedName{"", "a", "bc", "", "", ""});
+
+    EXPECT_NE(first, second);
+    EXPECT_TRUE(first.hasSameRaw(second));
+}
+
+TEST_F(InternedNameUT, defaultHandleEqualsEmptyName)
+{
+    const InternedName empty;
+
+    EXPECT_EQ(empty, InternedName(DistinguishedName{}));
+    EXPECT_TRUE(empty.getRaw().empty());
+    EXPECT_NE(empty, InternedName(name));
+}
+
+TEST_F(InternedNameUT, movedFromHandleStaysUsable)
+{
+    InternedName first(name);
+    const auto moved = std::move(first);
+
+    EXPECT_EQ(first, moved);
+    EXPECT_EQ(first.getRaw(), name.getRaw());
+}
+
+TEST_F(InternedNameUT, concurrentInterningOfSameNameShouldShareEntry)
+{
+    std::vector<std::future<InternedName>> results;
+    for (int i = 0; i < 8; ++i)
+    {
+        results.push_back(std::async(std::launch::async, [this] {
+            InternedName last;
+            for (int j = 0; j < 1000; ++j)
+            {
+                last = InternedName(DistinguishedName{name});
+            }
+            return last;
+        }));
+    }
+
+    const InternedName expected(name);
+    for (auto& result : results)
+    {
+        const auto interned = result.get();
+        EXPECT_EQ(expected, interned);
+        EXPECT_TRUE(expected.hasSameRaw(interned));
+    }
+}
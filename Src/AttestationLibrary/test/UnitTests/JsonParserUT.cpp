@@ -118,27 +118,16 @@ TEST_F(JsonParserTests, shouldCheckObjectWithDates)
 
 TEST_F(JsonParserTests, shouldParseObjectWithDate)
 {
-    struct tm expectedValue;
-    expectedValue.tm_sec = 22;
-    expectedValue.tm_min = 17;
-    expectedValue.tm_hour = 15;
-    expectedValue.tm_mday = 29;
-    expectedValue.tm_mon = 8;
-    expectedValue.tm_year = 118;
+    const time_t expectedValue = 1538234242; // 2018-09-29T15:17:22Z
 
     ASSERT_TRUE(jsonParser.parse(R"json({"data": {"date": "2018-09-29T15:17:22Z"}})json"));
     const auto& data = *jsonParser.getField("data");
     auto status = dcap::JsonParser::ParseStatus::Missing;
-    struct tm value{};
+    time_t value{};
     std::tie(value, status) = jsonParser.getDateFieldOf(data, "date");
 
     EXPECT_EQ(dcap::JsonParser::ParseStatus::OK, status);
-    EXPECT_EQ(expectedValue.tm_hour, value.tm_hour);
-    EXPECT_EQ(expectedValue.tm_min, value.tm_min);
-    EXPECT_EQ(expectedValue.tm_sec, value.tm_sec);
-    EXPECT_EQ(expectedValue.tm_year, value.tm_year);
-    EXPECT_EQ(expectedValue.tm_mon, value.tm_mon);
-    EXPECT_EQ(expectedValue.tm_mday, value.tm_mday);
+    EXPECT_EQ(expectedValue, value);
 }
 
 TEST_F(JsonParserTests, shouldFailWhenParsingInvalidHexstringField)
@@ -67,3 +67,19 @@ TEST(keyUtilsTest, rawTo256EcdsaKeyShouldReturnCorrectKey)
     // THEN
     EXPECT_TRUE(dcap::DigestUtils::verifySig(sig, data, *newPbKey));
 } 
+
+TEST(keyUtilsTest, rawTo256EcdsaKeyShouldReturnNullWhenPointIsNotOnCurve)
+{
+    // GIVEN
+    auto pb = dcap::test::pub(dcap::test::PEM_PUB);
+    const auto rawPub = dcap::test::getRawPub(*pb);
+    std::array<uint8_t, 64> arr{};
+    std::copy_n(rawPub.begin(), 64, arr.begin());
+    arr[63] ^= 0x01; // y coordinate no longer matches x
+
+    // WHEN
+    const auto newPbKey = dcap::crypto::rawToP256PubKey(arr);
+
+    // THEN
+    EXPECT_EQ(nullptr, newPbKey);
+}
@@ -84,7 +84,7 @@ public:
 class CertificateChainMock: public dcap::CertificateChain
 {
 public:
-    MOCK_METHOD1(parse, Status(const std::string&));
+    MOCK_METHOD1(parse, Status(std::string_view));
 
     MOCK_CONST_METHOD0(length, size_t());
     MOCK_CONST_METHOD1(get, std::shared_ptr<const dcap::parser::x509::Certificate>(const dcap::parser::x509::DistinguishedName &));
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/PrecomputedP256Backend.h>
+#include <gtest/gtest.h>
+
+#include "EcdsaSignatureGenerator.h"
+#include "KeyHelpers.h"
+#include "X509CertGenerator.h"
+
+#include <random>
+#include <vector>
+
+using namespace intel::sgx;
+using namespace ::testing;
+using dcap::Bytes;
+using dcap::crypto::PrecomputedP256Backend;
+using dcap::crypto::RawP256PublicKey;
+using dcap::crypto::RawP256Signature;
+
+namespace {
+
+struct SigningKey
+{
+    dcap::crypto::EVP_PKEY_uptr key;
+    RawP256PublicKey rawPublicKey;
+};
+
+// signs digest as is, so digests not coming from SHA-256 can be tested as well
+RawP256Signature signDigest(const Bytes& digest, EVP_PKEY& key)
+{
+    auto ctx = dcap::crypto::make_unique(EVP_PKEY_CTX_new(&key, nullptr));
+    size_t signatureSize = 0;
+    if (!ctx || EVP_PKEY_sign_init(ctx.get()) != 1 ||
+        EVP_PKEY_sign(ctx.get(), nullptr, &signatureSize, digest.data(), digest.size()) != 1)
+    {
+        return {};
+    }
+    Bytes signature(signatureSize);
+    if (EVP_PKEY_sign(ctx.get(), signature.data(), &signatureSize, digest.data(), digest.size()) != 1)
+    {
+        return {};
+    }
+    signature.resize(signatureSize);
+    return EcdsaSignatureGenerator::convertECDSASignatureToRawArray(signature);
+}
+
+} // namespace
+
+struct PrecomputedP256BackendUT : public Test
+{
+    const dcap::crypto::CryptoBackend& openssl = dcap::crypto::getOpensslCryptoBackend();
+    std::mt19937 random{12345};
+
+    std::vector<SigningKey> generateKeys(size_t count) const
+    {
+        const dcap::parser::test::X509CertGenerator certGenerator;
+        std::vector<SigningKey> keys;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto key = certGenerator.generateEcKeypair();
+            const auto rawPublicKey = dcap::test::getRawPub(*key);
+            keys.push_back(SigningKey{std::move(key), rawPublicKey});
+        }
+        return keys;
+    }
+
+    Bytes randomBytes(size_t size)
+    {
+        Bytes bytes(size);
+        for (auto& byte : bytes)
+        {
+            byte = static_cast<uint8_t>(random());
+        }
+        return bytes;
+    }
+
+    bool verify(const dcap::crypto::CryptoBackend& backend, const RawP256PublicKey& rawKey,
+                const RawP256Signature& signature, const Bytes& digest) const
+    {
+        const auto key = backend.importP256PublicKey(rawKey);
+        return key != nullptr && backend.verifyP256Signature(*key, signature, digest);
+    }
+};
+
+TEST_F(PrecomputedP256BackendUT, shouldBuildTableOnceKeyVerifiedThresholdTimes)
+{
+    PrecomputedP256Backend backend(3, 2);
+    const auto keys = generateKeys(1);
+    const auto digest = randomBytes(32);
+    const auto signature = signDigest(digest, *keys[0].key);
+
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+    EXPECT_EQ(0u, backend.getMetrics().tablesBuilt);
+
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+    EXPECT_EQ(1u, backend.getMetrics().tablesBuilt);
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+
+    const auto metrics = backend.getMetrics();
+    EXPECT_EQ(1u, metrics.tablesBuilt);
+    EXPECT_EQ(1u, metrics.tableHits);
+    EXPECT_EQ(1u, metrics.tables);
+}
+
+TEST_F(PrecomputedP256BackendUT, shouldNotBuildTablesForKeysWhichFailVerification)
+{
+    PrecomputedP256Backend backend(1, 1);
+    const auto keys = generateKeys(3);
+    const auto digest = randomBytes(32);
+    const auto signature = signDigest(digest, *keys[0].key);
+
+    // imports alone never count
+    for (int i = 0; i < 32; ++i)
+    {
+        EXPECT_NE(nullptr, backend.importP256PublicKey(keys[1].rawPublicKey));
+    }
+    EXPECT_EQ(0u, backend.getMetrics().tablesBuilt);
+
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+    EXPECT_EQ(1u, backend.getMetrics().tablesBuilt);
+
+    // signatures not made by the imported key neither build tables nor evict the existing one
+    for (int i = 0; i < 32; ++i)
+    {
+        EXPECT_FALSE(verify(backend, keys[1 + i % 2].rawPublicKey, signature, digest));
+        EXPECT_FALSE(verify(backend, keys[1 + i % 2].rawPublicKey, signDigest(randomBytes(32), *keys[1].key), digest));
+    }
+    const auto metrics = backend.getMetrics();
+    EXPECT_EQ(1u, metrics.tablesBuilt);
+    EXPECT_EQ(0u, metrics.evictions);
+    EXPECT_EQ(1u, metrics.tables);
+}
+
+TEST_F(PrecomputedP256BackendUT, shouldEvictLeastRecentlyImportedTableWhenFull)
+{
+    PrecomputedP256Backend backend(1, 2);
+    const auto keys = generateKeys(3);
+    const auto digest = randomBytes(32);
+    std::vector<RawP256Signature> signatures;
+    for (const auto& key : keys)
+    {
+        signatures.push_back(signDigest(digest, *key.key));
+    }
+
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signatures[0], digest));
+    EXPECT_TRUE(verify(backend, keys[1].rawPublicKey, signatures[1], digest));
+    const auto evictedKey = backend.importP256PublicKey(keys[1].rawPublicKey);
+    backend.importP256PublicKey(keys[0].rawPublicKey);
+    EXPECT_TRUE(verify(backend, keys[2].rawPublicKey, signatures[2], digest));
+    backend.importP256PublicKey(keys[0].rawPublicKey);
+
+    auto metrics = backend.getMetrics();
+    EXPECT_EQ(3u, metrics.tablesBuilt);
+    EXPECT_EQ(3u, metrics.tableHits);
+    EXPECT_EQ(1u, metrics.evictions);
+    EXPECT_EQ(2u, metrics.tables);
+
+    // key imported before eviction still holds its table
+    ASSERT_NE(nullptr, evictedKey);
+    EXPECT_TRUE(backend.verifyP256Signature(*evictedKey, signatures[1], digest));
+
+    EXPECT_TRUE(verify(backend, keys[1].rawPublicKey, signatures[1], digest));
+    metrics = backend.getMetrics();
+    EXPECT_EQ(4u, metrics.tablesBuilt);
+    EXPECT_EQ(2u, metrics.evictions);
+}
+
+TEST_F(PrecomputedP256BackendUT, shouldVerifyColdKeysWithoutBuildingTables)
+{
+    PrecomputedP256Backend backend(100, 2);
+    const auto keys = generateKeys(1);
+    const auto digest = randomBytes(32);
+    const auto signature = signDigest(digest, *keys[0].key);
+
+    EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+    EXPECT_FALSE(verify(backend, keys[0].rawPublicKey, signature, randomBytes(32)));
+    EXPECT_EQ(0u, backend.getMetrics().tablesBuilt);
+
+    PrecomputedP256Backend withoutTables(0, 0);
+    EXPECT_TRUE(verify(withoutTables, keys[0].rawPublicKey, signature, digest));
+    EXPECT_EQ(0u, withoutTables.getMetrics().tablesBuilt);
+}
+
+TEST_F(PrecomputedP256BackendUT, shouldAgreeWithOpensslOnRandomKeysAndSignatures)
+{
+    PrecomputedP256Backend backend(0, 4);
+    const auto keys = generateKeys(8);
+
+    for (const auto& key : keys)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            const auto digest = randomBytes(32);
+            const auto signature = signDigest(digest, *key.key);
+            EXPECT_TRUE(verify(openssl, key.rawPublicKey, signature, digest));
+            EXPECT_TRUE(verify(backend, key.rawPublicKey, signature, digest));
+
+            auto modifiedSignature = signature;
+            modifiedSignature[random() % modifiedSignature.size()] ^= static_cast<uint8_t>(1u << (random() % 8));
+            EXPECT_FALSE(verify(backend, key.rawPublicKey, modifiedSignature, digest));
+            EXPECT_EQ(verify(openssl, key.rawPublicKey, modifiedSignature, digest),
+                      verify(backend, key.rawPublicKey, modifiedSignature, digest));
+
+            const auto otherDigest = randomBytes(32);
+            EXPECT_FALSE(verify(backend, key.rawPublicKey, signature, otherDigest));
+        }
+    }
+    EXPECT_EQ(4u, backend.getMetrics().tables);
+}
+
+TEST_F(PrecomputedP256BackendUT, shouldReduceDigestsGreaterThanGroupOrder)
+{
+    PrecomputedP256Backend backend(0, 1);
+    const auto keys = generateKeys(1);
+
+    for (const auto& digest : {Bytes(32, 0xff), Bytes(32, 0x00)})
+    {
+        const auto signature = signDigest(digest, *keys[0].key);
+        EXPECT_TRUE(verify(openssl, keys[0].rawPublicKey, signature, digest));
+        EXPECT_TRUE(verify(backend, keys[0].rawPublicKey, signature, digest));
+    }
+}
+
+TEST_F(PrecomputedP256BackendUT, shouldRejectKeyOfOtherBackend)
+{
+    PrecomputedP256Backend backend(0, 1);
+    const auto keys = generateKeys(1);
+    const auto digest = randomBytes(32);
+    const auto signature = signDigest(digest, *keys[0].key);
+    const auto opensslKey = openssl.importP256PublicKey(keys[0].rawPublicKey);
+
+    ASSERT_NE(nullptr, opensslKey);
+    EXPECT_FALSE(backend.verifyP256Signature(*opensslKey, signature, digest));
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteV4Generator.h"
+#include "QuoteV5Generator.h"
+#include <QuoteVerification/Quote.h>
+#include <QuoteVerification/QuoteLayout.h>
+
+#include <gtest/gtest.h>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::quote;
+
+namespace {
+
+static_assert(getLayoutId(constants::QUOTE_VERSION_3, constants::TEE_TYPE_SGX, 0) == LayoutId::SGX_V3);
+static_assert(getLayoutId(constants::QUOTE_VERSION_3, constants::TEE_TYPE_TDX, 0) == LayoutId::UNSUPPORTED);
+static_assert(getLayoutId(constants::QUOTE_VERSION_4, constants::TEE_TYPE_TDX, 0) == LayoutId::TDX_V4);
+static_assert(getLayoutId(constants::QUOTE_VERSION_5, constants::TEE_TYPE_TDX,
+                          constants::BODY_TD_REPORT15_TYPE) == LayoutId::TDX15_V5);
+static_assert(getLayoutId(constants::QUOTE_VERSION_5, constants::TEE_TYPE_SGX,
+                          constants::BODY_TD_REPORT10_TYPE) == LayoutId::UNSUPPORTED);
+static_assert(Tdx15QuoteV5::HAS_BODY && Tdx15QuoteV5::IS_TDX && Tdx15QuoteV5::HAS_TEE_TCB_SVN2);
+static_assert(!TdxQuoteV4::HAS_BODY && !TdxQuoteV4::HAS_TEE_TCB_SVN2);
+static_assert(std::is_same_v<SgxQuoteV3::Report, EnclaveReport> && SgxQuoteV3::REPORT_BYTE_LEN == 384);
+
+template<typename Layout>
+int layoutTag(Layout)
+{
+    return Layout::VERSION * 10 + static_cast<int>(Layout::BODY_TYPE);
+}
+
+} // anonymous namespace
+
+TEST(QuoteLayoutUT, visitLayoutShouldCallVisitorWithLayoutOfGivenId)
+{
+    const auto visit = [](LayoutId id) { return visitLayout(id, -1, [](auto layout) { return layoutTag(layout); }); };
+
+    EXPECT_EQ(31, visit(LayoutId::SGX_V3));
+    EXPECT_EQ(41, visit(LayoutId::SGX_V4));
+    EXPECT_EQ(42, visit(LayoutId::TDX_V4));
+    EXPECT_EQ(51, visit(LayoutId::SGX_V5));
+    EXPECT_EQ(52, visit(LayoutId::TDX10_V5));
+    EXPECT_EQ(53, visit(LayoutId::TDX15_V5));
+    EXPECT_EQ(-1, visit(LayoutId::UNSUPPORTED));
+}
+
+TEST(QuoteLayoutUT, parseShouldRecordLayoutOfQuote)
+{
+    test::QuoteV4Generator v4Generator;
+    test::QuoteV5Generator v5Generator;
+    test::QuoteV5Generator::QuoteHeader tdxHeader;
+    tdxHeader.teeType = constants::TEE_TYPE_TDX;
+    v5Generator.withHeader(tdxHeader);
+    v5Generator.withBody({ constants::BODY_TD_REPORT15_TYPE, constants::TD_REPORT15_BYTE_LEN });
+
+    Quote sgxQuote;
+    Quote tdxQuote;
+    ASSERT_TRUE(sgxQuote.parse(v4Generator.buildSgxQuote()));
+    ASSERT_TRUE(tdxQuote.parse(v5Generator.buildTdx15Quote()));
+
+    EXPECT_EQ(LayoutId::SGX_V4, sgxQuote.getLayoutId());
+    EXPECT_EQ(LayoutId::TDX15_V5, tdxQuote.getLayoutId());
+    EXPECT_EQ(&tdxQuote.getTdReport15(), &tdxQuote.getReport<Tdx15QuoteV5>());
+}
+
+TEST(QuoteLayoutUT, parseShouldRecordUnsupportedLayoutWhenTeeTypeDoesNotMatchBody)
+{
+    test::QuoteV5Generator generator;
+    generator.withBody({ constants::BODY_TD_REPORT10_TYPE, constants::TD_REPORT10_BYTE_LEN });
+
+    Quote quote;
+    ASSERT_TRUE(quote.parse(generator.buildTdx10Quote()));
+
+    EXPECT_EQ(LayoutId::UNSUPPORTED, quote.getLayoutId());
+    EXPECT_FALSE(quote.validate());
+}
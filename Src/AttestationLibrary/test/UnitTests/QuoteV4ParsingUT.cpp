@@ -30,6 +30,7 @@
  */
 
 
+#include "DigestUtils.h"
 #include "QuoteV4Generator.h"
 #include <QuoteVerification/Quote.h>
 
@@ -585,4 +586,29 @@ TEST_F(QuoteV4ParsingUT, shouldNotParseCertificationDataWithUnsupportedType)
     dcap::Quote quote;
     ASSERT_TRUE(quote.parse(gen.buildSgxQuote()));
     ASSERT_FALSE(quote.validate());
-}
\ No newline at end of file
+}
+
+TEST_F(QuoteV4ParsingUT, shouldComputeDigestsOfSignedDataAndQeReportDataWhileParsing)
+{
+    // GIVEN
+    const auto sgxQuoteBytes = gen.buildSgxQuote();
+    auto sgxSignedData = gen.getHeader().bytes();
+    const auto enclaveReportBytes = gen.getEnclaveReport().bytes();
+    sgxSignedData.insert(sgxSignedData.end(), enclaveReportBytes.begin(), enclaveReportBytes.end());
+    gen.getHeader().teeType = dcap::constants::TEE_TYPE_TDX;
+    const auto tdxQuoteBytes = gen.buildTdxQuote();
+    const std::vector<uint8_t> tdxSignedData(tdxQuoteBytes.begin(), tdxQuoteBytes.begin() + dcap::constants::HEADER_BYTE_LEN + dcap::constants::TD_REPORT10_BYTE_LEN);
+
+    // WHEN
+    dcap::Quote sgxQuote;
+    dcap::Quote tdxQuote;
+    ASSERT_TRUE(sgxQuote.parse(sgxQuoteBytes));
+    ASSERT_TRUE(tdxQuote.parse(tdxQuoteBytes));
+
+    // THEN
+    EXPECT_EQ(dcap::DigestUtils::sha256Digest(sgxSignedData), sgxQuote.getSignedDataDigest());
+    EXPECT_EQ(dcap::DigestUtils::sha256Digest(tdxSignedData), tdxQuote.getSignedDataDigest());
+    std::vector<uint8_t> attestKeyAndQeAuthData(sgxQuote.getAttestKeyData().begin(), sgxQuote.getAttestKeyData().end());
+    attestKeyAndQeAuthData.insert(attestKeyAndQeAuthData.end(), sgxQuote.getQeAuthData().begin(), sgxQuote.getQeAuthData().end());
+    EXPECT_EQ(dcap::DigestUtils::sha256Digest(attestKeyAndQeAuthData), sgxQuote.getQeReportDataDigest());
+}
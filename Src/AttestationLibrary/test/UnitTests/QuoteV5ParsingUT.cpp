@@ -359,6 +359,31 @@ TEST_F(QuoteV5ParsingUT, shouldParseAndValidateQuoteTDX15Header)
     EXPECT_TRUE(testHeader == quoteObj.getHeader());
 }
 
+TEST_F(QuoteV5ParsingUT, shouldExposeOnlyReportAndAuthDataCarriedByTdx15Quote)
+{
+    gen.withBody({ dcap::constants::BODY_TD_REPORT15_TYPE,
+                   dcap::constants::TD_REPORT15_BYTE_LEN });
+    gen.getTdReport15().teeTcbSvn.fill(0x11);
+    gen.getTdReport15().mrSignerSeam.fill(0x22);
+    gen.getTdReport15().teeTcbSvn2.fill(0x33);
+
+    dcap::Quote quote;
+    ASSERT_TRUE(quote.parse(gen.buildTdx15Quote()));
+
+    EXPECT_EQ(gen.getTdReport15().teeTcbSvn, quote.getTeeTcbSvn());
+    EXPECT_EQ(gen.getTdReport15().mrSignerSeam, quote.getMrSignerSeam());
+    EXPECT_EQ(gen.getTdReport15().teeTcbSvn2, quote.getTdReport15().teeTcbSvn2);
+    EXPECT_EQ(&quote.getTdReport15().teeTcbSvn, &quote.getTeeTcbSvn());
+
+    const dcap::TDReport10 emptyTdReport10{};
+    const dcap::EnclaveReport emptyEnclaveReport{};
+    EXPECT_EQ(emptyTdReport10.teeTcbSvn, quote.getTdReport10().teeTcbSvn);
+    EXPECT_EQ(emptyEnclaveReport.mrEnclave, quote.getEnclaveReport().mrEnclave);
+    EXPECT_EQ(emptyEnclaveReport.mrSigner, quote.getAuthDataV3().qeReport.mrSigner);
+    EXPECT_EQ(&quote.getAuthDataV4().ecdsaAttestationKey.pubKey, &quote.getAttestKeyData());
+    EXPECT_EQ(qeReportCertificationData.qeReport.mrSigner, quote.getQeReport().mrSigner);
+}
+
 TEST_F(QuoteV5ParsingUT, shouldNotValdiateQuoteWithUnsupportedVersion)
 {
     dcap::test::QuoteV5Generator::QuoteHeader testHeader;
@@ -101,6 +101,8 @@ public:
     {
         header.teeType = constants::TEE_TYPE_TDX;
         body.bodyType = dcap::constants::BODY_TD_REPORT15_TYPE;
+        layoutId = quote::LayoutId::TDX15_V5;
+        auto& tdReport15 = report.emplace<TDReport15>();
         tdReport15.teeTcbSvn = teeTcbSvn;
         tdReport15.teeTcbSvn2 = teeTcbSvn2;
     }
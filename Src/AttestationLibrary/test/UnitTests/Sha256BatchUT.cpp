@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/DigestUtils.h>
+#include <OpensslHelpers/Sha256Batch.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+using namespace intel::sgx;
+using intel::sgx::dcap::Bytes;
+using namespace ::testing;
+
+struct Sha256BatchUT : public TestWithParam<dcap::crypto::Sha256Kernel>
+{
+    // lengths around padding boundaries, signed data of SGX and TDX quotes and a few multi-block messages
+    const std::vector<size_t> sizes{0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 432, 632, 1000, 4097};
+
+    static Bytes message(size_t size, uint8_t seed)
+    {
+        Bytes bytes(size);
+        std::iota(bytes.begin(), bytes.end(), seed);
+        return bytes;
+    }
+
+    static Bytes concat(const Bytes& data, const Bytes& suffix)
+    {
+        auto bytes = data;
+        bytes.insert(bytes.end(), suffix.begin(), suffix.end());
+        return bytes;
+    }
+
+    void SetUp() override
+    {
+        if (!dcap::crypto::isSha256KernelSupported(GetParam()))
+        {
+            GTEST_SKIP() << "SHA-256 kernel is not supported by this CPU";
+        }
+    }
+};
+
+TEST_P(Sha256BatchUT, digestsShouldMatchOpensslForMessagesOfUnevenLength)
+{
+    // GIVEN
+    std::vector<Bytes> messages;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        messages.push_back(message(sizes[i], static_cast<uint8_t>(i)));
+    }
+    std::vector<dcap::crypto::Sha256BatchInput> inputs;
+    for (const auto& msg : messages)
+    {
+        inputs.push_back({msg.data(), msg.size(), nullptr, 0});
+    }
+
+    // WHEN
+    const auto digests = dcap::crypto::sha256Batch(inputs, GetParam());
+
+    // THEN
+    ASSERT_EQ(messages.size(), digests.size());
+    for (size_t i = 0; i < messages.size(); ++i)
+    {
+        EXPECT_EQ(dcap::crypto::sha256Digest(messages[i]), digests[i]) << "message size " << messages[i].size();
+    }
+}
+
+TEST_P(Sha256BatchUT, digestOfMessageWithSuffixShouldMatchDigestOfConcatenation)
+{
+    // GIVEN
+    std::vector<std::pair<Bytes, Bytes>> messages;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        // every split point relative to block boundary, attestation key with QE Authentication Data among them
+        messages.emplace_back(message(sizes[i], 0x11), message(sizes[sizes.size() - 1 - i] % 100, 0x77));
+    }
+    messages.emplace_back(message(64, 0x01), message(32, 0x02));
+    std::vector<dcap::crypto::Sha256BatchInput> inputs;
+    for (const auto& msg : messages)
+    {
+        inputs.push_back({msg.first.data(), msg.first.size(), msg.second.data(), msg.second.size()});
+    }
+
+    // WHEN
+    const auto digests = dcap::crypto::sha256Batch(inputs, GetParam());
+
+    // THEN
+    ASSERT_EQ(messages.size(), digests.size());
+    for (size_t i = 0; i < messages.size(); ++i)
+    {
+        EXPECT_EQ(dcap::crypto::sha256Digest(concat(messages[i].first, messages[i].second)), digests[i])
+            << "message sizes " << messages[i].first.size() << " and " << messages[i].second.size();
+    }
+}
+
+TEST_P(Sha256BatchUT, emptyBatchShouldGiveNoDigests)
+{
+    EXPECT_TRUE(dcap::crypto::sha256Batch({}, GetParam()).empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, Sha256BatchUT, Values(dcap::crypto::Sha256Kernel::AUTO,
+                                                       dcap::crypto::Sha256Kernel::OPENSSL,
+                                                       dcap::crypto::Sha256Kernel::AVX2));
@@ -63,3 +63,23 @@ TEST(signatureVerification, shouldVerifyRawEcdsaSignature)
     // THEN
     EXPECT_TRUE(dcap::DigestUtils::verifySig(convertedBackSignature, data, *pb));
 }
+
+TEST(signatureVerification, shouldVerifyRawEcdsaSignatureOfPrecomputedDigest)
+{
+    // GIVEN
+    auto prv = dcap::test::priv(dcap::test::PEM_PRV);
+    auto pb = dcap::test::pub(dcap::test::PEM_PUB);
+    const std::vector<uint8_t> data(150, 0xff);
+    auto sig = dcap::DigestUtils::signMessageSha256(data, *prv);
+    const auto rawSig = EcdsaSignatureGenerator::convertECDSASignatureToRawArray(sig);
+    auto digest = dcap::DigestUtils::sha256Digest(data);
+
+    // WHEN
+    const auto valid = dcap::crypto::verifyEcdsaSignatureOfSha256Digest(rawSig, digest, *pb);
+    digest[0] ^= 0x01;
+    const auto tamperedValid = dcap::crypto::verifyEcdsaSignatureOfSha256Digest(rawSig, digest, *pb);
+
+    // THEN
+    EXPECT_TRUE(valid);
+    EXPECT_FALSE(tamperedValid);
+}
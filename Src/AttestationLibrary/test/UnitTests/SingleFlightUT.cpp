@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/SingleFlight.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+using namespace intel::sgx::dcap;
+using namespace ::testing;
+
+struct SingleFlightUT : public Test
+{
+    SingleFlight flights;
+    const SingleFlight::Key key{{0x01, 0x02}};
+    const SingleFlight::Key otherKey{{0x03, 0x04}};
+
+    void waitForRequests(uint64_t requests) const
+    {
+        while (flights.getMetrics().requests < requests)
+        {
+            std::this_thread::yield();
+        }
+    }
+};
+
+TEST_F(SingleFlightUT, concurrentCallWithSameKeyShouldWaitForFirstResult)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    std::atomic<int> computed{0};
+
+    auto first = std::async(std::launch::async, [&] {
+        return flights.run(key, [&] {
+            ++computed;
+            started.set_value();
+            releaseFuture.wait();
+            return STATUS_TCB_OUT_OF_DATE;
+        });
+    });
+    started.get_future().wait();
+    auto duplicate = std::async(std::launch::async, [&] {
+        return flights.run(key, [&] { ++computed; return STATUS_OK; });
+    });
+    waitForRequests(2);
+    release.set_value();
+
+    EXPECT_EQ(STATUS_TCB_OUT_OF_DATE, first.get());
+    EXPECT_EQ(STATUS_TCB_OUT_OF_DATE, duplicate.get());
+    EXPECT_EQ(1, computed.load());
+    const auto metrics = flights.getMetrics();
+    EXPECT_EQ(2u, metrics.requests);
+    EXPECT_EQ(1u, metrics.coalesced);
+    EXPECT_EQ(0u, metrics.inFlight);
+}
+
+TEST_F(SingleFlightUT, concurrentCallWithOtherKeyShouldBeComputed)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+
+    auto first = std::async(std::launch::async, [&] {
+        return flights.run(key, [&] { started.set_value(); releaseFuture.wait(); return STATUS_OK; });
+    });
+    started.get_future().wait();
+    EXPECT_EQ(1u, flights.getMetrics().inFlight);
+
+    EXPECT_EQ(STATUS_INVALID_QUOTE_SIGNATURE, flights.run(otherKey, [] { return STATUS_INVALID_QUOTE_SIGNATURE; }));
+    release.set_value();
+
+    EXPECT_EQ(STATUS_OK, first.get());
+    EXPECT_EQ(0u, flights.getMetrics().coalesced);
+}
+
+TEST_F(SingleFlightUT, callAfterCompletionShouldComputeAgain)
+{
+    EXPECT_EQ(STATUS_OK, flights.run(key, [] { return STATUS_OK; }));
+    EXPECT_EQ(STATUS_TCB_REVOKED, flights.run(key, [] { return STATUS_TCB_REVOKED; }));
+
+    const auto metrics = flights.getMetrics();
+    EXPECT_EQ(2u, metrics.requests);
+    EXPECT_EQ(0u, metrics.coalesced);
+}
+
+TEST_F(SingleFlightUT, exceptionShouldReachWaitingCallsAndEndFlight)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+
+    auto first = std::async(std::launch::async, [&] {
+        return flights.run(key, [&]() -> Status {
+            started.set_value();
+            releaseFuture.wait();
+            throw std::runtime_error("verification failed");
+        });
+    });
+    started.get_future().wait();
+    auto duplicate = std::async(std::launch::async, [&] {
+        return flights.run(key, [] { return STATUS_OK; });
+    });
+    waitForRequests(2);
+    release.set_value();
+
+    EXPECT_THROW(first.get(), std::runtime_error);
+    EXPECT_THROW(duplicate.get(), std::runtime_error);
+    EXPECT_EQ(0u, flights.getMetrics().inFlight);
+    EXPECT_EQ(STATUS_OK, flights.run(key, [] { return STATUS_OK; }));
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/StatusCache.h>
+
+#include <gtest/gtest.h>
+
+using namespace intel::sgx::dcap;
+using namespace ::testing;
+
+struct StatusCacheUT : public Test
+{
+    const StatusCache::Key key{{0x01, 0x02}};
+    const StatusCache::Key otherKey{{0x03, 0x04}};
+    const StatusCache::Key thirdKey{{0x05, 0x06}};
+    const std::time_t now = 1000;
+};
+
+TEST_F(StatusCacheUT, shouldReturnCachedStatusUntilExpiration)
+{
+    StatusCache cache(2);
+    auto status = STATUS_OK;
+
+    EXPECT_FALSE(cache.find(key, now, status));
+    cache.insert(key, STATUS_TCB_OUT_OF_DATE, now + 10);
+
+    EXPECT_TRUE(cache.find(key, now + 9, status));
+    EXPECT_EQ(STATUS_TCB_OUT_OF_DATE, status);
+    EXPECT_FALSE(cache.find(key, now + 10, status));
+    EXPECT_FALSE(cache.find(key, now, status)); // expired entry is dropped
+
+    const auto metrics = cache.getMetrics();
+    EXPECT_EQ(1u, metrics.hits);
+    EXPECT_EQ(3u, metrics.misses);
+    EXPECT_EQ(1u, metrics.expirations);
+    EXPECT_EQ(0u, metrics.evictions);
+    EXPECT_EQ(0u, metrics.entries);
+}
+
+TEST_F(StatusCacheUT, shouldEvictLeastRecentlyUsedEntryWhenFull)
+{
+    StatusCache cache(2);
+    auto status = STATUS_OK;
+    cache.insert(key, STATUS_OK, now + 10);
+    cache.insert(otherKey, STATUS_TCB_REVOKED, now + 10);
+    EXPECT_TRUE(cache.find(key, now, status));
+
+    cache.insert(thirdKey, STATUS_INVALID_QUOTE_SIGNATURE, now + 10);
+
+    EXPECT_TRUE(cache.find(key, now, status));
+    EXPECT_EQ(STATUS_OK, status);
+    EXPECT_FALSE(cache.find(otherKey, now, status));
+    EXPECT_TRUE(cache.find(thirdKey, now, status));
+    EXPECT_EQ(STATUS_INVALID_QUOTE_SIGNATURE, status);
+    const auto metrics = cache.getMetrics();
+    EXPECT_EQ(1u, metrics.evictions);
+    EXPECT_EQ(2u, metrics.entries);
+}
+
+TEST_F(StatusCacheUT, insertOfCachedKeyShouldReplaceEntry)
+{
+    StatusCache cache(2);
+    auto status = STATUS_OK;
+    cache.insert(key, STATUS_OK, now + 1);
+
+    cache.insert(key, STATUS_OK, now + 10);
+
+    EXPECT_TRUE(cache.find(key, now + 5, status));
+    EXPECT_EQ(1u, cache.getMetrics().entries);
+}
+
+TEST_F(StatusCacheUT, shouldNotCacheWhenCapacityIsZero)
+{
+    StatusCache cache(0);
+    auto status = STATUS_OK;
+
+    cache.insert(key, STATUS_OK, now + 10);
+
+    EXPECT_FALSE(cache.find(key, now, status));
+    EXPECT_EQ(0u, cache.getMetrics().entries);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/WorkerPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+
+using namespace intel::sgx::dcap;
+using namespace ::testing;
+
+struct WorkerPoolUT : public Test
+{};
+
+TEST_F(WorkerPoolUT, shouldExecuteAllAcceptedTasksBeforeDestruction)
+{
+    std::atomic<int> executed{0};
+    {
+        WorkerPool pool(4, 1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            ASSERT_TRUE(pool.trySubmit([&executed] { ++executed; }));
+        }
+    }
+    EXPECT_EQ(1000, executed.load());
+}
+
+TEST_F(WorkerPoolUT, shouldRejectTaskWhenQueueIsFull)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    std::atomic<int> executed{0};
+
+    WorkerPool pool(1, 2);
+    ASSERT_TRUE(pool.trySubmit([&started, releaseFuture] { started.set_value(); releaseFuture.wait(); }));
+    started.get_future().wait(); // the only worker is busy now
+
+    EXPECT_TRUE(pool.trySubmit([&executed] { ++executed; }));
+    EXPECT_TRUE(pool.trySubmit([&executed] { ++executed; }));
+    EXPECT_FALSE(pool.trySubmit([&executed] { ++executed; }));
+
+    release.set_value();
+}
+
+TEST_F(WorkerPoolUT, shouldUseHardwareConcurrencyWhenWorkerCountIsZero)
+{
+    WorkerPool pool(0, 1);
+    EXPECT_GE(pool.getWorkerCount(), 1u);
+}
+
+TEST_F(WorkerPoolUT, idleWorkerShouldStealTasksQueuedForBusyWorker)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto releaseFuture = release.get_future().share();
+    std::atomic<int> executed{0};
+
+    WorkerPool pool(2, 16);
+    ASSERT_TRUE(pool.trySubmit([&started, releaseFuture] { started.set_value(); releaseFuture.wait(); }));
+    started.get_future().wait();
+
+    // round robin places half of these on the deque of the blocked worker
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(pool.trySubmit([&executed] { ++executed; }));
+    }
+    while (executed.load() < 8)
+    {
+        std::this_thread::yield();
+    }
+
+    EXPECT_GE(pool.getStolenCount(), 1u);
+    release.set_value();
+}
+
+TEST_F(WorkerPoolUT, tasksSubmittedByWorkerShouldBeExecuted)
+{
+    std::atomic<int> executed{0};
+    std::promise<void> done;
+    {
+        WorkerPool pool(2, 8);
+        std::function<void(int)> submitChain;
+        submitChain = [&](int remaining) {
+            ++executed;
+            if (remaining == 0)
+            {
+                done.set_value();
+                return;
+            }
+            EXPECT_TRUE(pool.trySubmit([&submitChain, remaining] { submitChain(remaining - 1); }));
+        };
+        ASSERT_TRUE(pool.trySubmit([&submitChain] { submitChain(5); }));
+        done.get_future().wait();
+    }
+    EXPECT_EQ(6, executed.load());
+}
+
+TEST_F(WorkerPoolUT, pinnedWorkersShouldExecuteTasks)
+{
+    std::atomic<int> executed{0};
+    {
+        WorkerPool::Placement placement;
+        placement.pinToCpu = true;
+        placement.firstCpu = 1;
+        WorkerPool pool(3, 100, placement);
+        for (int i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(pool.trySubmit([&executed] { ++executed; }));
+        }
+    }
+    EXPECT_EQ(100, executed.load());
+}
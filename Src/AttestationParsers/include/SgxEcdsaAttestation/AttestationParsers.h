@@ -45,6 +45,7 @@
 #include <vector>
 #include <set>
 #include <string>
+#include <string_view>
 #include <ctime>
 #include <stdexcept>
 #include <cstdint>
@@ -65,8 +66,6 @@ typedef struct X509_name_st X509_NAME;
 typedef struct asn1_string_st ASN1_STRING;
 typedef struct asn1_string_st ASN1_BIT_STRING;
 typedef struct X509_extension_st X509_EXTENSION;
-struct stack_st_ASN1_TYPE;
-typedef struct asn1_type_st ASN1_TYPE;
 typedef struct x509_st X509;
 
 namespace intel { namespace sgx { namespace dcap { namespace parser
@@ -105,7 +104,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         {
         public:
             TdxModule() = default;
+            TdxModule(const TdxModule &) = default;
+            TdxModule(TdxModule &&) = default;
             virtual ~TdxModule() = default;
+
+            TdxModule& operator=(const TdxModule &) = default;
+            TdxModule& operator=(TdxModule &&) = default;
+
             TdxModule(const std::vector<uint8_t>& mrsigner, const std::vector<uint8_t>& attributes,
                       const std::vector<uint8_t>& attributesMask): _mrsigner(mrsigner), _attributes(attributes),
                       _attributesMask(attributesMask) {}
@@ -146,8 +151,12 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         public:
             TdxModuleTcb() = default;
             explicit TdxModuleTcb(uint16_t isvSvn);
+            TdxModuleTcb(const TdxModuleTcb &) = default;
+            TdxModuleTcb(TdxModuleTcb &&) = default;
             virtual ~TdxModuleTcb() = default;
 
+            TdxModuleTcb& operator=(const TdxModuleTcb &) = default;
+            TdxModuleTcb& operator=(TdxModuleTcb &&) = default;
 
             virtual uint16_t getIsvSvn() const;
 
@@ -166,7 +175,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             TdxModuleTcbLevel() = default;
             explicit TdxModuleTcbLevel(const TdxModuleTcb& tcb, const std::time_t& tcbDate,
                                        const std::string& tcbStatus, const std::vector<std::string>& advisoryIDs);
+            TdxModuleTcbLevel(const TdxModuleTcbLevel &) = default;
+            TdxModuleTcbLevel(TdxModuleTcbLevel &&) = default;
             virtual ~TdxModuleTcbLevel() = default;
+
+            TdxModuleTcbLevel& operator=(const TdxModuleTcbLevel &) = default;
+            TdxModuleTcbLevel& operator=(TdxModuleTcbLevel &&) = default;
+
             virtual bool operator>(const TdxModuleTcbLevel& other) const;
 
             virtual const TdxModuleTcb& getTcb() const;
@@ -193,7 +208,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             explicit TdxModuleIdentity(const std::string& id, const std::vector<uint8_t>& mrsigner,
                                        const std::vector<uint8_t>& attributes, const std::vector<uint8_t>& attributesMask,
                                        const std::set<TdxModuleTcbLevel, std::greater<TdxModuleTcbLevel>>& tcbLevels);
+            TdxModuleIdentity(const TdxModuleIdentity &) = default;
+            TdxModuleIdentity(TdxModuleIdentity &&) = default;
             virtual ~TdxModuleIdentity() = default;
+
+            TdxModuleIdentity& operator=(const TdxModuleIdentity &) = default;
+            TdxModuleIdentity& operator=(TdxModuleIdentity &&) = default;
+
             virtual std::string getId() const;
 
             /**
@@ -254,8 +275,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             static const std::string TDX_ID;
 
             TcbInfo() = default;
+            TcbInfo(const TcbInfo &) = default;
+            TcbInfo(TcbInfo &&) = default;
             virtual ~TcbInfo() = default;
 
+            TcbInfo& operator=(const TcbInfo &) = default;
+            TcbInfo& operator=(TcbInfo &&) = default;
+
             /**
              * Get identifier of TCB Info structure
              * @return string with identifier
@@ -439,7 +465,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
                      const uint32_t pceSvn,
                      const std::string& status);
 
+            TcbLevel(const TcbLevel &) = default;
+            TcbLevel(TcbLevel &&) = default;
             virtual ~TcbLevel() = default;
+
+            TcbLevel& operator=(const TcbLevel &) = default;
+            TcbLevel& operator=(TcbLevel &&) = default;
+
             virtual bool operator>(const TcbLevel& other) const;
 
             /**
@@ -576,8 +608,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
                               const std::string& organizationName,
                               const std::string& locationName,
                               const std::string& stateName);
+            DistinguishedName(const DistinguishedName &) = default;
+            DistinguishedName(DistinguishedName &&) = default;
             virtual ~DistinguishedName() = default;
 
+            DistinguishedName& operator=(const DistinguishedName &) = default;
+            DistinguishedName& operator=(DistinguishedName &&) = default;
+
             virtual bool operator==(const DistinguishedName& other) const;
             virtual bool operator!=(const DistinguishedName& other) const;
 
@@ -716,8 +753,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             Extension(int nid,
                       const std::string& name,
                       const std::vector<uint8_t>& value) noexcept;
+            Extension(const Extension &) = default;
+            Extension(Extension &&) = default;
             virtual ~Extension() = default;
 
+            Extension& operator=(const Extension &) = default;
+            Extension& operator=(Extension &&) = default;
+
             /**
              * Check if extensions are equal
              * @return true if equal
@@ -776,8 +818,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             Signature(const std::vector<uint8_t>& rawDer,
                       const std::vector<uint8_t>& r,
                       const std::vector<uint8_t>& s);
+            Signature(const Signature &) = default;
+            Signature(Signature &&) = default;
             virtual ~Signature() = default;
 
+            Signature& operator=(const Signature &) = default;
+            Signature& operator=(Signature &&) = default;
+
             /**
              * Check if signatures are equal
              * @param other
@@ -908,7 +955,10 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
              *
              * @throws intel::sgx::dcap::parser::FormatException in case of parsing error
              */
+            static Certificate parse(std::string_view pem);
+            // kept for binaries built against the std::string signature, forwards to the string_view one
             static Certificate parse(const std::string& pem);
+            static Certificate parse(const char* pem) { return parse(std::string_view(pem)); }
 
         protected:
             uint32_t _version;
@@ -923,6 +973,7 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             std::string _pem;
             std::string _crlDistributionPoint;
 
+            explicit Certificate(std::string_view pem);
             explicit Certificate(const std::string& pem);
 
         private:
@@ -963,8 +1014,13 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             Tcb(const std::vector<uint8_t>& cpusvn,
                 const std::vector<uint8_t>& cpusvnComponents,
                 uint32_t pcesvn);
+            Tcb(const Tcb &) = default;
+            Tcb(Tcb &&) = default;
             virtual ~Tcb() = default;
 
+            Tcb& operator=(const Tcb &) = default;
+            Tcb& operator=(Tcb &&) = default;
+
             /**
              * Check if TCB objects are equal
              * @param other TCB
@@ -1003,8 +1059,6 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             std::vector<uint8_t> _cpuSvnComponents;
             uint32_t _pceSvn{};
 
-            explicit Tcb(const ASN1_TYPE *);
-
             friend class PckCertificate;
         };
 
@@ -1057,8 +1111,6 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             bool _cachedKeys = true;
             bool _smtEnabled = true;
 
-            explicit Configuration(const ASN1_TYPE *configurationSeq);
-
             friend class PckCertificate;
             friend class ProcessorPckCertificate;
             friend class PlatformPckCertificate;
@@ -1142,8 +1194,8 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             uint8_t PROCESSOR_CA_EXTENSION_COUNT = 5;
             uint8_t PLATFORM_CA_EXTENSION_COUNT = 7;
 
-            stack_st_ASN1_TYPE* getSgxExtensions();
-            void setMembers(stack_st_ASN1_TYPE *sgxExtensions);
+            const Extension& getSgxExtension() const;
+            void setMembers(const Extension& sgxExtension);
 
             explicit PckCertificate(const std::string& pem);
 
@@ -1178,7 +1230,7 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         private:
             explicit ProcessorPckCertificate(const std::string& pem);
 
-            void setMembers(stack_st_ASN1_TYPE *sgxExtensions);
+            void setMembers(const Extension& sgxExtension);
         };
 
         /**
@@ -1233,7 +1285,7 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         private:
             explicit PlatformPckCertificate(const std::string& pem);
 
-            void setMembers(stack_st_ASN1_TYPE *sgxExtensions);
+            void setMembers(const Extension& sgxExtension);
 
             std::vector<uint8_t> _platformInstanceId;
             Configuration _configuration;
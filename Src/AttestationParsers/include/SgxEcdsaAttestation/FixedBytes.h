@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_PARSERS_FIXED_BYTES_H_
+#define SGX_DCAP_PARSERS_FIXED_BYTES_H_
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace parser {
+
+    /**
+     * Fixed-width byte field of an SGX/TDX structure (MRSIGNER, attributes, miscselect, ...).
+     * Value is kept inline, masked comparison is done a machine word at a time so that
+     * the compiler can keep it in registers or vector units.
+     */
+    template<size_t N>
+    class FixedBytes
+    {
+    public:
+        static constexpr size_t SIZE = N;
+
+        FixedBytes() = default;
+        explicit FixedBytes(const std::array<uint8_t, N>& bytes): _bytes(bytes) {}
+
+        /**
+         * Copy value from variable-length byte buffer
+         * @return false and zeroed value if buffer size is not exactly N bytes
+         */
+        bool assign(const std::vector<uint8_t>& bytes)
+        {
+            if (bytes.size() != N)
+            {
+                _bytes.fill(0);
+                return false;
+            }
+            std::memcpy(_bytes.data(), bytes.data(), N);
+            return true;
+        }
+
+        const uint8_t* data() const { return _bytes.data(); }
+        constexpr size_t size() const { return N; }
+        typename std::array<uint8_t, N>::const_iterator begin() const { return _bytes.cbegin(); }
+        typename std::array<uint8_t, N>::const_iterator end() const { return _bytes.cend(); }
+        uint8_t operator[](size_t index) const { return _bytes[index]; }
+        const std::array<uint8_t, N>& asArray() const { return _bytes; }
+
+        /**
+         * Compatibility conversion for interfaces still taking byte vectors
+         */
+        std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(_bytes.begin(), _bytes.end()); }
+
+        /**
+         * Check if value with mask applied is equal to expected value
+         */
+        bool matches(const FixedBytes& expected, const FixedBytes& mask) const
+        {
+            uint64_t difference = 0;
+            size_t offset = 0;
+            for (; offset + sizeof(uint64_t) <= N; offset += sizeof(uint64_t))
+            {
+                difference |= (loadWord(*this, offset) & loadWord(mask, offset)) ^ loadWord(expected, offset);
+            }
+            for (; offset < N; ++offset)
+            {
+                difference |= static_cast<uint64_t>((_bytes[offset] & mask._bytes[offset]) ^ expected._bytes[offset]);
+            }
+            return difference == 0;
+        }
+
+        bool operator==(const FixedBytes& other) const { return std::memcmp(_bytes.data(), other._bytes.data(), N) == 0; }
+        bool operator!=(const FixedBytes& other) const { return !(*this == other); }
+        bool operator==(const std::array<uint8_t, N>& other) const { return std::memcmp(_bytes.data(), other.data(), N) == 0; }
+        bool operator!=(const std::array<uint8_t, N>& other) const { return !(*this == other); }
+
+    private:
+        static uint64_t loadWord(const FixedBytes& bytes, size_t offset)
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes._bytes.data() + offset, sizeof(word));
+            return word;
+        }
+
+        std::array<uint8_t, N> _bytes{};
+    };
+
+    using Miscselect = FixedBytes<4>;
+    using SgxAttributes = FixedBytes<16>;
+    using MrSigner = FixedBytes<32>;
+    using TdxModuleAttributes = FixedBytes<8>;
+    using MrSignerSeam = FixedBytes<48>;
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser {
+
+#endif // SGX_DCAP_PARSERS_FIXED_BYTES_H_
@@ -35,9 +35,11 @@
 #include <rapidjson/fwd.h>
 #include <rapidjson/document.h>
 
+#include <ctime>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <ctime>
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
 
@@ -62,9 +64,20 @@ public:
     std::pair<int, ParseStatus> getIntFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName) const;
 
 private:
-    bool isValidHexstring(const std::string& hexString) const;
+    // DOM and its parse stack share a pool allocator, values are still plain rapidjson::Value
+    using ScratchDocument = rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>,
+                                                       rapidjson::MemoryPoolAllocator<>>;
+
+    // document placed in a per-thread scratch buffer, created only when something gets parsed
+    struct Arena;
+    struct ArenaDeleter
+    {
+        void operator()(Arena* allocated) const noexcept;
+    };
+
+    bool isValidHexstring(std::string_view hexString) const;
 
-    rapidjson::Document jsonDocument;
+    std::unique_ptr<Arena, ArenaDeleter> arena;
 };
 
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
@@ -278,7 +278,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
     {
         LOG_AND_THROW(InvalidExtensionException, "Could not parse [signature] field of TCB info JSON to bytes");
     }
-    _signature = hexStringToBytes(signatureField->GetString());
+    _signature = hexStringToBytes({signatureField->GetString(), signatureField->GetStringLength()});
 
     if(!tcbInfo->HasMember("tcbLevels"))
     {
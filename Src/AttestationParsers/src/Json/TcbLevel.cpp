@@ -335,10 +335,9 @@ void TcbLevel::setTcbComponents(const rapidjson::Value &tcb) {
     _sgxTcbComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
     _cpuSvnComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
     for (auto itr = sgxComponentsArray.Begin(); itr != sgxComponentsArray.End(); ++itr) {
-        auto component = TcbComponent(*itr);
-        _sgxTcbComponents.push_back(component);
+        _sgxTcbComponents.push_back(TcbComponent(*itr));
         // backward compatibility
-        _cpuSvnComponents.push_back(component.getSvn());
+        _cpuSvnComponents.push_back(_sgxTcbComponents.back().getSvn());
     }
 
     if(_id == TcbInfo::TDX_ID)
@@ -359,8 +358,7 @@ void TcbLevel::setTcbComponents(const rapidjson::Value &tcb) {
         _tdxTcbComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
 
         for (auto itr = tdxComponentsArray.Begin(); itr != tdxComponentsArray.End(); ++itr) {
-            auto component = TcbComponent(*itr);
-            _tdxTcbComponents.push_back(component);
+            _tdxTcbComponents.push_back(TcbComponent(*itr));
         }
     }
 }
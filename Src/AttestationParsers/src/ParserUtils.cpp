@@ -107,10 +107,7 @@ std::string x509NameToString(const X509_NAME* name)
 
     // dataStart ptr is not null terminated
     // we need to rely on returned size
-    std::string ret;
-    std::copy_n(dataStart, nameLength, std::back_inserter(ret));
-
-    return ret;
+    return std::string(dataStart, static_cast<size_t>(nameLength));
 }
 
 std::string getNameEntry(X509_NAME* name, int nid)
@@ -177,11 +174,7 @@ std::string getNameEntry(X509_NAME* name, int nid)
     }
 
 
-    std::string ret;
-    const auto staticCaster = [](unsigned char chr){ return static_cast<char>(chr); };
-    std::transform(strBuff.get(), strBuff.get() + len, std::back_inserter(ret), staticCaster);
-
-    return ret;
+    return std::string(reinterpret_cast<const char*>(strBuff.get()), static_cast<size_t>(len));
 }
 
 // Converts ASN1_TIME to time_t using ASN1_TIME_diff to get number of seconds from 1 Jan 1970
@@ -191,6 +184,19 @@ std::time_t asn1TimeToTimet(
     static_assert(sizeof(std::time_t) >= sizeof(int64_t), "std::time_t size too small, the dates may overflow");
     static constexpr int64_t SECONDS_IN_A_DAY = 24 * 60 * 60;
 
+    // RFC 5280 profile times are converted directly, other encodings go through OpenSSL
+    const auto type = ASN1_STRING_type(asn1Time);
+    if(type == V_ASN1_UTCTIME || type == V_ASN1_GENERALIZEDTIME)
+    {
+        const std::string_view content(reinterpret_cast<const char*>(ASN1_STRING_get0_data(asn1Time)),
+                                       static_cast<size_t>(ASN1_STRING_length(asn1Time)));
+        time_t converted = 0;
+        if(parseAsn1Time(content, type == V_ASN1_GENERALIZEDTIME, converted))
+        {
+            return converted;
+        }
+    }
+
     int pday;
     int psec;
     auto from = crypto::make_unique(ASN1_TIME_new());
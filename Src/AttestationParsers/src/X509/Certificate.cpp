@@ -33,6 +33,7 @@
 
 #include "X509Constants.h"
 #include "ParserUtils.h"
+#include "PemDecoder.h"
 #include "Utils/Logger.h"
 
 #include <OpensslHelpers/OpensslTypes.h>
@@ -121,25 +122,50 @@ const std::string &Certificate::getCrlDistributionPoint() const {
     return _crlDistributionPoint;
 }
 
-Certificate Certificate::parse(const std::string& pem)
+Certificate Certificate::parse(std::string_view pem)
 {
     return Certificate(pem);
 }
 
-// Protected
+Certificate Certificate::parse(const std::string& pem)
+{
+    return parse(std::string_view(pem));
+}
 
-Certificate::Certificate(const std::string &pem)
+namespace {
+
+crypto::X509_uptr readX509(std::string_view pemCertificate)
 {
-    _pem = pem;
-    crypto::BIO_uptr bio(BIO_new(BIO_s_mem()), ::BIO_free_all);
-    BIO_puts(bio.get(), pem.c_str());
+    // Plain PEM is decoded in place, anything unusual (headers, other armor) is left to OpenSSL
+    std::vector<uint8_t> der;
+    if (pem::certificateToDer(pemCertificate, der))
+    {
+        const uint8_t *derPtr = der.data();
+        auto x509 = crypto::make_unique(d2i_X509(nullptr, &derPtr, static_cast<long>(der.size())));
+        if (x509)
+        {
+            return x509;
+        }
+        ERR_clear_error();
+    }
 
+    crypto::BIO_uptr bio(BIO_new_mem_buf(pemCertificate.data(), static_cast<int>(pemCertificate.size())), ::BIO_free_all);
     auto x509 = crypto::make_unique(PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr));
     if (!x509) {
         auto err = getLastError();
-        LOG_ERROR("Parsing certificate failed: {}, PEM: {}", err, pem);
+        LOG_ERROR("Parsing certificate failed: {}, PEM: {}", err, pemCertificate);
         throw FormatException("PEM_read_bio_X509 failed " + err);
     }
+    return x509;
+}
+
+} // anonymous namespace
+
+// Protected
+
+Certificate::Certificate(std::string_view pem): _pem(pem)
+{
+    auto x509 = readX509(pem);
 
     setPublicKey(x509.get());
     setInfo(x509.get());
@@ -153,6 +179,9 @@ Certificate::Certificate(const std::string &pem)
     setCrlDistributionPoint(x509.get());
 }
 
+Certificate::Certificate(const std::string& pem): Certificate(std::string_view(pem))
+{}
+
 // Private
 
 void Certificate::setInfo(X509 *x509)
@@ -252,15 +281,17 @@ void Certificate::setExtensions(const X509 *x509)
     std::generate(extensions.begin(), extensions.end(),
                   [&x509, &index]{ return Extension(X509_get_ext(x509, index++)); });
 
-    std::vector<int> expectedExtensions = constants::REQUIRED_X509_EXTENSIONS;
+    const auto isPresent = [&extensions](int nid) {
+        return std::any_of(extensions.cbegin(), extensions.cend(), [nid](const Extension& extension) { return extension.getNid() == nid; });
+    };
 
-    for (const auto& extension : extensions)
+    // list of missing extensions is built only for the error message
+    const auto& requiredExtensions = constants::REQUIRED_X509_EXTENSIONS;
+    if (!std::all_of(requiredExtensions.cbegin(), requiredExtensions.cend(), isPresent))
     {
-        expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), extension.getNid()), expectedExtensions.end());
-    }
+        std::vector<int> expectedExtensions;
+        std::remove_copy_if(requiredExtensions.cbegin(), requiredExtensions.cend(), std::back_inserter(expectedExtensions), isPresent);
 
-    if (!expectedExtensions.empty())
-    {
         std::string err = "Required Certificate extensions not found. Missing [";
 
         // Convert all but the last element to avoid a trailing ","
@@ -31,17 +31,6 @@
 
 #include "SgxEcdsaAttestation/AttestationParsers.h"
 
-#include "X509Constants.h"
-#include "ParserUtils.h"
-#include "OpensslHelpers/OpensslTypes.h"
-#include "OpensslHelpers/OidUtils.h"
-#include "Utils/Logger.h"
-
-#include <openssl/asn1.h>
-
-#include <algorithm>
-
-
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
 Configuration::Configuration(
@@ -75,71 +64,4 @@ bool Configuration::operator ==(const Configuration& other) const
             _smtEnabled == other._smtEnabled;
 }
 
-// Private
-
-Configuration::Configuration(const ASN1_TYPE *configurationSeq)
-{
-    crypto::validateOid(oids::CONFIGURATION, configurationSeq, V_ASN1_SEQUENCE);
-
-    const auto stack = crypto::oidToStack(configurationSeq);
-    const auto stackEntries = sk_ASN1_TYPE_num(stack.get());
-
-    std::vector<Extension::Type> expectedExtensions = constants::CONFIGURATION_REQUIRED_SGX_EXTENSIONS;
-
-    // Iterate through SGX Configuration Extensions stored as sequence(tuple) of OIDName and OIDValue
-    for (int i=0; i < stackEntries; i++)
-    {
-        const auto oidTupleWrapper = sk_ASN1_TYPE_value(stack.get(), i);
-        crypto::validateOid(oids::CONFIGURATION, oidTupleWrapper, V_ASN1_SEQUENCE);
-
-        const auto oidTuple = crypto::oidToStack(oidTupleWrapper);
-        const auto oidTupleEntries = sk_ASN1_TYPE_num(oidTuple.get());
-        if (oidTupleEntries != 2)
-        {
-            std::string err = "OID tuple [" + oids::CONFIGURATION + "] expected number of elements is [2] given [" +
-                              std::to_string(oidTupleEntries) + "]";
-            LOG_AND_THROW(InvalidExtensionException, err);
-        }
-
-        const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
-        crypto::validateOid(oids::CONFIGURATION, oidName, V_ASN1_OBJECT);
-
-        const auto oidValue = sk_ASN1_TYPE_value(oidTuple.get(), 1);
-        const auto oidNameStr = obj2Str(oidName->value.object);
-
-        if (oidNameStr == oids::DYNAMIC_PLATFORM) // TODO DRY
-        {
-            crypto::validateOid(oids::DYNAMIC_PLATFORM, oidValue, V_ASN1_BOOLEAN);
-            _dynamicPlatform = oidValue->value.boolean;
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::DYNAMIC_PLATFORM), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::CACHED_KEYS)
-        {
-            crypto::validateOid(oids::CACHED_KEYS, oidValue, V_ASN1_BOOLEAN);
-            _cachedKeys = oidValue->value.boolean;
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::CACHED_KEYS), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::SMT_ENABLED)
-        {
-            crypto::validateOid(oids::SMT_ENABLED, oidValue, V_ASN1_BOOLEAN);
-            _smtEnabled = oidValue->value.boolean;
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::SMT_ENABLED), expectedExtensions.end());
-        }
-    }
-
-    if (!expectedExtensions.empty())
-    {
-        std::string err = "Required Configuration SGX extensions not found. Missing [";
-
-        // Convert all but the last element to avoid a trailing ","
-        std::for_each(expectedExtensions.begin(), expectedExtensions.end() - 1, [&err](const auto& extension) {
-            err += oids::type2Description(extension) + ", ";
-        });
-
-        // Now add the last element with no delimiter
-        err += oids::type2Description(expectedExtensions.back()) + "]";
-        LOG_AND_THROW(InvalidExtensionException,err);
-    }
-}
-
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
@@ -32,20 +32,16 @@
 #include "SgxEcdsaAttestation/AttestationParsers.h"
 
 #include "ParserUtils.h"
-#include "X509Constants.h"
-#include "OpensslHelpers/OidUtils.h"
+#include "SgxExtensionParser.h"
 #include "Utils/Logger.h"
 
 #include <algorithm> // find_if
 
-#include <openssl/asn1.h>
-
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
 PckCertificate::PckCertificate(const Certificate& certificate): Certificate(certificate)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    setMembers(getSgxExtension());
 }
 
 const std::vector<uint8_t>& PckCertificate::getPpid() const
@@ -92,11 +88,10 @@ PckCertificate PckCertificate::parse(const std::string& pem)
 
 PckCertificate::PckCertificate(const std::string& pem): Certificate(pem)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    setMembers(getSgxExtension());
 }
 
-stack_st_ASN1_TYPE* PckCertificate::getSgxExtensions()
+const Extension& PckCertificate::getSgxExtension() const
 {
     const auto sgxExtension = std::find_if(_extensions.begin(), _extensions.end(),
                                            [](const Extension &ext) { return ext.getNid() == NID_undef && ext.getName() == oids::SGX_EXTENSION; });
@@ -107,100 +102,31 @@ stack_st_ASN1_TYPE* PckCertificate::getSgxExtensions()
         LOG_AND_THROW(InvalidExtensionException, "Certificate is missing SGX Extensions OID[" + oids::SGX_EXTENSION + "]");
     }
 
-    // WARNING! Using this temporary pointer is mandatory!
-    const auto *dtPtr = sgxExtension->getValue().data();
-    const auto topSequence = crypto::make_unique(
-            d2i_ASN1_TYPE(nullptr, &dtPtr, static_cast<long>(sgxExtension->getValue().size())));
-
-    if(!topSequence)
-    {
-        auto err = "d2i_ASN1_TYPE cannot parse data to correct type " + getLastError();
-        LOG_AND_THROW(InvalidExtensionException, err);
-    }
-
-    crypto::validateOid(oids::SGX_EXTENSION, topSequence.get(), V_ASN1_SEQUENCE);
-
-    return crypto::oidToStack(topSequence.get()).release();
+    return *sgxExtension;
 }
 
-void PckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
+void PckCertificate::setMembers(const Extension& sgxExtension)
 {
-    const auto stackEntries = sk_ASN1_TYPE_num(sgxExtensions);
-    if(stackEntries != PROCESSOR_CA_EXTENSION_COUNT && stackEntries != PLATFORM_CA_EXTENSION_COUNT)
+    const auto& value = sgxExtension.getValue();
+
+    const auto entries = countSgxExtensionElements(value.data(), value.size());
+    if(entries != PROCESSOR_CA_EXTENSION_COUNT && entries != PLATFORM_CA_EXTENSION_COUNT)
     {
         std::string err = "OID [" + oids::SGX_EXTENSION + "] expected to contain [" +
                 std::to_string(PROCESSOR_CA_EXTENSION_COUNT) + "] or [" + std::to_string(PLATFORM_CA_EXTENSION_COUNT) +
-                "] elements when given [" + std::to_string(stackEntries) + "]";
+                "] elements when given [" + std::to_string(entries) + "]";
         LOG_AND_THROW(InvalidExtensionException,err);
     }
 
-    std::vector<Extension::Type> expectedExtensions = constants::PCK_REQUIRED_SGX_EXTENSIONS;
+    const auto extension = parsePckSgxExtension(value.data(), value.size());
 
-    // Iterate through SGX Extensions stored as sequence(tuple) of OIDName and OIDValue
-    for (int i=0; i < stackEntries; i++)
-    {
-        const auto oidTupleWrapper = sk_ASN1_TYPE_value(sgxExtensions, i);
-        crypto::validateOid(oids::SGX_EXTENSION, oidTupleWrapper, V_ASN1_SEQUENCE);
-
-        const auto oidTuple = crypto::oidToStack(oidTupleWrapper);
-        const auto oidTupleEntries = sk_ASN1_TYPE_num(oidTuple.get());
-        if (oidTupleEntries != 2)
-        {
-            std::string err = "OID tuple [" + oids::SGX_EXTENSION + "] expected number of elements is [2] given [" +
-                               std::to_string(oidTupleEntries) + "]";
-            LOG_AND_THROW(InvalidExtensionException, err);
-        }
-
-        const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
-        crypto::validateOid(oids::SGX_EXTENSION, oidName, V_ASN1_OBJECT);
-        
-        const auto oidValue = sk_ASN1_TYPE_value(oidTuple.get(), 1);
-        const auto oidNameStr = obj2Str(oidName->value.object);
-
-        if (oidNameStr == oids::PPID) // TODO DRY
-        {
-            crypto::validateOid(oids::PPID, oidValue, V_ASN1_OCTET_STRING, constants::PPID_BYTE_LEN);
-            _ppid = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::PPID), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::TCB)
-        {
-            _tcb = Tcb(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::TCB), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::PCEID)
-        {
-            crypto::validateOid(oids::PCEID, oidValue, V_ASN1_OCTET_STRING, constants::PCEID_BYTE_LEN);
-            _pceId = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::PCEID), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::FMSPC)
-        {
-            crypto::validateOid(oids::FMSPC, oidValue, V_ASN1_OCTET_STRING, constants::FMSPC_BYTE_LEN);
-            _fmspc = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::FMSPC), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::SGX_TYPE)
-        {
-            crypto::validateOid(oids::SGX_TYPE, oidValue, V_ASN1_ENUMERATED);
-            _sgxType = static_cast<SgxType>(crypto::oidToEnum(oidValue));
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::SGX_TYPE), expectedExtensions.end());
-        }
-    }
-
-    if (!expectedExtensions.empty())
-    {
-        std::string err = "Required PCK SGX extensions not found. Missing [";
-
-        // Convert all but the last element to avoid a trailing ","
-        std::for_each(expectedExtensions.begin(), expectedExtensions.end() - 1, [&err](const auto& extension) {
-            err += oids::type2Description(extension) + ", ";
-        });
-
-        // Now add the last element with no delimiter
-        err += oids::type2Description(expectedExtensions.back()) + "]";
-        LOG_AND_THROW(InvalidExtensionException, err);
-    }
+    _ppid.assign(extension.ppid.begin(), extension.ppid.end());
+    _pceId.assign(extension.pceId.begin(), extension.pceId.end());
+    _fmspc.assign(extension.fmspc.begin(), extension.fmspc.end());
+    _sgxType = static_cast<SgxType>(extension.sgxType);
+    _tcb._cpuSvn.assign(extension.cpuSvn.begin(), extension.cpuSvn.end());
+    _tcb._cpuSvnComponents.assign(extension.cpuSvnComponents.begin(), extension.cpuSvnComponents.end());
+    _tcb._pceSvn = extension.pceSvn;
 }
 
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
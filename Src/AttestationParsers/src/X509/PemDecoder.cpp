@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "PemDecoder.h"
+
+#include <array>
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 { namespace pem {
+
+namespace {
+
+constexpr std::string_view BEGIN_CERTIFICATE = "-----BEGIN CERTIFICATE-----";
+constexpr std::string_view END_CERTIFICATE = "-----END CERTIFICATE-----";
+constexpr std::string_view BEGIN_MARKER = "-----BEGIN ";
+
+constexpr uint8_t INVALID = 0x80;
+constexpr uint8_t WHITESPACE = 0x81;
+constexpr uint8_t PADDING = 0x82;
+// every table entry other than 6-bit value has this bit set
+constexpr uint8_t NOT_DATA = 0x80;
+
+constexpr std::array<uint8_t, 256> makeDecodeTable()
+{
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table)
+    {
+        entry = INVALID;
+    }
+    constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (size_t i = 0; i < alphabet.size(); i++)
+    {
+        table[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+    }
+    table[static_cast<uint8_t>(' ')] = WHITESPACE;
+    table[static_cast<uint8_t>('\t')] = WHITESPACE;
+    table[static_cast<uint8_t>('\r')] = WHITESPACE;
+    table[static_cast<uint8_t>('\n')] = WHITESPACE;
+    table[static_cast<uint8_t>('=')] = PADDING;
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> DECODE_TABLE = makeDecodeTable();
+
+uint8_t* writeTriple(uint8_t *out, uint32_t quantum)
+{
+    out[0] = static_cast<uint8_t>(quantum >> 16);
+    out[1] = static_cast<uint8_t>(quantum >> 8);
+    out[2] = static_cast<uint8_t>(quantum);
+    return out + 3;
+}
+
+bool isLineEnd(std::string_view text, size_t pos)
+{
+    return pos == text.size() || text[pos] == '\r' || text[pos] == '\n';
+}
+
+} // anonymous namespace
+
+bool decodeBase64(std::string_view encoded, std::vector<uint8_t>& decoded)
+{
+    const auto initialSize = decoded.size();
+    decoded.resize(initialSize + encoded.size() / 4 * 3);
+
+    const auto *in = reinterpret_cast<const uint8_t*>(encoded.data());
+    const auto *end = in + encoded.size();
+    uint8_t *out = decoded.data() + initialSize;
+
+    uint32_t quantum = 0;
+    unsigned sextets = 0;
+    unsigned padding = 0;
+
+    while (in != end)
+    {
+        // PEM lines are 64 characters long, so most of the input is decoded here
+        // four characters at a time with a single check for anything that is not data
+        if (sextets == 0 && padding == 0)
+        {
+            while (end - in >= 4)
+            {
+                const uint8_t a = DECODE_TABLE[in[0]];
+                const uint8_t b = DECODE_TABLE[in[1]];
+                const uint8_t c = DECODE_TABLE[in[2]];
+                const uint8_t d = DECODE_TABLE[in[3]];
+                if (((a | b | c | d) & NOT_DATA) != 0)
+                {
+                    break;
+                }
+                out = writeTriple(out, static_cast<uint32_t>(a) << 18 | static_cast<uint32_t>(b) << 12 |
+                                       static_cast<uint32_t>(c) << 6 | d);
+                in += 4;
+            }
+            if (in == end)
+            {
+                break;
+            }
+        }
+
+        const uint8_t value = DECODE_TABLE[*in++];
+        if (value == WHITESPACE)
+        {
+            continue;
+        }
+        if (value == PADDING)
+        {
+            padding++;
+            continue;
+        }
+        if (value == INVALID || padding != 0)
+        {
+            return false;
+        }
+
+        quantum = quantum << 6 | value;
+        if (++sextets == 4)
+        {
+            out = writeTriple(out, quantum);
+            quantum = 0;
+            sextets = 0;
+        }
+    }
+
+    // padding completes last quantum: two characters + "==" or three characters + "="
+    if (sextets + padding != 0 && (sextets < 2 || sextets + padding != 4))
+    {
+        return false;
+    }
+    if (sextets == 2)
+    {
+        *out++ = static_cast<uint8_t>(quantum >> 4);
+    }
+    if (sextets == 3)
+    {
+        *out++ = static_cast<uint8_t>(quantum >> 10);
+        *out++ = static_cast<uint8_t>(quantum >> 2);
+    }
+
+    decoded.resize(static_cast<size_t>(out - decoded.data()));
+    return true;
+}
+
+bool certificateToDer(std::string_view pem, std::vector<uint8_t>& der)
+{
+    // first armor line in the text has to be the certificate one and has to start a line
+    const auto begin = pem.find(BEGIN_MARKER);
+    if (begin == std::string_view::npos || (begin != 0 && pem[begin - 1] != '\n') ||
+        pem.compare(begin, BEGIN_CERTIFICATE.size(), BEGIN_CERTIFICATE) != 0 ||
+        isLineEnd(pem, begin + BEGIN_CERTIFICATE.size()) == false)
+    {
+        return false;
+    }
+
+    const auto bodyBegin = begin + BEGIN_CERTIFICATE.size();
+    const auto end = pem.find(END_CERTIFICATE, bodyBegin);
+    if (end == std::string_view::npos || pem[end - 1] != '\n' ||
+        isLineEnd(pem, end + END_CERTIFICATE.size()) == false)
+    {
+        return false;
+    }
+
+    der.clear();
+    return decodeBase64(pem.substr(bodyBegin, end - bodyBegin), der);
+}
+
+}}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 { namespace pem {
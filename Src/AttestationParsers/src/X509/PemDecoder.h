@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_PARSERS_PEM_DECODER_H
+#define SGX_DCAP_PARSERS_PEM_DECODER_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 { namespace pem {
+
+/**
+ * Decode base64 text, skipping line breaks and blanks between characters.
+ *
+ * @param encoded base64 text, padded to a multiple of four characters
+ * @param decoded decoded bytes are appended to this buffer
+ * @return false on characters outside of the base64 alphabet, missing or misplaced padding
+ */
+bool decodeBase64(std::string_view encoded, std::vector<uint8_t>& decoded);
+
+/**
+ * Extract DER of the first certificate from PEM text without going through a BIO.
+ *
+ * Only the plain form produced by PEM writers is handled: "-----BEGIN CERTIFICATE-----" line,
+ * base64 body without encapsulated headers and matching end line.
+ * Anything else is reported as unsupported and is expected to be handled by PEM_read_bio_X509,
+ * so both paths always agree on the accepted input.
+ *
+ * @param pem PEM text
+ * @param der decoded DER, content unspecified on failure
+ * @return false when input is not in the plain form or its body is not valid base64
+ */
+bool certificateToDer(std::string_view pem, std::vector<uint8_t>& der);
+
+}}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 { namespace pem {
+
+#endif // SGX_DCAP_PARSERS_PEM_DECODER_H
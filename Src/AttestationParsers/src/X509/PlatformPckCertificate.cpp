@@ -31,19 +31,15 @@
 
 #include "SgxEcdsaAttestation/AttestationParsers.h"
 
-#include "OpensslHelpers/OidUtils.h"
-#include "X509Constants.h"
 #include "ParserUtils.h"
+#include "SgxExtensionParser.h"
 #include "Utils/Logger.h"
 
-#include <algorithm> // find_if
-
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
 PlatformPckCertificate::PlatformPckCertificate(const Certificate& certificate): PckCertificate(certificate)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    setMembers(getSgxExtension());
 }
 
 bool PlatformPckCertificate::operator==(const PlatformPckCertificate& other) const
@@ -72,70 +68,28 @@ PlatformPckCertificate PlatformPckCertificate::parse(const std::string& pem)
 
 PlatformPckCertificate::PlatformPckCertificate(const std::string& pem): PckCertificate(pem)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    setMembers(getSgxExtension());
 }
 
 
-void PlatformPckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
+void PlatformPckCertificate::setMembers(const Extension& sgxExtension)
 {
-    PckCertificate::setMembers(sgxExtensions);
+    const auto& value = sgxExtension.getValue();
 
-    const auto stackEntries = sk_ASN1_TYPE_num(sgxExtensions);
-    if(stackEntries != PLATFORM_CA_EXTENSION_COUNT)
+    const auto entries = countSgxExtensionElements(value.data(), value.size());
+    if(entries != PLATFORM_CA_EXTENSION_COUNT)
     {
         std::string err = "OID [" + oids::SGX_EXTENSION + "] expected to contain [" + std::to_string(PLATFORM_CA_EXTENSION_COUNT) +
-                          "] elements when given [" + std::to_string(stackEntries) + "]";
+                          "] elements when given [" + std::to_string(entries) + "]";
         LOG_AND_THROW(InvalidExtensionException, err);
     }
 
-    std::vector<Extension::Type> expectedExtensions = constants::PLATFORM_PCK_REQUIRED_SGX_EXTENSIONS;
-
-    // Iterate through SGX Extensions stored as sequence(tuple) of OIDName and OIDValue
-    for (int i=0; i < stackEntries; i++) {
-        const auto oidTupleWrapper = sk_ASN1_TYPE_value(sgxExtensions, i);
-        crypto::validateOid(oids::SGX_EXTENSION, oidTupleWrapper, V_ASN1_SEQUENCE);
-
-        const auto oidTuple = crypto::oidToStack(oidTupleWrapper);
-        const auto oidTupleEntries = sk_ASN1_TYPE_num(oidTuple.get());
-        if (oidTupleEntries != 2) {
-            std::string err = "OID tuple [" + oids::SGX_EXTENSION + "] expected number of elements is [2] given [" +
-                              std::to_string(oidTupleEntries) + "]";
-            LOG_AND_THROW(InvalidExtensionException, err);
-        }
-
-        const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
-        const auto oidValue = sk_ASN1_TYPE_value(oidTuple.get(), 1);
-        const auto oidNameStr = obj2Str(oidName->value.object);
-
-        if (oidNameStr == oids::PLATFORM_INSTANCE_ID) {
-            crypto::validateOid(oids::PLATFORM_INSTANCE_ID, oidValue, V_ASN1_OCTET_STRING,
-                                constants::PLATFORM_INSTANCE_ID_LEN);
-            _platformInstanceId = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(),
-                                                 Extension::Type::PLATFORM_INSTANCE_ID), expectedExtensions.end());
-        } else if (oidNameStr == oids::CONFIGURATION) {
-            _configuration = Configuration(oidValue);
-            expectedExtensions.erase(
-                    std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::CONFIGURATION),
-                    expectedExtensions.end());
-        }
-    }
-
-    if (!expectedExtensions.empty())
-    {
-        std::string err = "Required PCK SGX extensions not found. Missing [";
-
-        // Convert all but the last element to avoid a trailing ","
-        std::for_each(expectedExtensions.begin(), expectedExtensions.end() - 1, [&err](const auto& extension) {
-            err += oids::type2Description(extension) + ", ";
-        });
-
-        // Now add the last element with no delimiter
-        err += oids::type2Description(expectedExtensions.back()) + "]";
+    const auto extension = parsePlatformSgxExtension(value.data(), value.size());
 
-        LOG_AND_THROW(InvalidExtensionException, err);
-    }
+    _platformInstanceId.assign(extension.platformInstanceId.begin(), extension.platformInstanceId.end());
+    _configuration._dynamicPlatform = extension.dynamicPlatform;
+    _configuration._cachedKeys = extension.cachedKeys;
+    _configuration._smtEnabled = extension.smtEnabled;
 }
 
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
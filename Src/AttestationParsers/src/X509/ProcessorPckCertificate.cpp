@@ -31,16 +31,15 @@
 
 #include "SgxEcdsaAttestation/AttestationParsers.h"
 
-#include "OpensslHelpers/OidUtils.h"
 #include "ParserUtils.h"
+#include "SgxExtensionParser.h"
 #include "Utils/Logger.h"
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
 ProcessorPckCertificate::ProcessorPckCertificate(const Certificate& certificate): PckCertificate(certificate)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    setMembers(getSgxExtension());
 }
 
 ProcessorPckCertificate ProcessorPckCertificate::parse(const std::string& pem)
@@ -52,20 +51,19 @@ ProcessorPckCertificate ProcessorPckCertificate::parse(const std::string& pem)
 
 ProcessorPckCertificate::ProcessorPckCertificate(const std::string& pem): PckCertificate(pem)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    setMembers(getSgxExtension());
 }
 
 
-void ProcessorPckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
+void ProcessorPckCertificate::setMembers(const Extension& sgxExtension)
 {
-    PckCertificate::setMembers(sgxExtensions);
+    const auto& value = sgxExtension.getValue();
 
-    const auto stackEntries = sk_ASN1_TYPE_num(sgxExtensions);
-    if(stackEntries != PROCESSOR_CA_EXTENSION_COUNT)
+    const auto entries = countSgxExtensionElements(value.data(), value.size());
+    if(entries != PROCESSOR_CA_EXTENSION_COUNT)
     {
         std::string err = "OID [" + oids::SGX_EXTENSION + "] expected to contain [" + std::to_string(PROCESSOR_CA_EXTENSION_COUNT) +
-                          "] elements when given [" + std::to_string(stackEntries) + "]";
+                          "] elements when given [" + std::to_string(entries) + "]";
         LOG_AND_THROW(InvalidExtensionException, err);
     }
 }
@@ -0,0 +1,570 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "SgxExtensionParser.h"
+
+#include "ParserUtils.h"
+#include "Utils/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
+
+namespace der {
+
+namespace {
+
+const uint8_t END_OF_CONTENTS = 0x00;
+const uint8_t BIT_STRING = 0x03;
+const uint8_t NULL_TYPE = 0x05;
+
+const uint8_t CLASS_MASK = 0xC0;
+const uint8_t CONSTRUCTED_MASK = 0x20;
+const uint8_t TAG_NUMBER_MASK = 0x1F;
+const uint8_t HIGH_TAG_NUMBER = 0x1F;
+const uint8_t SEQUENCE_TAG_NUMBER = 0x10;
+const uint8_t SET_TAG_NUMBER = 0x11;
+
+const uint8_t LONG_FORM_MASK = 0x80;
+const size_t MAX_TAG_BYTES = 4;
+const size_t MAX_LENGTH_BYTES = 4;
+
+bool isValidInteger(const uint8_t *value, size_t length)
+{
+    if (length == 0)
+    {
+        return false;
+    }
+    if (length == 1)
+    {
+        return true;
+    }
+
+    // leading byte is redundant when first nine bits are all zeros or all ones
+    const bool redundantZero = value[0] == 0x00 && (value[1] & 0x80) == 0;
+    const bool redundantOne = value[0] == 0xFF && (value[1] & 0x80) != 0;
+    return !redundantZero && !redundantOne;
+}
+
+bool isValidObject(const uint8_t *value, size_t length)
+{
+    if (length == 0 || (value[length - 1] & 0x80) != 0)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        // subidentifier must not start with padding byte
+        if (value[i] == 0x80 && (i == 0 || (value[i - 1] & 0x80) == 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isValidContent(uint8_t tag, const uint8_t *value, size_t length)
+{
+    switch (tag)
+    {
+        case END_OF_CONTENTS:
+            return false;
+        case BOOLEAN:
+            return length == 1;
+        case INTEGER:
+        case ENUMERATED:
+            return isValidInteger(value, length);
+        case BIT_STRING:
+            return length > 0 && value[0] <= 7;
+        case NULL_TYPE:
+            return length == 0;
+        case OBJECT:
+            return isValidObject(value, length);
+        default:
+            break;
+    }
+
+    const uint8_t tagNumber = tag & TAG_NUMBER_MASK;
+    if ((tag & CLASS_MASK) != 0 || tagNumber == HIGH_TAG_NUMBER)
+    {
+        return true;
+    }
+
+    // universal types other than SEQUENCE and SET have to use primitive encoding
+    const bool constructed = (tag & CONSTRUCTED_MASK) != 0;
+    return constructed == (tagNumber == SEQUENCE_TAG_NUMBER || tagNumber == SET_TAG_NUMBER);
+}
+
+} // namespace
+
+Reader::Reader(const uint8_t *data, size_t length): _position(data), _end(data + length)
+{}
+
+Reader::Reader(const Element& constructed): Reader(constructed.value, constructed.length)
+{}
+
+bool Reader::empty() const
+{
+    return _position == _end;
+}
+
+bool Reader::read(Element& element)
+{
+    const uint8_t *position = _position;
+    if (position == _end)
+    {
+        return false;
+    }
+
+    const uint8_t tag = *position++;
+    if ((tag & TAG_NUMBER_MASK) == HIGH_TAG_NUMBER)
+    {
+        // tag number continues as long as the most significant bit is set,
+        // such tags never match any of the expected types so only its first byte is kept
+        size_t tagBytes = 0;
+        do
+        {
+            if (position == _end || ++tagBytes > MAX_TAG_BYTES)
+            {
+                return false;
+            }
+        } while ((*position++ & 0x80) != 0);
+    }
+
+    if (position == _end)
+    {
+        return false;
+    }
+
+    size_t length = *position++;
+    if ((length & LONG_FORM_MASK) != 0)
+    {
+        // zero length bytes means indefinite length which is not allowed in DER
+        const size_t lengthBytes = length & ~static_cast<size_t>(LONG_FORM_MASK);
+        if (lengthBytes == 0 || lengthBytes > MAX_LENGTH_BYTES ||
+            static_cast<size_t>(_end - position) < lengthBytes)
+        {
+            return false;
+        }
+
+        length = 0;
+        for (size_t i = 0; i < lengthBytes; i++)
+        {
+            length = (length << 8) | *position++;
+        }
+    }
+
+    if (static_cast<size_t>(_end - position) < length || !isValidContent(tag, position, length))
+    {
+        return false;
+    }
+
+    element.tag = tag;
+    element.value = position;
+    element.length = length;
+    _position = position + length;
+    return true;
+}
+
+Element Reader::next(const std::string& oidName)
+{
+    Element element;
+    if (!read(element))
+    {
+        std::string err = "OID [" + oidName + "] contains malformed DER element";
+        LOG_AND_THROW(FormatException, err);
+    }
+    return element;
+}
+
+} // namespace der
+
+namespace {
+
+// 1.2.840.113741.1.13.1
+const uint8_t SGX_EXTENSION_OID[] = { 0x2A, 0x86, 0x48, 0x86, 0xF8, 0x4D, 0x01, 0x0D, 0x01 };
+
+const uint8_t PPID_ARC = 1;
+const uint8_t TCB_ARC = 2;
+const uint8_t PCEID_ARC = 3;
+const uint8_t FMSPC_ARC = 4;
+const uint8_t SGX_TYPE_ARC = 5;
+const uint8_t PLATFORM_INSTANCE_ID_ARC = 6;
+const uint8_t CONFIGURATION_ARC = 7;
+
+const uint8_t DYNAMIC_PLATFORM_ARC = 1;
+const uint8_t CACHED_KEYS_ARC = 2;
+const uint8_t SMT_ENABLED_ARC = 3;
+
+struct TcbEntry
+{
+    const std::string *oidName;
+    Extension::Type type;
+};
+
+// indexed by last arc of OIDs nested in TCB
+const TcbEntry TCB_ENTRIES[] = {
+    { nullptr,                   Extension::Type::NONE },
+    { &oids::SGX_TCB_COMP01_SVN, Extension::Type::SGX_TCB_COMP01_SVN },
+    { &oids::SGX_TCB_COMP02_SVN, Extension::Type::SGX_TCB_COMP02_SVN },
+    { &oids::SGX_TCB_COMP03_SVN, Extension::Type::SGX_TCB_COMP03_SVN },
+    { &oids::SGX_TCB_COMP04_SVN, Extension::Type::SGX_TCB_COMP04_SVN },
+    { &oids::SGX_TCB_COMP05_SVN, Extension::Type::SGX_TCB_COMP05_SVN },
+    { &oids::SGX_TCB_COMP06_SVN, Extension::Type::SGX_TCB_COMP06_SVN },
+    { &oids::SGX_TCB_COMP07_SVN, Extension::Type::SGX_TCB_COMP07_SVN },
+    { &oids::SGX_TCB_COMP08_SVN, Extension::Type::SGX_TCB_COMP08_SVN },
+    { &oids::SGX_TCB_COMP09_SVN, Extension::Type::SGX_TCB_COMP09_SVN },
+    { &oids::SGX_TCB_COMP10_SVN, Extension::Type::SGX_TCB_COMP10_SVN },
+    { &oids::SGX_TCB_COMP11_SVN, Extension::Type::SGX_TCB_COMP11_SVN },
+    { &oids::SGX_TCB_COMP12_SVN, Extension::Type::SGX_TCB_COMP12_SVN },
+    { &oids::SGX_TCB_COMP13_SVN, Extension::Type::SGX_TCB_COMP13_SVN },
+    { &oids::SGX_TCB_COMP14_SVN, Extension::Type::SGX_TCB_COMP14_SVN },
+    { &oids::SGX_TCB_COMP15_SVN, Extension::Type::SGX_TCB_COMP15_SVN },
+    { &oids::SGX_TCB_COMP16_SVN, Extension::Type::SGX_TCB_COMP16_SVN },
+    { &oids::PCESVN,             Extension::Type::PCESVN },
+    { &oids::CPUSVN,             Extension::Type::CPUSVN }
+};
+
+const uint8_t PCESVN_ARC = 17;
+const uint8_t CPUSVN_ARC = 18;
+
+uint32_t bit(Extension::Type type)
+{
+    return 1u << static_cast<uint32_t>(type);
+}
+
+// Last arc of OID placed directly under SGX Extension or 0 for any other OID
+uint8_t sgxArc(const der::Element& oid)
+{
+    if (oid.length != sizeof(SGX_EXTENSION_OID) + 1 ||
+        std::memcmp(oid.value, SGX_EXTENSION_OID, sizeof(SGX_EXTENSION_OID)) != 0)
+    {
+        return 0;
+    }
+    return oid.value[sizeof(SGX_EXTENSION_OID)];
+}
+
+// Last arc of OID placed under given child of SGX Extension or 0 for any other OID
+uint8_t sgxArc(const der::Element& oid, uint8_t parentArc)
+{
+    if (oid.length != sizeof(SGX_EXTENSION_OID) + 2 ||
+        std::memcmp(oid.value, SGX_EXTENSION_OID, sizeof(SGX_EXTENSION_OID)) != 0 ||
+        oid.value[sizeof(SGX_EXTENSION_OID)] != parentArc)
+    {
+        return 0;
+    }
+    return oid.value[sizeof(SGX_EXTENSION_OID) + 1];
+}
+
+void validateType(const std::string& oidName, const der::Element& element, uint8_t expectedTag)
+{
+    if (element.tag != expectedTag)
+    {
+        std::string err = "OID [" + oidName + "] type expected [" + std::to_string(expectedTag & 0x1F) +
+                          "] given [" + std::to_string(element.tag & 0x1F) + "]";
+        LOG_AND_THROW(FormatException, err);
+    }
+}
+
+template<size_t N>
+void copyOctetString(const std::string& oidName, const der::Element& value, std::array<uint8_t, N>& output)
+{
+    validateType(oidName, value, der::OCTET_STRING);
+    if (value.length != N)
+    {
+        std::string err = "OID [" + oidName + "] length expected [" + std::to_string(N) + "] given [" +
+                          std::to_string(value.length) + "]";
+        LOG_AND_THROW(FormatException, err);
+    }
+    std::copy_n(value.value, N, output.begin());
+}
+
+// Same result as ASN1_INTEGER_get, values not fitting in 64 bits are returned as -1
+int64_t toInt64(const der::Element& integer)
+{
+    if (integer.length > sizeof(int64_t))
+    {
+        return -1;
+    }
+
+    uint64_t value = (integer.value[0] & 0x80) != 0 ? ~uint64_t{0} : 0;
+    for (size_t i = 0; i < integer.length; i++)
+    {
+        value = (value << 8) | integer.value[i];
+    }
+    return static_cast<int64_t>(value);
+}
+
+size_t countElements(const std::string& oidName, const der::Element& sequence)
+{
+    der::Reader reader(sequence);
+    size_t count = 0;
+    while (!reader.empty())
+    {
+        reader.next(oidName);
+        count++;
+    }
+    return count;
+}
+
+// SGX Extension entries are stored as sequence(tuple) of OIDName and OIDValue
+void readTuple(const std::string& oidName, const der::Element& tuple, der::Element& name, der::Element& value)
+{
+    validateType(oidName, tuple, der::SEQUENCE);
+
+    der::Reader reader(tuple);
+    size_t entries = 0;
+    while (!reader.empty())
+    {
+        const auto element = reader.next(oidName);
+        if (entries == 0)
+        {
+            name = element;
+        }
+        else if (entries == 1)
+        {
+            value = element;
+        }
+        entries++;
+    }
+
+    if (entries != 2)
+    {
+        std::string err = "OID tuple [" + oidName + "] expected number of elements is [2] given [" +
+                          std::to_string(entries) + "]";
+        LOG_AND_THROW(InvalidExtensionException, err);
+    }
+
+    validateType(oidName, name, der::OBJECT);
+}
+
+void throwIfMissing(const std::vector<Extension::Type>& required, uint32_t found, const std::string& extensionsName)
+{
+    std::string missing;
+    for (const auto type : required)
+    {
+        if ((found & bit(type)) == 0)
+        {
+            missing += (missing.empty() ? "" : ", ") + oids::type2Description(type);
+        }
+    }
+
+    if (!missing.empty())
+    {
+        std::string err = "Required " + extensionsName + " SGX extensions not found. Missing [" + missing + "]";
+        LOG_AND_THROW(InvalidExtensionException, err);
+    }
+}
+
+der::Element readSgxExtension(const uint8_t *data, size_t length)
+{
+    der::Reader reader(data, length);
+    der::Element sgxExtension;
+    if (!reader.read(sgxExtension))
+    {
+        std::string err = "SGX Extension OID[" + oids::SGX_EXTENSION + "] cannot be decoded";
+        LOG_AND_THROW(InvalidExtensionException, err);
+    }
+
+    validateType(oids::SGX_EXTENSION, sgxExtension, der::SEQUENCE);
+    return sgxExtension;
+}
+
+void parseTcb(const der::Element& tcb, PckSgxExtension& extension)
+{
+    validateType(oids::TCB, tcb, der::SEQUENCE);
+
+    const auto entries = countElements(oids::TCB, tcb);
+    if (entries != constants::TCB_SEQUENCE_LEN)
+    {
+        std::string err = "TCB length expected [" + std::to_string(constants::TCB_SEQUENCE_LEN) + "] given [" +
+                          std::to_string(entries) + "]";
+        LOG_AND_THROW(InvalidExtensionException, err);
+    }
+
+    uint32_t found = 0;
+    der::Reader reader(tcb);
+    while (!reader.empty())
+    {
+        der::Element name;
+        der::Element value;
+        readTuple(oids::TCB, reader.next(oids::TCB), name, value);
+
+        const auto arc = sgxArc(name, TCB_ARC);
+        if (arc == 0 || arc > CPUSVN_ARC)
+        {
+            continue;
+        }
+
+        const auto& entry = TCB_ENTRIES[arc];
+        if (arc == CPUSVN_ARC)
+        {
+            copyOctetString(*entry.oidName, value, extension.cpuSvn);
+        }
+        else
+        {
+            validateType(*entry.oidName, value, der::INTEGER);
+            if (arc == PCESVN_ARC)
+            {
+                extension.pceSvn = static_cast<uint32_t>(toInt64(value));
+            }
+            else
+            {
+                extension.cpuSvnComponents[arc - 1u] = static_cast<uint8_t>(toInt64(value));
+            }
+        }
+        found |= bit(entry.type);
+    }
+
+    throwIfMissing(constants::TCB_REQUIRED_SGX_EXTENSIONS, found, "TCB");
+}
+
+void parseConfiguration(const der::Element& configuration, PlatformSgxExtension& extension)
+{
+    validateType(oids::CONFIGURATION, configuration, der::SEQUENCE);
+
+    uint32_t found = 0;
+    der::Reader reader(configuration);
+    while (!reader.empty())
+    {
+        der::Element name;
+        der::Element value;
+        readTuple(oids::CONFIGURATION, reader.next(oids::CONFIGURATION), name, value);
+
+        switch (sgxArc(name, CONFIGURATION_ARC))
+        {
+            case DYNAMIC_PLATFORM_ARC:
+                validateType(oids::DYNAMIC_PLATFORM, value, der::BOOLEAN);
+                extension.dynamicPlatform = value.value[0] != 0;
+                found |= bit(Extension::Type::DYNAMIC_PLATFORM);
+                break;
+            case CACHED_KEYS_ARC:
+                validateType(oids::CACHED_KEYS, value, der::BOOLEAN);
+                extension.cachedKeys = value.value[0] != 0;
+                found |= bit(Extension::Type::CACHED_KEYS);
+                break;
+            case SMT_ENABLED_ARC:
+                validateType(oids::SMT_ENABLED, value, der::BOOLEAN);
+                extension.smtEnabled = value.value[0] != 0;
+                found |= bit(Extension::Type::SMT_ENABLED);
+                break;
+            default:
+                break;
+        }
+    }
+
+    throwIfMissing(constants::CONFIGURATION_REQUIRED_SGX_EXTENSIONS, found, "Configuration");
+}
+
+} // namespace
+
+PckSgxExtension parsePckSgxExtension(const uint8_t *data, size_t length)
+{
+    PckSgxExtension extension;
+    uint32_t found = 0;
+
+    der::Reader reader(readSgxExtension(data, length));
+    while (!reader.empty())
+    {
+        der::Element name;
+        der::Element value;
+        readTuple(oids::SGX_EXTENSION, reader.next(oids::SGX_EXTENSION), name, value);
+
+        switch (sgxArc(name))
+        {
+            case PPID_ARC:
+                copyOctetString(oids::PPID, value, extension.ppid);
+                found |= bit(Extension::Type::PPID);
+                break;
+            case TCB_ARC:
+                parseTcb(value, extension);
+                found |= bit(Extension::Type::TCB);
+                break;
+            case PCEID_ARC:
+                copyOctetString(oids::PCEID, value, extension.pceId);
+                found |= bit(Extension::Type::PCEID);
+                break;
+            case FMSPC_ARC:
+                copyOctetString(oids::FMSPC, value, extension.fmspc);
+                found |= bit(Extension::Type::FMSPC);
+                break;
+            case SGX_TYPE_ARC:
+                validateType(oids::SGX_TYPE, value, der::ENUMERATED);
+                extension.sgxType = static_cast<int>(toInt64(value));
+                found |= bit(Extension::Type::SGX_TYPE);
+                break;
+            default:
+                break;
+        }
+    }
+
+    throwIfMissing(constants::PCK_REQUIRED_SGX_EXTENSIONS, found, "PCK");
+    return extension;
+}
+
+size_t countSgxExtensionElements(const uint8_t *data, size_t length)
+{
+    return countElements(oids::SGX_EXTENSION, readSgxExtension(data, length));
+}
+
+PlatformSgxExtension parsePlatformSgxExtension(const uint8_t *data, size_t length)
+{
+    PlatformSgxExtension extension;
+    uint32_t found = 0;
+
+    der::Reader reader(readSgxExtension(data, length));
+    while (!reader.empty())
+    {
+        der::Element name;
+        der::Element value;
+        readTuple(oids::SGX_EXTENSION, reader.next(oids::SGX_EXTENSION), name, value);
+
+        switch (sgxArc(name))
+        {
+            case PLATFORM_INSTANCE_ID_ARC:
+                copyOctetString(oids::PLATFORM_INSTANCE_ID, value, extension.platformInstanceId);
+                found |= bit(Extension::Type::PLATFORM_INSTANCE_ID);
+                break;
+            case CONFIGURATION_ARC:
+                parseConfiguration(value, extension);
+                found |= bit(Extension::Type::CONFIGURATION);
+                break;
+            default:
+                break;
+        }
+    }
+
+    throwIfMissing(constants::PLATFORM_PCK_REQUIRED_SGX_EXTENSIONS, found, "PCK");
+    return extension;
+}
+
+}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
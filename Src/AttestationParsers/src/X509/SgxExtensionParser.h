@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_PARSERS_SGX_EXTENSION_PARSER_H
+#define SGX_DCAP_PARSERS_SGX_EXTENSION_PARSER_H
+
+#include "X509Constants.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
+
+namespace der {
+
+const uint8_t BOOLEAN = 0x01;
+const uint8_t INTEGER = 0x02;
+const uint8_t OCTET_STRING = 0x04;
+const uint8_t OBJECT = 0x06;
+const uint8_t ENUMERATED = 0x0A;
+const uint8_t SEQUENCE = 0x30;
+
+/**
+ * Single TLV element. Value points into the buffer the element was read from.
+ */
+struct Element
+{
+    uint8_t tag = 0;
+    const uint8_t *value = nullptr;
+    size_t length = 0;
+};
+
+/**
+ * Forward only, bounds checked reader over consecutive DER elements.
+ * Does not allocate nor copy any data.
+ */
+class Reader
+{
+public:
+    Reader(const uint8_t *data, size_t length);
+    explicit Reader(const Element& constructed);
+
+    bool empty() const;
+
+    /**
+     * Read next element
+     * @param element output element, untouched on failure
+     * @return false when element is truncated or its content is not valid for its universal type
+     */
+    bool read(Element& element);
+
+    /**
+     * Read next element
+     * @param oidName name of OID the element belongs to, used in error message
+     * @return next element
+     *
+     * @throws intel::sgx::dcap::parser::FormatException when element cannot be read
+     */
+    Element next(const std::string& oidName);
+
+private:
+    const uint8_t *_position;
+    const uint8_t *_end;
+};
+
+} // namespace der
+
+struct PckSgxExtension
+{
+    std::array<uint8_t, constants::PPID_BYTE_LEN> ppid{};
+    std::array<uint8_t, constants::PCEID_BYTE_LEN> pceId{};
+    std::array<uint8_t, constants::FMSPC_BYTE_LEN> fmspc{};
+    int sgxType = 0;
+    std::array<uint8_t, constants::CPUSVN_BYTE_LEN> cpuSvn{};
+    std::array<uint8_t, constants::CPUSVN_BYTE_LEN> cpuSvnComponents{};
+    uint32_t pceSvn = 0;
+};
+
+struct PlatformSgxExtension
+{
+    std::array<uint8_t, constants::PLATFORM_INSTANCE_ID_LEN> platformInstanceId{};
+    bool dynamicPlatform = true;
+    bool cachedKeys = true;
+    bool smtEnabled = true;
+};
+
+/**
+ * Decode fields common to all PCK certificates from DER encoded SGX Extension (OID 1.2.840.113741.1.13.1).
+ * OIDs are matched on their encoded bytes, elements of unknown OIDs are skipped.
+ *
+ * @param data DER encoded value of SGX Extension
+ * @param length length of data
+ * @return decoded fields
+ *
+ * @throws intel::sgx::dcap::parser::FormatException when element has unexpected type or length
+ * @throws intel::sgx::dcap::parser::InvalidExtensionException when required element is missing
+ */
+PckSgxExtension parsePckSgxExtension(const uint8_t *data, size_t length);
+
+/**
+ * Count top level elements of DER encoded SGX Extension without decoding them.
+ *
+ * @throws intel::sgx::dcap::parser::FormatException when extension is malformed
+ * @throws intel::sgx::dcap::parser::InvalidExtensionException when extension is not DER encoded
+ */
+size_t countSgxExtensionElements(const uint8_t *data, size_t length);
+
+/**
+ * Decode Platform Instance ID and Configuration from DER encoded SGX Extension of Platform PCK certificate.
+ *
+ * @throws intel::sgx::dcap::parser::FormatException when element has unexpected type or length
+ * @throws intel::sgx::dcap::parser::InvalidExtensionException when required element is missing
+ */
+PlatformSgxExtension parsePlatformSgxExtension(const uint8_t *data, size_t length);
+
+}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
+
+#endif // SGX_DCAP_PARSERS_SGX_EXTENSION_PARSER_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+#include "X509/SgxExtensionParser.h"
+#include "ParserUtils.h"
+
+#include "X509TestConstants.h"
+#include "X509CertGenerator.h"
+
+#include <benchmark/benchmark.h>
+#include <openssl/asn1.h>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::parser;
+
+namespace {
+
+struct PckCertificates
+{
+    std::string processorPem;
+    std::string platformPem;
+    Bytes platformSgxExtension;
+
+    PckCertificates()
+    {
+        test::X509CertGenerator certGenerator;
+        const Bytes sn(20, 0x40);
+        const Bytes ppid(16, 0xaa);
+        const Bytes cpusvn(16, 0x09);
+        const Bytes pcesvn = {0x03, 0xf2};
+        const Bytes pceId = {0x04, 0xf3};
+        const Bytes fmspc = {0x05, 0xf4, 0x44, 0x45, 0xaa, 0x00};
+        const Bytes platformInstanceId(16, 0x0a);
+
+        const auto keyInt = certGenerator.generateEcKeypair();
+        const auto key = certGenerator.generateEcKeypair();
+
+        const auto processorCert = certGenerator.generatePCKCert(2, sn, 0, 3600, key.get(), keyInt.get(),
+                                                                 parser::constants::PCK_SUBJECT, parser::constants::PLATFORM_CA_SUBJECT,
+                                                                 ppid, cpusvn, pcesvn, pceId, fmspc, 0);
+        const auto platformCert = certGenerator.generatePCKCert(2, sn, 0, 3600, key.get(), keyInt.get(),
+                                                                parser::constants::PCK_SUBJECT, parser::constants::PLATFORM_CA_SUBJECT,
+                                                                ppid, cpusvn, pcesvn, pceId, fmspc, 1, platformInstanceId,
+                                                                true, true, true);
+        processorPem = certGenerator.x509ToString(processorCert.get());
+        platformPem = certGenerator.x509ToString(platformCert.get());
+
+        const auto platformCertificate = x509::Certificate::parse(platformPem);
+        for (const auto& extension : platformCertificate.getExtensions())
+        {
+            if (extension.getName() == oids::SGX_EXTENSION)
+            {
+                platformSgxExtension = extension.getValue();
+            }
+        }
+    }
+};
+
+const PckCertificates& certificates()
+{
+    static const PckCertificates instance;
+    return instance;
+}
+
+// Generic OpenSSL decoding of every nested sequence, reference point for the DER walker
+int decodeWithAsn1Type(const ASN1_TYPE *sequence)
+{
+    const unsigned char *data = sequence->value.sequence->data;
+    auto stack = crypto::make_unique(d2i_ASN1_SEQUENCE_ANY(nullptr, &data, sequence->value.sequence->length));
+    int decoded = 0;
+    for (int i = 0; i < sk_ASN1_TYPE_num(stack.get()); i++)
+    {
+        const auto entry = sk_ASN1_TYPE_value(stack.get(), i);
+        decoded += entry->type == V_ASN1_SEQUENCE ? decodeWithAsn1Type(entry) : 1;
+    }
+    return decoded;
+}
+
+} // namespace
+
+static void BM_ProcessorPckCertificateParse(benchmark::State& state)
+{
+    const auto& pem = certificates().processorPem;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(x509::ProcessorPckCertificate::parse(pem));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessorPckCertificateParse);
+
+static void BM_PlatformPckCertificateParse(benchmark::State& state)
+{
+    const auto& pem = certificates().platformPem;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(x509::PlatformPckCertificate::parse(pem));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PlatformPckCertificateParse);
+
+static void BM_SgxExtensionDerWalker(benchmark::State& state)
+{
+    const auto& value = certificates().platformSgxExtension;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(x509::parsePckSgxExtension(value.data(), value.size()));
+        benchmark::DoNotOptimize(x509::parsePlatformSgxExtension(value.data(), value.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+}
+BENCHMARK(BM_SgxExtensionDerWalker);
+
+static void BM_SgxExtensionAsn1Type(benchmark::State& state)
+{
+    const auto& value = certificates().platformSgxExtension;
+    for (auto _ : state)
+    {
+        const unsigned char *data = value.data();
+        const auto topSequence = crypto::make_unique(d2i_ASN1_TYPE(nullptr, &data, static_cast<long>(value.size())));
+        benchmark::DoNotOptimize(decodeWithAsn1Type(topSequence.get()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+}
+BENCHMARK(BM_SgxExtensionAsn1Type);
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+#include "X509/PemDecoder.h"
+
+#include "X509TestConstants.h"
+#include "X509CertGenerator.h"
+
+#include <benchmark/benchmark.h>
+#include <openssl/pem.h>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::parser;
+
+namespace {
+
+const std::string& pemCertificate()
+{
+    static const std::string pem = [] {
+        test::X509CertGenerator certGenerator;
+        const auto key = certGenerator.generateEcKeypair();
+        const auto cert = certGenerator.generateCaCert(2, Bytes(20, 0x40), 0, 3600, key.get(), key.get(),
+                                                       constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+        return certGenerator.x509ToString(cert.get());
+    }();
+    return pem;
+}
+
+} // namespace
+
+static void BM_PemToDerInPlace(benchmark::State& state)
+{
+    const auto& pem = pemCertificate();
+    std::vector<uint8_t> der;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(x509::pem::certificateToDer(pem, der));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pem.size()));
+}
+BENCHMARK(BM_PemToDerInPlace);
+
+static void BM_PemToDerMemBio(benchmark::State& state)
+{
+    const auto& pem = pemCertificate();
+    for (auto _ : state)
+    {
+        auto bio = crypto::make_unique(BIO_new(BIO_s_mem()));
+        BIO_puts(bio.get(), pem.c_str());
+        unsigned char *data = nullptr;
+        long length = 0;
+        char *name = nullptr;
+        benchmark::DoNotOptimize(PEM_bytes_read_bio(&data, &length, &name, PEM_STRING_X509, bio.get(), nullptr, nullptr));
+        OPENSSL_free(data);
+        OPENSSL_free(name);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pem.size()));
+}
+BENCHMARK(BM_PemToDerMemBio);
+
+static void BM_CertificateParse(benchmark::State& state)
+{
+    const auto& pem = pemCertificate();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(x509::Certificate::parse(pem));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CertificateParse);
@@ -92,6 +92,14 @@ TEST_F(CertificateUT, certificateParse)
     ASSERT_NO_THROW(x509::Certificate::parse(pemRootCert));
 }
 
+TEST_F(CertificateUT, certificateParseOverloadsShouldAgree)
+{
+    const auto fromString = x509::Certificate::parse(pemPckCert);
+
+    ASSERT_EQ(fromString, x509::Certificate::parse(std::string_view(pemPckCert)));
+    ASSERT_EQ(fromString, x509::Certificate::parse(pemPckCert.c_str()));
+}
+
 TEST_F(CertificateUT, certificateConstructors)
 {
     const auto& certificate = x509::Certificate::parse(pemPckCert);
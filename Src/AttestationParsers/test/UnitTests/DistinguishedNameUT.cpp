@@ -77,4 +77,33 @@ TEST_F(DistinguishedNameUT, distinguishedNameOperators)
                                                                ORGANIZATION_NAME_ISSUER, "dummy"));
     ASSERT_NE(distinguishedNameIssuer, createDistinguishedName(RAW_ISSUER, COMMON_NAME_ISSUER, COUNTRY_NAME_ISSUER,
                                                                ORGANIZATION_NAME_ISSUER, LOCATION_NAME_ISSUER, "dummy"));
-}
\ No newline at end of file
+}
+
+TEST_F(DistinguishedNameUT, componentBoundariesAreKeptApart)
+{
+    const DistinguishedName first{"", "ab", "c", "", "", ""};
+    const DistinguishedName second{"", "a", "bc", "", "", ""};
+
+    ASSERT_NE(first, second);
+    ASSERT_EQ(first.getCommonName(), "ab");
+    ASSERT_EQ(second.getCountryName(), "bc");
+}
+
+TEST_F(DistinguishedNameUT, defaultConstructedNamesAreEqual)
+{
+    const DistinguishedName empty;
+
+    ASSERT_EQ(empty, DistinguishedName{});
+    ASSERT_EQ(empty, DistinguishedName("", "", "", "", "", ""));
+    ASSERT_TRUE(empty.getCommonName().empty());
+    ASSERT_TRUE(empty.getRaw().empty());
+}
+
+TEST_F(DistinguishedNameUT, movedFromNameStaysUsable)
+{
+    auto issuer = createDistinguishedName();
+    const auto moved = std::move(issuer);
+
+    ASSERT_EQ(moved, createDistinguishedName());
+    ASSERT_NO_THROW(issuer.getRaw().size());
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "SgxEcdsaAttestation/FixedBytes.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace intel::sgx::dcap::parser;
+
+TEST(FixedBytesUT, shouldAssignOnlyBuffersOfExactSize)
+{
+    FixedBytes<6> sixBytes;
+
+    EXPECT_TRUE(sixBytes.assign({0x00, 0x90, 0x6E, 0xA1, 0x00, 0x00}));
+    EXPECT_EQ(sixBytes.toVector(), std::vector<uint8_t>({0x00, 0x90, 0x6E, 0xA1, 0x00, 0x00}));
+
+    EXPECT_FALSE(sixBytes.assign({0x00, 0x90, 0x6E, 0xA1, 0x00}));
+    EXPECT_EQ(sixBytes, FixedBytes<6>());
+}
+
+TEST(FixedBytesUT, shouldCompareWithArraysOfSameSize)
+{
+    std::array<uint8_t, 48> bytes{};
+    bytes[47] = 0x01;
+    const MrSignerSeam mrSignerSeam(bytes);
+
+    EXPECT_TRUE(mrSignerSeam == bytes);
+    bytes[47] = 0x02;
+    EXPECT_TRUE(mrSignerSeam != bytes);
+    EXPECT_NE(mrSignerSeam, MrSignerSeam());
+}
+
+TEST(FixedBytesUT, shouldMatchMaskedValueOnEveryByteIncludingTail)
+{
+    // 16 bytes cover whole words only, 6 bytes are handled as tail only
+    const SgxAttributes attributes({0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+                                    0xE7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80});
+    const SgxAttributes mask({0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F,
+                              0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    const SgxAttributes expected({0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F,
+                                  0xE7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+
+    EXPECT_TRUE(attributes.matches(expected, mask));
+    EXPECT_FALSE(attributes.matches(attributes, mask));
+
+    const FixedBytes<6> sixBytes({0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC});
+    const FixedBytes<6> tailMask({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F});
+    EXPECT_TRUE(sixBytes.matches(FixedBytes<6>({0x12, 0x34, 0x56, 0x78, 0x9A, 0x0C}), tailMask));
+    EXPECT_FALSE(sixBytes.matches(FixedBytes<6>({0x12, 0x34, 0x56, 0x78, 0x9A, 0x0D}), tailMask));
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+#include "X509/PemDecoder.h"
+
+#include "X509TestConstants.h"
+#include "X509CertGenerator.h"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::parser;
+using namespace ::testing;
+
+namespace {
+
+std::string encodeBase64(const Bytes& data)
+{
+    std::string encoded(4 * ((data.size() + 2) / 3) + 1, '\0');
+    const auto length = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), data.data(), static_cast<int>(data.size()));
+    encoded.resize(static_cast<size_t>(length));
+    return encoded;
+}
+
+// Decoding as done before, by OpenSSL PEM reader, used as reference
+bool readWithOpenssl(const std::string& pem, Bytes& der)
+{
+    auto bio = crypto::make_unique(BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size())));
+    auto x509 = crypto::make_unique(PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr));
+    ERR_clear_error();
+    if (!x509)
+    {
+        return false;
+    }
+    unsigned char *out = nullptr;
+    const auto length = i2d_X509(x509.get(), &out);
+    der.assign(out, out + length);
+    OPENSSL_free(out);
+    return true;
+}
+
+// Raw PEM body as decoded by OpenSSL PEM reader
+bool readBytesWithOpenssl(const std::string& pem, Bytes& der)
+{
+    auto bio = crypto::make_unique(BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size())));
+    unsigned char *data = nullptr;
+    long length = 0;
+    char *name = nullptr;
+    const auto result = PEM_bytes_read_bio(&data, &length, &name, PEM_STRING_X509, bio.get(), nullptr, nullptr);
+    ERR_clear_error();
+    if (result != 1)
+    {
+        return false;
+    }
+    der.assign(data, data + length);
+    OPENSSL_free(data);
+    OPENSSL_free(name);
+    return true;
+}
+
+} // anonymous namespace
+
+struct PemDecoderUT : public Test
+{
+    std::string pemCert;
+    Bytes derCert;
+
+    PemDecoderUT()
+    {
+        test::X509CertGenerator certGenerator;
+        const auto key = certGenerator.generateEcKeypair();
+        const auto cert = certGenerator.generateCaCert(2, Bytes(20, 0x40), 0, 3600, key.get(), key.get(),
+                                                       constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+        pemCert = certGenerator.x509ToString(cert.get());
+        EXPECT_TRUE(readWithOpenssl(pemCert, derCert));
+    }
+};
+
+TEST_F(PemDecoderUT, base64RoundTripForAllRemainders)
+{
+    Bytes data;
+    for (size_t length = 0; length < 200; length++)
+    {
+        Bytes decoded;
+        ASSERT_TRUE(x509::pem::decodeBase64(encodeBase64(data), decoded)) << "length " << length;
+        ASSERT_EQ(decoded, data);
+        data.push_back(static_cast<uint8_t>(length * 37 + 11));
+    }
+}
+
+TEST_F(PemDecoderUT, base64SkipsLineBreaksAndBlanks)
+{
+    const Bytes expected = {'h', 'e', 'l', 'l', 'o', '!', 'o', 'k'};
+    for (const auto& encoded : {"aGVsbG8hb2s=", "aGVs\nbG8h\nb2s=\n", "aG\r\nVsbG8hb2\r\ns=\r\n", " aGVs bG8h\tb2s = "})
+    {
+        Bytes decoded;
+        EXPECT_TRUE(x509::pem::decodeBase64(encoded, decoded)) << encoded;
+        EXPECT_EQ(decoded, expected) << encoded;
+    }
+}
+
+TEST_F(PemDecoderUT, base64AppendsToOutput)
+{
+    Bytes decoded = {0x01};
+    ASSERT_TRUE(x509::pem::decodeBase64("AgM=", decoded));
+    EXPECT_THAT(decoded, ElementsAre(0x01, 0x02, 0x03));
+}
+
+TEST_F(PemDecoderUT, base64RejectsMalformedInput)
+{
+    for (const auto& encoded : {"aGVsbG8", "aGVsbG", "a", "aGVsbG8h=", "aGVs=G8h", "aGVsbG8=h", "aGV===", "====",
+                                "aGVs!G8h", "aGVs-G8h", "aGVsbG8hb2s=aGVs", "aGVsbG8hb2s==="})
+    {
+        Bytes decoded;
+        EXPECT_FALSE(x509::pem::decodeBase64(encoded, decoded)) << encoded;
+    }
+}
+
+TEST_F(PemDecoderUT, certificateToDerMatchesOpenssl)
+{
+    Bytes der;
+    ASSERT_TRUE(x509::pem::certificateToDer(pemCert, der));
+    EXPECT_EQ(der, derCert);
+
+    std::string crlfPem;
+    for (const auto c : pemCert)
+    {
+        crlfPem += c == '\n' ? std::string("\r\n") : std::string(1, c);
+    }
+    ASSERT_TRUE(x509::pem::certificateToDer(crlfPem, der));
+    EXPECT_EQ(der, derCert);
+}
+
+TEST_F(PemDecoderUT, certificateToDerLeavesUnusualFormsToOpenssl)
+{
+    std::string oldArmor = pemCert;
+    oldArmor.replace(oldArmor.find("BEGIN CERTIFICATE"), 17, "BEGIN X509 CERTIFICATE");
+    oldArmor.replace(oldArmor.find("END CERTIFICATE"), 15, "END X509 CERTIFICATE");
+
+    const std::string afterOtherBlock = "-----BEGIN PUBLIC KEY-----\nAAAA\n-----END PUBLIC KEY-----\n" + pemCert;
+    const std::string notAtLineStart = "garbage" + pemCert;
+
+    for (const auto& pem : {oldArmor, afterOtherBlock, notAtLineStart})
+    {
+        Bytes der;
+        EXPECT_FALSE(x509::pem::certificateToDer(pem, der)) << pem;
+
+        Bytes expectedDer;
+        const auto acceptedByOpenssl = readWithOpenssl(pem, expectedDer);
+        if (acceptedByOpenssl)
+        {
+            EXPECT_EQ(x509::Certificate::parse(pem).getPem(), pem);
+        }
+        else
+        {
+            EXPECT_THROW(x509::Certificate::parse(pem), FormatException) << pem;
+        }
+    }
+}
+
+TEST_F(PemDecoderUT, certificateParseAgreesWithOpensslOnMutatedPem)
+{
+    const auto reference = x509::Certificate::parse(pemCert);
+    const char replacements[] = {'A', '/', '=', '\n', ' ', '-', ':', '\0'};
+
+    std::vector<std::string> mutations;
+    for (size_t i = 0; i < pemCert.size(); i++)
+    {
+        for (const auto replacement : replacements)
+        {
+            if (pemCert[i] != replacement)
+            {
+                auto mutated = pemCert;
+                mutated[i] = replacement;
+                mutations.push_back(mutated);
+            }
+        }
+        auto removed = pemCert;
+        removed.erase(i, 1);
+        mutations.push_back(removed);
+    }
+
+    for (const auto& mutated : mutations)
+    {
+        Bytes expectedDer;
+        const auto acceptedByOpenssl = readWithOpenssl(mutated, expectedDer);
+
+        Bytes der;
+        if (x509::pem::certificateToDer(mutated, der))
+        {
+            // fast path accepted, OpenSSL has to decode the very same bytes
+            Bytes expectedBytes;
+            ASSERT_TRUE(readBytesWithOpenssl(mutated, expectedBytes)) << mutated;
+            ASSERT_EQ(der, expectedBytes) << mutated;
+        }
+
+        try
+        {
+            const auto certificate = x509::Certificate::parse(mutated);
+            ASSERT_TRUE(acceptedByOpenssl) << mutated;
+            if (expectedDer == derCert)
+            {
+                ASSERT_EQ(certificate.getInfo(), reference.getInfo()) << mutated;
+                ASSERT_EQ(certificate.getSignature(), reference.getSignature()) << mutated;
+            }
+        }
+        catch (const FormatException& ex)
+        {
+            // certificate decoded but with content rejected later on is fine as well
+            ASSERT_TRUE(!acceptedByOpenssl || std::string(ex.what()).find("PEM_read_bio_X509") == std::string::npos) << mutated;
+        }
+        catch (const InvalidExtensionException&)
+        {
+            ASSERT_TRUE(acceptedByOpenssl) << mutated;
+        }
+    }
+}
@@ -0,0 +1,568 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+#include "X509/SgxExtensionParser.h"
+#include "OpensslHelpers/OidUtils.h"
+#include "ParserUtils.h"
+
+#include "X509TestConstants.h"
+#include "X509CertGenerator.h"
+
+#include <openssl/asn1.h>
+
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <set>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::parser;
+using namespace ::testing;
+
+namespace {
+
+struct DecodedSgxExtension
+{
+    bool accepted = false;
+    Bytes ppid;
+    Bytes pceId;
+    Bytes fmspc;
+    int sgxType = 0;
+    Bytes cpuSvn;
+    Bytes cpuSvnComponents;
+    uint32_t pceSvn = 0;
+    Bytes platformInstanceId;
+    bool dynamicPlatform = false;
+    bool cachedKeys = false;
+    bool smtEnabled = false;
+
+    bool operator==(const DecodedSgxExtension& other) const
+    {
+        if (!accepted || !other.accepted)
+        {
+            return accepted == other.accepted;
+        }
+        return ppid == other.ppid && pceId == other.pceId && fmspc == other.fmspc &&
+               sgxType == other.sgxType && cpuSvn == other.cpuSvn && cpuSvnComponents == other.cpuSvnComponents &&
+               pceSvn == other.pceSvn && platformInstanceId == other.platformInstanceId &&
+               dynamicPlatform == other.dynamicPlatform && cachedKeys == other.cachedKeys && smtEnabled == other.smtEnabled;
+    }
+};
+
+std::string toHex(const Bytes& bytes)
+{
+    std::ostringstream os;
+    for (const auto byte : bytes)
+    {
+        os << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+    return os.str();
+}
+
+std::ostream& operator<<(std::ostream& os, const DecodedSgxExtension& decoded)
+{
+    if (!decoded.accepted)
+    {
+        return os << "rejected";
+    }
+    return os << "ppid=" << toHex(decoded.ppid) << " pceId=" << toHex(decoded.pceId) << " fmspc=" << toHex(decoded.fmspc)
+              << " sgxType=" << decoded.sgxType << " cpuSvn=" << toHex(decoded.cpuSvn)
+              << " components=" << toHex(decoded.cpuSvnComponents) << " pceSvn=" << decoded.pceSvn
+              << " platformInstanceId=" << toHex(decoded.platformInstanceId) << " configuration="
+              << decoded.dynamicPlatform << decoded.cachedKeys << decoded.smtEnabled;
+}
+
+using TupleHandler = std::function<void(const std::string& oidName, const ASN1_TYPE *oidValue)>;
+
+// Walks sequence of (OIDName, OIDValue) tuples with OpenSSL ASN1_TYPE decoder
+int forEachTuple(const ASN1_TYPE *sequence, const TupleHandler& handler)
+{
+    const auto stack = crypto::oidToStack(sequence);
+    const auto entries = sk_ASN1_TYPE_num(stack.get());
+    for (int i = 0; i < entries; i++)
+    {
+        const auto oidTupleWrapper = sk_ASN1_TYPE_value(stack.get(), i);
+        crypto::validateOid(oids::SGX_EXTENSION, oidTupleWrapper, V_ASN1_SEQUENCE);
+
+        const auto oidTuple = crypto::oidToStack(oidTupleWrapper);
+        if (sk_ASN1_TYPE_num(oidTuple.get()) != 2)
+        {
+            throw InvalidExtensionException("OID tuple expected to contain 2 elements");
+        }
+
+        const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
+        crypto::validateOid(oids::SGX_EXTENSION, oidName, V_ASN1_OBJECT);
+        handler(obj2Str(oidName->value.object), sk_ASN1_TYPE_value(oidTuple.get(), 1));
+    }
+    return entries;
+}
+
+Bytes octetString(const std::string& oidName, const ASN1_TYPE *oidValue, size_t length)
+{
+    crypto::validateOid(oidName, oidValue, V_ASN1_OCTET_STRING, static_cast<int>(length));
+    return crypto::oidToBytes(oidValue);
+}
+
+bool boolean(const std::string& oidName, const ASN1_TYPE *oidValue)
+{
+    crypto::validateOid(oidName, oidValue, V_ASN1_BOOLEAN);
+    return oidValue->value.boolean != 0;
+}
+
+// Reference decoder built on d2i_ASN1_TYPE and string OID comparison
+DecodedSgxExtension decodeWithOpenssl(const Bytes& value)
+{
+    DecodedSgxExtension decoded;
+    try
+    {
+        const auto *data = value.data();
+        const auto topSequence = crypto::make_unique(d2i_ASN1_TYPE(nullptr, &data, static_cast<long>(value.size())));
+        if (!topSequence)
+        {
+            return decoded;
+        }
+        crypto::validateOid(oids::SGX_EXTENSION, topSequence.get(), V_ASN1_SEQUENCE);
+
+        const auto entries = sk_ASN1_TYPE_num(crypto::oidToStack(topSequence.get()).get());
+        if (entries != 5 && entries != 7)
+        {
+            return decoded;
+        }
+
+        std::set<std::string> found;
+        forEachTuple(topSequence.get(), [&](const std::string& oidName, const ASN1_TYPE *oidValue) {
+            if (oidName == oids::PPID)
+            {
+                decoded.ppid = octetString(oidName, oidValue, 16);
+            }
+            else if (oidName == oids::PCEID)
+            {
+                decoded.pceId = octetString(oidName, oidValue, 2);
+            }
+            else if (oidName == oids::FMSPC)
+            {
+                decoded.fmspc = octetString(oidName, oidValue, 6);
+            }
+            else if (oidName == oids::SGX_TYPE)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_ENUMERATED);
+                decoded.sgxType = crypto::oidToEnum(oidValue);
+            }
+            else if (oidName == oids::TCB)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_SEQUENCE);
+                if (sk_ASN1_TYPE_num(crypto::oidToStack(oidValue).get()) != 18)
+                {
+                    throw InvalidExtensionException("TCB length");
+                }
+                decoded.cpuSvnComponents = Bytes(16);
+                std::set<std::string> tcbFound;
+                forEachTuple(oidValue, [&](const std::string& tcbOidName, const ASN1_TYPE *tcbOidValue) {
+                    if (tcbOidName == oids::CPUSVN)
+                    {
+                        decoded.cpuSvn = octetString(tcbOidName, tcbOidValue, 16);
+                    }
+                    else if (tcbOidName == oids::PCESVN)
+                    {
+                        crypto::validateOid(tcbOidName, tcbOidValue, V_ASN1_INTEGER);
+                        decoded.pceSvn = crypto::oidToUInt(tcbOidValue);
+                    }
+                    else
+                    {
+                        size_t component = 1;
+                        while (component <= 16 && tcbOidName != oids::TCB + "." + std::to_string(component))
+                        {
+                            component++;
+                        }
+                        if (component > 16)
+                        {
+                            return;
+                        }
+                        crypto::validateOid(tcbOidName, tcbOidValue, V_ASN1_INTEGER);
+                        decoded.cpuSvnComponents[component - 1] = crypto::oidToByte(tcbOidValue);
+                    }
+                    tcbFound.insert(tcbOidName);
+                });
+                if (tcbFound.size() != 18)
+                {
+                    throw InvalidExtensionException("TCB incomplete");
+                }
+            }
+            else
+            {
+                return;
+            }
+            found.insert(oidName);
+        });
+        if (found.size() != 5)
+        {
+            return decoded;
+        }
+
+        if (entries == 7)
+        {
+            std::set<std::string> platformFound;
+            forEachTuple(topSequence.get(), [&](const std::string& oidName, const ASN1_TYPE *oidValue) {
+                if (oidName == oids::PLATFORM_INSTANCE_ID)
+                {
+                    decoded.platformInstanceId = octetString(oidName, oidValue, 16);
+                }
+                else if (oidName == oids::CONFIGURATION)
+                {
+                    crypto::validateOid(oidName, oidValue, V_ASN1_SEQUENCE);
+                    std::set<std::string> configurationFound;
+                    forEachTuple(oidValue, [&](const std::string& confOidName, const ASN1_TYPE *confOidValue) {
+                        if (confOidName == oids::DYNAMIC_PLATFORM)
+                        {
+                            decoded.dynamicPlatform = boolean(confOidName, confOidValue);
+                        }
+                        else if (confOidName == oids::CACHED_KEYS)
+                        {
+                            decoded.cachedKeys = boolean(confOidName, confOidValue);
+                        }
+                        else if (confOidName == oids::SMT_ENABLED)
+                        {
+                            decoded.smtEnabled = boolean(confOidName, confOidValue);
+                        }
+                        else
+                        {
+                            return;
+                        }
+                        configurationFound.insert(confOidName);
+                    });
+                    if (configurationFound.size() != 3)
+                    {
+                        throw InvalidExtensionException("Configuration incomplete");
+                    }
+                }
+                else
+                {
+                    return;
+                }
+                platformFound.insert(oidName);
+            });
+            if (platformFound.size() != 2)
+            {
+                return decoded;
+            }
+        }
+        decoded.accepted = true;
+    }
+    catch (const FormatException&)
+    {
+        decoded.accepted = false;
+    }
+    catch (const InvalidExtensionException&)
+    {
+        decoded.accepted = false;
+    }
+    return decoded;
+}
+
+DecodedSgxExtension decodeWithDerWalker(const Bytes& value)
+{
+    DecodedSgxExtension decoded;
+    try
+    {
+        const auto entries = x509::countSgxExtensionElements(value.data(), value.size());
+        if (entries != 5 && entries != 7)
+        {
+            return decoded;
+        }
+
+        const auto pck = x509::parsePckSgxExtension(value.data(), value.size());
+        decoded.ppid = Bytes(pck.ppid.begin(), pck.ppid.end());
+        decoded.pceId = Bytes(pck.pceId.begin(), pck.pceId.end());
+        decoded.fmspc = Bytes(pck.fmspc.begin(), pck.fmspc.end());
+        decoded.sgxType = pck.sgxType;
+        decoded.cpuSvn = Bytes(pck.cpuSvn.begin(), pck.cpuSvn.end());
+        decoded.cpuSvnComponents = Bytes(pck.cpuSvnComponents.begin(), pck.cpuSvnComponents.end());
+        decoded.pceSvn = pck.pceSvn;
+
+        if (entries == 7)
+        {
+            const auto platform = x509::parsePlatformSgxExtension(value.data(), value.size());
+            decoded.platformInstanceId = Bytes(platform.platformInstanceId.begin(), platform.platformInstanceId.end());
+            decoded.dynamicPlatform = platform.dynamicPlatform;
+            decoded.cachedKeys = platform.cachedKeys;
+            decoded.smtEnabled = platform.smtEnabled;
+        }
+        decoded.accepted = true;
+    }
+    catch (const FormatException&)
+    {
+        decoded.accepted = false;
+    }
+    catch (const InvalidExtensionException&)
+    {
+        decoded.accepted = false;
+    }
+    return decoded;
+}
+
+// Minimal DER encoder used to build SGX Extensions by hand
+Bytes tlv(uint8_t tag, const Bytes& content)
+{
+    Bytes encoded{tag};
+    if (content.size() < 0x80)
+    {
+        encoded.push_back(static_cast<uint8_t>(content.size()));
+    }
+    else
+    {
+        encoded.push_back(0x82);
+        encoded.push_back(static_cast<uint8_t>(content.size() >> 8));
+        encoded.push_back(static_cast<uint8_t>(content.size()));
+    }
+    return encoded + content;
+}
+
+Bytes sgxOid(const Bytes& arcs)
+{
+    return tlv(x509::der::OBJECT, Bytes{0x2A, 0x86, 0x48, 0x86, 0xF8, 0x4D, 0x01, 0x0D, 0x01} + arcs);
+}
+
+Bytes sgxTuple(const Bytes& arcs, const Bytes& value)
+{
+    return tlv(x509::der::SEQUENCE, sgxOid(arcs) + value);
+}
+
+Bytes tcb(const Bytes& lastComponent = tlv(x509::der::INTEGER, {0x10}))
+{
+    Bytes entries;
+    for (uint8_t i = 1; i <= 15; i++)
+    {
+        entries = entries + sgxTuple({0x02, i}, tlv(x509::der::INTEGER, {i}));
+    }
+    entries = entries + sgxTuple({0x02, 16}, lastComponent);
+    entries = entries + sgxTuple({0x02, 17}, tlv(x509::der::INTEGER, {0x01, 0x02}));
+    entries = entries + sgxTuple({0x02, 18}, tlv(x509::der::OCTET_STRING, Bytes(16, 0x33)));
+    return tlv(x509::der::SEQUENCE, entries);
+}
+
+Bytes processorSgxExtension(const Bytes& tcbValue = tcb(), const Bytes& sgxType = tlv(x509::der::ENUMERATED, {0x00}))
+{
+    return tlv(x509::der::SEQUENCE,
+               sgxTuple({0x01}, tlv(x509::der::OCTET_STRING, Bytes(16, 0x11))) +
+               sgxTuple({0x02}, tcbValue) +
+               sgxTuple({0x03}, tlv(x509::der::OCTET_STRING, {0x00, 0x01})) +
+               sgxTuple({0x04}, tlv(x509::der::OCTET_STRING, {0x00, 0x90, 0x6E, 0xA1, 0x00, 0x00})) +
+               sgxTuple({0x05}, sgxType));
+}
+
+} // namespace
+
+struct SgxExtensionParserUT: public testing::Test {
+    int timeNow = 0;
+    int timeOneHour = 3600;
+
+    Bytes sn { 0x40, 0x66, 0xB0, 0x01, 0x4B, 0x71, 0x7C, 0xF7, 0x01, 0xD5,
+               0xB7, 0xD8, 0xF1, 0x36, 0xB1, 0x99, 0xE9, 0x73, 0x96, 0xC8 };
+    Bytes ppid = Bytes(16, 0xaa);
+    Bytes cpusvn = {0x00, 0x01, 0x7F, 0x80, 0xFF, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    Bytes pcesvn = {0x03, 0xf2};
+    Bytes pceId = {0x04, 0xf3};
+    Bytes fmspc = {0x05, 0xf4, 0x44, 0x45, 0xaa, 0x00};
+    Bytes platformInstanceId = {0x0A, 0xBB, 0xFF, 0x05, 0xf4, 0x44, 0xB0, 0x01,
+                                0x4B, 0x71, 0xB1, 0x99, 0xE9, 0xE9, 0x73, 0x96};
+    test::X509CertGenerator certGenerator;
+
+    crypto::EVP_PKEY_uptr keyInt = certGenerator.generateEcKeypair();
+    crypto::EVP_PKEY_uptr key = certGenerator.generateEcKeypair();
+
+    Bytes sgxExtensionOf(const crypto::X509_uptr& cert)
+    {
+        const auto certificate = x509::Certificate::parse(certGenerator.x509ToString(cert.get()));
+        for (const auto& extension : certificate.getExtensions())
+        {
+            if (extension.getName() == oids::SGX_EXTENSION)
+            {
+                return extension.getValue();
+            }
+        }
+        return {};
+    }
+
+    Bytes processorExtension(int sgxType = 0)
+    {
+        return sgxExtensionOf(certGenerator.generatePCKCert(2, sn, timeNow, timeOneHour, key.get(), keyInt.get(),
+                                                            parser::constants::PCK_SUBJECT, parser::constants::PLATFORM_CA_SUBJECT,
+                                                            ppid, cpusvn, pcesvn, pceId, fmspc, sgxType));
+    }
+
+    Bytes platformExtension(bool dynamicPlatform, bool cachedKeys, bool smtEnabled)
+    {
+        return sgxExtensionOf(certGenerator.generatePCKCert(2, sn, timeNow, timeOneHour, key.get(), keyInt.get(),
+                                                            parser::constants::PCK_SUBJECT, parser::constants::PLATFORM_CA_SUBJECT,
+                                                            ppid, cpusvn, pcesvn, pceId, fmspc, 1, platformInstanceId,
+                                                            dynamicPlatform, cachedKeys, smtEnabled));
+    }
+
+    // Every byte of the extension is replaced with a set of values that hit tags, lengths and OID arcs
+    void expectSameResultForMutations(const Bytes& sgxExtension)
+    {
+        for (size_t i = 0; i < sgxExtension.size(); i++)
+        {
+            const uint8_t original = sgxExtension[i];
+            const uint8_t replacements[] = {
+                    0x00, 0x01, 0x7F, 0x80, 0x81, 0xFF,
+                    static_cast<uint8_t>(original + 1), static_cast<uint8_t>(original - 1),
+                    static_cast<uint8_t>(original ^ 0x20), static_cast<uint8_t>(original ^ 0x80)
+            };
+            for (const auto replacement : replacements)
+            {
+                auto mutated = sgxExtension;
+                mutated[i] = replacement;
+
+                const auto walked = decodeWithDerWalker(mutated);
+                const auto reference = decodeWithOpenssl(mutated);
+                ASSERT_EQ(walked, reference) << toHex(sgxExtension) << " byte " << i << " replaced with " << static_cast<int>(replacement);
+            }
+        }
+
+        for (size_t length = 0; length < sgxExtension.size(); length++)
+        {
+            const Bytes truncated(sgxExtension.begin(), sgxExtension.begin() + static_cast<long>(length));
+            ASSERT_FALSE(decodeWithDerWalker(truncated).accepted) << "truncated to " << length;
+            ASSERT_FALSE(decodeWithOpenssl(truncated).accepted) << "truncated to " << length;
+        }
+    }
+};
+
+TEST_F(SgxExtensionParserUT, processorExtensionDecodedSameAsOpenssl)
+{
+    for (const auto sgxType : {0, 1, 2, 999})
+    {
+        const auto sgxExtension = processorExtension(sgxType);
+        const auto walked = decodeWithDerWalker(sgxExtension);
+
+        ASSERT_TRUE(walked.accepted);
+        ASSERT_EQ(walked, decodeWithOpenssl(sgxExtension));
+        ASSERT_EQ(walked.ppid, ppid);
+        ASSERT_EQ(walked.cpuSvn, cpusvn);
+        ASSERT_EQ(walked.cpuSvnComponents, cpusvn);
+        ASSERT_EQ(walked.pceSvn, 0x03f2u);
+        ASSERT_EQ(walked.pceId, pceId);
+        ASSERT_EQ(walked.fmspc, fmspc);
+        ASSERT_EQ(walked.sgxType, sgxType);
+    }
+}
+
+TEST_F(SgxExtensionParserUT, platformExtensionDecodedSameAsOpenssl)
+{
+    // Configuration is only encoded when at least one of its flags is set
+    for (int flags = 1; flags < 8; flags++)
+    {
+        const auto sgxExtension = platformExtension((flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0);
+        const auto walked = decodeWithDerWalker(sgxExtension);
+
+        ASSERT_TRUE(walked.accepted);
+        ASSERT_EQ(walked, decodeWithOpenssl(sgxExtension));
+        ASSERT_EQ(walked.platformInstanceId, platformInstanceId);
+        ASSERT_EQ(walked.dynamicPlatform, (flags & 1) != 0);
+        ASSERT_EQ(walked.cachedKeys, (flags & 2) != 0);
+        ASSERT_EQ(walked.smtEnabled, (flags & 4) != 0);
+    }
+}
+
+TEST_F(SgxExtensionParserUT, mutatedProcessorExtensionDecodedSameAsOpenssl)
+{
+    expectSameResultForMutations(processorExtension());
+}
+
+TEST_F(SgxExtensionParserUT, mutatedPlatformExtensionDecodedSameAsOpenssl)
+{
+    expectSameResultForMutations(platformExtension(true, false, true));
+}
+
+TEST_F(SgxExtensionParserUT, integerValuesTruncatedSameAsOpenssl)
+{
+    const Bytes values[] = {
+            {0x00, 0xFF}, {0x01, 0x00}, {0xFF}, {0x80}, {0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+            {0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}
+    };
+    for (const auto& value : values)
+    {
+        const auto tcbExtension = processorSgxExtension(tcb(tlv(x509::der::INTEGER, value)));
+        const auto sgxTypeExtension = processorSgxExtension(tcb(), tlv(x509::der::ENUMERATED, value));
+
+        ASSERT_TRUE(decodeWithDerWalker(tcbExtension).accepted);
+        ASSERT_EQ(decodeWithDerWalker(tcbExtension), decodeWithOpenssl(tcbExtension));
+        ASSERT_TRUE(decodeWithDerWalker(sgxTypeExtension).accepted);
+        ASSERT_EQ(decodeWithDerWalker(sgxTypeExtension), decodeWithOpenssl(sgxTypeExtension));
+    }
+}
+
+TEST_F(SgxExtensionParserUT, unknownOidsAreSkipped)
+{
+    const auto sgxExtension = tlv(x509::der::SEQUENCE,
+                                  sgxTuple({0x01}, tlv(x509::der::OCTET_STRING, Bytes(16, 0x11))) +
+                                  sgxTuple({0x02}, tcb()) +
+                                  sgxTuple({0x03}, tlv(x509::der::OCTET_STRING, {0x00, 0x01})) +
+                                  sgxTuple({0x04}, tlv(x509::der::OCTET_STRING, Bytes(6, 0x00))) +
+                                  sgxTuple({0x05}, tlv(x509::der::ENUMERATED, {0x00})) +
+                                  sgxTuple({0x08}, tlv(x509::der::INTEGER, {0x00})) +
+                                  sgxTuple({0x01, 0x01}, tlv(x509::der::INTEGER, {0x00})));
+
+    ASSERT_EQ(x509::countSgxExtensionElements(sgxExtension.data(), sgxExtension.size()), 7u);
+    ASSERT_NO_THROW(x509::parsePckSgxExtension(sgxExtension.data(), sgxExtension.size()));
+    ASSERT_THROW(x509::parsePlatformSgxExtension(sgxExtension.data(), sgxExtension.size()), InvalidExtensionException);
+}
+
+TEST_F(SgxExtensionParserUT, malformedExtensionRejected)
+{
+    const auto valid = processorSgxExtension();
+    ASSERT_NO_THROW(x509::parsePckSgxExtension(valid.data(), valid.size()));
+
+    // indefinite length is not allowed in DER
+    auto indefinite = valid;
+    indefinite[1] = 0x80;
+    ASSERT_THROW(x509::parsePckSgxExtension(indefinite.data(), indefinite.size()), InvalidExtensionException);
+
+    ASSERT_THROW(x509::parsePckSgxExtension(valid.data(), 0), InvalidExtensionException);
+    ASSERT_THROW(x509::parsePckSgxExtension(valid.data(), valid.size() - 1), InvalidExtensionException);
+
+    const auto notSequence = tlv(x509::der::OCTET_STRING, {0x00});
+    ASSERT_THROW(x509::parsePckSgxExtension(notSequence.data(), notSequence.size()), FormatException);
+
+    const auto wrongTcbLength = processorSgxExtension(tlv(x509::der::SEQUENCE, sgxTuple({0x02, 0x01}, tlv(x509::der::INTEGER, {0x00}))));
+    ASSERT_THROW(x509::parsePckSgxExtension(wrongTcbLength.data(), wrongTcbLength.size()), InvalidExtensionException);
+
+    const auto paddedInteger = processorSgxExtension(tcb(tlv(x509::der::INTEGER, {0x00, 0x01})));
+    ASSERT_THROW(x509::parsePckSgxExtension(paddedInteger.data(), paddedInteger.size()), FormatException);
+
+    const auto wrongComponentType = processorSgxExtension(tcb(tlv(x509::der::OCTET_STRING, {0x01})));
+    ASSERT_THROW(x509::parsePckSgxExtension(wrongComponentType.data(), wrongComponentType.size()), FormatException);
+}